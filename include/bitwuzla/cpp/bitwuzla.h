@@ -1010,6 +1010,13 @@ class TermManager
   friend Bitwuzla;
 
   TermManager();
+  /**
+   * Constructor.
+   * @param thread_safe True to allow creating sorts and terms of this term
+   *                    manager from multiple threads concurrently. Note that
+   *                    Bitwuzla instances are still not thread-safe.
+   */
+  explicit TermManager(bool thread_safe);
   ~TermManager();
 
   /** Disallow copy construction. */
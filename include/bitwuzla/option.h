@@ -123,6 +123,106 @@ enum ENUM(Option)
    *                 propagation-based local search.
    */
   EVALUE(BV_SOLVER),
+  /*! **Optimize bit-blasted AIGs.**
+   *
+   * When enabled, the AIGs of the bit-blasted assertions are optimized with
+   * balancing, DAG-aware rewriting and refactoring before they are encoded
+   * to CNF.
+   *
+   * Values:
+   *  * **1**: enable
+   *  * **0**: disable [**default**]
+   *
+   *  @warning This is an expert option to configure the bit-blasting engine.
+   */
+  EVALUE(BV_AIG_OPT),
+  /*! **Merge equivalent nodes of bit-blasted AIGs.**
+   *
+   * When enabled, functionally equivalent nodes of the AIGs of the
+   * bit-blasted assertions are merged before they are encoded to CNF
+   * (FRAIGing). Candidate equivalences are identified via random simulation
+   * and proved with conflict-limited calls to a dedicated SAT solver.
+   *
+   * Values:
+   *  * **1**: enable
+   *  * **0**: disable [**default**]
+   *
+   *  @warning This is an expert option to configure the bit-blasting engine.
+   */
+  EVALUE(BV_AIG_FRAIG),
+  /*! **Plaisted-Greenbaum CNF encoding of bit-blasted AIGs.**
+   *
+   * When enabled, AIG nodes are only encoded to CNF in the polarities in
+   * which they are used by the assertions and assumptions, instead of
+   * encoding full equivalences.
+   *
+   * Values:
+   *  * **1**: enable
+   *  * **0**: disable [**default**]
+   *
+   *  @warning This is an expert option to configure the bit-blasting engine.
+   */
+  EVALUE(BV_CNF_PG),
+  /*! **Encoding of bit-vector multiplication.**
+   *
+   * Configure the circuit used for bit-blasting bit-vector multiplication.
+   *
+   * Values:
+   *  * **array**:
+   *    Shift-and-add array multiplier with ripple-carry rows. [**default**]
+   *  * **wallace**:
+   *    Partial products reduced with a Wallace tree of carry-save adders.
+   *  * **dadda**:
+   *    Partial products reduced with a Dadda tree of carry-save adders.
+   *  * **booth**:
+   *    Radix-4 Booth recoded partial products reduced with a Dadda tree.
+   *  * **auto**:
+   *    Use **booth** if an operand is a value, **dadda** for bit-widths
+   *    of at least 16 and **array** otherwise.
+   *
+   *  @warning This is an expert option to configure the bit-blasting engine.
+   */
+  EVALUE(BV_MUL_ENC),
+  /*! **Encode division by values via multiplication.**
+   *
+   * When enabled, unsigned bit-vector division and remainder by a value
+   * that is not zero or a power of two are bit-blasted as multiplication
+   * with the reciprocal of the value instead of a (constant propagated)
+   * shift-subtract divider.
+   *
+   * Values:
+   *  * **1**: enable
+   *  * **0**: disable [**default**]
+   *
+   *  @warning This is an expert option to configure the bit-blasting engine.
+   */
+  EVALUE(BV_DIV_RECIPROCAL),
+  /*! **Run bv solver engine preprop in parallel.**
+   *
+   * When enabled, bv solver engine `preprop` runs propagation-based local
+   * search and bit-blasting concurrently on two threads instead of
+   * sequentially. The answer of the engine that finishes first is used.
+   *
+   * Values:
+   *  * **1**: enable
+   *  * **0**: disable [**default**]
+   */
+  EVALUE(PREPROP_PARALLEL),
+  /*! **Warm-start bit-blasting of bv solver engine preprop.**
+   *
+   * When enabled, bv solver engine `preprop` seeds the initial phases of the
+   * SAT solver with the current assignment of the propagation-based local
+   * search, i.e., with the assignment it ended up with if it did not
+   * determine an answer, or the model of the previous satisfiable check.
+   *
+   * Values:
+   *  * **1**: enable [**default**]
+   *  * **0**: disable
+   *
+   * @note Only has an effect for SAT solvers that support setting phases
+   *       (CaDiCaL and its portfolio mode).
+   */
+  EVALUE(PREPROP_WARM_START),
   /*! **Rewrite level.**
    *
    * Values:
@@ -148,8 +248,18 @@ enum ENUM(Option)
    *    [Kissat](https://github.com/arminbiere/kissat)
    *  * **lingeling**:
    *    [Lingeling](https://github.com/arminbiere/lingeling)
+   *  * **portfolio**:
+   *    Parallel portfolio of CaDiCaL configurations and Kissat (if
+   *    configured), running on ::EVALUE(THREADS) threads.
    */
   EVALUE(SAT_SOLVER),
+  /*! **Number of threads used by parallel engines.**
+   *
+   * Values:
+   *  * An unsigned integer value, 0 for one thread per available hardware
+   *    thread. [**default**: 0]
+   */
+  EVALUE(THREADS),
 
   /* ---------------- BV: Prop Engine Options (Expert) ---------------------- */
 
@@ -280,6 +390,86 @@ enum ENUM(Option)
    *  @warning This is an expert option to configure the prop solver engine.
    */
   EVALUE(PROP_NORMALIZE),
+  /*! **Propagation-based local search solver engine:
+   *    Parallel portfolio.**
+   *
+   * When enabled, run ::EVALUE(THREADS) local search instances with different
+   * seeds and configurations concurrently and use the first answer.
+   *
+   * Values:
+   *  * **1**: enable
+   *  * **0**: disable [**default**]
+   *
+   *  @warning This is an expert option to configure the prop solver engine.
+   */
+  EVALUE(PROP_PORTFOLIO),
+  /*! **Propagation-based local search solver engine:
+   *    Root weighting.**
+   *
+   * When enabled, maintain weights for roots (assertions), select
+   * unsatisfied roots proportionally to their weight, and perform the move
+   * among several candidate moves that minimizes the weighted number of
+   * unsatisfied roots. Weights of unsatisfied roots are increased when no
+   * candidate move improves this number.
+   *
+   * Values:
+   *  * **1**: enable
+   *  * **0**: disable [**default**]
+   *
+   *  @warning This is an expert option to configure the prop solver engine.
+   */
+  EVALUE(PROP_ROOT_WEIGHTS),
+  /*! **Propagation-based local search solver engine:
+   *    Native floating-point operators.**
+   *
+   * When enabled, floating-point operators are handled natively by the
+   * local search engine, i.e., inverse and consistent values are computed on
+   * the level of floating-point values instead of the word-blasted
+   * bit-vector representation. Formulas with floating-point operators that
+   * are not supported natively (`fp.fma`, `fp.min`, `fp.max`, `fp.rem`,
+   * `fp.roundToIntegral`, `fp.sqrt`, `fp.to_sbv`, `fp.to_ubv`) are answered
+   * with unknown.
+   *
+   * Values:
+   *  * **1**: enable
+   *  * **0**: disable [**default**]
+   *
+   * @note Only effective with `Option::BV_SOLVER` set to `prop`.
+   *
+   *  @warning This is an expert option to configure the prop solver engine.
+   */
+  EVALUE(PROP_FP),
+  /*! **Propagation-based local search solver engine:
+   *    Restarts.**
+   *
+   * When enabled, the local search engine tracks the best assignment seen,
+   * i.e., the assignment with the fewest unsatisfied constraints, and
+   * restarts from it after a number of moves without improvement, following
+   * the Luby sequence. If a check is inconclusive, the next (incremental)
+   * check starts from the best assignment seen rather than the last one.
+   *
+   * Values:
+   *  * **1**: enable
+   *  * **0**: disable [**default**]
+   *
+   *  @warning This is an expert option to configure the prop solver engine.
+   */
+  EVALUE(PROP_RESTARTS),
+  /*! **Propagation-based local search solver engine:
+   *    Inverse value memoization.**
+   *
+   * When enabled, multiplicative inverses computed for inverse values of
+   * `bvmul` and wheel factorizations computed for inverse values of `bvurem`
+   * are memoized per term in a small bounded memo, keyed by the target value,
+   * the value of the other operand and the operand position.
+   *
+   * Values:
+   *  * **1**: enable
+   *  * **0**: disable [**default**]
+   *
+   *  @warning This is an expert option to configure the prop solver engine.
+   */
+  EVALUE(PROP_INV_MEMO),
 
   /*! **Abstraction module**
    *
@@ -58,6 +58,14 @@ _init_reverse(const std::unordered_map<K, V> &map)
 static const std::unordered_map<Option, bzla::option::Option>
     s_internal_options = {
         {Option::BV_SOLVER, bzla::option::Option::BV_SOLVER},
+        {Option::BV_AIG_OPT, bzla::option::Option::BV_AIG_OPT},
+        {Option::BV_AIG_FRAIG, bzla::option::Option::BV_AIG_FRAIG},
+        {Option::BV_CNF_PG, bzla::option::Option::BV_CNF_PG},
+        {Option::BV_MUL_ENC, bzla::option::Option::BV_MUL_ENC},
+        {Option::BV_DIV_RECIPROCAL, bzla::option::Option::BV_DIV_RECIPROCAL},
+        {Option::PREPROP_PARALLEL, bzla::option::Option::PREPROP_PARALLEL},
+        {Option::PREPROP_WARM_START,
+         bzla::option::Option::PREPROP_WARM_START},
         {Option::LOGLEVEL, bzla::option::Option::LOG_LEVEL},
         {Option::PRODUCE_MODELS, bzla::option::Option::PRODUCE_MODELS},
         {Option::PRODUCE_UNSAT_ASSUMPTIONS,
@@ -65,6 +73,7 @@ static const std::unordered_map<Option, bzla::option::Option>
         {Option::PRODUCE_UNSAT_CORES,
          bzla::option::Option::PRODUCE_UNSAT_CORES},
         {Option::SAT_SOLVER, bzla::option::Option::SAT_SOLVER},
+        {Option::THREADS, bzla::option::Option::THREADS},
         {Option::SEED, bzla::option::Option::SEED},
         {Option::VERBOSITY, bzla::option::Option::VERBOSITY},
         {Option::TIME_LIMIT_PER, bzla::option::Option::TIME_LIMIT_PER},
@@ -85,6 +94,11 @@ static const std::unordered_map<Option, bzla::option::Option>
          bzla::option::Option::PROP_PROB_PICK_INV_VALUE},
         {Option::PROP_SEXT, bzla::option::Option::PROP_SEXT},
         {Option::PROP_NORMALIZE, bzla::option::Option::PROP_NORMALIZE},
+        {Option::PROP_PORTFOLIO, bzla::option::Option::PROP_PORTFOLIO},
+        {Option::PROP_ROOT_WEIGHTS, bzla::option::Option::PROP_ROOT_WEIGHTS},
+        {Option::PROP_FP, bzla::option::Option::PROP_FP},
+        {Option::PROP_RESTARTS, bzla::option::Option::PROP_RESTARTS},
+        {Option::PROP_INV_MEMO, bzla::option::Option::PROP_INV_MEMO},
         {Option::ABSTRACTION, bzla::option::Option::ABSTRACTION},
         {Option::ABSTRACTION_BV_SIZE,
          bzla::option::Option::ABSTRACTION_BV_SIZE},
@@ -1603,6 +1617,11 @@ Bitwuzla::solver_state_change()
 
 TermManager::TermManager() : d_nm(new bzla::NodeManager()) {}
 
+TermManager::TermManager(bool thread_safe)
+    : d_nm(new bzla::NodeManager(thread_safe))
+{
+}
+
 TermManager::~TermManager() {}
 
 Sort
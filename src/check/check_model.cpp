@@ -13,6 +13,7 @@
 #include <unordered_set>
 
 #include "node/node_manager.h"
+#include "rewrite/batch_evaluator.h"
 
 namespace bzla::check {
 
@@ -35,6 +36,14 @@ CheckModel::check()
   Log(1) << "*** check model";
   Log(1);
 
+  collect_consts();
+
+  if (check_eval())
+  {
+    Log(1) << "model checked via evaluation";
+    return true;
+  }
+
   option::Options opts;
   opts.dbg_check_model.set(false);
   NodeManager& nm = d_ctx.env().nm();
@@ -44,7 +53,6 @@ CheckModel::check()
     check_ctx.assert_formula(assertion);
   }
 
-  collect_consts();
   for (const Node& input : d_consts)
   {
     Node value = d_ctx.get_value(input);
@@ -68,6 +76,24 @@ CheckModel::check()
   return check_ctx.solve() != Result::UNSAT; // unknown allowed for now
 }
 
+bool
+CheckModel::check_eval()
+{
+  const auto& assertions = d_ctx.original_assertions();
+  BatchEvaluator eval(
+      std::vector<Node>(assertions.begin(), assertions.end()));
+  if (!eval.is_supported())
+  {
+    return false;
+  }
+  for (const Node& input : eval.inputs())
+  {
+    eval.set_value(input, 0, d_ctx.get_value(input));
+  }
+  eval.evaluate();
+  return eval.satisfied() & 1;
+}
+
 void
 CheckModel::collect_consts()
 {
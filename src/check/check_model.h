@@ -26,6 +26,14 @@ class CheckModel
   bool check();
 
  private:
+  /**
+   * Check the model by evaluating the original assertions with the batch
+   * evaluator.
+   * @return True if all assertions evaluate to true. False if the assertions
+   *         contain unsupported terms or if an assertion evaluates to false,
+   *         in which case the model is checked via a new solving context.
+   */
+  bool check_eval();
   void collect_consts();
   void assert_array_model(SolvingContext& ctx,
                           const Node& input,
@@ -10,8 +10,8 @@
 
 #include "bitblast/aig/aig_cnf.h"
 
+#include <array>
 #include <cstdlib>
-#include <functional>
 #include <unordered_set>
 #include <vector>
 
@@ -20,44 +20,47 @@ namespace bzla::bitblast {
 void
 AigCnfEncoder::encode(const AigNode& node, bool top_level)
 {
+  const AigManager& mgr = *node.d_mgr;
+  d_level = top_level ? 0 : static_cast<uint32_t>(d_activation.size());
   if (top_level)
   {
-    std::unordered_set<int64_t> cache;
-    std::vector<std::reference_wrapper<const AigNode>> visit{node};
-    std::vector<std::reference_wrapper<const AigNode>> children;
+    std::unordered_set<AigLit> cache;
+    std::vector<AigLit> visit{node.d_lit};
+    std::vector<AigLit> children;
     do
     {
-      const AigNode& cur = visit.back();
+      AigLit cur = visit.back();
       visit.pop_back();
 
-      auto [it, inserted] = cache.insert(cur.get_id());
+      auto [it, inserted] = cache.insert(cur);
       if (!inserted)
       {
         continue;
       }
 
-      if (cur.is_and() && !cur.is_negated())
+      const AigNodeData& d = mgr.d_nodes[cur >> 1];
+      if (d.d_left != 0 && !(cur & 1))
       {
-        visit.push_back(cur[1]);
-        visit.push_back(cur[0]);
+        visit.push_back(d.d_right);
+        visit.push_back(d.d_left);
       }
       else
       {
         children.push_back(cur);
-        _encode(cur);
+        _encode(mgr, cur >> 1, (cur & 1) ? POL_NEG : POL_POS);
       }
     } while (!visit.empty());
     assert(!children.empty());
 
-    for (const AigNode& child : children)
+    for (AigLit child : children)
     {
-      d_sat_solver.add_clause({child.get_id()});
+      add_clause({AigNode::to_id(child)});
       ++d_statistics.num_clauses;
     }
   }
   else
   {
-    _encode(node);
+    _encode(mgr, node.index(), node.is_negated() ? POL_NEG : POL_POS);
   }
 }
 
@@ -74,7 +77,7 @@ AigCnfEncoder::value(const AigNode& aig)
   }
 
   int32_t val = -1;
-  if (is_encoded(aig))
+  if (is_encoded(aig.index()))
   {
     val = d_sat_solver.value(std::abs(aig.get_id())) ? 1 : -1;
   }
@@ -82,6 +85,54 @@ AigCnfEncoder::value(const AigNode& aig)
   return aig.is_negated() ? -val : val;
 }
 
+bool
+AigCnfEncoder::is_encoded(const AigNode& node) const
+{
+  return is_encoded(node.index());
+}
+
+void
+AigCnfEncoder::push(const AigNode& activation)
+{
+  assert(activation.is_const());
+  d_activation.push_back(activation.get_id());
+  d_control.push_back(d_trail.size());
+}
+
+void
+AigCnfEncoder::pop()
+{
+  assert(!d_activation.empty());
+  assert(!d_control.empty());
+  size_t pop_to = d_control.back();
+  d_control.pop_back();
+
+  // AIGs that were encoded again at the top level in the meantime are kept.
+  uint32_t level = static_cast<uint32_t>(d_activation.size());
+  while (d_trail.size() > pop_to)
+  {
+    AigLit lit = d_trail.back();
+    size_t pos = static_cast<size_t>((lit >> 1) - 1);
+    assert(pos < d_aig_encoded.size());
+    auto& levels = d_aig_encoded[pos];
+    if (levels[lit & 1] == level + 1)
+    {
+      levels[lit & 1] = 0;
+      if (levels[0] == 0 && levels[1] == 0)
+      {
+        ++d_statistics.num_released;
+      }
+    }
+    d_trail.pop_back();
+  }
+
+  // Disable all clauses guarded by the activation literal of this scope.
+  d_sat_solver.add_clause({-d_activation.back()});
+  ++d_statistics.num_clauses;
+  ++d_statistics.num_literals;
+  d_activation.pop_back();
+}
+
 const AigCnfEncoder::Statistics&
 AigCnfEncoder::statistics() const
 {
@@ -90,43 +141,185 @@ AigCnfEncoder::statistics() const
 
 namespace {
 
+/** The kinds of gates encoded natively. */
+enum class GateKind
+{
+  AND,
+  ITE,
+  XOR,
+  MAJ,
+};
+
+/**
+ * A gate over the literals of its inputs: AND(a,b), ITE(c,a,b), XOR(a,b) or
+ * MAJ(a,b,c).
+ */
+struct Gate
+{
+  GateKind d_kind;
+  std::array<AigLit, 3> d_inputs;
+  uint32_t d_num_inputs;
+};
+
+/**
+ * Check whether given literal is a negated AND gate.
+ * @param children Set to the children of the AND gate.
+ */
+bool
+is_nand(const std::vector<AigNodeData>& nodes,
+        AigLit lit,
+        std::array<AigLit, 2>& children)
+{
+  if (!(lit & 1) || nodes[lit >> 1].d_left == 0)
+  {
+    return false;
+  }
+  children = {nodes[lit >> 1].d_left, nodes[lit >> 1].d_right};
+  return true;
+}
+
+/**
+ * Check whether given two-level AIG encodes a xor(a,b).
+ *
+ * Matches ~(a /\ b) /\ ~(~a /\ ~b), which covers the XOR and XNOR gates
+ * created by the bit-blaster.
+ *
+ * @param nodes The node storage of the AIG manager.
+ * @param aig The node data of the AIG to check.
+ * @param children The children a, b of xor(a,b).
+ *
+ * @return True if given AIG is a xor.
+ */
+bool
+is_xor(const std::vector<AigNodeData>& nodes,
+       const AigNodeData& aig,
+       std::array<AigLit, 2>& children)
+{
+  assert(aig.d_left != 0);
+  std::array<AigLit, 2> l, r;
+  if (!is_nand(nodes, aig.d_left, l) || !is_nand(nodes, aig.d_right, r))
+  {
+    return false;
+  }
+  if ((r[0] == (l[0] ^ 1) && r[1] == (l[1] ^ 1))
+      || (r[0] == (l[1] ^ 1) && r[1] == (l[0] ^ 1)))
+  {
+    children = l;
+    return true;
+  }
+  return false;
+}
+
+/** @return True if given literals encode xor(a,b). */
+bool
+is_xor_of(const std::vector<AigNodeData>& nodes, AigLit lit, AigLit a, AigLit b)
+{
+  const AigNodeData& d = nodes[lit >> 1];
+  std::array<AigLit, 2> children;
+  if (d.d_left == 0 || !is_xor(nodes, d, children))
+  {
+    return false;
+  }
+  // ~xor(x,y) = xor(~x,y) and xor(x,y) = xor(~x,~y)
+  AigLit x = children[0] ^ (lit & 1);
+  AigLit y = children[1];
+  return (x == a && y == b) || (x == b && y == a)
+         || ((x ^ 1) == a && (y ^ 1) == b) || ((x ^ 1) == b && (y ^ 1) == a);
+}
+
+/** @return True if given literal encodes or(a,b). */
+bool
+is_or_of(const std::vector<AigNodeData>& nodes, AigLit lit, AigLit a, AigLit b)
+{
+  std::array<AigLit, 2> children;
+  if (!is_nand(nodes, lit, children))
+  {
+    return false;
+  }
+  return (children[0] == (a ^ 1) && children[1] == (b ^ 1))
+         || (children[0] == (b ^ 1) && children[1] == (a ^ 1));
+}
+
+/**
+ * Check whether given AIG encodes a majority gate, the carry of a full adder.
+ *
+ * Matches ~(a /\ b) /\ ~(c /\ x), where x is either xor(a,b) (carry of
+ * the full adders of the bit-blaster) or a \/ b. The AIG encodes the
+ * negation of maj(a,b,c) = maj(~a,~b,~c).
+ *
+ * @param nodes The node storage of the AIG manager.
+ * @param aig The node data of the AIG to check.
+ * @param children The children ~a, ~b, ~c of maj(~a,~b,~c).
+ *
+ * @return True if given AIG is a majority gate.
+ */
+bool
+is_maj(const std::vector<AigNodeData>& nodes,
+       const AigNodeData& aig,
+       std::array<AigLit, 3>& children)
+{
+  assert(aig.d_left != 0);
+  std::array<AigLit, 2> l, r;
+  if (!is_nand(nodes, aig.d_left, l) || !is_nand(nodes, aig.d_right, r))
+  {
+    return false;
+  }
+  for (const auto& [ab, cx] : {std::make_pair(l, r), std::make_pair(r, l)})
+  {
+    for (size_t i = 0; i < 2; ++i)
+    {
+      AigLit c = cx[1 - i];
+      AigLit x = cx[i];
+      if (is_xor_of(nodes, x, ab[0], ab[1]) || is_or_of(nodes, x, ab[0], ab[1]))
+      {
+        children = {ab[0] ^ 1, ab[1] ^ 1, c ^ 1};
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
 /**
  * Check whether given two-level AIG encodes an ite(c,a,b).
  *
- * @param aig The AIG to check.
+ * @param nodes The node storage of the AIG manager.
+ * @param aig The node data of the AIG to check.
+ * @param parents The parent counts of the AIG nodes.
  * @param children The children of ite(c,a,b), added as c,~a,~b. Note that a
  *                 and b have to be negated when encoding the ite to CNF since
- *                 we do not push new negated nodes onto the vector, but use
- *                 the existing ones that occur in `aig`.
+ *                 we store the literals that occur in `aig`.
  *
  * @return True if given AIG is a if-then-else.
  */
 bool
-is_ite(const AigNode& aig, std::vector<const AigNode*>& children)
+is_ite(const std::vector<AigNodeData>& nodes,
+       const AigNodeData& aig,
+       const std::vector<uint32_t>& parents,
+       std::array<AigLit, 3>& children)
 {
-  assert(aig.is_and());
-  assert(children.empty());
+  assert(aig.d_left != 0);
 
-  const auto& l = aig[0];
-  if (!l.is_negated() || !l.is_and())
+  AigLit l = aig.d_left;
+  if (!(l & 1) || nodes[l >> 1].d_left == 0)
   {
     return false;
   }
 
   // Do not extract ITE if it destroys sharing
-  if (l.parents() > 1)
+  if (parents[l >> 1] > 1)
   {
     return false;
   }
 
-  const auto& r = aig[1];
-  if (!r.is_negated() || !r.is_and())
+  AigLit r = aig.d_right;
+  if (!(r & 1) || nodes[r >> 1].d_left == 0)
   {
     return false;
   }
 
   // Do not extract ITE if it destroys sharing
-  if (r.parents() > 1)
+  if (parents[r >> 1] > 1)
   {
     return false;
   }
@@ -134,170 +327,301 @@ is_ite(const AigNode& aig, std::vector<const AigNode*>& children)
   // ite(c,a,b) == (c -> a) /\ (~c -> b)
   // Check all commutative cases of: ~(c /\ ~a) /\ ~(~c /\ ~b)
   //                                   ll   lr       rl    rr
-  const auto& ll = l[0];
-  const auto& lr = l[1];
-  const auto& rl = r[0];
-  const auto& rr = r[1];
+  AigLit ll = nodes[l >> 1].d_left;
+  AigLit lr = nodes[l >> 1].d_right;
+  AigLit rl = nodes[r >> 1].d_left;
+  AigLit rr = nodes[r >> 1].d_right;
 
   // ~(~b /\ ~c) /\  ~(c /\ ~a)
-  if (-lr.get_id() == rl.get_id())
+  if ((lr ^ 1) == rl)
   {
-    children.push_back(&rl);  // c
-    children.push_back(&rr);  // ~a
-    children.push_back(&ll);  // ~b
+    children = {rl, rr, ll};  // c, ~a, ~b
     return true;
   }
   // ~(~c /\ ~b) /\ ~(c /\ ~a)
-  if (-ll.get_id() == rl.get_id())
+  if ((ll ^ 1) == rl)
   {
-    children.push_back(&rl);  // c
-    children.push_back(&rr);  // ~a
-    children.push_back(&lr);  // ~b
+    children = {rl, rr, lr};  // c, ~a, ~b
     return true;
   }
   // ~(~b /\ ~c) /\  ~(~a /\ c)
-  if (-lr.get_id() == rr.get_id())
+  if ((lr ^ 1) == rr)
   {
-    children.push_back(&rr);  // c
-    children.push_back(&rl);  // ~a
-    children.push_back(&ll);  // ~b
+    children = {rr, rl, ll};  // c, ~a, ~b
     return true;
   }
   // ~(~c /\ ~b) /\  ~(~a /\ c)
-  if (-ll.get_id() == rr.get_id())
+  if ((ll ^ 1) == rr)
   {
-    children.push_back(&rr);  // c
-    children.push_back(&rl);  // ~a
-    children.push_back(&lr);  // ~b
+    children = {rr, rl, lr};  // c, ~a, ~b
     return true;
   }
 
   return false;
 }
 
+/** Determine the gate encoded by given AIG. */
+void
+get_gate(const std::vector<AigNodeData>& nodes,
+         const AigNodeData& aig,
+         const std::vector<uint32_t>& parents,
+         Gate& gate)
+{
+  std::array<AigLit, 2> xor_children;
+  if (is_xor(nodes, aig, xor_children))
+  {
+    gate.d_kind       = GateKind::XOR;
+    gate.d_inputs     = {xor_children[0], xor_children[1], 0};
+    gate.d_num_inputs = 2;
+  }
+  else if (is_maj(nodes, aig, gate.d_inputs))
+  {
+    gate.d_kind       = GateKind::MAJ;
+    gate.d_num_inputs = 3;
+  }
+  else if (is_ite(nodes, aig, parents, gate.d_inputs))
+  {
+    // is_ite() yields c, ~a, ~b for ite(c,a,b).
+    gate.d_kind = GateKind::ITE;
+    gate.d_inputs[1] ^= 1;
+    gate.d_inputs[2] ^= 1;
+    gate.d_num_inputs = 3;
+  }
+  else
+  {
+    gate.d_kind       = GateKind::AND;
+    gate.d_inputs     = {aig.d_left, aig.d_right, 0};
+    gate.d_num_inputs = 2;
+  }
+}
+
 }  // namespace
 
 void
-AigCnfEncoder::_encode(const AigNode& aig)
+AigCnfEncoder::_encode(const AigManager& mgr, uint32_t id, uint8_t pol)
 {
-  std::vector<const AigNode*> visit;
-  std::unordered_set<const AigNode*> cache;
-  visit.push_back(&aig);
+  const std::vector<AigNodeData>& nodes = mgr.d_nodes;
+  std::vector<std::pair<uint32_t, uint8_t>> visit{
+      {id, d_plaisted_greenbaum ? pol : POL_BOTH}};
+  std::unordered_set<uint64_t> cache;
+  Gate gate;
+
+  auto clause = [this](const std::initializer_list<int64_t>& literals) {
+    add_clause(literals);
+    ++d_statistics.num_clauses;
+    d_statistics.num_literals += literals.size();
+  };
+
   do
   {
-    auto cur = visit.back();
-    resize(*cur);
+    auto [cur, p] = visit.back();
+    resize(cur);
 
-    if (is_encoded(*cur))
+    // The polarities that still have to be encoded.
+    uint8_t missing = p & ~encoded_polarities(cur, d_level);
+    if (missing == 0)
     {
       visit.pop_back();
       continue;
     }
 
-    if (cur->is_true() || cur->is_false() || cur->is_const())
+    const AigNodeData& d = nodes[cur];
+    if (d.d_left == 0)
     {
       visit.pop_back();
-      set_encoded(*cur);
-      if (cur->is_true() || cur->is_false())
+      set_encoded(cur, POL_BOTH);
+      if (cur == AigNode::s_true_id)
       {
-        d_sat_solver.add_clause({std::abs(cur->get_id())});
+        add_clause({static_cast<int64_t>(cur)});
         ++d_statistics.num_clauses;
         ++d_statistics.num_literals;
       }
+      continue;
     }
-    else
+
+    auto [it, inserted] =
+        cache.insert(static_cast<uint64_t>(cur) << 2 | missing);
+    get_gate(nodes, d, mgr.d_parents, gate);
+
+    if (inserted)
     {
-      assert(cur->is_and());
+      for (uint32_t i = 0; i < gate.d_num_inputs; ++i)
+      {
+        // The condition of an ITE and the inputs of a XOR occur in both
+        // polarities, all other inputs in the polarity of the gate.
+        uint8_t child_pol = missing;
+        if (gate.d_kind == GateKind::XOR
+            || (gate.d_kind == GateKind::ITE && i == 0))
+        {
+          child_pol = POL_BOTH;
+        }
+        AigLit lit = gate.d_inputs[i];
+        if ((lit & 1) && child_pol != POL_BOTH)
+        {
+          child_pol ^= POL_BOTH;
+        }
+        visit.emplace_back(lit >> 1, child_pol);
+      }
+      continue;
+    }
 
-      auto [it, inserted] = cache.insert(cur);
+    visit.pop_back();
+    set_encoded(cur, missing);
 
-      std::vector<const AigNode*> children;
-      bool ite = is_ite(*cur, children);
+    // TODO: and optimization: collect all children and encode one big and
 
-      if (inserted)
-      {
-        if (ite)
+    auto x   = static_cast<int64_t>(cur);
+    auto a   = AigNode::to_id(gate.d_inputs[0]);
+    auto b   = AigNode::to_id(gate.d_inputs[1]);
+    bool pos = missing & POL_POS;
+    bool neg = missing & POL_NEG;
+    switch (gate.d_kind)
+    {
+      case GateKind::AND:
+        // x <-> a /\ b --> (~x \/ a) /\ (~x \/ b) /\ (x \/ ~a \/ ~b)
+        if (pos)
         {
-          visit.insert(visit.end(), children.begin(), children.end());
+          clause({-x, a});
+          clause({-x, b});
         }
-        else
+        if (neg)
         {
-          visit.push_back(&(*cur)[0]);
-          visit.push_back(&(*cur)[1]);
+          clause({x, -a, -b});
         }
+        break;
+
+      case GateKind::ITE: {
+        // x <-> ite(c,a,b)
+        auto c = a;
+        a      = b;
+        b      = AigNode::to_id(gate.d_inputs[2]);
+        if (pos)
+        {
+          clause({-x, -c, a});
+          clause({-x, c, b});
+        }
+        if (neg)
+        {
+          clause({x, -c, -a});
+          clause({x, c, -b});
+        }
+        break;
       }
-      else
-      {
-        visit.pop_back();
-        set_encoded(*cur);
 
-        // TODO: and optimization: collect all children and encode one big and
-        // TODO: xor optimization: use native xor encoding
+      case GateKind::XOR:
+        // x <-> a xor b
+        if (pos)
+        {
+          clause({-x, a, b});
+          clause({-x, -a, -b});
+        }
+        if (neg)
+        {
+          clause({x, -a, b});
+          clause({x, a, -b});
+        }
+        break;
 
-        if (ite)
+      case GateKind::MAJ: {
+        // x <-> (a /\ b) \/ (a /\ c) \/ (b /\ c)
+        auto c = AigNode::to_id(gate.d_inputs[2]);
+        if (pos)
         {
-          // Encode x <-> ite(c,a,b)
-          auto x = std::abs(cur->get_id());
-          auto c = children[0]->get_id();   // cond
-          auto a = -children[1]->get_id();  // then
-          auto b = -children[2]->get_id();  // else
-
-          d_sat_solver.add_clause({-x, -c, a});
-          d_sat_solver.add_clause({-x, c, b});
-          d_sat_solver.add_clause({x, -c, -a});
-          d_sat_solver.add_clause({x, c, -b});
-          d_statistics.num_clauses += 4;
-          d_statistics.num_literals += 12;
+          clause({-x, a, b});
+          clause({-x, a, c});
+          clause({-x, b, c});
         }
-        else
+        if (neg)
         {
-          // Encode binary AND
-          //
-          // x <-> a /\ b --> (~x \/ a) /\ (~x \/ b) /\ (x \/ ~a \/ ~b)
-
-          auto x = std::abs(cur->get_id());
-          auto a = (*cur)[0].get_id();
-          auto b = (*cur)[1].get_id();
-
-          d_sat_solver.add_clause({-x, a});
-          d_sat_solver.add_clause({-x, b});
-          d_sat_solver.add_clause({x, -a, -b});
-          d_statistics.num_clauses += 3;
-          d_statistics.num_literals += 7;
+          clause({x, -a, -b});
+          clause({x, -a, -c});
+          clause({x, -b, -c});
         }
+        break;
       }
     }
   } while (!visit.empty());
 }
 
 void
-AigCnfEncoder::resize(const AigNode& aig)
+AigCnfEncoder::resize(uint32_t id)
 {
-  size_t pos = static_cast<size_t>(std::abs(aig.get_id()) - 1);
+  size_t pos = static_cast<size_t>(id - 1);
   if (pos < d_aig_encoded.size())
   {
     return;
   }
-  d_aig_encoded.resize(pos + 1, false);
+  d_aig_encoded.resize(pos + 1, {0, 0});
 }
 
 bool
-AigCnfEncoder::is_encoded(const AigNode& aig) const
+AigCnfEncoder::is_encoded(uint32_t id) const
 {
-  size_t pos = static_cast<size_t>(std::abs(aig.get_id()) - 1);
+  size_t pos = static_cast<size_t>(id - 1);
   if (pos < d_aig_encoded.size())
   {
-    return d_aig_encoded[pos];
+    return d_aig_encoded[pos][0] != 0 || d_aig_encoded[pos][1] != 0;
   }
   return false;
 }
 
+uint8_t
+AigCnfEncoder::encoded_polarities(uint32_t id, uint32_t level) const
+{
+  size_t pos = static_cast<size_t>(id - 1);
+  uint8_t res = 0;
+  if (pos < d_aig_encoded.size())
+  {
+    const auto& levels = d_aig_encoded[pos];
+    if (levels[0] != 0 && levels[0] <= level + 1)
+    {
+      res |= POL_POS;
+    }
+    if (levels[1] != 0 && levels[1] <= level + 1)
+    {
+      res |= POL_NEG;
+    }
+  }
+  return res;
+}
+
 void
-AigCnfEncoder::set_encoded(const AigNode& aig)
+AigCnfEncoder::set_encoded(uint32_t id, uint8_t pol)
 {
-  size_t pos = static_cast<size_t>(std::abs(aig.get_id()) - 1);
+  size_t pos = static_cast<size_t>(id - 1);
   assert(pos < d_aig_encoded.size());
-  d_aig_encoded[pos] = true;
-  ++d_statistics.num_vars;
+  auto& levels = d_aig_encoded[pos];
+  if (levels[0] == 0 && levels[1] == 0)
+  {
+    ++d_statistics.num_vars;
+  }
+  for (uint32_t i = 0; i < 2; ++i)
+  {
+    if (pol & (1 << i))
+    {
+      levels[i] = d_level + 1;
+      if (d_level > 0)
+      {
+        d_trail.push_back(id << 1 | i);
+      }
+    }
+  }
+}
+
+void
+AigCnfEncoder::add_clause(const std::initializer_list<int64_t>& literals)
+{
+  if (d_level == 0)
+  {
+    d_sat_solver.add_clause(literals);
+    return;
+  }
+  for (int64_t lit : literals)
+  {
+    d_sat_solver.add(lit);
+  }
+  d_sat_solver.add(-d_activation[d_level - 1]);
+  d_sat_solver.add(0);
+  ++d_statistics.num_literals;
 }
 }  // namespace bzla::bitblast
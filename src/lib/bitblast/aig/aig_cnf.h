@@ -10,6 +10,8 @@
 
 #ifndef BZLA__BITBLAST_AIG_CNF_H
 #define BZLA__BITBLAST_AIG_CNF_H
+#include <array>
+
 #include "bitblast/aig/aig_manager.h"
 
 namespace bzla::bitblast {
@@ -43,13 +45,31 @@ class AigCnfEncoder
     uint64_t num_vars     = 0;  // Number of added variables
     uint64_t num_clauses  = 0;  // Number of added clauses
     uint64_t num_literals = 0;  // Number of added literals
+    uint64_t num_released = 0;  // Number of variables released on pop()
   };
 
-  AigCnfEncoder(SatInterface& sat_solver) : d_sat_solver(sat_solver){};
+  /**
+   * Constructor.
+   *
+   * XOR, majority (carry of full adders) and if-then-else gates are detected
+   * and encoded natively, all other gates as binary AND gates.
+   *
+   * @param sat_solver The SAT solver to add the clauses to.
+   * @param plaisted_greenbaum True to only encode the polarities in which
+   *                           AIG nodes are used (Plaisted-Greenbaum
+   *                           encoding) instead of full equivalences.
+   */
+  AigCnfEncoder(SatInterface& sat_solver, bool plaisted_greenbaum = false)
+      : d_sat_solver(sat_solver), d_plaisted_greenbaum(plaisted_greenbaum){};
 
   /**
    * Recursively encodes AIG node to CNF.
    *
+   * With Plaisted-Greenbaum encoding, only the polarity of given node is
+   * encoded, i.e., the node may only be asserted or assumed in the polarity
+   * it was encoded with. Missing polarities of already encoded nodes are
+   * added on demand.
+   *
    * @param node The AIG node to encode.
    * @param top_level Indicates whether given node is at the top level, which
    *        enables certain optimization.
@@ -58,23 +78,92 @@ class AigCnfEncoder
 
   int32_t value(const AigNode& node);
 
+  /** @return True if given AIG node was already encoded. */
+  bool is_encoded(const AigNode& node) const;
+
+  /**
+   * Open a new scope.
+   *
+   * All clauses added by non-top-level encodings while the scope is open are
+   * guarded by the given activation literal, which has to be assumed when
+   * solving. Top-level encodings are never guarded since they are expected to
+   * persist.
+   *
+   * @param activation The activation literal of the scope, an AIG constant
+   *                   that is not used otherwise.
+   */
+  void push(const AigNode& activation);
+  /**
+   * Close the last scope.
+   *
+   * Permanently disables the clauses of the scope by adding the negation of
+   * its activation literal as unit clause, which allows the SAT solver to
+   * delete them. AIG nodes encoded in the scope are marked as not encoded,
+   * and will be encoded again on the next call to encode().
+   *
+   * @note AIG ids double as SAT variables and are never reused, hence the
+   *       number of SAT variables (and the size of the encoding state
+   *       indexed by AIG id) still grows with the AIGs created in popped
+   *       scopes.
+   */
+  void pop();
+
   /** @return CNF statistics. */
   const Statistics& statistics() const;
 
  private:
-  /** Encode AIG to CNF. */
-  void _encode(const AigNode& node);
-  /** Ensure that `d_aig_encoded` is big enough to store `aig`. */
-  void resize(const AigNode& aig);
-  /** Checks whether `aig` was already encoded. */
-  bool is_encoded(const AigNode& aig) const;
-  /** Mark `aig` as encoded. */
-  void set_encoded(const AigNode& aig);
-
-  /** Maps AIG id to flag that indicates whether the AIG was already encoded. */
-  std::vector<bool> d_aig_encoded;
+  /** Bit masks for the polarities of AIG nodes. */
+  static constexpr uint8_t POL_POS  = 1;
+  static constexpr uint8_t POL_NEG  = 2;
+  static constexpr uint8_t POL_BOTH = POL_POS | POL_NEG;
+
+  /**
+   * Encode AIG to CNF.
+   * @param mgr The AIG manager storing the AIG.
+   * @param id The id of the AIG.
+   * @param pol The polarities of the AIG to encode, ignored if
+   *            Plaisted-Greenbaum encoding is disabled.
+   */
+  void _encode(const AigManager& mgr, uint32_t id, uint8_t pol);
+  /** Ensure that `d_aig_encoded` is big enough to store AIG with given id. */
+  void resize(uint32_t id);
+  /** Checks whether AIG with given id was already encoded. */
+  bool is_encoded(uint32_t id) const;
+  /**
+   * Get the polarities of the AIG with given id that were already encoded in
+   * given scope level or below, i.e., whose clauses are active whenever the
+   * clauses of given level are.
+   */
+  uint8_t encoded_polarities(uint32_t id, uint32_t level) const;
+  /** Mark given polarities of AIG with given id as encoded. */
+  void set_encoded(uint32_t id, uint8_t pol);
+  /** Add clause, guarded by the current activation literal (if any). */
+  void add_clause(const std::initializer_list<int64_t>& literals);
+
+  /**
+   * Maps AIG id to 1 + the scope level the positive (index 0) and negative
+   * (index 1) polarity of the AIG was encoded in, 0 if the polarity was not
+   * encoded yet. Top-level encodings are at level 0.
+   */
+  std::vector<std::array<uint32_t, 2>> d_aig_encoded;
+  /** Activation literals of open scopes. */
+  std::vector<int64_t> d_activation;
+  /**
+   * Polarities of AIGs encoded in open scopes, as literals, i.e., the id of
+   * the AIG and the polarity in the sign bit.
+   */
+  std::vector<AigLit> d_trail;
+  /** Control stack marking the start of each scope in `d_trail`. */
+  std::vector<size_t> d_control;
+  /**
+   * Scope level of current encoding, clauses are guarded by the activation
+   * literal of this level if it is not 0.
+   */
+  uint32_t d_level = 0;
   /** SAT solver. */
   SatInterface& d_sat_solver;
+  /** True if Plaisted-Greenbaum encoding is enabled. */
+  bool d_plaisted_greenbaum;
   /** CNF statistics. */
   Statistics d_statistics;
 };
@@ -0,0 +1,369 @@
+/***
+ * Bitwuzla: Satisfiability Modulo Theories (SMT) solver.
+ *
+ * Copyright (C) 2022 by the authors listed in the AUTHORS file at
+ * https://github.com/bitwuzla/bitwuzla/blob/main/AUTHORS
+ *
+ * This file is part of Bitwuzla under the MIT license. See COPYING for more
+ * information at https://github.com/bitwuzla/bitwuzla/blob/main/COPYING
+ */
+
+#include "bitblast/aig/aig_fraig.h"
+
+#include <algorithm>
+#include <unordered_set>
+
+namespace bzla::bitblast {
+
+AigFraig::AigFraig(FraigSatInterface& sat_solver,
+                   const InputPredicate& is_input,
+                   uint64_t conflict_limit,
+                   uint32_t seed)
+    : d_sat_solver(sat_solver),
+      d_cnf_encoder(sat_solver),
+      d_is_input(is_input),
+      d_conflict_limit(conflict_limit),
+      d_rng(seed)
+{
+}
+
+void
+AigFraig::fraig(std::vector<AigNode>& roots)
+{
+  if (roots.empty())
+  {
+    return;
+  }
+
+  init(roots);
+
+  // Initial random simulation.
+  std::vector<uint64_t> patterns(d_num_inputs);
+  for (uint32_t i = 0; i < s_num_words; ++i)
+  {
+    for (auto& p : patterns)
+    {
+      p = d_rng.pick<uint64_t>();
+    }
+    simulate(patterns);
+  }
+  for (uint32_t i = 0, n = static_cast<uint32_t>(d_nodes.size()); i < n; ++i)
+  {
+    d_phase[i] = d_sim[i][0] & 1;
+  }
+  compute_classes();
+  new_cex_word();
+
+  auto image = [this](AigLit lit) {
+    const AigNode& res = d_images[d_index.at(lit >> 1)];
+    return (lit & 1) ? d_mgr->mk_not(res) : res;
+  };
+
+  for (uint32_t i = 0; i < d_num_inputs; ++i)
+  {
+    d_images[i] = AigNode(d_mgr, AigNode::to_lit(d_nodes[i]));
+  }
+
+  for (uint32_t i = d_num_inputs, n = static_cast<uint32_t>(d_nodes.size());
+       i < n;
+       ++i)
+  {
+    const AigNodeData& d = d_mgr->d_nodes[d_nodes[i]];
+    d_images[i]          = d_mgr->mk_and(image(d.d_left), image(d.d_right));
+
+    // Determine the representative of the class of the node, which is the
+    // first member of the class and has been processed already.
+    uint32_t cls  = d_class[i];
+    bool is_const = cls == 0;
+    uint32_t rep  = is_const ? 0 : d_classes[cls][0];
+    if (!is_const && rep == i)
+    {
+      continue;
+    }
+
+    // Nodes that differ on the counterexamples collected since the last
+    // refinement are not equivalent.
+    uint32_t last = static_cast<uint32_t>(d_sim[i].size() - 1);
+    if (word(i, last) != (is_const ? 0 : word(rep, last)))
+    {
+      continue;
+    }
+
+    AigNode target = is_const ? d_mgr->mk_false() : d_images[rep];
+    if (d_phase[i] != (!is_const && d_phase[rep]))
+    {
+      target = d_mgr->mk_not(target);
+    }
+    if (d_images[i] == target)
+    {
+      continue;
+    }
+
+    ++d_statistics.num_candidates;
+    Check res = check(d_images[i], target);
+    if (res == Check::EQUAL)
+    {
+      ++d_statistics.num_merged;
+      d_images[i] = target;
+    }
+    else if (res == Check::DIFFERENT)
+    {
+      ++d_statistics.num_disproved;
+      if (d_num_cex == 64)
+      {
+        refine();
+      }
+    }
+    else
+    {
+      ++d_statistics.num_unknown;
+    }
+  }
+
+  for (AigNode& root : roots)
+  {
+    root = image(root.d_lit);
+  }
+
+  d_nodes.clear();
+  d_index.clear();
+  d_sim.clear();
+  d_phase.clear();
+  d_class.clear();
+  d_classes.clear();
+  d_images.clear();
+  d_cex.clear();
+  d_mgr = nullptr;
+}
+
+const AigFraig::Statistics&
+AigFraig::statistics() const
+{
+  return d_statistics;
+}
+
+bool
+AigFraig::is_input(uint32_t id) const
+{
+  const AigNodeData& d = d_mgr->d_nodes[id];
+  return d.d_left == 0
+         || (d_is_input && d_is_input(AigNode(d_mgr, AigNode::to_lit(id))));
+}
+
+void
+AigFraig::init(const std::vector<AigNode>& roots)
+{
+  d_mgr = roots[0].d_mgr;
+
+  std::vector<uint32_t> inputs, ands;
+  std::unordered_set<uint32_t> cache;
+  std::vector<uint32_t> visit;
+  for (const AigNode& root : roots)
+  {
+    visit.push_back(root.index());
+  }
+  do
+  {
+    uint32_t cur = visit.back();
+    visit.pop_back();
+    if (!cache.insert(cur).second)
+    {
+      continue;
+    }
+    if (is_input(cur))
+    {
+      inputs.push_back(cur);
+      continue;
+    }
+    ands.push_back(cur);
+    const AigNodeData& d = d_mgr->d_nodes[cur];
+    visit.push_back(d.d_left >> 1);
+    visit.push_back(d.d_right >> 1);
+  } while (!visit.empty());
+
+  // Children of AND gates have smaller ids than their parents.
+  std::sort(inputs.begin(), inputs.end());
+  std::sort(ands.begin(), ands.end());
+  d_nodes      = std::move(inputs);
+  d_num_inputs = static_cast<uint32_t>(d_nodes.size());
+  d_nodes.insert(d_nodes.end(), ands.begin(), ands.end());
+  for (uint32_t i = 0, n = static_cast<uint32_t>(d_nodes.size()); i < n; ++i)
+  {
+    d_index.emplace(d_nodes[i], i);
+  }
+
+  d_sim.resize(d_nodes.size());
+  d_phase.resize(d_nodes.size());
+  d_class.resize(d_nodes.size());
+  d_images.resize(d_nodes.size());
+}
+
+void
+AigFraig::simulate(const std::vector<uint64_t>& patterns)
+{
+  assert(patterns.size() == d_num_inputs);
+  for (uint32_t i = 0; i < d_num_inputs; ++i)
+  {
+    // The true node always evaluates to true.
+    d_sim[i].push_back(d_nodes[i] == AigNode::s_true_id ? ~uint64_t{0}
+                                                        : patterns[i]);
+  }
+  for (uint32_t i = d_num_inputs, n = static_cast<uint32_t>(d_nodes.size());
+       i < n;
+       ++i)
+  {
+    const AigNodeData& d = d_mgr->d_nodes[d_nodes[i]];
+    uint64_t l           = d_sim[d_index.at(d.d_left >> 1)].back();
+    uint64_t r           = d_sim[d_index.at(d.d_right >> 1)].back();
+    d_sim[i].push_back((d.d_left & 1 ? ~l : l) & (d.d_right & 1 ? ~r : r));
+  }
+}
+
+void
+AigFraig::compute_classes()
+{
+  // Class 0 is the class of nodes that are candidates for being constant.
+  d_classes.clear();
+  d_classes.emplace_back();
+  std::unordered_map<uint64_t, std::vector<uint32_t>> buckets;
+  for (uint32_t i = 0, n = static_cast<uint32_t>(d_nodes.size()); i < n; ++i)
+  {
+    uint32_t num_words = static_cast<uint32_t>(d_sim[i].size());
+    uint64_t hash      = 0;
+    bool is_zero       = true;
+    for (uint32_t j = 0; j < num_words; ++j)
+    {
+      uint64_t w = word(i, j);
+      hash       = hash * 0x9E3779B97F4A7C15u + w;
+      is_zero    = is_zero && w == 0;
+    }
+    if (is_zero)
+    {
+      d_class[i] = 0;
+      d_classes[0].push_back(i);
+      continue;
+    }
+
+    auto& bucket = buckets[hash];
+    auto it = std::find_if(bucket.begin(), bucket.end(), [&](uint32_t cls) {
+      uint32_t rep = d_classes[cls][0];
+      for (uint32_t j = 0; j < num_words; ++j)
+      {
+        if (word(i, j) != word(rep, j))
+        {
+          return false;
+        }
+      }
+      return true;
+    });
+    if (it == bucket.end())
+    {
+      d_class[i] = static_cast<uint32_t>(d_classes.size());
+      bucket.push_back(d_class[i]);
+      d_classes.emplace_back();
+    }
+    else
+    {
+      d_class[i] = *it;
+    }
+    d_classes[d_class[i]].push_back(i);
+  }
+}
+
+AigFraig::Check
+AigFraig::check(const AigNode& a, const AigNode& b)
+{
+  assert(!(a == b));
+  bool a_const = a.is_true() || a.is_false();
+  bool b_const = b.is_true() || b.is_false();
+  if (a_const)
+  {
+    // Both are constants if the images of the nodes simplified to different
+    // constants, which are different by construction.
+    return b_const ? Check::DIFFERENT : check(b, a);
+  }
+
+  // Two queries for a != b: (a, ~b) and (~a, b), a single query for a != c
+  // with c a constant.
+  std::vector<std::pair<int64_t, int64_t>> queries;
+  d_cnf_encoder.encode(a);
+  if (b_const)
+  {
+    int64_t lit = b.is_true() ? -a.get_id() : a.get_id();
+    queries.emplace_back(lit, lit);
+  }
+  else
+  {
+    d_cnf_encoder.encode(b);
+    queries.emplace_back(a.get_id(), -b.get_id());
+    queries.emplace_back(-a.get_id(), b.get_id());
+  }
+
+  for (const auto& [l1, l2] : queries)
+  {
+    ++d_statistics.num_sat_calls;
+    d_sat_solver.assume(l1);
+    d_sat_solver.assume(l2);
+    int32_t res = d_sat_solver.solve(d_conflict_limit);
+    if (res == 10)
+    {
+      record_counterexample();
+      return Check::DIFFERENT;
+    }
+    if (res != 20)
+    {
+      return Check::UNKNOWN;
+    }
+  }
+  return Check::EQUAL;
+}
+
+void
+AigFraig::record_counterexample()
+{
+  assert(d_num_cex < 64);
+  uint64_t mask = uint64_t{1} << d_num_cex;
+  for (uint32_t i = 0; i < d_num_inputs; ++i)
+  {
+    // Inputs that are not encoded are not constrained by the query.
+    if (d_cnf_encoder.value(d_images[i]) > 0)
+    {
+      d_cex[i] |= mask;
+    }
+    else
+    {
+      d_cex[i] &= ~mask;
+    }
+  }
+  ++d_num_cex;
+
+  // Resimulate the last word with the counterexample.
+  for (auto& sim : d_sim)
+  {
+    sim.pop_back();
+  }
+  simulate(d_cex);
+}
+
+void
+AigFraig::refine()
+{
+  ++d_statistics.num_refinements;
+  compute_classes();
+  new_cex_word();
+}
+
+void
+AigFraig::new_cex_word()
+{
+  // The remaining bits of the word are random patterns.
+  d_cex.resize(d_num_inputs);
+  for (auto& p : d_cex)
+  {
+    p = d_rng.pick<uint64_t>();
+  }
+  d_num_cex = 0;
+  simulate(d_cex);
+}
+
+}  // namespace bzla::bitblast
@@ -0,0 +1,188 @@
+/***
+ * Bitwuzla: Satisfiability Modulo Theories (SMT) solver.
+ *
+ * Copyright (C) 2022 by the authors listed in the AUTHORS file at
+ * https://github.com/bitwuzla/bitwuzla/blob/main/AUTHORS
+ *
+ * This file is part of Bitwuzla under the MIT license. See COPYING for more
+ * information at https://github.com/bitwuzla/bitwuzla/blob/main/COPYING
+ */
+
+#ifndef BZLA__BITBLAST_AIG_FRAIG_H
+#define BZLA__BITBLAST_AIG_FRAIG_H
+
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+#include "bitblast/aig/aig_cnf.h"
+#include "bitblast/aig/aig_manager.h"
+#include "rng/rng.h"
+
+namespace bzla::bitblast {
+
+/** SAT interface for the equivalence checks of AigFraig. */
+class FraigSatInterface : public SatInterface
+{
+ public:
+  /**
+   * Assume literal for the next call to solve().
+   * @param lit The literal to assume.
+   */
+  virtual void assume(int64_t lit) = 0;
+  /**
+   * Check satisfiability under the current assumptions.
+   * @param conflict_limit The maximum number of conflicts, 0 for no limit.
+   * @return 10 if satisfiable, 20 if unsatisfiable and 0 if unknown.
+   */
+  virtual int32_t solve(uint64_t conflict_limit) = 0;
+};
+
+/**
+ * Functionally reduced AIGs via SAT sweeping [1].
+ *
+ * AIG nodes are simulated bit-parallel on random input patterns to partition
+ * them into candidate equivalence classes (modulo negation), where nodes that
+ * simulate to constant patterns are candidates for being constant. Nodes are
+ * then rebuilt in topological order and each node is checked for equivalence
+ * against the rebuilt representative of its class with resource-bounded SAT
+ * calls. Proven equivalent nodes are merged with their representative.
+ * Counterexamples of failed checks are collected and used to refine the
+ * classes via simulation.
+ *
+ * [1] FRAIGs: A Unifying Representation for Logic Synthesis and
+ *     Verification. Alan Mishchenko, Satrajit Chatterjee, Roland Jiang,
+ *     Robert Brayton.
+ */
+class AigFraig
+{
+ public:
+  /**
+   * Predicate to identify nodes that are treated as inputs, i.e., whose
+   * structure is not reduced.
+   */
+  using InputPredicate = std::function<bool(const AigNode&)>;
+
+  struct Statistics
+  {
+    uint64_t num_candidates  = 0;  // Number of candidate equivalences
+    uint64_t num_sat_calls   = 0;  // Number of SAT calls
+    uint64_t num_merged      = 0;  // Number of merged nodes
+    uint64_t num_disproved   = 0;  // Number of disproved candidates
+    uint64_t num_unknown     = 0;  // Number of SAT calls hitting the limit
+    uint64_t num_refinements = 0;  // Number of refinements of the classes
+  };
+
+  /**
+   * Constructor.
+   * @param sat_solver     The SAT solver for the equivalence checks, used
+   *                       exclusively by this instance.
+   * @param is_input       Predicate for nodes that are treated as inputs, may
+   *                       be null. AIG constants are always treated as
+   *                       inputs.
+   * @param conflict_limit The conflict limit for each SAT call.
+   * @param seed           The seed for the random simulation.
+   */
+  AigFraig(FraigSatInterface& sat_solver,
+           const InputPredicate& is_input = nullptr,
+           uint64_t conflict_limit        = 1000,
+           uint32_t seed                  = 0);
+
+  /**
+   * Merge functionally equivalent nodes in the AIGs of given roots.
+   * @param roots The roots to reduce, updated in place.
+   */
+  void fraig(std::vector<AigNode>& roots);
+
+  /** @return FRAIG statistics. */
+  const Statistics& statistics() const;
+
+ private:
+  /** Number of 64-bit random simulation words per node. */
+  static constexpr uint32_t s_num_words = 4;
+
+  /** Result of an equivalence check. */
+  enum class Check
+  {
+    EQUAL,
+    DIFFERENT,
+    UNKNOWN,
+  };
+
+  /** @return True if the node with given id is treated as an input. */
+  bool is_input(uint32_t id) const;
+
+  /**
+   * Collect inputs and AND gates of the AIGs of given roots, the AND gates
+   * in topological order.
+   */
+  void init(const std::vector<AigNode>& roots);
+  /** Simulate all nodes on the given input patterns (one word per input). */
+  void simulate(const std::vector<uint64_t>& patterns);
+  /** Partition the nodes into candidate equivalence classes. */
+  void compute_classes();
+  /** @return The i-th simulation word of node `idx`, normalized by phase. */
+  uint64_t word(uint32_t idx, uint32_t i) const
+  {
+    uint64_t w = d_sim[idx][i];
+    return d_phase[idx] ? ~w : w;
+  }
+
+  /**
+   * Check given rebuilt nodes for equivalence with SAT. On disproof, the
+   * counterexample is recorded for refining the classes.
+   */
+  Check check(const AigNode& a, const AigNode& b);
+  /** Record the values of the inputs in the last satisfying assignment. */
+  void record_counterexample();
+  /** Refine the classes with the recorded counterexamples. */
+  void refine();
+  /**
+   * Start a new simulation word for collecting counterexamples, the last
+   * simulation word of the nodes.
+   */
+  void new_cex_word();
+
+  /** The SAT solver for equivalence checks. */
+  FraigSatInterface& d_sat_solver;
+  /** The CNF encoder for `d_sat_solver`. */
+  AigCnfEncoder d_cnf_encoder;
+  /** The input predicate. */
+  InputPredicate d_is_input;
+  /** The conflict limit per SAT call. */
+  uint64_t d_conflict_limit;
+  /** The random number generator for simulation patterns. */
+  RNG d_rng;
+
+  /** The AIG manager of the current call. */
+  AigManager* d_mgr = nullptr;
+  /**
+   * The nodes of the current call, inputs first, then AND gates in
+   * topological order. Nodes are referred to by their index in this vector.
+   */
+  std::vector<uint32_t> d_nodes;
+  /** The number of inputs in `d_nodes`. */
+  uint32_t d_num_inputs = 0;
+  /** Maps AIG ids to indices in `d_nodes`. */
+  std::unordered_map<uint32_t, uint32_t> d_index;
+  /** The simulation words of the nodes. */
+  std::vector<std::vector<uint64_t>> d_sim;
+  /** The phase of the nodes, i.e., the value in the first pattern. */
+  std::vector<bool> d_phase;
+  /** The class of each node. */
+  std::vector<uint32_t> d_class;
+  /** The candidate equivalence classes, members sorted by index. */
+  std::vector<std::vector<uint32_t>> d_classes;
+  /** The rebuilt nodes, by index. */
+  std::vector<AigNode> d_images;
+  /** Counterexample patterns of the inputs, by input index. */
+  std::vector<uint64_t> d_cex;
+  /** The number of recorded counterexamples in `d_cex`. */
+  uint32_t d_num_cex = 0;
+  /** FRAIG statistics. */
+  Statistics d_statistics;
+};
+
+}  // namespace bzla::bitblast
+
+#endif
@@ -16,106 +16,105 @@ namespace bzla::bitblast {
 
 // AigNodeUniqueTable
 
-AigNodeUniqueTable::AigNodeUniqueTable() { d_buckets.resize(16, nullptr); }
-
-std::pair<bool, AigNodeData*>
-AigNodeUniqueTable::insert(AigNodeData* d)
+AigNodeUniqueTable::AigNodeUniqueTable(const std::vector<AigNodeData>& nodes)
+    : d_nodes(nodes)
 {
-  size_t h         = hash(d->d_left, d->d_right);
-  AigNodeData* cur = d_buckets[h];
-  int64_t left_id  = d->d_left.get_id();
-  int64_t right_id = d->d_right.get_id();
+  d_slots.resize(16, 0);
+}
 
-  // Check collision chain.
-  while (cur)
+uint32_t
+AigNodeUniqueTable::find(AigLit left, AigLit right) const
+{
+  // Probe slots until we hit an empty slot.
+  for (size_t i = slot_index(hash(left, right));; i = next_slot(i))
   {
-    if (cur->d_left.get_id() == left_id && cur->d_right.get_id() == right_id)
+    uint32_t id = d_slots[i];
+    if (id == 0)
+    {
+      break;
+    }
+    const AigNodeData& d = d_nodes[id];
+    if (d.d_left == left && d.d_right == right)
     {
-      return std::make_pair(false, cur);
+      return id;
     }
-    cur = cur->next;
   }
+  return 0;
+}
 
-  if (d_num_elements == d_buckets.capacity())
+void
+AigNodeUniqueTable::insert(uint32_t id)
+{
+  // Keep the load factor below 3/4.
+  if ((d_num_elements + 1) * 4 > d_slots.size() * 3)
   {
     resize();
-    h = hash(d->d_left, d->d_right);
   }
-  assert(d->next == nullptr);
-  d->next      = d_buckets[h];
-  d_buckets[h] = d;
-
-  ++d_num_elements;
-  return std::make_pair(true, d);
+  const AigNodeData& d = d_nodes[id];
+  insert(hash(d.d_left, d.d_right), id);
 }
 
 void
-AigNodeUniqueTable::erase(const AigNodeData* d)
+AigNodeUniqueTable::erase(uint32_t id)
 {
-  size_t h          = hash(d->d_left, d->d_right);
-  AigNodeData* cur  = d_buckets[h];
-  AigNodeData* prev = nullptr;
-  assert(cur != nullptr);
+  const AigNodeData& d = d_nodes[id];
+  size_t i             = slot_index(hash(d.d_left, d.d_right));
 
-  // Should not happen
-  if (cur == nullptr)
+  // Find slot of id in probe sequence.
+  while (d_slots[i] != id)
   {
-    return;
+    assert(d_slots[i] != 0);
+    i = next_slot(i);
   }
 
-  // Find data in collision chain.
-  int64_t left_id  = d->d_left.get_id();
-  int64_t right_id = d->d_right.get_id();
-  while (cur)
+  // Backward shift deletion, see NodeUniqueTable::erase().
+  size_t mask = d_slots.size() - 1;
+  for (size_t j = next_slot(i);; j = next_slot(j))
   {
-    if (cur->d_left.get_id() == left_id && cur->d_right.get_id() == right_id)
+    uint32_t cur = d_slots[j];
+    if (cur == 0)
     {
       break;
     }
-    prev = cur;
-    cur  = cur->next;
-  }
-  assert(cur);
-
-  // Update collision chain.
-  if (prev == nullptr)
-  {
-    d_buckets[h] = cur->next;
-  }
-  else
-  {
-    prev->next = cur->next;
+    const AigNodeData& dc = d_nodes[cur];
+    size_t home           = slot_index(hash(dc.d_left, dc.d_right));
+    if (((j - home) & mask) >= ((j - i) & mask))
+    {
+      d_slots[i] = cur;
+      i          = j;
+    }
   }
+  d_slots[i] = 0;
   --d_num_elements;
 }
 
-size_t
-AigNodeUniqueTable::hash(const AigNode& left, const AigNode& right)
+void
+AigNodeUniqueTable::insert(size_t hash, uint32_t id)
 {
-  size_t lhs = static_cast<size_t>(std::abs(left.get_id()));
-  size_t rhs = static_cast<size_t>(std::abs(right.get_id()));
-  size_t h   = 547789289u * lhs + 786695309u * rhs;
-  return h & (d_buckets.capacity() - 1);
+  size_t i = slot_index(hash);
+  while (d_slots[i] != 0)
+  {
+    i = next_slot(i);
+  }
+  d_slots[i] = id;
+  ++d_num_elements;
 }
 
 void
 AigNodeUniqueTable::resize()
 {
-  auto buckets = d_buckets;
-
-  d_buckets.clear();
-  d_buckets.resize(d_buckets.capacity() * 2, nullptr);
+  std::vector<uint32_t> slots(d_slots.size() * 2, 0);
+  std::swap(slots, d_slots);
+  --d_shift;
 
   // Rehash elements.
-  for (auto cur : buckets)
+  d_num_elements = 0;
+  for (uint32_t id : slots)
   {
-    while (cur)
+    if (id != 0)
     {
-      size_t h     = hash(cur->d_left, cur->d_right);
-      auto next    = cur->next;
-      cur->next    = d_buckets[h];
-      d_buckets[h] = cur;
-      cur          = next;
+      const AigNodeData& d = d_nodes[id];
+      insert(hash(d.d_left, d.d_right), id);
     }
   }
 }
@@ -123,7 +122,12 @@ AigNodeUniqueTable::resize()
 // BitNodeInterface<AigNode>
 
 AigManager::AigManager()
-    : d_true(new_data(), false), d_false(d_true.d_data, true)
+    : d_nodes(1),
+      d_refs(1, 0),
+      d_parents(1, 0),
+      d_unique_table(d_nodes),
+      d_true(this, AigNode::to_lit(new_node())),
+      d_false(this, AigNode::to_lit(-AigNode::s_true_id))
 {
   assert(d_true.get_id() == AigNode::s_true_id);
   assert(d_false.get_id() == -AigNode::s_true_id);
@@ -137,38 +141,42 @@ AigManager::statistics() const
   return d_statistics;
 }
 
-void
-AigManager::init_id(AigNodeData* d)
+uint32_t
+AigManager::new_node(AigLit left, AigLit right)
 {
-  assert(d_aig_id_counter < INT64_MAX);
-  assert(d != nullptr);
-  assert(d->d_id == 0);
-  d_node_data.emplace_back(d);
-  assert(d_node_data.size() == static_cast<size_t>(d_aig_id_counter));
-  d->d_id = d_aig_id_counter++;
-  if (!d->d_left.is_null())
+  // Literals are 32-bit, hence ids are limited to 31 bits.
+  assert(d_nodes.size() < (static_cast<size_t>(1) << 31));
+  auto id = static_cast<uint32_t>(d_nodes.size());
+  d_nodes.push_back({left, right});
+  d_refs.push_back(0);
+  d_parents.push_back(0);
+  if (left != 0)
   {
-    ++d->d_left.d_data->d_parents;
-    ++d->d_right.d_data->d_parents;
+    // Children are referenced by their parent.
+    uint32_t l = left >> 1, r = right >> 1;
+    inc_refs(l);
+    inc_refs(r);
+    ++d_parents[l];
+    ++d_parents[r];
   }
+  return id;
 }
 
-AigNodeData*
-AigManager::find_or_create_and(const AigNode& left, const AigNode& right)
+uint32_t
+AigManager::find_or_create_and(AigLit left, AigLit right)
 {
-  assert(std::abs(left.get_id()) < std::abs(right.get_id()));
-  AigNodeData* d          = new AigNodeData(this, left, right);
-  auto [inserted, lookup] = d_unique_table.insert(d);
-  if (!inserted)
+  assert((left >> 1) < (right >> 1));
+  uint32_t id = d_unique_table.find(left, right);
+  if (id != 0)
   {
     ++d_statistics.num_shared;
-    delete d;
-    return lookup;
+    return id;
   }
 
-  init_id(d);
+  id = new_node(left, right);
+  d_unique_table.insert(id);
   ++d_statistics.num_ands;
-  return d;
+  return id;
 }
 
 AigNode
@@ -400,94 +408,58 @@ AigManager::rewrite_and(const AigNode& l, const AigNode& r)
   }
 
   // create AND with left, right
-  AigNodeData* d = find_or_create_and(get_node(left), get_node(right));
-  return AigNode(d);
-}
-
-AigNode
-AigManager::get_node(int64_t id)
-{
-  assert(static_cast<size_t>(std::abs(id)) <= d_node_data.size());
-  return AigNode(d_node_data[std::abs(id) - 1].get(), id < 0);
+  uint32_t id =
+      find_or_create_and(AigNode::to_lit(left), AigNode::to_lit(right));
+  return AigNode(this, AigNode::to_lit(id));
 }
 
 std::pair<int64_t, int64_t>
 AigManager::get_children(int64_t id) const
 {
-  assert(static_cast<size_t>(std::abs(id)) <= d_node_data.size());
-  const auto& d = d_node_data[std::abs(id) - 1];
-  return {d->d_left.get_id(), d->d_right.get_id()};
-}
-
-AigNodeData*
-AigManager::new_data()
-{
-  AigNodeData* d = new AigNodeData(this);
-  init_id(d);
-  return d;
+  assert(static_cast<size_t>(std::abs(id)) < d_nodes.size());
+  const AigNodeData& d = d_nodes[std::abs(id)];
+  return {AigNode::to_id(d.d_left), AigNode::to_id(d.d_right)};
 }
 
 void
-AigManager::garbage_collect(AigNodeData* d)
+AigManager::garbage_collect(uint32_t id)
 {
-  assert(d->d_refs == 0);
-
-  if (d_gc_mode)
-  {
-    assert(false);
-    return;
-  }
-
-  d_gc_mode = true;
-
-  AigNodeData *cur, *data;
-  std::vector<AigNodeData*> visit{d};
+  assert(d_refs[id] == 0);
 
+  std::vector<uint32_t> visit{id};
   do
   {
-    cur = visit.back();
+    uint32_t cur = visit.back();
     visit.pop_back();
-    assert(cur->d_refs == 0);
+    assert(d_refs[cur] == 0);
 
+    AigNodeData& d = d_nodes[cur];
     // Decrement reference counts for children of AND nodes
-    if (!cur->d_left.is_null())
+    if (d.d_left != 0)
     {
-      assert(!cur->d_right.is_null());
+      assert(d.d_right != 0);
 
-      // Erase node data from unique table before we modify children.
+      // Erase node from unique table before we modify children.
       d_unique_table.erase(cur);
 
-      data = cur->d_left.d_data;
-      --data->d_refs;
-      --data->d_parents;
-      cur->d_left.d_data = nullptr;
-      if (data->d_refs == 0)
+      for (AigLit child : {d.d_left, d.d_right})
       {
-        visit.push_back(data);
-      }
-
-      data = cur->d_right.d_data;
-      --data->d_refs;
-      --data->d_parents;
-      cur->d_right.d_data = nullptr;
-      if (data->d_refs == 0)
-      {
-        visit.push_back(data);
+        uint32_t c = child >> 1;
+        assert(d_refs[c] > 0);
+        --d_parents[c];
+        if (--d_refs[c] == 0)
+        {
+          visit.push_back(c);
+        }
       }
+      d = AigNodeData();
       --d_statistics.num_ands;
     }
-    else
+    else if (cur != AigNode::s_true_id)
     {
       --d_statistics.num_consts;
     }
-
-    // Delete node data
-    assert(cur->d_id > 0);
-    assert(d_node_data[static_cast<size_t>(cur->d_id) - 1]->d_id == cur->d_id);
-    d_node_data[static_cast<size_t>(cur->d_id) - 1].reset(nullptr);
   } while (!visit.empty());
-
-  d_gc_mode = false;
 }
 
 }  // namespace bzla::bitblast
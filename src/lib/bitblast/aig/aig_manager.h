@@ -14,34 +14,96 @@
 #include <cassert>
 #include <cstddef>
 #include <cstdint>
-#include <memory>
 #include <vector>
 
 #include "bitblast/aig/aig_node.h"
 
 namespace bzla::bitblast {
 
+/**
+ * AIG node data.
+ *
+ * Stores the literals of the children of an AND gate. Both literals are 0 for
+ * AIG constants, the true node and deleted nodes.
+ */
+struct AigNodeData
+{
+  /** Left child of AND gate. */
+  AigLit d_left = 0;
+  /** Right child of AND gate. */
+  AigLit d_right = 0;
+};
+
 // AigNodeUniqueTable
 class AigNodeUniqueTable
 {
  public:
-  AigNodeUniqueTable();
+  /**
+   * Constructor.
+   * @param nodes The node storage of the AIG manager.
+   */
+  AigNodeUniqueTable(const std::vector<AigNodeData>& nodes);
 
-  // AigNodeData* lookup(const AigNode& left, const AigNode& right);
-  std::pair<bool, AigNodeData*> insert(AigNodeData* d);
-  void erase(const AigNodeData* d);
+  /**
+   * Find AND gate with given children.
+   * @param left Literal of the left child.
+   * @param right Literal of the right child.
+   * @return The id of the AND gate or 0 if it was not yet constructed.
+   */
+  uint32_t find(AigLit left, AigLit right) const;
+  /**
+   * Insert AND gate with given id.
+   * @note Does not check for duplicates.
+   */
+  void insert(uint32_t id);
+  /** Erase AND gate with given id. */
+  void erase(uint32_t id);
 
  private:
-  size_t hash(const AigNode& left, const AigNode& right);
+  /** Multiplier for Fibonacci hashing of slot indices. */
+  static constexpr uint64_t s_fib_mult = 11400714819323198485u;
+
+  static size_t hash(AigLit left, AigLit right)
+  {
+    return 547789289u * static_cast<size_t>(left)
+           + 786695309u * static_cast<size_t>(right);
+  }
+
+  /** Compute home slot index in d_slots based on hash value. */
+  size_t slot_index(size_t hash) const
+  {
+    return static_cast<size_t>((static_cast<uint64_t>(hash) * s_fib_mult)
+                               >> d_shift);
+  }
+
+  /** @return The index of the slot following slot `i` (wraps around). */
+  size_t next_slot(size_t i) const { return (i + 1) & (d_slots.size() - 1); }
+
+  /** Insert id into the first empty slot of its probe sequence. */
+  void insert(size_t hash, uint32_t id);
+
+  /** Resizes unique table and rehashes AND gates. */
   void resize();
 
+  /** The node storage of the AIG manager. */
+  const std::vector<AigNodeData>& d_nodes;
+  /** Number of AND gates stored in unique table. */
   size_t d_num_elements = 0;
-  std::vector<AigNodeData*> d_buckets;
+  /** Shift amount to map 64-bit hashes to slot indices. */
+  size_t d_shift = 60;
+  /**
+   * Hash table slots (open addressing with linear probing) storing ids of AND
+   * gates, 0 if slot is empty.
+   */
+  std::vector<uint32_t> d_slots;
 };
 
 class AigManager
 {
-  friend class AigNodeData;
+  friend AigNode;
+  friend AigCnfEncoder;
+  friend AigOptimizer;
+  friend AigFraig;
 
  public:
   struct Statistics
@@ -59,13 +121,10 @@ class AigManager
   AigNode mk_const()
   {
     ++d_statistics.num_consts;
-    return AigNode(new_data());
+    return AigNode(this, AigNode::to_lit(new_node()));
   }
 
-  AigNode mk_not(const AigNode& a)
-  {
-    return AigNode(a.d_data, !a.is_negated());
-  }
+  AigNode mk_not(const AigNode& a) { return AigNode(this, a.d_lit ^ 1); }
 
   AigNode mk_and(const AigNode& a, const AigNode& b)
   {
@@ -76,21 +135,15 @@ class AigManager
   const Statistics& statistics() const;
 
  private:
-  /** Counter for AIG ids. */
-  int64_t d_aig_id_counter = AigNode::s_true_id;
-
-  /** Returns the next free AIG id. */
-  void init_id(AigNodeData* d);
-
   /**
-   * Find already constructed and gate with given children.
+   * Find already constructed AND gate with given children or create a new
+   * one.
    *
-   * @param left Left child of AND gate.
-   * @param right Right child of AND gate.
-   * @return Pointer to existing node data or nullptr if AND gate was not yet
-   * constructed.
+   * @param left Literal of left child of AND gate.
+   * @param right Literal of right child of AND gate.
+   * @return The id of the AND gate.
    */
-  AigNodeData* find_or_create_and(const AigNode& left, const AigNode& right);
+  uint32_t find_or_create_and(AigLit left, AigLit right);
 
   /**
    * Implements two-level AIG rewriting from [1].
@@ -101,23 +154,49 @@ class AigManager
   AigNode rewrite_and(const AigNode& left, const AigNode& right);
 
   /** Get AigNode by id. */
-  AigNode get_node(int64_t id);
+  AigNode get_node(int64_t id) { return AigNode(this, AigNode::to_lit(id)); }
 
   /** Get children ids from AND gate. */
   std::pair<int64_t, int64_t> get_children(int64_t id) const;
 
   /**
-   * Construct a new node data.
+   * Construct a new node.
+   * @param left Literal of left child, 0 for AIG constants.
+   * @param right Literal of right child, 0 for AIG constants.
+   * @return The id of the new node.
    */
-  AigNodeData* new_data();
+  uint32_t new_node(AigLit left = 0, AigLit right = 0);
+
+  void inc_refs(uint32_t id)
+  {
+    assert(id < d_refs.size());
+    ++d_refs[id];
+  }
+  void dec_refs(uint32_t id)
+  {
+    assert(id < d_refs.size());
+    assert(d_refs[id] > 0);
+    if (--d_refs[id] == 0)
+    {
+      garbage_collect(id);
+    }
+  }
 
   /**
-   * Delete given node data.
+   * Delete node with given id and all of its children that are not
+   * referenced anymore.
    */
-  void garbage_collect(AigNodeData* d);
+  void garbage_collect(uint32_t id);
 
-  /** Maps node id to node data and stores all created node data. */
-  std::vector<std::unique_ptr<AigNodeData>> d_node_data;
+  /**
+   * Node storage indexed by node id. Index 0 does not correspond to a node.
+   * Node ids are not reused.
+   */
+  std::vector<AigNodeData> d_nodes;
+  /** Reference counts, indexed by node id. */
+  std::vector<uint32_t> d_refs;
+  /** Number of parents, indexed by node id. */
+  std::vector<uint32_t> d_parents;
   /** AND gate cache used for hash consing. */
   AigNodeUniqueTable d_unique_table;
 
@@ -126,12 +205,65 @@ class AigManager
   /** AIG node representing false. */
   AigNode d_false;
 
-  /** Indicates whether AIG manager is in garbage collection mode. */
-  bool d_gc_mode = false;
-
   Statistics d_statistics;
 };
 
+inline AigNode::AigNode(AigManager* mgr, AigLit lit) : d_mgr(mgr), d_lit(lit)
+{
+  d_mgr->inc_refs(index());
+}
+
+inline bool
+AigNode::is_true() const
+{
+  return d_lit == AigNode::to_lit(s_true_id);
+}
+
+inline bool
+AigNode::is_false() const
+{
+  return d_lit == AigNode::to_lit(-s_true_id);
+}
+
+inline bool
+AigNode::is_and() const
+{
+  return d_mgr->d_nodes[index()].d_left != 0;
+}
+
+inline bool
+AigNode::is_const() const
+{
+  return !is_and() && index() != s_true_id;
+}
+
+inline AigNode
+AigNode::operator[](int index) const
+{
+  assert(is_and());
+  const AigNodeData& d = d_mgr->d_nodes[this->index()];
+  if (index == 0)
+  {
+    return AigNode(d_mgr, d.d_left);
+  }
+  assert(index == 1);
+  return AigNode(d_mgr, d.d_right);
+}
+
+inline uint32_t
+AigNode::parents() const
+{
+  assert(!is_null());
+  return d_mgr->d_parents[index()];
+}
+
+inline uint64_t
+AigNode::get_refs() const
+{
+  assert(!is_null());
+  return d_mgr->d_refs[index()];
+}
+
 }  // namespace bzla::bitblast
 
 #endif
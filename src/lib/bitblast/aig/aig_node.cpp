@@ -6,68 +6,50 @@
 
 namespace bzla::bitblast {
 
-AigNode::AigNode(AigNodeData* data, bool negated)
-    : d_data(data), d_negated(negated)
-{
-  d_data->inc_refs();
-}
-
 AigNode::~AigNode()
 {
   if (!is_null())
   {
-    d_data->dec_refs();
+    d_mgr->dec_refs(index());
   }
 }
 
-AigNode::AigNode(const AigNode& other)
-    : d_data(other.d_data), d_negated(other.d_negated)
+AigNode::AigNode(const AigNode& other) : d_mgr(other.d_mgr), d_lit(other.d_lit)
 {
   assert(!other.is_null());
-  d_data->inc_refs();
+  d_mgr->inc_refs(index());
 }
 
 AigNode&
 AigNode::operator=(const AigNode& other)
 {
-  if (d_data)
+  // Increment first in case other refers to the same node.
+  other.d_mgr->inc_refs(other.index());
+  if (!is_null())
   {
-    d_data->dec_refs();
+    d_mgr->dec_refs(index());
   }
-  d_data    = other.d_data;
-  d_negated = other.d_negated;
-  d_data->inc_refs();
+  d_mgr = other.d_mgr;
+  d_lit = other.d_lit;
   return *this;
 }
 
-AigNode::AigNode(AigNode&& other)
+AigNode::AigNode(AigNode&& other) : d_mgr(other.d_mgr), d_lit(other.d_lit)
 {
-  if (d_data)
-  {
-    d_data->dec_refs();
-  }
-  d_data       = other.d_data;
-  d_negated    = other.d_negated;
-  other.d_data = nullptr;
+  other.d_lit = 0;
 }
 
 AigNode&
 AigNode::operator=(AigNode&& other)
 {
-  if (d_data)
+  if (!is_null())
   {
-    d_data->dec_refs();
+    d_mgr->dec_refs(index());
   }
-  d_data       = other.d_data;
-  d_negated    = other.d_negated;
-  other.d_data = nullptr;
+  d_mgr       = other.d_mgr;
+  d_lit       = other.d_lit;
+  other.d_lit = 0;
   return *this;
 }
 
-void
-AigNodeData::gc()
-{
-  d_mgr->garbage_collect(this);
-}
-
 }  // namespace bzla::bitblast
@@ -18,16 +18,31 @@
 namespace bzla::bitblast {
 
 class AigManager;
-class AigNodeData;
+class AigCnfEncoder;
+class AigOptimizer;
+class AigFraig;
 
 /**
- * Wrapper around AigNodeData with automatic reference counting on
- * construction/destruction.
+ * AIG literal.
+ *
+ * Edges between AIG nodes are encoded as 32-bit literals `id << 1 | negated`,
+ * where `id` is the index of the node in the node storage of the AIG manager.
+ * Literal 0 does not refer to any node.
+ */
+using AigLit = uint32_t;
+
+/**
+ * Handle to an AIG node stored in an AigManager with automatic reference
+ * counting on construction/destruction.
+ *
+ * @note The methods accessing node data are defined in aig_manager.h.
  */
 class AigNode
 {
   friend AigManager;
-  friend AigNodeData;
+  friend AigCnfEncoder;
+  friend AigOptimizer;
+  friend AigFraig;
 
  public:
   AigNode() = default;
@@ -45,9 +60,9 @@ class AigNode
 
   bool is_const() const;
 
-  bool is_negated() const { return d_negated; }
+  bool is_negated() const { return d_lit & 1; }
 
-  const AigNode& operator[](int index) const;
+  AigNode operator[](int index) const;
 
   int64_t get_id() const;
 
@@ -56,16 +71,34 @@ class AigNode
  private:
   static const int64_t s_true_id = 1;
 
+  /** @return The literal corresponding to given signed id. */
+  static AigLit to_lit(int64_t id)
+  {
+    assert(id != 0);
+    return id < 0 ? static_cast<AigLit>(-id) << 1 | 1
+                  : static_cast<AigLit>(id) << 1;
+  }
+  /** @return The signed id corresponding to given literal. */
+  static int64_t to_id(AigLit lit)
+  {
+    int64_t id = static_cast<int64_t>(lit >> 1);
+    return (lit & 1) ? -id : id;
+  }
+
   // Should only be constructed via AigManager
-  AigNode(AigNodeData* data, bool negated = false);
+  AigNode(AigManager* mgr, AigLit lit);
 
-  bool is_null() const { return d_data == nullptr; }
+  bool is_null() const { return d_lit == 0; }
+
+  /** @return The index of the node in the node storage of the manager. */
+  uint32_t index() const { return d_lit >> 1; }
 
   uint64_t get_refs() const;
 
-  AigNodeData* d_data = nullptr;
-  // TODO: optimization hide flag in d_data pointer
-  bool d_negated = false;
+  /** The manager storing the node data. */
+  AigManager* d_mgr = nullptr;
+  /** The literal of this node. */
+  AigLit d_lit = 0;
 };
 
 inline bool
@@ -80,116 +113,11 @@ operator<(const AigNode& a, const AigNode& b)
   return a.get_id() < b.get_id();
 }
 
-/**
- * AigNodeData storing all node data.
- */
-class AigNodeData
-{
-  friend class AigNode;
-  friend AigManager;
-  friend class AigNodeUniqueTable;
-
- public:
-  AigNodeData() = delete;
-  ~AigNodeData() { assert(d_refs == 0); }
-
-  void inc_refs() { ++d_refs; }
-  void dec_refs()
-  {
-    assert(d_refs > 0);
-    --d_refs;
-    if (d_refs == 0)
-    {
-      gc();
-    }
-  }
-
- private:
-  AigNodeData(AigManager* mgr) : d_mgr(mgr) {}
-  AigNodeData(AigManager* mgr, const AigNode& left, const AigNode& right)
-      : d_mgr(mgr), d_left(left), d_right(right)
-  {
-  }
-
-  void gc();
-
-  /** Pointer to AIG Manager to allow automatic deletion. */
-  AigManager* d_mgr = nullptr;
-
-  /** AIG node id. */
-  int64_t d_id = 0;
-  /** Reference count. */
-  uint32_t d_refs = 0;
-  /** Number of parents. */
-  uint32_t d_parents = 0;
-  /** Left child of AND gate. */
-  AigNode d_left;
-  /** Right child of AND gate. */
-  AigNode d_right;
-
-  /** Next pointer for collision chain. */
-  AigNodeData* next = nullptr;
-};
-
-inline bool
-AigNode::is_true() const
-{
-  return d_data->d_id == AigNode::s_true_id && !is_negated();
-}
-
-inline bool
-AigNode::is_false() const
-{
-  return d_data->d_id == AigNode::s_true_id && is_negated();
-}
-
-inline bool
-AigNode::is_and() const
-{
-  return !d_data->d_left.is_null();
-}
-
-inline bool
-AigNode::is_const() const
-{
-  return !is_and() && !is_true() && !is_false();
-}
-
-inline const AigNode&
-AigNode::operator[](int index) const
-{
-  assert(is_and());
-  if (index == 0)
-  {
-    return d_data->d_left;
-  }
-  assert(index == 1);
-  return d_data->d_right;
-}
-
 inline int64_t
 AigNode::get_id() const
 {
-  // only happens if constructed with default constructor
-  if (is_null())
-  {
-    return 0;
-  }
-  return is_negated() ? -d_data->d_id : d_data->d_id;
-}
-
-inline uint32_t
-AigNode::parents() const
-{
-  assert(!is_null());
-  return d_data->d_parents;
-}
-
-inline uint64_t
-AigNode::get_refs() const
-{
-  assert(!is_null());
-  return d_data->d_refs;
+  // Null nodes (default constructor) are mapped to id 0.
+  return to_id(d_lit);
 }
 
 }  // namespace bzla::bitblast
@@ -0,0 +1,820 @@
+/***
+ * Bitwuzla: Satisfiability Modulo Theories (SMT) solver.
+ *
+ * Copyright (C) 2022 by the authors listed in the AUTHORS file at
+ * https://github.com/bitwuzla/bitwuzla/blob/main/AUTHORS
+ *
+ * This file is part of Bitwuzla under the MIT license. See COPYING for more
+ * information at https://github.com/bitwuzla/bitwuzla/blob/main/COPYING
+ */
+
+#include "bitblast/aig/aig_optimizer.h"
+
+#include <algorithm>
+#include <array>
+#include <unordered_set>
+
+namespace bzla::bitblast {
+
+namespace {
+
+/** Truth tables of the (up to 6) inputs of a cut. */
+constexpr std::array<uint64_t, 6> s_vars = {0xAAAAAAAAAAAAAAAAu,
+                                            0xCCCCCCCCCCCCCCCCu,
+                                            0xF0F0F0F0F0F0F0F0u,
+                                            0xFF00FF00FF00FF00u,
+                                            0xFFFF0000FFFF0000u,
+                                            0xFFFFFFFF00000000u};
+
+/** @return The negative cofactor of truth table `t` w.r.t. input `v`. */
+uint64_t
+cofactor0(uint64_t t, uint32_t v)
+{
+  t &= ~s_vars[v];
+  return t | (t << (1u << v));
+}
+
+/** @return The positive cofactor of truth table `t` w.r.t. input `v`. */
+uint64_t
+cofactor1(uint64_t t, uint32_t v)
+{
+  t &= s_vars[v];
+  return t | (t >> (1u << v));
+}
+
+/** @return The number of literals of given cover. */
+template <class T>
+uint32_t
+num_literals(const std::vector<T>& cover)
+{
+  uint32_t res = 0;
+  for (const auto& cube : cover)
+  {
+    res += __builtin_popcount(cube.d_pos) + __builtin_popcount(cube.d_neg);
+  }
+  return res;
+}
+
+}  // namespace
+
+AigOptimizer::AigOptimizer(const InputPredicate& is_input)
+    : d_is_input(is_input)
+{
+}
+
+void
+AigOptimizer::optimize(std::vector<AigNode>& roots)
+{
+  if (roots.empty())
+  {
+    return;
+  }
+
+  uint64_t num_ands = count_ands(roots);
+  d_statistics.num_ands_before += num_ands;
+  for (auto pass :
+       {Pass::BALANCE, Pass::REWRITE, Pass::REFACTOR, Pass::BALANCE})
+  {
+    std::vector<AigNode> res = rebuild(roots, pass);
+    uint64_t n               = count_ands(res);
+    if (n <= num_ands)
+    {
+      roots    = std::move(res);
+      num_ands = n;
+    }
+  }
+  d_statistics.num_ands_after += num_ands;
+}
+
+std::vector<AigNode>
+AigOptimizer::balance(const std::vector<AigNode>& roots)
+{
+  return rebuild(roots, Pass::BALANCE);
+}
+
+std::vector<AigNode>
+AigOptimizer::rewrite(const std::vector<AigNode>& roots)
+{
+  return rebuild(roots, Pass::REWRITE);
+}
+
+std::vector<AigNode>
+AigOptimizer::refactor(const std::vector<AigNode>& roots)
+{
+  return rebuild(roots, Pass::REFACTOR);
+}
+
+uint64_t
+AigOptimizer::count_ands(const std::vector<AigNode>& roots) const
+{
+  if (roots.empty())
+  {
+    return 0;
+  }
+
+  AigManager* mgr = roots[0].d_mgr;
+  std::unordered_set<uint32_t> cache;
+  std::vector<uint32_t> visit;
+  for (const AigNode& root : roots)
+  {
+    visit.push_back(root.index());
+  }
+
+  uint64_t res = 0;
+  do
+  {
+    uint32_t cur = visit.back();
+    visit.pop_back();
+    const AigNodeData& d = mgr->d_nodes[cur];
+    if (d.d_left == 0 || !cache.insert(cur).second
+        || (d_is_input && d_is_input(AigNode(mgr, AigNode::to_lit(cur)))))
+    {
+      continue;
+    }
+    ++res;
+    visit.push_back(d.d_left >> 1);
+    visit.push_back(d.d_right >> 1);
+  } while (!visit.empty());
+  return res;
+}
+
+const AigOptimizer::Statistics&
+AigOptimizer::statistics() const
+{
+  return d_statistics;
+}
+
+/* --- AigOptimizer private ------------------------------------------------- */
+
+bool
+AigOptimizer::is_input(uint32_t id) const
+{
+  return !is_and(id) || (d_is_input && d_is_input(node(AigNode::to_lit(id))));
+}
+
+void
+AigOptimizer::init(const std::vector<AigNode>& roots)
+{
+  assert(!roots.empty());
+  d_mgr = roots[0].d_mgr;
+  d_refs.assign(d_mgr->d_nodes.size(), 0);
+
+  // Post-order traversal, visited AND gates have a non-zero reference count.
+  std::vector<std::pair<uint32_t, bool>> visit;
+  for (const AigNode& root : roots)
+  {
+    visit.emplace_back(root.index(), false);
+  }
+  do
+  {
+    auto [cur, done] = visit.back();
+    visit.pop_back();
+    if (done)
+    {
+      d_ands.push_back(cur);
+      continue;
+    }
+    if (d_refs[cur]++ > 0 || is_input(cur))
+    {
+      continue;
+    }
+    visit.emplace_back(cur, true);
+    visit.emplace_back(right(cur) >> 1, false);
+    visit.emplace_back(left(cur) >> 1, false);
+  } while (!visit.empty());
+}
+
+void
+AigOptimizer::reset()
+{
+  d_ands.clear();
+  d_refs.clear();
+  d_cuts.clear();
+  d_images.clear();
+  d_mffc.clear();
+  d_used.clear();
+  d_levels.clear();
+}
+
+std::vector<AigNode>
+AigOptimizer::rebuild(const std::vector<AigNode>& roots, Pass pass)
+{
+  if (roots.empty())
+  {
+    return {};
+  }
+
+  init(roots);
+  if (pass == Pass::REWRITE)
+  {
+    compute_cuts();
+  }
+
+  // Rebuild nodes on demand, the nodes needed to rebuild a node are
+  // determined on its first visit and rebuilt before the node.
+  std::vector<std::pair<uint32_t, bool>> visit;
+  for (const AigNode& root : roots)
+  {
+    visit.emplace_back(root.index(), false);
+  }
+  do
+  {
+    auto [cur, done] = visit.back();
+    visit.pop_back();
+    if (is_input(cur) || d_images.find(cur) != d_images.end())
+    {
+      continue;
+    }
+    if (done)
+    {
+      d_images.emplace(cur, build(cur, pass));
+      continue;
+    }
+    visit.emplace_back(cur, true);
+    for (uint32_t id : needed(cur, pass))
+    {
+      visit.emplace_back(id, false);
+    }
+  } while (!visit.empty());
+
+  std::vector<AigNode> res;
+  for (const AigNode& root : roots)
+  {
+    res.push_back(image(root.d_lit));
+  }
+  reset();
+  return res;
+}
+
+std::vector<uint32_t>
+AigOptimizer::needed(uint32_t id, Pass pass)
+{
+  std::vector<uint32_t> res;
+  if (pass == Pass::BALANCE)
+  {
+    std::vector<AigLit> inputs;
+    collect_supergate(id, inputs);
+    for (AigLit lit : inputs)
+    {
+      res.push_back(lit >> 1);
+    }
+    return res;
+  }
+
+  if (pass == Pass::REFACTOR && d_cuts.find(id) == d_cuts.end())
+  {
+    d_cuts.emplace(id, std::vector<Cut>{compute_reconv_cut(id)});
+  }
+  res.push_back(left(id) >> 1);
+  res.push_back(right(id) >> 1);
+  for (const Cut& cut : d_cuts.at(id))
+  {
+    if (cut.size() > 1 || cut[0] != id)
+    {
+      res.insert(res.end(), cut.begin(), cut.end());
+    }
+  }
+  return res;
+}
+
+AigNode
+AigOptimizer::build(uint32_t id, Pass pass)
+{
+  if (pass == Pass::BALANCE)
+  {
+    std::vector<AigLit> lits;
+    if (!collect_supergate(id, lits))
+    {
+      return d_mgr->mk_false();
+    }
+    std::vector<AigNode> inputs;
+    for (AigLit lit : lits)
+    {
+      inputs.push_back(image(lit));
+    }
+    if (inputs.size() > 2)
+    {
+      ++d_statistics.num_balanced;
+    }
+    AigNode res = build_balanced(inputs);
+    mark_used(res);
+    return res;
+  }
+
+  AigNode res       = d_mgr->mk_and(image(left(id)), image(right(id)));
+  uint32_t max_gain = 0;
+  for (const Cut& cut : d_cuts.at(id))
+  {
+    if (cut.size() == 1 && cut[0] == id)
+    {
+      continue;
+    }
+    std::vector<AigNode> inputs;
+    for (uint32_t leaf : cut)
+    {
+      inputs.push_back(image(AigNode::to_lit(leaf)));
+    }
+    uint32_t saved = mffc_size(id, cut);
+    if (saved <= max_gain)
+    {
+      continue;
+    }
+    AigNode candidate = synthesize(truth_table(id, cut), inputs);
+    uint32_t added    = count_new(candidate, inputs);
+    if (added < saved && saved - added > max_gain)
+    {
+      max_gain = saved - added;
+      res      = candidate;
+    }
+  }
+  if (max_gain > 0)
+  {
+    if (pass == Pass::REWRITE)
+    {
+      ++d_statistics.num_rewritten;
+    }
+    else
+    {
+      ++d_statistics.num_refactored;
+    }
+  }
+  mark_used(res);
+  return res;
+}
+
+AigNode
+AigOptimizer::image(AigLit lit)
+{
+  uint32_t id = lit >> 1;
+  if (is_input(id))
+  {
+    return node(lit);
+  }
+  const AigNode& res = d_images.at(id);
+  return (lit & 1) ? d_mgr->mk_not(res) : res;
+}
+
+bool
+AigOptimizer::collect_supergate(uint32_t id, std::vector<AigLit>& inputs) const
+{
+  // AND gates with a single fanout are merged into their parent.
+  std::vector<AigLit> visit{left(id), right(id)};
+  do
+  {
+    AigLit cur = visit.back();
+    visit.pop_back();
+    uint32_t cur_id = cur >> 1;
+    if (!(cur & 1) && !is_input(cur_id) && d_refs[cur_id] == 1)
+    {
+      visit.push_back(left(cur_id));
+      visit.push_back(right(cur_id));
+    }
+    else
+    {
+      inputs.push_back(cur);
+    }
+  } while (!visit.empty());
+
+  std::sort(inputs.begin(), inputs.end());
+  inputs.erase(std::unique(inputs.begin(), inputs.end()), inputs.end());
+  for (size_t i = 1, size = inputs.size(); i < size; ++i)
+  {
+    if ((inputs[i - 1] ^ 1) == inputs[i])
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+AigNode
+AigOptimizer::build_balanced(std::vector<AigNode>& inputs)
+{
+  assert(!inputs.empty());
+  // Sorted by decreasing level, combine the two inputs with the lowest levels
+  // first.
+  auto cmp = [this](const AigNode& a, const AigNode& b) {
+    return level(a) > level(b);
+  };
+  std::sort(inputs.begin(), inputs.end(), cmp);
+  while (inputs.size() > 1)
+  {
+    AigNode a = inputs.back();
+    inputs.pop_back();
+    AigNode b = inputs.back();
+    inputs.pop_back();
+    AigNode res = d_mgr->mk_and(a, b);
+    inputs.insert(std::upper_bound(inputs.begin(), inputs.end(), res, cmp),
+                  res);
+  }
+  return inputs[0];
+}
+
+uint32_t
+AigOptimizer::level(const AigNode& node)
+{
+  std::vector<uint32_t> visit{node.index()};
+  do
+  {
+    uint32_t cur = visit.back();
+    if (d_levels.size() <= cur)
+    {
+      d_levels.resize(d_mgr->d_nodes.size(), 0);
+    }
+    if (d_levels[cur] > 0 || is_input(cur))
+    {
+      visit.pop_back();
+      continue;
+    }
+    uint32_t l  = left(cur) >> 1, r = right(cur) >> 1;
+    bool l_done = is_input(l) || d_levels[l] > 0;
+    bool r_done = is_input(r) || d_levels[r] > 0;
+    if (l_done && r_done)
+    {
+      d_levels[cur] = 1 + std::max(d_levels[l], d_levels[r]);
+      visit.pop_back();
+      continue;
+    }
+    if (!l_done)
+    {
+      visit.push_back(l);
+    }
+    if (!r_done)
+    {
+      visit.push_back(r);
+    }
+  } while (!visit.empty());
+  return is_input(node.index()) ? 0 : d_levels[node.index()];
+}
+
+void
+AigOptimizer::compute_cuts()
+{
+  // Merge the cuts of the children in topological order, inputs and nodes
+  // outside of the current AIGs only have their trivial cut.
+  for (uint32_t id : d_ands)
+  {
+    std::vector<Cut> cuts{{id}};
+    const std::vector<Cut> trivial_left{{left(id) >> 1}};
+    const std::vector<Cut> trivial_right{{right(id) >> 1}};
+    auto it_left  = d_cuts.find(left(id) >> 1);
+    auto it_right = d_cuts.find(right(id) >> 1);
+    const auto& cuts_left =
+        it_left == d_cuts.end() ? trivial_left : it_left->second;
+    const auto& cuts_right =
+        it_right == d_cuts.end() ? trivial_right : it_right->second;
+
+    for (const Cut& l : cuts_left)
+    {
+      for (const Cut& r : cuts_right)
+      {
+        Cut cut;
+        std::set_union(
+            l.begin(), l.end(), r.begin(), r.end(), std::back_inserter(cut));
+        if (cut.size() <= s_rewrite_cut_size
+            && std::find(cuts.begin(), cuts.end(), cut) == cuts.end())
+        {
+          cuts.push_back(std::move(cut));
+        }
+      }
+    }
+    // Keep the trivial cut and the smallest non-trivial cuts.
+    std::stable_sort(
+        cuts.begin() + 1, cuts.end(), [](const Cut& a, const Cut& b) {
+          return a.size() < b.size();
+        });
+    if (cuts.size() > s_rewrite_num_cuts + 1)
+    {
+      cuts.resize(s_rewrite_num_cuts + 1);
+    }
+    d_cuts.emplace(id, std::move(cuts));
+  }
+}
+
+AigOptimizer::Cut
+AigOptimizer::compute_reconv_cut(uint32_t id) const
+{
+  Cut leaves{left(id) >> 1};
+  if ((right(id) >> 1) != leaves[0])
+  {
+    leaves.push_back(right(id) >> 1);
+  }
+  std::unordered_set<uint32_t> visited(leaves.begin(), leaves.end());
+  visited.insert(id);
+
+  // Expand the leaf that increases the size of the cut the least.
+  while (true)
+  {
+    size_t best       = leaves.size();
+    uint32_t min_cost = 2;
+    for (size_t i = 0, size = leaves.size(); i < size; ++i)
+    {
+      uint32_t leaf = leaves[i];
+      if (is_input(leaf))
+      {
+        continue;
+      }
+      uint32_t cost = (visited.find(left(leaf) >> 1) == visited.end())
+                      + (visited.find(right(leaf) >> 1) == visited.end());
+      if (cost < min_cost || best == leaves.size())
+      {
+        best     = i;
+        min_cost = cost;
+      }
+    }
+    if (best == leaves.size()
+        || leaves.size() - 1 + min_cost > s_refactor_cut_size)
+    {
+      break;
+    }
+    uint32_t leaf = leaves[best];
+    leaves.erase(leaves.begin() + best);
+    for (AigLit child : {left(leaf), right(leaf)})
+    {
+      if (visited.insert(child >> 1).second)
+      {
+        leaves.push_back(child >> 1);
+      }
+    }
+  }
+  std::sort(leaves.begin(), leaves.end());
+  return leaves;
+}
+
+uint64_t
+AigOptimizer::truth_table(uint32_t id, const Cut& cut) const
+{
+  assert(cut.size() <= s_vars.size());
+  std::unordered_map<uint32_t, uint64_t> cache;
+  for (size_t i = 0, size = cut.size(); i < size; ++i)
+  {
+    cache.emplace(cut[i], s_vars[i]);
+  }
+
+  std::vector<uint32_t> visit{id};
+  do
+  {
+    uint32_t cur = visit.back();
+    if (cache.find(cur) != cache.end())
+    {
+      visit.pop_back();
+      continue;
+    }
+    assert(is_and(cur));
+    AigLit l  = left(cur), r = right(cur);
+    auto it_l = cache.find(l >> 1);
+    auto it_r = cache.find(r >> 1);
+    if (it_l != cache.end() && it_r != cache.end())
+    {
+      uint64_t t_l = (l & 1) ? ~it_l->second : it_l->second;
+      uint64_t t_r = (r & 1) ? ~it_r->second : it_r->second;
+      cache.emplace(cur, t_l & t_r);
+      visit.pop_back();
+      continue;
+    }
+    if (it_l == cache.end())
+    {
+      visit.push_back(l >> 1);
+    }
+    if (it_r == cache.end())
+    {
+      visit.push_back(r >> 1);
+    }
+  } while (!visit.empty());
+  return cache.at(id);
+}
+
+uint32_t
+AigOptimizer::mffc_size(uint32_t id, const Cut& cut)
+{
+  // Dereference the cone of the node, AND gates whose reference count drops
+  // to zero are only used within the cone.
+  d_mffc.assign(1, id);
+  std::vector<uint32_t> visit{id}, derefed;
+  do
+  {
+    uint32_t cur = visit.back();
+    visit.pop_back();
+    for (AigLit child : {left(cur), right(cur)})
+    {
+      uint32_t c = child >> 1;
+      if (is_input(c) || std::find(cut.begin(), cut.end(), c) != cut.end())
+      {
+        continue;
+      }
+      derefed.push_back(c);
+      if (--d_refs[c] == 0)
+      {
+        d_mffc.push_back(c);
+        visit.push_back(c);
+      }
+    }
+  } while (!visit.empty());
+
+  for (uint32_t c : derefed)
+  {
+    ++d_refs[c];
+  }
+  return static_cast<uint32_t>(d_mffc.size());
+}
+
+AigNode
+AigOptimizer::synthesize(uint64_t truth, const std::vector<AigNode>& inputs)
+{
+  uint32_t num_vars = static_cast<uint32_t>(inputs.size());
+  if (truth == 0)
+  {
+    return d_mgr->mk_false();
+  }
+  if (truth == ~uint64_t{0})
+  {
+    return d_mgr->mk_true();
+  }
+
+  // Factor the smaller cover of the function and its negation.
+  std::vector<Cube> cover_pos, cover_neg;
+  isop(truth, truth, num_vars, cover_pos);
+  isop(~truth, ~truth, num_vars, cover_neg);
+  if (num_literals(cover_neg) < num_literals(cover_pos))
+  {
+    return d_mgr->mk_not(factor(cover_neg, inputs));
+  }
+  return factor(cover_pos, inputs);
+}
+
+uint64_t
+AigOptimizer::isop(uint64_t lower,
+                   uint64_t upper,
+                   uint32_t num_vars,
+                   std::vector<Cube>& cover) const
+{
+  assert((lower & ~upper) == 0);
+  if (lower == 0)
+  {
+    return 0;
+  }
+  if (upper == ~uint64_t{0})
+  {
+    cover.emplace_back();
+    return upper;
+  }
+
+  // Find topmost input the bounds depend on.
+  assert(num_vars > 0);
+  uint32_t v = num_vars - 1;
+  while (v > 0 && cofactor0(lower, v) == cofactor1(lower, v)
+         && cofactor0(upper, v) == cofactor1(upper, v))
+  {
+    --v;
+  }
+
+  uint64_t lower0 = cofactor0(lower, v), lower1 = cofactor1(lower, v);
+  uint64_t upper0 = cofactor0(upper, v), upper1 = cofactor1(upper, v);
+
+  size_t begin0 = cover.size();
+  uint64_t res0 = isop(lower0 & ~upper1, upper0, v, cover);
+  for (size_t i = begin0, size = cover.size(); i < size; ++i)
+  {
+    cover[i].d_neg |= 1u << v;
+  }
+  size_t begin1 = cover.size();
+  uint64_t res1 = isop(lower1 & ~upper0, upper1, v, cover);
+  for (size_t i = begin1, size = cover.size(); i < size; ++i)
+  {
+    cover[i].d_pos |= 1u << v;
+  }
+  uint64_t res2 = isop(
+      (lower0 & ~res0) | (lower1 & ~res1), upper0 & upper1, v, cover);
+  return (res0 & ~s_vars[v]) | (res1 & s_vars[v]) | res2;
+}
+
+AigNode
+AigOptimizer::factor(const std::vector<Cube>& cover,
+                     const std::vector<AigNode>& inputs)
+{
+  if (cover.empty())
+  {
+    return d_mgr->mk_false();
+  }
+
+  // Count occurrences of literals, index 2 * v (+ 1 if negative).
+  std::array<uint32_t, 2 * s_vars.size()> occs{};
+  for (const Cube& cube : cover)
+  {
+    if (cube.d_pos == 0 && cube.d_neg == 0)
+    {
+      return d_mgr->mk_true();
+    }
+    for (uint32_t v = 0, n = inputs.size(); v < n; ++v)
+    {
+      occs[2 * v] += (cube.d_pos >> v) & 1;
+      occs[2 * v + 1] += (cube.d_neg >> v) & 1;
+    }
+  }
+  size_t best = std::max_element(occs.begin(), occs.end()) - occs.begin();
+
+  if (cover.size() == 1 || occs[best] == 1)
+  {
+    // Sum of products.
+    AigNode res = d_mgr->mk_false();
+    for (const Cube& cube : cover)
+    {
+      AigNode prod = d_mgr->mk_true();
+      for (uint32_t v = 0, n = inputs.size(); v < n; ++v)
+      {
+        if ((cube.d_pos >> v) & 1)
+        {
+          prod = d_mgr->mk_and(prod, inputs[v]);
+        }
+        else if ((cube.d_neg >> v) & 1)
+        {
+          prod = d_mgr->mk_and(prod, d_mgr->mk_not(inputs[v]));
+        }
+      }
+      res = d_mgr->mk_not(
+          d_mgr->mk_and(d_mgr->mk_not(res), d_mgr->mk_not(prod)));
+    }
+    return res;
+  }
+
+  // Divide by the most frequent literal: lit * (cover / lit) + remainder.
+  uint32_t v   = best / 2;
+  uint8_t mask = 1u << v;
+  std::vector<Cube> quotient, remainder;
+  for (const Cube& cube : cover)
+  {
+    if ((best & 1) ? (cube.d_neg & mask) : (cube.d_pos & mask))
+    {
+      quotient.push_back({static_cast<uint8_t>(cube.d_pos & ~mask),
+                          static_cast<uint8_t>(cube.d_neg & ~mask)});
+    }
+    else
+    {
+      remainder.push_back(cube);
+    }
+  }
+  AigNode lit = (best & 1) ? d_mgr->mk_not(inputs[v]) : inputs[v];
+  AigNode res = d_mgr->mk_and(lit, factor(quotient, inputs));
+  if (!remainder.empty())
+  {
+    AigNode rem = factor(remainder, inputs);
+    res = d_mgr->mk_not(d_mgr->mk_and(d_mgr->mk_not(res), d_mgr->mk_not(rem)));
+  }
+  return res;
+}
+
+uint32_t
+AigOptimizer::count_new(const AigNode& node, const std::vector<AigNode>& inputs)
+{
+  // AND gates are for free if they are already used in the rebuilt AIGs and
+  // not part of the fanout-free cone that is replaced.
+  std::unordered_set<uint32_t> cache;
+  for (const AigNode& input : inputs)
+  {
+    cache.insert(input.index());
+  }
+  uint32_t res = 0;
+  std::vector<uint32_t> visit{node.index()};
+  do
+  {
+    uint32_t cur = visit.back();
+    visit.pop_back();
+    if (is_input(cur) || !cache.insert(cur).second)
+    {
+      continue;
+    }
+    if (cur < d_used.size() && d_used[cur]
+        && std::find(d_mffc.begin(), d_mffc.end(), cur) == d_mffc.end())
+    {
+      continue;
+    }
+    ++res;
+    visit.push_back(left(cur) >> 1);
+    visit.push_back(right(cur) >> 1);
+  } while (!visit.empty());
+  return res;
+}
+
+void
+AigOptimizer::mark_used(const AigNode& node)
+{
+  if (d_used.size() < d_mgr->d_nodes.size())
+  {
+    d_used.resize(d_mgr->d_nodes.size(), false);
+  }
+  std::vector<uint32_t> visit{node.index()};
+  do
+  {
+    uint32_t cur = visit.back();
+    visit.pop_back();
+    if (is_input(cur) || d_used[cur])
+    {
+      continue;
+    }
+    d_used[cur] = true;
+    visit.push_back(left(cur) >> 1);
+    visit.push_back(right(cur) >> 1);
+  } while (!visit.empty());
+}
+
+}  // namespace bzla::bitblast
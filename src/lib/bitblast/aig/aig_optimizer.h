@@ -0,0 +1,226 @@
+/***
+ * Bitwuzla: Satisfiability Modulo Theories (SMT) solver.
+ *
+ * Copyright (C) 2022 by the authors listed in the AUTHORS file at
+ * https://github.com/bitwuzla/bitwuzla/blob/main/AUTHORS
+ *
+ * This file is part of Bitwuzla under the MIT license. See COPYING for more
+ * information at https://github.com/bitwuzla/bitwuzla/blob/main/COPYING
+ */
+
+#ifndef BZLA__BITBLAST_AIG_OPTIMIZER_H
+#define BZLA__BITBLAST_AIG_OPTIMIZER_H
+
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+#include "bitblast/aig/aig_manager.h"
+
+namespace bzla::bitblast {
+
+/**
+ * Optimizer for the AIGs of a set of roots, based on the ABC passes [1]:
+ *
+ * - balance:  Rebuilds multi-input AND trees (AND gates with single fanout
+ *             merged into their parent) as trees of minimal depth.
+ * - rewrite:  DAG-aware rewriting over 4-feasible cuts.
+ * - refactor: DAG-aware rewriting over a single large (up to 6 inputs)
+ *             reconvergence-driven cut per node.
+ *
+ * Cuts are resynthesized from their truth table via an irredundant sum of
+ * products that is algebraically factored. A candidate is accepted if the
+ * number of AND gates it adds is smaller than the number of AND gates of the
+ * maximum fanout-free cone it replaces, where gates that are already part of
+ * the optimized AIG are for free.
+ *
+ * Since AIG nodes are immutable, the passes do not modify AIGs in place but
+ * rebuild the roots. Nodes are only rebuilt on demand, starting from the
+ * roots, hence nodes that are not reachable anymore are never constructed.
+ *
+ * [1] DAG-Aware AIG Rewriting: A Fresh Look at Combinational Logic
+ *     Synthesis. Alan Mishchenko, Satrajit Chatterjee, Robert Brayton.
+ */
+class AigOptimizer
+{
+ public:
+  /**
+   * Predicate to identify nodes that are treated as inputs, i.e., whose
+   * structure is not optimized.
+   */
+  using InputPredicate = std::function<bool(const AigNode&)>;
+
+  struct Statistics
+  {
+    uint64_t num_ands_before = 0;  // Number of AND gates before optimizing
+    uint64_t num_ands_after  = 0;  // Number of AND gates after optimizing
+    uint64_t num_balanced    = 0;  // Number of balanced AND trees
+    uint64_t num_rewritten   = 0;  // Number of accepted rewrites
+    uint64_t num_refactored  = 0;  // Number of accepted refactorings
+  };
+
+  /**
+   * Constructor.
+   * @param is_input Predicate for nodes that are treated as inputs, may be
+   *                 null. AIG constants are always treated as inputs.
+   */
+  AigOptimizer(const InputPredicate& is_input = nullptr);
+
+  /**
+   * Optimize the AIGs of given roots with balance, rewrite, refactor,
+   * balance. The result of a pass is only kept if it does not increase the
+   * number of AND gates.
+   * @param roots The roots to optimize, updated in place.
+   */
+  void optimize(std::vector<AigNode>& roots);
+
+  /** Balance the AIGs of given roots. */
+  std::vector<AigNode> balance(const std::vector<AigNode>& roots);
+  /** Rewrite the AIGs of given roots over 4-feasible cuts. */
+  std::vector<AigNode> rewrite(const std::vector<AigNode>& roots);
+  /** Refactor the AIGs of given roots over large cuts. */
+  std::vector<AigNode> refactor(const std::vector<AigNode>& roots);
+
+  /**
+   * @return The number of AND gates in the AIGs of given roots, stopping at
+   *         inputs.
+   */
+  uint64_t count_ands(const std::vector<AigNode>& roots) const;
+
+  /** @return Optimizer statistics. */
+  const Statistics& statistics() const;
+
+ private:
+  /** Maximum number of inputs of cuts considered by rewrite. */
+  static constexpr uint32_t s_rewrite_cut_size = 4;
+  /** Maximum number of cuts stored per node for rewrite. */
+  static constexpr uint32_t s_rewrite_num_cuts = 8;
+  /** Maximum number of inputs of cuts considered by refactor. */
+  static constexpr uint32_t s_refactor_cut_size = 6;
+
+  /** A cut, a set of node ids sorted in ascending order. */
+  using Cut = std::vector<uint32_t>;
+
+  /** A cube of a cover, a pair of bit masks of positive/negative inputs. */
+  struct Cube
+  {
+    uint8_t d_pos = 0;
+    uint8_t d_neg = 0;
+  };
+
+  /** The optimization passes. */
+  enum class Pass
+  {
+    BALANCE,
+    REWRITE,
+    REFACTOR,
+  };
+
+  /** @return True if the node with given id is treated as an input. */
+  bool is_input(uint32_t id) const;
+  /** @return True if the node with given id is an AND gate. */
+  bool is_and(uint32_t id) const { return d_mgr->d_nodes[id].d_left != 0; }
+  /** @return The literal of the left child of AND gate with given id. */
+  AigLit left(uint32_t id) const { return d_mgr->d_nodes[id].d_left; }
+  /** @return The literal of the right child of AND gate with given id. */
+  AigLit right(uint32_t id) const { return d_mgr->d_nodes[id].d_right; }
+  /** @return The AIG node with given literal. */
+  AigNode node(AigLit lit) const { return AigNode(d_mgr, lit); }
+
+  /**
+   * Initialize the pass for given roots. Collects the AND gates of the AIGs
+   * in topological order and counts their fanouts.
+   */
+  void init(const std::vector<AigNode>& roots);
+  /** Reset pass data. */
+  void reset();
+
+  /**
+   * Rebuild given roots with given pass.
+   * @return The rebuilt roots.
+   */
+  std::vector<AigNode> rebuild(const std::vector<AigNode>& roots, Pass pass);
+  /**
+   * @return The ids of the nodes whose rebuilt AIGs are needed to rebuild
+   *         the node with given id.
+   */
+  std::vector<uint32_t> needed(uint32_t id, Pass pass);
+  /** @return The rebuilt AIG of the node with given id. */
+  AigNode build(uint32_t id, Pass pass);
+  /** @return The rebuilt AIG of given literal. */
+  AigNode image(AigLit lit);
+
+  /**
+   * Collect the inputs of the multi-input AND gate rooted at given node.
+   * @return False if the AND gate is trivially false.
+   */
+  bool collect_supergate(uint32_t id, std::vector<AigLit>& inputs) const;
+  /** Build balanced AND tree over given (rebuilt) inputs. */
+  AigNode build_balanced(std::vector<AigNode>& inputs);
+  /** @return The logic level of given node. */
+  uint32_t level(const AigNode& node);
+
+  /** Compute the 4-feasible cuts of all AND gates of the current pass. */
+  void compute_cuts();
+  /** Compute a reconvergence-driven cut of the node with given id. */
+  Cut compute_reconv_cut(uint32_t id) const;
+
+  /** @return The truth table of given node over given cut. */
+  uint64_t truth_table(uint32_t id, const Cut& cut) const;
+  /**
+   * @return The number of AND gates of the maximum fanout-free cone of the
+   *         node with given id, bounded by given cut.
+   */
+  uint32_t mffc_size(uint32_t id, const Cut& cut);
+  /**
+   * Resynthesize the function of given truth table over given inputs.
+   * @param truth The truth table.
+   * @param inputs The (rebuilt) inputs of the function.
+   * @return The resynthesized AIG.
+   */
+  AigNode synthesize(uint64_t truth, const std::vector<AigNode>& inputs);
+  /**
+   * Compute the irredundant sum of products of a function with lower bound
+   * `lower` and upper bound `upper` (Minato-Morreale).
+   * @return The truth table of the computed cover.
+   */
+  uint64_t isop(uint64_t lower,
+                uint64_t upper,
+                uint32_t num_vars,
+                std::vector<Cube>& cover) const;
+  /** Build algebraically factored AIG of given cover. */
+  AigNode factor(const std::vector<Cube>& cover,
+                 const std::vector<AigNode>& inputs);
+  /** @return The number of new AND gates in the AIG of given node. */
+  uint32_t count_new(const AigNode& node, const std::vector<AigNode>& inputs);
+  /** Mark the AND gates of given (rebuilt) node as used. */
+  void mark_used(const AigNode& node);
+
+  /** The AIG manager of the current pass. */
+  AigManager* d_mgr = nullptr;
+  /** The input predicate. */
+  InputPredicate d_is_input;
+  /** The AND gates of the current pass in topological order. */
+  std::vector<uint32_t> d_ands;
+  /** The number of fanouts of the nodes of the current pass, by id. */
+  std::vector<uint32_t> d_refs;
+  /**
+   * The cuts of the AND gates of the current pass: all 4-feasible cuts for
+   * rewrite, a single reconvergence-driven cut for refactor.
+   */
+  std::unordered_map<uint32_t, std::vector<Cut>> d_cuts;
+  /** The rebuilt AIGs of the AND gates of the current pass. */
+  std::unordered_map<uint32_t, AigNode> d_images;
+  /** The ids of the AND gates of the last computed fanout-free cone. */
+  std::vector<uint32_t> d_mffc;
+  /** Marks AND gates that are part of the rebuilt AIGs, indexed by id. */
+  std::vector<bool> d_used;
+  /** Cached logic levels of AND gates, indexed by id. */
+  std::vector<uint32_t> d_levels;
+  /** Optimizer statistics. */
+  Statistics d_statistics;
+};
+
+}  // namespace bzla::bitblast
+
+#endif
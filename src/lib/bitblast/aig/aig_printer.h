@@ -13,6 +13,7 @@
 
 #include "bitblast/aig/aig_manager.h"
 
+#include <sstream>
 #include <vector>
 
 namespace bzla::bitblast::aig {
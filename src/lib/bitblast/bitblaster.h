@@ -11,9 +11,11 @@
 #ifndef BZLA__BITBLAST_BITBLASTER_H
 #define BZLA__BITBLAST_BITBLASTER_H
 
+#include <algorithm>
 #include <cassert>
 #include <cmath>
 #include <cstddef>
+#include <string>
 #include <vector>
 
 #include "bv/bitvector.h"
@@ -46,12 +48,42 @@ class BitInterface
   T mk_ite(const T& c, const T& a, const T& b);
 };
 
+/** Encodings for bit-vector multiplication. */
+enum class MulEncoding
+{
+  /** Shift-and-add array multiplier with ripple-carry rows. */
+  ARRAY,
+  /** Partial products reduced with a Wallace tree. */
+  WALLACE,
+  /** Partial products reduced with a Dadda tree. */
+  DADDA,
+  /** Radix-4 Booth recoded partial products reduced with a Dadda tree. */
+  BOOTH,
+  /**
+   * Booth if an operand is a value, Dadda for wide operands and array
+   * otherwise.
+   */
+  AUTO,
+};
+
 template <class T>
 class BitblasterInterface
 {
  public:
   using Bits = std::vector<T>;
 
+  /** Minimum bit-width for selecting a Dadda tree with MulEncoding::AUTO. */
+  static constexpr size_t s_mul_tree_min_size = 16;
+
+  /** Set the encoding used by bv_mul(). */
+  void set_mul_encoding(MulEncoding encoding) { d_mul_encoding = encoding; }
+
+  /**
+   * Configure whether bv_udiv() and bv_urem() encode division by a value as
+   * multiplication with its reciprocal (see udiv_urem_value()).
+   */
+  void set_div_reciprocal(bool value) { d_div_reciprocal = value; }
+
   virtual Bits bv_value(const BitVector& bv_value)
   {
     Bits res;
@@ -133,6 +165,16 @@ class BitblasterInterface
       return Bits{d_bit_mgr.mk_and(a[0], d_bit_mgr.mk_not(b[0]))};
     }
 
+    // Optimization: A shift by a value is a rewiring of the bits of `a`.
+    T false_bit     = d_bit_mgr.mk_false();
+    BitVector b_max = upper_bound(b);
+    bool in_range   = b_max.compare(BitVector::from_ui(b.size(), size)) < 0;
+    if (is_value(b))
+    {
+      return shift_by_value(
+          a, in_range ? b_max.to_uint64(true) : size, true, false_bit);
+    }
+
     size_t shift_size = static_cast<size_t>(std::ceil(std::log2(b.size())));
     assert(shift_size <= b.size());
 
@@ -143,6 +185,12 @@ class BitblasterInterface
       size_t shift_bit  = b.size() - 1 - i;
       assert(shift_step < size);
 
+      // Optimization: Skip stages for shift bits that are known to be zero.
+      if (b[shift_bit] == false_bit)
+      {
+        continue;
+      }
+
       // Perform left shift by `shift_step` bits.
       for (size_t j = 0; j < size - shift_step; ++j)
       {
@@ -158,6 +206,13 @@ class BitblasterInterface
       }
     }
 
+    // Optimization: No range check if the shift amount is known to be less
+    // than the bit-width.
+    if (in_range)
+    {
+      return shift_result;
+    }
+
     Bits res =
         bv_ite(ult_helper(b, bv_value(BitVector::from_ui(b.size(), size))),
                shift_result,
@@ -176,6 +231,16 @@ class BitblasterInterface
       return Bits{d_bit_mgr.mk_and(a[0], d_bit_mgr.mk_not(b[0]))};
     }
 
+    // Optimization: A shift by a value is a rewiring of the bits of `a`.
+    T false_bit     = d_bit_mgr.mk_false();
+    BitVector b_max = upper_bound(b);
+    bool in_range   = b_max.compare(BitVector::from_ui(b.size(), size)) < 0;
+    if (is_value(b))
+    {
+      return shift_by_value(
+          a, in_range ? b_max.to_uint64(true) : size, false, false_bit);
+    }
+
     size_t shift_size = static_cast<size_t>(std::ceil(std::log2(b.size())));
     assert(shift_size <= b.size());
 
@@ -186,6 +251,12 @@ class BitblasterInterface
       size_t shift_bit  = b.size() - 1 - i;
       assert(shift_step < size);
 
+      // Optimization: Skip stages for shift bits that are known to be zero.
+      if (b[shift_bit] == false_bit)
+      {
+        continue;
+      }
+
       // Perform right shift by `shift_step` bits.
       for (size_t j = 0, k = size - 1; j < size - shift_step; ++j, --k)
       {
@@ -201,6 +272,13 @@ class BitblasterInterface
       }
     }
 
+    // Optimization: No range check if the shift amount is known to be less
+    // than the bit-width.
+    if (in_range)
+    {
+      return shift_result;
+    }
+
     Bits res =
         bv_ite(ult_helper(b, bv_value(BitVector::from_ui(b.size(), size))),
                shift_result,
@@ -219,6 +297,16 @@ class BitblasterInterface
       return a;
     }
 
+    // Optimization: A shift by a value is a rewiring of the bits of `a`.
+    T false_bit     = d_bit_mgr.mk_false();
+    BitVector b_max = upper_bound(b);
+    bool in_range   = b_max.compare(BitVector::from_ui(b.size(), size)) < 0;
+    if (is_value(b))
+    {
+      return shift_by_value(
+          a, in_range ? b_max.to_uint64(true) : size, false, a[0]);
+    }
+
     size_t shift_size = static_cast<size_t>(std::ceil(std::log2(b.size())));
     assert(shift_size <= b.size());
 
@@ -229,6 +317,12 @@ class BitblasterInterface
       size_t shift_bit  = b.size() - 1 - i;
       assert(shift_step < size);
 
+      // Optimization: Skip stages for shift bits that are known to be zero.
+      if (b[shift_bit] == false_bit)
+      {
+        continue;
+      }
+
       // Perform right shift by `shift_step` bits.
       for (size_t j = 0, k = size - 1; j < size - shift_step; ++j, --k)
       {
@@ -245,6 +339,13 @@ class BitblasterInterface
       }
     }
 
+    // Optimization: No range check if the shift amount is known to be less
+    // than the bit-width.
+    if (in_range)
+    {
+      return shift_result;
+    }
+
     T shift_less_than_size =
         ult_helper(b, bv_value(BitVector::from_ui(b.size(), size)));
     for (size_t i = 0; i < size; ++i)
@@ -343,11 +444,43 @@ class BitblasterInterface
   virtual Bits bv_mul(const Bits& a, const Bits& b)
   {
     // Normalize operands s.t. operands with fixed bits come first
-    if (a > b)
+    const Bits& x = a > b ? b : a;
+    const Bits& y = a > b ? a : b;
+
+    MulEncoding encoding = d_mul_encoding;
+    if (encoding == MulEncoding::AUTO)
     {
-      return mul_helper(b, a);
+      // Booth recoding of a value skips all zero digits and turns runs of
+      // ones into a single subtraction.
+      if (is_value(x) || is_value(y))
+      {
+        encoding = MulEncoding::BOOTH;
+      }
+      else if (x.size() >= s_mul_tree_min_size)
+      {
+        encoding = MulEncoding::DADDA;
+      }
+      else
+      {
+        encoding = MulEncoding::ARRAY;
+      }
+    }
+
+    switch (encoding)
+    {
+      case MulEncoding::WALLACE:
+        return reduce_columns(and_partial_products(x, y), false);
+      case MulEncoding::DADDA:
+        return reduce_columns(and_partial_products(x, y), true);
+      case MulEncoding::BOOTH:
+        // Recode the operand that is a value, if any.
+        if (is_value(x) && !is_value(y))
+        {
+          return reduce_columns(booth_partial_products(y, x), true);
+        }
+        return reduce_columns(booth_partial_products(x, y), true);
+      default: return mul_helper(x, y);
     }
-    return mul_helper(a, b);
   }
 
   virtual Bits bv_udiv(const Bits& a, const Bits& b)
@@ -417,6 +550,10 @@ class BitblasterInterface
  protected:
 
   BitInterface<T> d_bit_mgr;
+  /** The encoding used by bv_mul(). */
+  MulEncoding d_mul_encoding = MulEncoding::ARRAY;
+  /** True to encode division by a value via multiplication. */
+  bool d_div_reciprocal = false;
 
  private:
   Bits add_helper(const Bits& a, const Bits& b)
@@ -474,6 +611,276 @@ class BitblasterInterface
     return res;
   }
 
+  /** @return True if all bits of `bits` are constants. */
+  bool is_value(const Bits& bits)
+  {
+    T false_bit = d_bit_mgr.mk_false();
+    T true_bit  = d_bit_mgr.mk_true();
+    for (const T& bit : bits)
+    {
+      if (!(bit == false_bit) && !(bit == true_bit))
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  /**
+   * @return The maximum unsigned value of `bits`, i.e., the value of `bits`
+   *         with all bits that are not constants set to 1.
+   */
+  BitVector upper_bound(const Bits& bits)
+  {
+    T false_bit = d_bit_mgr.mk_false();
+    std::string str;
+    str.reserve(bits.size());
+    for (const T& bit : bits)
+    {
+      str.push_back(bit == false_bit ? '0' : '1');
+    }
+    return BitVector(bits.size(), str);
+  }
+
+  /**
+   * Rewire the bits of `a` for a shift by value `shift`.
+   *
+   * Shifts left if `left` is true and right otherwise, the vacated bits are
+   * filled with `fill`.
+   */
+  Bits shift_by_value(const Bits& a, size_t shift, bool left, const T& fill)
+  {
+    size_t size = a.size();
+    Bits res;
+    res.reserve(size);
+    for (size_t i = 0; i < size; ++i)
+    {
+      if (left)
+      {
+        res.push_back(i + shift < size ? a[i + shift] : fill);
+      }
+      else
+      {
+        res.push_back(i >= shift ? a[i - shift] : fill);
+      }
+    }
+    return res;
+  }
+
+  /**
+   * Compute the partial products `a[i] & b[j]` of `a * b`.
+   *
+   * Returns the columns of the partial product matrix, where column k holds
+   * the bits of weight 2^k. Partial products of weight >= 2^size and
+   * partial products that are false are omitted.
+   */
+  std::vector<Bits> and_partial_products(const Bits& a, const Bits& b)
+  {
+    size_t size = a.size();
+    std::vector<Bits> cols(size);
+    T false_bit = d_bit_mgr.mk_false();
+    for (size_t i = 0; i < size; ++i)
+    {
+      const T& b_bit = b[size - 1 - i];
+      if (b_bit == false_bit)
+      {
+        continue;
+      }
+      for (size_t j = 0; i + j < size; ++j)
+      {
+        T p = d_bit_mgr.mk_and(a[size - 1 - j], b_bit);
+        if (!(p == false_bit))
+        {
+          cols[i + j].push_back(p);
+        }
+      }
+    }
+    return cols;
+  }
+
+  /**
+   * Compute the partial products of `a * b` with radix-4 Booth recoding of
+   * `b`.
+   *
+   * Each digit `-2 * b[j+1] + b[j] + b[j-1]` of `b` (j even) selects one of
+   * 0, a, 2a, -a, -2a as partial product, which halves the number of rows
+   * compared to and_partial_products(). Negative partial products are
+   * encoded as one's complement plus a correction bit in column j. Since
+   * only the lower `size` bits of the product are computed, `b` can be
+   * interpreted as signed and no sign extension of the rows is required.
+   *
+   * Returns the columns of the partial product matrix (see
+   * and_partial_products()).
+   */
+  std::vector<Bits> booth_partial_products(const Bits& a, const Bits& b)
+  {
+    size_t size = a.size();
+    std::vector<Bits> cols(size);
+    T false_bit = d_bit_mgr.mk_false();
+
+    // Bits indexed from the lsb, b is sign extended.
+    auto a_bit = [&](size_t i) { return a[size - 1 - i]; };
+    auto b_bit = [&](size_t i) { return i < size ? b[size - 1 - i] : b[0]; };
+
+    for (size_t j = 0; j < size; j += 2)
+    {
+      T b1 = b_bit(j + 1);
+      T b0 = b_bit(j);
+      T bm = j == 0 ? false_bit : b_bit(j - 1);
+
+      // Digit is -a or -2a.
+      T neg = b1;
+      // Digit is a or -a.
+      T one = mk_xor(b0, bm);
+      // Digit is 2a or -2a.
+      T two = d_bit_mgr.mk_or(
+          d_bit_mgr.mk_and(b1,
+                           d_bit_mgr.mk_and(d_bit_mgr.mk_not(b0),
+                                            d_bit_mgr.mk_not(bm))),
+          d_bit_mgr.mk_and(d_bit_mgr.mk_not(b1), d_bit_mgr.mk_and(b0, bm)));
+
+      // Optimization: Skip digits that are 0.
+      if (one == false_bit && two == false_bit)
+      {
+        continue;
+      }
+
+      for (size_t k = 0; j + k < size; ++k)
+      {
+        T p = d_bit_mgr.mk_and(one, a_bit(k));
+        if (k > 0)
+        {
+          p = d_bit_mgr.mk_or(p, d_bit_mgr.mk_and(two, a_bit(k - 1)));
+        }
+        p = mk_xor(p, neg);
+        if (!(p == false_bit))
+        {
+          cols[j + k].push_back(p);
+        }
+      }
+      if (!(neg == false_bit))
+      {
+        cols[j].push_back(neg);
+      }
+    }
+    return cols;
+  }
+
+  /**
+   * Sum up the columns of a partial product matrix (see
+   * and_partial_products()).
+   *
+   * The columns are compressed with full and half adders until each column
+   * has at most two bits, which are then summed up with a ripple-carry
+   * adder. With `dadda` set, the columns are compressed according to the
+   * Dadda scheme, which only compresses columns as far as necessary to
+   * reach the next target height of the sequence 2, 3, 4, 6, 9, 13, ...
+   * Otherwise, a Wallace tree is created, which compresses all columns as
+   * early as possible.
+   *
+   * Returns the lower `cols.size()` bits of the sum.
+   */
+  Bits reduce_columns(std::vector<Bits> cols, bool dadda)
+  {
+    size_t size = cols.size();
+
+    size_t max_height = 0;
+    for (const Bits& col : cols)
+    {
+      max_height = std::max(max_height, col.size());
+    }
+
+    std::vector<size_t> heights{2};
+    while (heights.back() < max_height)
+    {
+      heights.push_back(heights.back() * 3 / 2);
+    }
+    heights.pop_back();
+
+    // Add bits `a`, `b` and optionally `c` of column `i`, the sum is added
+    // to `next[i]` and the carry to `next[i + 1]`.
+    auto add = [&](std::vector<Bits>& next,
+                   size_t i,
+                   const T& a,
+                   const T& b,
+                   const T* c) {
+      // Optimization: The carry out of the msb column is not needed.
+      if (i + 1 == size)
+      {
+        next[i].push_back(c ? mk_xor(mk_xor(a, b), *c) : mk_xor(a, b));
+        return;
+      }
+      auto [sum, carry] = c ? full_adder(a, b, *c) : half_adder(a, b);
+      next[i].push_back(sum);
+      next[i + 1].push_back(carry);
+    };
+
+    while (max_height > 2)
+    {
+      std::vector<Bits> next(size);
+      for (size_t i = 0; i < size; ++i)
+      {
+        const Bits& col = cols[i];
+        size_t pos      = 0;
+        if (dadda)
+        {
+          // Compress column to the target height, taking the carries into
+          // account that were already added to this column.
+          size_t target = heights.back();
+          auto height   = [&]() { return next[i].size() + col.size() - pos; };
+          while (height() > target && col.size() - pos >= 2)
+          {
+            if (height() == target + 1 || col.size() - pos == 2)
+            {
+              add(next, i, col[pos], col[pos + 1], nullptr);
+              pos += 2;
+            }
+            else
+            {
+              add(next, i, col[pos], col[pos + 1], &col[pos + 2]);
+              pos += 3;
+            }
+          }
+        }
+        else if (col.size() > 2)
+        {
+          for (; col.size() - pos >= 3; pos += 3)
+          {
+            add(next, i, col[pos], col[pos + 1], &col[pos + 2]);
+          }
+          if (col.size() - pos == 2)
+          {
+            add(next, i, col[pos], col[pos + 1], nullptr);
+            pos += 2;
+          }
+        }
+        next[i].insert(next[i].end(), col.begin() + pos, col.end());
+      }
+      cols = std::move(next);
+
+      max_height = 0;
+      for (const Bits& col : cols)
+      {
+        max_height = std::max(max_height, col.size());
+      }
+      if (dadda && heights.size() > 1)
+      {
+        heights.pop_back();
+      }
+    }
+
+    // Final addition of the remaining two rows.
+    Bits x, y;
+    T false_bit = d_bit_mgr.mk_false();
+    for (size_t i = 0, j = size - 1; i < size; ++i, --j)
+    {
+      const Bits& col = cols[j];
+      x.push_back(col.size() > 0 ? col[0] : false_bit);
+      y.push_back(col.size() > 1 ? col[1] : false_bit);
+    }
+    return add_helper(x, y);
+  }
+
   T ult_helper(const Bits& a, const Bits& b)
   {
     size_t lsb = a.size() - 1;
@@ -560,6 +967,89 @@ class BitblasterInterface
     return mk_xor(d_bit_mgr.mk_and(mk_xor(d, c), q), r);
   }
 
+  /**
+   * Encode division of `a` by value `d`.
+   *
+   * Division by zero and by powers of two are rewirings of the bits of `a`.
+   * Otherwise, the quotient is computed via multiplication with the
+   * reciprocal of `d` [1]: For a dividend with n bits (excluding high bits
+   * of `a` that are known to be zero), l = ceil(log2(d)) and
+   * m = ceil(2^(n + l) / d), which has at most n + 1 bits,
+   * a / d = (a * m) >> (n + l) for all a < 2^n. The remainder is
+   * a - (a / d) * d, of which only the lower l bits are computed since it is
+   * less than d.
+   *
+   * Returns a pair of bits consisting of the quotient and remainder of the
+   * division operation.
+   *
+   * [1] Division by Invariant Integers using Multiplication.
+   *     Torbjorn Granlund, Peter L. Montgomery.
+   */
+  std::pair<Bits, Bits> udiv_urem_value(const Bits& a, const BitVector& d)
+  {
+    size_t size = a.size();
+    T false_bit = d_bit_mgr.mk_false();
+
+    // Division by zero: quotient is all ones, remainder is `a`.
+    if (d.is_zero())
+    {
+      return std::make_pair(bv_value(BitVector::mk_ones(size)), a);
+    }
+
+    // Division by 2^k: quotient is a >> k, remainder is a[k-1:0].
+    if (d.is_power_of_two())
+    {
+      size_t k = d.count_trailing_zeros();
+      Bits rem(size - k, false_bit);
+      rem.insert(rem.end(),
+                 a.end() - static_cast<typename Bits::difference_type>(k),
+                 a.end());
+      return std::make_pair(shift_by_value(a, k, false, false_bit), rem);
+    }
+
+    // Quotient is zero if `a` is known to be less than `d`.
+    BitVector a_max = upper_bound(a);
+    if (a_max.compare(d) < 0)
+    {
+      return std::make_pair(Bits(size, false_bit), a);
+    }
+
+    // Compute the quotient bits via (a * m) >> (n + l), where the product
+    // has at most 2 * n + 1 bits.
+    size_t n        = size - a_max.count_leading_zeros();
+    size_t l        = size - d.count_leading_zeros();
+    size_t mul_size = 2 * n + 1;
+    assert(l <= n);
+    BitVector dd = d.bvextract(n - 1, 0).ibvzext(n + 1);
+    BitVector m  = BitVector::mk_one(mul_size)
+                      .ibvshl(n + l)
+                      .ibvadd(dd)
+                      .ibvdec()
+                      .ibvudiv(dd);
+    Bits a_ext(n + 1, false_bit);
+    Bits a_n = bv_extract(a, n - 1, 0);
+    a_ext.insert(a_ext.end(), a_n.begin(), a_n.end());
+    Bits prod =
+        reduce_columns(booth_partial_products(a_ext, bv_value(m)), true);
+    Bits quot(size - n + l - 1, false_bit);
+    quot.insert(quot.end(), prod.begin(), prod.end() - n - l);
+    assert(quot.size() == size);
+
+    // Compute the lower l bits of the remainder a - quot * d.
+    Bits quot_l = bv_extract(quot, l - 1, 0);
+    Bits d_l    = bv_value(d.bvextract(l - 1, 0));
+    Bits prod_l = reduce_columns(booth_partial_products(quot_l, d_l), true);
+    Bits rem(size, false_bit);
+    Bits a_l = bv_extract(a, l - 1, 0);
+    T carry  = d_bit_mgr.mk_true();
+    for (size_t i = 0, j = l - 1; i < l; ++i, --j)
+    {
+      std::tie(rem[size - l + j], carry) =
+          full_adder(a_l[j], d_bit_mgr.mk_not(prod_l[j]), carry);
+    }
+    return std::make_pair(quot, rem);
+  }
+
   /**
    * Encode shift/subtract divider circuit.
    *
@@ -568,6 +1058,16 @@ class BitblasterInterface
    */
   std::pair<Bits, Bits> udiv_urem_helper(const Bits& a, const Bits& b)
   {
+    // Optimization: Specialized circuits for division by a value.
+    if (is_value(b))
+    {
+      BitVector d = upper_bound(b);
+      if (d.is_zero() || d.is_power_of_two() || d_div_reciprocal)
+      {
+        return udiv_urem_value(a, d);
+      }
+    }
+
     // Prepare divisor for subtraction operation: -d == ~d + 1
     // Note: The divisor is reversed here to have lsb at position 0.
     Bits d;
@@ -10,6 +10,7 @@
 
 #include "bv/bitvector.h"
 
+#include <algorithm>
 #include <bitset>
 #include <cassert>
 #include <iostream>
@@ -173,6 +174,305 @@ mpz_mul_2exp_ull(mpz_t rop, const mpz_t op1, uint64_t op2)
   mpz_mul_2exp(rop, op1, op2);
 }
 
+// Kernels for inline bit-vector values, represented as arrays of 64-bit limbs
+// (least significant limb first). Unless noted otherwise, the result may alias
+// the operands, and results are not normalized to the bit-width.
+
+/** @return The number of limbs required to represent given number of bits. */
+uint64_t
+limbs_size(uint64_t size)
+{
+  return (size + 63) / 64;
+}
+
+/** Clear all bits of the most significant limb that exceed given size. */
+void
+limbs_normalize(uint64_t* r, uint64_t size)
+{
+  uint64_t rem = size % 64;
+  if (rem)
+  {
+    r[limbs_size(size) - 1] &= UINT64_MAX >> (64 - rem);
+  }
+}
+
+/** Set all limbs to the given value. */
+void
+limbs_fill(uint64_t* r, uint64_t n, uint64_t val)
+{
+  std::fill_n(r, n, val);
+}
+
+/** @return True if all limbs are zero. */
+bool
+limbs_is_zero(const uint64_t* a, uint64_t n)
+{
+  for (uint64_t i = 0; i < n; ++i)
+  {
+    if (a[i]) return false;
+  }
+  return true;
+}
+
+/** @return -1, 0, 1 if a is less than, equal to, or greater than b. */
+int32_t
+limbs_cmp(const uint64_t* a, const uint64_t* b, uint64_t n)
+{
+  for (uint64_t i = n; i-- > 0;)
+  {
+    if (a[i] != b[i])
+    {
+      return a[i] < b[i] ? -1 : 1;
+    }
+  }
+  return 0;
+}
+
+/** r = a + b + carry, returns the carry out. */
+uint64_t
+limbs_add(
+    uint64_t* r, const uint64_t* a, const uint64_t* b, uint64_t n, uint64_t c)
+{
+  for (uint64_t i = 0; i < n; ++i)
+  {
+    uint64_t s  = a[i] + c;
+    c           = s < c;
+    uint64_t bi = b[i];
+    r[i]        = s + bi;
+    c += r[i] < bi;
+  }
+  return c;
+}
+
+/** r = a + val, returns the carry out. */
+uint64_t
+limbs_add_ui(uint64_t* r, const uint64_t* a, uint64_t n, uint64_t val)
+{
+  uint64_t c = val;
+  for (uint64_t i = 0; i < n; ++i)
+  {
+    r[i] = a[i] + c;
+    c    = r[i] < c;
+  }
+  return c;
+}
+
+/** r = a - b. */
+void
+limbs_sub(uint64_t* r, const uint64_t* a, const uint64_t* b, uint64_t n)
+{
+  uint64_t borrow = 0;
+  for (uint64_t i = 0; i < n; ++i)
+  {
+    uint64_t ai = a[i], bi = b[i];
+    uint64_t d  = ai - bi;
+    uint64_t b1 = ai < bi;
+    r[i]        = d - borrow;
+    borrow      = b1 | (d < borrow);
+  }
+}
+
+/** r = a - val. */
+void
+limbs_sub_ui(uint64_t* r, const uint64_t* a, uint64_t n, uint64_t val)
+{
+  uint64_t borrow = val;
+  for (uint64_t i = 0; i < n; ++i)
+  {
+    uint64_t ai = a[i];
+    r[i]        = ai - borrow;
+    borrow      = ai < borrow;
+  }
+}
+
+/** r = ~a. */
+void
+limbs_not(uint64_t* r, const uint64_t* a, uint64_t n)
+{
+  for (uint64_t i = 0; i < n; ++i)
+  {
+    r[i] = ~a[i];
+  }
+}
+
+/** @return The low 64 bits of a * b, the high 64 bits are stored in `hi`. */
+uint64_t
+mul_64x64(uint64_t a, uint64_t b, uint64_t* hi)
+{
+#if defined(__SIZEOF_INT128__)
+  // Marked as extension to avoid pedantic warnings for non-ISO type.
+  __extension__ typedef unsigned __int128 uint128_t;
+  uint128_t p = static_cast<uint128_t>(a) * b;
+  *hi         = static_cast<uint64_t>(p >> 64);
+  return static_cast<uint64_t>(p);
+#else
+  uint64_t a_lo = a & UINT32_MAX, a_hi = a >> 32;
+  uint64_t b_lo = b & UINT32_MAX, b_hi = b >> 32;
+  uint64_t ll = a_lo * b_lo, lh = a_lo * b_hi;
+  uint64_t hl = a_hi * b_lo, hh = a_hi * b_hi;
+  uint64_t mid = (ll >> 32) + (lh & UINT32_MAX) + (hl & UINT32_MAX);
+  *hi          = hh + (lh >> 32) + (hl >> 32) + (mid >> 32);
+  return (mid << 32) | (ll & UINT32_MAX);
+#endif
+}
+
+/**
+ * r = a * b, truncated to the `rn` least significant limbs (schoolbook
+ * multiplication, rn <= 2 * n).
+ */
+void
+limbs_mul(uint64_t* r,
+          uint64_t rn,
+          const uint64_t* a,
+          const uint64_t* b,
+          uint64_t n)
+{
+  assert(rn <= 2 * BitVector::s_n_inline_limbs);
+  uint64_t t[2 * BitVector::s_n_inline_limbs] = {};
+  for (uint64_t i = 0; i < n && i < rn; ++i)
+  {
+    uint64_t ai = a[i];
+    if (ai == 0) continue;
+    uint64_t c = 0;
+    for (uint64_t j = 0; j < n && i + j < rn; ++j)
+    {
+      uint64_t hi;
+      uint64_t lo = mul_64x64(ai, b[j], &hi);
+      lo += c;
+      hi += lo < c;
+      t[i + j] += lo;
+      hi += t[i + j] < lo;
+      c = hi;
+    }
+    if (i + n < rn)
+    {
+      t[i + n] = c;
+    }
+  }
+  std::copy_n(t, rn, r);
+}
+
+/** r = a << shift, requires shift < n * 64. */
+void
+limbs_shl(uint64_t* r, const uint64_t* a, uint64_t n, uint64_t shift)
+{
+  assert(shift < n * 64);
+  uint64_t limbs = shift / 64;
+  uint64_t bits  = shift % 64;
+  for (uint64_t i = n; i-- > limbs;)
+  {
+    uint64_t v = a[i - limbs] << bits;
+    if (bits && i > limbs)
+    {
+      v |= a[i - limbs - 1] >> (64 - bits);
+    }
+    r[i] = v;
+  }
+  limbs_fill(r, limbs, 0);
+}
+
+/** r = a >> shift, requires shift < n * 64. */
+void
+limbs_shr(uint64_t* r, const uint64_t* a, uint64_t n, uint64_t shift)
+{
+  assert(shift < n * 64);
+  uint64_t limbs = shift / 64;
+  uint64_t bits  = shift % 64;
+  for (uint64_t i = 0; i + limbs < n; ++i)
+  {
+    uint64_t v = a[i + limbs] >> bits;
+    if (bits && i + limbs + 1 < n)
+    {
+      v |= a[i + limbs + 1] << (64 - bits);
+    }
+    r[i] = v;
+  }
+  limbs_fill(r + n - limbs, limbs, 0);
+}
+
+/** @return The number of leading zeros of a non-zero 64-bit value. */
+uint64_t
+clz_64(uint64_t val)
+{
+  assert(val);
+#if defined(__GNUC__) || defined(__clang__)
+  return static_cast<uint64_t>(__builtin_clzll(val));
+#else
+  uint64_t res = 0;
+  for (uint64_t mask = (uint64_t) 1 << 63; !(val & mask); mask >>= 1) ++res;
+  return res;
+#endif
+}
+
+/** @return The number of trailing zeros of a non-zero 64-bit value. */
+uint64_t
+ctz_64(uint64_t val)
+{
+  assert(val);
+#if defined(__GNUC__) || defined(__clang__)
+  return static_cast<uint64_t>(__builtin_ctzll(val));
+#else
+  uint64_t res = 0;
+  for (; !(val & 1); val >>= 1) ++res;
+  return res;
+#endif
+}
+
+/** Store the value of given limbs in the (initialized) GMP integer `r`. */
+void
+limbs_to_mpz(mpz_t r, const uint64_t* a, uint64_t n)
+{
+  mpz_import(r, n, -1, sizeof(uint64_t), 0, 0, a);
+}
+
+/** Store the value of GMP integer `val` in `n` limbs, val < 2^(n * 64). */
+void
+limbs_from_mpz(uint64_t* r, uint64_t n, const mpz_t val)
+{
+  assert(mpz_sgn(val) >= 0);
+  assert(mpz_sizeinbase(val, 2) <= n * 64);
+  limbs_fill(r, n, 0);
+  mpz_export(r, nullptr, -1, sizeof(uint64_t), 0, 0, val);
+}
+
+/**
+ * q = a / b and r = a % b, b must not be zero. Either `q` or `r` may be
+ * nullptr.
+ */
+void
+limbs_udivrem(uint64_t* q,
+              uint64_t* r,
+              const uint64_t* a,
+              const uint64_t* b,
+              uint64_t n)
+{
+  assert(!limbs_is_zero(b, n));
+  mpz_t ma, mb;
+  mpz_init(ma);
+  mpz_init(mb);
+  limbs_to_mpz(ma, a, n);
+  limbs_to_mpz(mb, b, n);
+  if (q && r)
+  {
+    mpz_fdiv_qr(ma, mb, ma, mb);
+    limbs_from_mpz(q, n, ma);
+    limbs_from_mpz(r, n, mb);
+  }
+  else if (q)
+  {
+    mpz_fdiv_q(ma, ma, mb);
+    limbs_from_mpz(q, n, ma);
+  }
+  else
+  {
+    assert(r);
+    mpz_fdiv_r(ma, ma, mb);
+    limbs_from_mpz(r, n, ma);
+  }
+  mpz_clear(ma);
+  mpz_clear(mb);
+}
+
 }  // namespace
 
 bool
@@ -181,36 +481,23 @@ BitVector::fits_in_size(uint64_t size, const std::string& str, uint32_t base)
   bool is_neg = str[0] == '-';
   bool res;
 
-  mpz_t tmp;
+  mpz_t tmp, bound;
   /* We do not want to normalize to 'size'. */
   mpz_init_set_str(tmp, str.c_str(), base);
+  mpz_init(bound);
 
   if (is_neg)
   {
-    BitVector min = BitVector::mk_min_signed(size);
     mpz_abs(tmp, tmp);
-    if (min.is_gmp())
-    {
-      res = mpz_cmp(tmp, min.d_val_gmp) <= 0;
-    }
-    else
-    {
-      res = mpz_cmp_ui(tmp, min.d_val_uint64) <= 0;
-    }
+    BitVector::mk_min_signed(size).to_mpz(bound);
   }
   else
   {
-    BitVector max = BitVector::mk_ones(size);
-    if (max.is_gmp())
-    {
-      res = mpz_cmp(tmp, max.d_val_gmp) <= 0;
-    }
-    else
-    {
-      res = mpz_cmp_ui(tmp, max.d_val_uint64) <= 0;
-    }
+    BitVector::mk_ones(size).to_mpz(bound);
   }
+  res = mpz_cmp(tmp, bound) <= 0;
   mpz_clear(tmp);
+  mpz_clear(bound);
   return res;
 }
 
@@ -257,12 +544,17 @@ BitVector
 BitVector::mk_ones(uint64_t size)
 {
   BitVector res(size);
-  if (size > s_native_size)
+  if (res.is_gmp())
   {
     mpz_set_ui(res.d_val_gmp, 1);
     mpz_mul_2exp_ull(res.d_val_gmp, res.d_val_gmp, size);
     mpz_sub_ui(res.d_val_gmp, res.d_val_gmp, 1);
   }
+  else if (res.is_inline())
+  {
+    limbs_fill(res.d_val_limbs, limbs_size(size), UINT64_MAX);
+    limbs_normalize(res.d_val_limbs, size);
+  }
   else
   {
     res.d_val_uint64 = uint64_fdiv_r_2exp(size, UINT64_MAX);
@@ -297,9 +589,9 @@ BitVector::bvite(const BitVector& c, const BitVector& t, const BitVector& e)
   return c.is_true() ? t : e;
 }
 
-BitVector::BitVector() : d_size(0), d_val_uint64(0) {}
+BitVector::BitVector() : d_size(0), d_val_limbs() {}
 
-BitVector::BitVector(uint64_t size) : d_size(size), d_val_uint64(0)
+BitVector::BitVector(uint64_t size) : d_size(size), d_val_limbs()
 {
   assert(size > 0);
   if (is_gmp())
@@ -315,6 +607,16 @@ BitVector::BitVector(uint64_t size, RNG& rng) : BitVector(size)
     mpz_urandomb(d_val_gmp, *rng.get_gmp_state(), size);
     mpz_fdiv_r_2exp_ull(d_val_gmp, d_val_gmp, size);
   }
+  else if (is_inline())
+  {
+    // Draw from the GMP random state to pick the same values as for
+    // GMP bit-vectors.
+    mpz_t tmp;
+    mpz_init(tmp);
+    mpz_urandomb(tmp, *rng.get_gmp_state(), size);
+    limbs_from_mpz(d_val_limbs, limbs_size(size), tmp);
+    mpz_clear(tmp);
+  }
   else
   {
     d_val_uint64 = uint64_fdiv_r_2exp(
@@ -393,6 +695,14 @@ BitVector::BitVector(uint64_t size, const std::string& value, uint32_t base)
      * absolute value of 'value') in GMP when created from mpz_init_set_str. */
     mpz_fdiv_r_2exp_ull(d_val_gmp, d_val_gmp, size);
   }
+  else if (is_inline())
+  {
+    mpz_t tmp;
+    mpz_init_set_str(tmp, value.c_str(), base);
+    mpz_fdiv_r_2exp_ull(tmp, tmp, size);
+    limbs_from_mpz(d_val_limbs, limbs_size(size), tmp);
+    mpz_clear(tmp);
+  }
   else
   {
     d_val_uint64 = uint64_fdiv_r_2exp(
@@ -413,6 +723,10 @@ BitVector::from_ui(uint64_t size, uint64_t value, bool truncate)
     mpz_init_set_ull(res.d_val_gmp, value);
     mpz_fdiv_r_2exp_ull(res.d_val_gmp, res.d_val_gmp, size);
   }
+  else if (res.is_inline())
+  {
+    res.d_val_limbs[0] = value;
+  }
   else
   {
     res.d_val_uint64 = uint64_fdiv_r_2exp(size, value);
@@ -433,6 +747,12 @@ BitVector::from_si(uint64_t size, int64_t value, bool truncate)
     mpz_init_set_sll(res.d_val_gmp, value);
     mpz_fdiv_r_2exp_ull(res.d_val_gmp, res.d_val_gmp, size);
   }
+  else if (res.is_inline())
+  {
+    limbs_fill(res.d_val_limbs, limbs_size(size), value < 0 ? UINT64_MAX : 0);
+    res.d_val_limbs[0] = static_cast<uint64_t>(value);
+    limbs_normalize(res.d_val_limbs, size);
+  }
   else
   {
     res.d_val_uint64 = uint64_fdiv_r_2exp(size, static_cast<uint64_t>(value));
@@ -459,7 +779,7 @@ BitVector::BitVector(const BitVector& other)
     }
     else
     {
-      d_val_uint64 = other.d_val_uint64;
+      copy_limbs(other);
     }
   }
 }
@@ -476,7 +796,8 @@ BitVector::BitVector(BitVector&& other)
     else
     {
       mpz_clear(d_val_gmp);
-      d_val_uint64 = std::exchange(other.d_val_uint64, 0);
+      copy_limbs(other);
+      other.d_val_uint64 = 0;
     }
   }
   else
@@ -487,7 +808,8 @@ BitVector::BitVector(BitVector&& other)
     }
     else
     {
-      d_val_uint64 = std::exchange(other.d_val_uint64, 0);
+      copy_limbs(other);
+      other.d_val_uint64 = 0;
     }
   }
   d_size = std::exchange(other.d_size, 0);
@@ -524,7 +846,7 @@ BitVector::operator=(const BitVector& other)
       }
       else
       {
-        d_val_uint64 = other.d_val_uint64;
+        copy_limbs(other);
       }
     }
     else
@@ -532,7 +854,7 @@ BitVector::operator=(const BitVector& other)
       if (!other.is_gmp())
       {
         mpz_clear(d_val_gmp);
-        d_val_uint64 = other.d_val_uint64;
+        copy_limbs(other);
       }
       else
       {
@@ -587,6 +909,33 @@ BitVector::hash() const
       res = ((x >> 16) ^ x);
     }
   }
+  else if (is_inline())
+  {
+    // Hash the same way as GMP values (with 64-bit limbs), disregarding the
+    // most significant zero limbs.
+    n = limbs_size(d_size);
+    while (n > 0 && d_val_limbs[n - 1] == 0) --n;
+    for (i = 0, j = 0; i < n; ++i)
+    {
+      p0 = s_hash_primes[j++];
+      if (j == s_n_primes) j = 0;
+      p1 = s_hash_primes[j++];
+      if (j == s_n_primes) j = 0;
+      uint64_t limb = d_val_limbs[i];
+      x             = limb ^ res;
+      x             = ((x >> 16) ^ x) * p0;
+      x             = ((x >> 16) ^ x) * p1;
+      x             = ((x >> 16) ^ x);
+      p0            = s_hash_primes[j++];
+      if (j == s_n_primes) j = 0;
+      p1 = s_hash_primes[j++];
+      if (j == s_n_primes) j = 0;
+      x   = x ^ (limb >> 32);
+      x   = ((x >> 16) ^ x) * p0;
+      x   = ((x >> 16) ^ x) * p1;
+      res = ((x >> 16) ^ x);
+    }
+  }
   else
   {
     p0 = s_hash_primes[j++];
@@ -612,6 +961,11 @@ BitVector::iset(uint64_t value)
     mpz_set_ull(d_val_gmp, value);
     mpz_fdiv_r_2exp_ull(d_val_gmp, d_val_gmp, d_size);
   }
+  else if (is_inline())
+  {
+    limbs_fill(d_val_limbs, limbs_size(d_size), 0);
+    d_val_limbs[0] = value;
+  }
   else
   {
     d_val_uint64 = uint64_fdiv_r_2exp(d_size, value);
@@ -630,7 +984,7 @@ BitVector::iset(const BitVector& bv)
   }
   else
   {
-    d_val_uint64 = bv.d_val_uint64;
+    copy_limbs(bv);
   }
 }
 
@@ -668,6 +1022,23 @@ BitVector::iset(RNG& rng,
       mpz_add(d_val_gmp, d_val_gmp, from.d_val_gmp);
     }
   }
+  else if (is_inline())
+  {
+    // Draw from the GMP random state to pick the same values as for
+    // GMP bit-vectors.
+    mpz_t _to, _from;
+    mpz_init(_to);
+    mpz_init(_from);
+    to.bvsub(from).to_mpz(_to);
+    mpz_add_ui(_to, _to, 1);
+    from.to_mpz(_from);
+    mpz_urandomm(_to, *rng.get_gmp_state(), _to);
+    mpz_add(_to, _to, _from);
+    mpz_fdiv_r_2exp_ull(_to, _to, d_size);
+    limbs_from_mpz(d_val_limbs, limbs_size(d_size), _to);
+    mpz_clear(_to);
+    mpz_clear(_from);
+  }
   else
   {
     if (is_signed)
@@ -704,10 +1075,22 @@ BitVector::str(uint32_t base) const
 {
   if (is_null()) return "(nil)";
 
-  if (is_gmp())
+  if (is_gmp() || is_inline())
   {
     std::stringstream res;
-    char* tmp = mpz_get_str(0, base, d_val_gmp);
+    char* tmp;
+    if (is_inline())
+    {
+      mpz_t val;
+      mpz_init(val);
+      to_mpz(val);
+      tmp = mpz_get_str(0, base, val);
+      mpz_clear(val);
+    }
+    else
+    {
+      tmp = mpz_get_str(0, base, d_val_gmp);
+    }
     assert(tmp[0] != '-');  // may not be negative
     if (base == 2)
     {
@@ -747,6 +1130,11 @@ BitVector::to_uint64(bool truncate) const
   {
     return mpz_get_ull(d_val_gmp);
   }
+  if (is_inline())
+  {
+    assert(truncate || limbs_is_zero(d_val_limbs + 1, limbs_size(d_size) - 1));
+    return d_val_limbs[0];
+  }
   return d_val_uint64;
 }
 
@@ -765,6 +1153,10 @@ BitVector::compare(const BitVector& bv) const
   {
     return mpz_cmp(d_val_gmp, bv.d_val_gmp);
   }
+  if (is_inline())
+  {
+    return limbs_cmp(d_val_limbs, bv.d_val_limbs, limbs_size(d_size));
+  }
 
   if (d_val_uint64 == bv.d_val_uint64)
   {
@@ -811,6 +1203,10 @@ BitVector::bit(uint64_t idx) const
   {
     return mpz_tstbit(d_val_gmp, idx);
   }
+  if (is_inline())
+  {
+    return (d_val_limbs[idx / 64] >> (idx % 64)) & 1;
+  }
   return (d_val_uint64 >> idx) & 1;
 }
 
@@ -830,6 +1226,17 @@ BitVector::set_bit(uint64_t idx, bool value)
       mpz_clrbit(d_val_gmp, idx);
     }
   }
+  else if (is_inline())
+  {
+    if (value)
+    {
+      d_val_limbs[idx / 64] |= ((uint64_t) 1 << (idx % 64));
+    }
+    else
+    {
+      d_val_limbs[idx / 64] &= ~((uint64_t) 1 << (idx % 64));
+    }
+  }
   else
   {
     if (value)
@@ -851,6 +1258,11 @@ BitVector::flip_bit(uint64_t idx)
   {
     mpz_combit(d_val_gmp, idx);
   }
+  else if (is_inline())
+  {
+    assert(idx < d_size);
+    d_val_limbs[idx / 64] ^= ((uint64_t) 1 << (idx % 64));
+  }
   else
   {
     set_bit(idx, bit(idx) ? false : true);
@@ -895,6 +1307,10 @@ BitVector::is_zero() const
   {
     return mpz_cmp_ui(d_val_gmp, 0) == 0;
   }
+  if (is_inline())
+  {
+    return limbs_is_zero(d_val_limbs, limbs_size(d_size));
+  }
   return d_val_uint64 == 0;
 }
 
@@ -925,6 +1341,15 @@ BitVector::is_ones() const
         - d_size % static_cast<uint64_t>(mp_bits_per_limb);
     return (static_cast<uint64_t>(limb)) == (max >> m);
   }
+  if (is_inline())
+  {
+    uint64_t n = limbs_size(d_size);
+    for (uint64_t i = 0; i < n - 1; ++i)
+    {
+      if (d_val_limbs[i] != UINT64_MAX) return false;
+    }
+    return d_val_limbs[n - 1] == (UINT64_MAX >> (n * 64 - d_size));
+  }
   return d_val_uint64 == uint64_fdiv_r_2exp(d_size, UINT64_MAX);
 }
 
@@ -936,6 +1361,11 @@ BitVector::is_one() const
   {
     return mpz_cmp_ui(d_val_gmp, 1) == 0;
   }
+  if (is_inline())
+  {
+    return d_val_limbs[0] == 1
+           && limbs_is_zero(d_val_limbs + 1, limbs_size(d_size) - 1);
+  }
   return d_val_uint64 == 1;
 }
 
@@ -947,6 +1377,15 @@ BitVector::is_min_signed() const
   {
     if (mpz_scan1(d_val_gmp, 0) != d_size - 1) return false;
   }
+  else if (is_inline())
+  {
+    uint64_t n = limbs_size(d_size);
+    if (d_val_limbs[n - 1] != ((uint64_t) 1 << ((d_size - 1) % 64))
+        || !limbs_is_zero(d_val_limbs, n - 1))
+    {
+      return false;
+    }
+  }
   else
   {
     if (d_val_uint64
@@ -966,6 +1405,18 @@ BitVector::is_max_signed() const
   {
     if (mpz_scan0(d_val_gmp, 0) != d_size - 1) return false;
   }
+  else if (is_inline())
+  {
+    uint64_t n = limbs_size(d_size);
+    for (uint64_t i = 0; i < n - 1; ++i)
+    {
+      if (d_val_limbs[i] != UINT64_MAX) return false;
+    }
+    if (d_val_limbs[n - 1] != ((uint64_t) 1 << ((d_size - 1) % 64)) - 1)
+    {
+      return false;
+    }
+  }
   else
   {
     if (d_size == 1 && d_val_uint64 == 0) return true;
@@ -989,6 +1440,13 @@ BitVector::is_uadd_overflow(const BitVector& bv) const
 {
   assert(!is_null());
   assert(d_size == bv.d_size);
+  if (is_inline())
+  {
+    uint64_t n = limbs_size(d_size);
+    uint64_t add[s_n_inline_limbs];
+    if (limbs_add(add, d_val_limbs, bv.d_val_limbs, n, 0)) return true;
+    return d_size % 64 && (add[n - 1] >> (d_size % 64)) != 0;
+  }
   mpz_t add;
   if (is_gmp())
   {
@@ -1011,6 +1469,14 @@ BitVector::is_umul_overflow(const BitVector& bv) const
 {
   assert(!is_null());
   assert(d_size == bv.d_size);
+  if (is_inline())
+  {
+    uint64_t n = limbs_size(d_size);
+    uint64_t mul[2 * s_n_inline_limbs];
+    limbs_mul(mul, 2 * n, d_val_limbs, bv.d_val_limbs, n);
+    if (d_size % 64 && (mul[n - 1] >> (d_size % 64)) != 0) return true;
+    return !limbs_is_zero(mul + n, n);
+  }
   if (d_size > 1)
   {
     mpz_t mul;
@@ -1042,6 +1508,12 @@ BitVector::count_trailing_zeros() const
     res = mpz_scan1(d_val_gmp, 0);
     if (res > d_size) res = d_size;
   }
+  else if (is_inline())
+  {
+    uint64_t i = 0, n = limbs_size(d_size);
+    for (; i < n && d_val_limbs[i] == 0; ++i) res += 64;
+    res = i < n ? res + ctz_64(d_val_limbs[i]) : d_size;
+  }
   else
   {
     for (uint64_t i = 0; i < d_size; ++i)
@@ -1333,6 +1805,11 @@ BitVector::ibvneg(const BitVector& bv)
     mpz_add_ui(d_val_gmp, d_val_gmp, 1);
     mpz_fdiv_r_2exp_ull(d_val_gmp, d_val_gmp, d_size);
   }
+  else if (is_inline())
+  {
+    limbs_add_ui(d_val_limbs, d_val_limbs, limbs_size(d_size), 1);
+    limbs_normalize(d_val_limbs, d_size);
+  }
   else
   {
     d_val_uint64 += 1;
@@ -1363,7 +1840,15 @@ BitVector::ibvnot(const BitVector& bv)
     {
       mpz_clear(d_val_gmp);
     }
-    d_val_uint64 = uint64_fdiv_r_2exp(size, ~bv.d_val_uint64);
+    if (bv.is_inline())
+    {
+      limbs_not(d_val_limbs, bv.d_val_limbs, limbs_size(size));
+      limbs_normalize(d_val_limbs, size);
+    }
+    else
+    {
+      d_val_uint64 = uint64_fdiv_r_2exp(size, ~bv.d_val_uint64);
+    }
   }
   d_size = size;
   return *this;
@@ -1391,7 +1876,15 @@ BitVector::ibvinc(const BitVector& bv)
     {
       mpz_clear(d_val_gmp);
     }
-    d_val_uint64 = uint64_fdiv_r_2exp(size, bv.d_val_uint64 + 1);
+    if (bv.is_inline())
+    {
+      limbs_add_ui(d_val_limbs, bv.d_val_limbs, limbs_size(size), 1);
+      limbs_normalize(d_val_limbs, size);
+    }
+    else
+    {
+      d_val_uint64 = uint64_fdiv_r_2exp(size, bv.d_val_uint64 + 1);
+    }
   }
   d_size = size;
   return *this;
@@ -1419,7 +1912,15 @@ BitVector::ibvdec(const BitVector& bv)
     {
       mpz_clear(d_val_gmp);
     }
-    d_val_uint64 = uint64_fdiv_r_2exp(size, bv.d_val_uint64 - 1);
+    if (bv.is_inline())
+    {
+      limbs_sub_ui(d_val_limbs, bv.d_val_limbs, limbs_size(size), 1);
+      limbs_normalize(d_val_limbs, size);
+    }
+    else
+    {
+      d_val_uint64 = uint64_fdiv_r_2exp(size, bv.d_val_uint64 - 1);
+    }
   }
   d_size = size;
   return *this;
@@ -1458,6 +1959,10 @@ BitVector::ibvredor(const BitVector& bv)
       }
     }
   }
+  else if (bv.is_inline())
+  {
+    val = !limbs_is_zero(bv.d_val_limbs, limbs_size(bv.d_size));
+  }
   else if (bv.d_val_uint64 != 0)
   {
     val = 1;
@@ -1492,8 +1997,17 @@ BitVector::ibvadd(const BitVector& bv0, const BitVector& bv1)
     {
       mpz_clear(d_val_gmp);
     }
-    d_val_uint64 =
-        uint64_fdiv_r_2exp(size, bv0.d_val_uint64 + bv1.d_val_uint64);
+    if (bv0.is_inline())
+    {
+      limbs_add(
+          d_val_limbs, bv0.d_val_limbs, bv1.d_val_limbs, limbs_size(size), 0);
+      limbs_normalize(d_val_limbs, size);
+    }
+    else
+    {
+      d_val_uint64 =
+          uint64_fdiv_r_2exp(size, bv0.d_val_uint64 + bv1.d_val_uint64);
+    }
   }
   d_size = size;
   return *this;
@@ -1523,8 +2037,17 @@ BitVector::ibvsub(const BitVector& bv0, const BitVector& bv1)
     {
       mpz_clear(d_val_gmp);
     }
-    d_val_uint64 =
-        uint64_fdiv_r_2exp(size, bv0.d_val_uint64 - bv1.d_val_uint64);
+    if (bv0.is_inline())
+    {
+      limbs_sub(
+          d_val_limbs, bv0.d_val_limbs, bv1.d_val_limbs, limbs_size(size));
+      limbs_normalize(d_val_limbs, size);
+    }
+    else
+    {
+      d_val_uint64 =
+          uint64_fdiv_r_2exp(size, bv0.d_val_uint64 - bv1.d_val_uint64);
+    }
   }
   d_size = size;
   return *this;
@@ -1554,13 +2077,23 @@ BitVector::ibvand(const BitVector& bv0, const BitVector& bv1)
     {
       mpz_clear(d_val_gmp);
     }
-    d_val_uint64 =
-        uint64_fdiv_r_2exp(size, bv0.d_val_uint64 & bv1.d_val_uint64);
-  }
-  d_size = size;
-  return *this;
-}
-
+    if (bv0.is_inline())
+    {
+      for (uint64_t i = 0, n = limbs_size(size); i < n; ++i)
+      {
+        d_val_limbs[i] = bv0.d_val_limbs[i] & bv1.d_val_limbs[i];
+      }
+    }
+    else
+    {
+      d_val_uint64 =
+          uint64_fdiv_r_2exp(size, bv0.d_val_uint64 & bv1.d_val_uint64);
+    }
+  }
+  d_size = size;
+  return *this;
+}
+
 BitVector&
 BitVector::ibvimplies(const BitVector& bv0, const BitVector& bv1)
 {
@@ -1604,8 +2137,19 @@ BitVector::ibvnand(const BitVector& bv0, const BitVector& bv1)
     {
       mpz_clear(d_val_gmp);
     }
-    d_val_uint64 =
-        uint64_fdiv_r_2exp(size, ~(bv0.d_val_uint64 & bv1.d_val_uint64));
+    if (bv0.is_inline())
+    {
+      for (uint64_t i = 0, n = limbs_size(size); i < n; ++i)
+      {
+        d_val_limbs[i] = ~(bv0.d_val_limbs[i] & bv1.d_val_limbs[i]);
+      }
+      limbs_normalize(d_val_limbs, size);
+    }
+    else
+    {
+      d_val_uint64 =
+          uint64_fdiv_r_2exp(size, ~(bv0.d_val_uint64 & bv1.d_val_uint64));
+    }
   }
   d_size = size;
   return *this;
@@ -1636,8 +2180,19 @@ BitVector::ibvnor(const BitVector& bv0, const BitVector& bv1)
     {
       mpz_clear(d_val_gmp);
     }
-    d_val_uint64 =
-        uint64_fdiv_r_2exp(size, ~(bv0.d_val_uint64 | bv1.d_val_uint64));
+    if (bv0.is_inline())
+    {
+      for (uint64_t i = 0, n = limbs_size(size); i < n; ++i)
+      {
+        d_val_limbs[i] = ~(bv0.d_val_limbs[i] | bv1.d_val_limbs[i]);
+      }
+      limbs_normalize(d_val_limbs, size);
+    }
+    else
+    {
+      d_val_uint64 =
+          uint64_fdiv_r_2exp(size, ~(bv0.d_val_uint64 | bv1.d_val_uint64));
+    }
   }
   d_size = size;
   return *this;
@@ -1667,8 +2222,18 @@ BitVector::ibvor(const BitVector& bv0, const BitVector& bv1)
     {
       mpz_clear(d_val_gmp);
     }
-    d_val_uint64 =
-        uint64_fdiv_r_2exp(size, bv0.d_val_uint64 | bv1.d_val_uint64);
+    if (bv0.is_inline())
+    {
+      for (uint64_t i = 0, n = limbs_size(size); i < n; ++i)
+      {
+        d_val_limbs[i] = bv0.d_val_limbs[i] | bv1.d_val_limbs[i];
+      }
+    }
+    else
+    {
+      d_val_uint64 =
+          uint64_fdiv_r_2exp(size, bv0.d_val_uint64 | bv1.d_val_uint64);
+    }
   }
   d_size = size;
   return *this;
@@ -1699,8 +2264,19 @@ BitVector::ibvxnor(const BitVector& bv0, const BitVector& bv1)
     {
       mpz_clear(d_val_gmp);
     }
-    d_val_uint64 =
-        uint64_fdiv_r_2exp(size, ~(bv0.d_val_uint64 ^ bv1.d_val_uint64));
+    if (bv0.is_inline())
+    {
+      for (uint64_t i = 0, n = limbs_size(size); i < n; ++i)
+      {
+        d_val_limbs[i] = ~(bv0.d_val_limbs[i] ^ bv1.d_val_limbs[i]);
+      }
+      limbs_normalize(d_val_limbs, size);
+    }
+    else
+    {
+      d_val_uint64 =
+          uint64_fdiv_r_2exp(size, ~(bv0.d_val_uint64 ^ bv1.d_val_uint64));
+    }
   }
   d_size = size;
   return *this;
@@ -1730,8 +2306,18 @@ BitVector::ibvxor(const BitVector& bv0, const BitVector& bv1)
     {
       mpz_clear(d_val_gmp);
     }
-    d_val_uint64 =
-        uint64_fdiv_r_2exp(size, bv0.d_val_uint64 ^ bv1.d_val_uint64);
+    if (bv0.is_inline())
+    {
+      for (uint64_t i = 0, n = limbs_size(size); i < n; ++i)
+      {
+        d_val_limbs[i] = bv0.d_val_limbs[i] ^ bv1.d_val_limbs[i];
+      }
+    }
+    else
+    {
+      d_val_uint64 =
+          uint64_fdiv_r_2exp(size, bv0.d_val_uint64 ^ bv1.d_val_uint64);
+    }
   }
   d_size = size;
   return *this;
@@ -1751,6 +2337,14 @@ BitVector::ibveq(const BitVector& bv0, const BitVector& bv1)
       val = 1;
     }
   }
+  else if (bv0.is_inline())
+  {
+    if (limbs_cmp(bv0.d_val_limbs, bv1.d_val_limbs, limbs_size(bv0.d_size))
+        == 0)
+    {
+      val = 1;
+    }
+  }
   else if (bv0.d_val_uint64 == bv1.d_val_uint64)
   {
     val = 1;
@@ -1775,6 +2369,14 @@ BitVector::ibvne(const BitVector& bv0, const BitVector& bv1)
       val = 1;
     }
   }
+  else if (bv0.is_inline())
+  {
+    if (limbs_cmp(bv0.d_val_limbs, bv1.d_val_limbs, limbs_size(bv0.d_size))
+        != 0)
+    {
+      val = 1;
+    }
+  }
   else if (bv0.d_val_uint64 != bv1.d_val_uint64)
   {
     val = 1;
@@ -1799,6 +2401,14 @@ BitVector::ibvult(const BitVector& bv0, const BitVector& bv1)
       val = 1;
     }
   }
+  else if (bv0.is_inline())
+  {
+    if (limbs_cmp(bv0.d_val_limbs, bv1.d_val_limbs, limbs_size(bv0.d_size))
+        < 0)
+    {
+      val = 1;
+    }
+  }
   else if (bv0.d_val_uint64 < bv1.d_val_uint64)
   {
     val = 1;
@@ -1823,6 +2433,14 @@ BitVector::ibvule(const BitVector& bv0, const BitVector& bv1)
       val = 1;
     }
   }
+  else if (bv0.is_inline())
+  {
+    if (limbs_cmp(bv0.d_val_limbs, bv1.d_val_limbs, limbs_size(bv0.d_size))
+        <= 0)
+    {
+      val = 1;
+    }
+  }
   else if (bv0.d_val_uint64 <= bv1.d_val_uint64)
   {
     val = 1;
@@ -1847,6 +2465,14 @@ BitVector::ibvugt(const BitVector& bv0, const BitVector& bv1)
       val = 1;
     }
   }
+  else if (bv0.is_inline())
+  {
+    if (limbs_cmp(bv0.d_val_limbs, bv1.d_val_limbs, limbs_size(bv0.d_size))
+        > 0)
+    {
+      val = 1;
+    }
+  }
   else if (bv0.d_val_uint64 > bv1.d_val_uint64)
   {
     val = 1;
@@ -1871,6 +2497,14 @@ BitVector::ibvuge(const BitVector& bv0, const BitVector& bv1)
       val = 1;
     }
   }
+  else if (bv0.is_inline())
+  {
+    if (limbs_cmp(bv0.d_val_limbs, bv1.d_val_limbs, limbs_size(bv0.d_size))
+        >= 0)
+    {
+      val = 1;
+    }
+  }
   else if (bv0.d_val_uint64 >= bv1.d_val_uint64)
   {
     val = 1;
@@ -2018,7 +2652,20 @@ BitVector::ibvshl(const BitVector& bv, uint64_t shift)
     {
       mpz_clear(d_val_gmp);
     }
-    if (shift >= size)
+    if (bv.is_inline())
+    {
+      uint64_t n = limbs_size(size);
+      if (shift >= size)
+      {
+        limbs_fill(d_val_limbs, n, 0);
+      }
+      else
+      {
+        limbs_shl(d_val_limbs, bv.d_val_limbs, n, shift);
+        limbs_normalize(d_val_limbs, size);
+      }
+    }
+    else if (shift >= size)
     {
       d_val_uint64 = 0;
     }
@@ -2061,7 +2708,14 @@ BitVector::ibvshl(const BitVector& bv, const BitVector& shift)
       {
         mpz_clear(d_val_gmp);
       }
-      d_val_uint64 = 0;
+      if (bv.is_inline())
+      {
+        limbs_fill(d_val_limbs, limbs_size(size), 0);
+      }
+      else
+      {
+        d_val_uint64 = 0;
+      }
     }
   }
   d_size = size;
@@ -2096,7 +2750,20 @@ BitVector::ibvshr(const BitVector& bv, uint64_t shift)
     {
       mpz_clear(d_val_gmp);
     }
-    if (shift >= size)
+    if (bv.is_inline())
+    {
+      uint64_t n = limbs_size(size);
+      if (shift >= size)
+      {
+        limbs_fill(d_val_limbs, n, 0);
+      }
+      else
+      {
+        limbs_shr(d_val_limbs, bv.d_val_limbs, n, shift);
+        limbs_normalize(d_val_limbs, size);
+      }
+    }
+    else if (shift >= size)
     {
       d_val_uint64 = 0;
     }
@@ -2139,7 +2806,14 @@ BitVector::ibvshr(const BitVector& bv, const BitVector& shift)
       {
         mpz_clear(d_val_gmp);
       }
-      d_val_uint64 = 0;
+      if (bv.is_inline())
+      {
+        limbs_fill(d_val_limbs, limbs_size(size), 0);
+      }
+      else
+      {
+        d_val_uint64 = 0;
+      }
     }
   }
   d_size = size;
@@ -2213,8 +2887,17 @@ BitVector::ibvmul(const BitVector& bv0, const BitVector& bv1)
     {
       mpz_clear(d_val_gmp);
     }
-    d_val_uint64 =
-        uint64_fdiv_r_2exp(size, bv0.d_val_uint64 * bv1.d_val_uint64);
+    if (bv0.is_inline())
+    {
+      uint64_t n = limbs_size(size);
+      limbs_mul(d_val_limbs, n, bv0.d_val_limbs, bv1.d_val_limbs, n);
+      limbs_normalize(d_val_limbs, size);
+    }
+    else
+    {
+      d_val_uint64 =
+          uint64_fdiv_r_2exp(size, bv0.d_val_uint64 * bv1.d_val_uint64);
+    }
   }
   d_size = size;
   return *this;
@@ -2253,7 +2936,21 @@ BitVector::ibvudiv(const BitVector& bv0, const BitVector& bv1)
     {
       mpz_clear(d_val_gmp);
     }
-    if (bv1.is_zero())
+    if (bv0.is_inline())
+    {
+      uint64_t n = limbs_size(size);
+      if (bv1.is_zero())
+      {
+        limbs_fill(d_val_limbs, n, UINT64_MAX);
+        limbs_normalize(d_val_limbs, size);
+      }
+      else
+      {
+        limbs_udivrem(
+            d_val_limbs, nullptr, bv0.d_val_limbs, bv1.d_val_limbs, n);
+      }
+    }
+    else if (bv1.is_zero())
     {
       d_val_uint64 = uint64_fdiv_r_2exp(size, UINT64_MAX);
     }
@@ -2297,7 +2994,22 @@ BitVector::ibvurem(const BitVector& bv0, const BitVector& bv1)
     {
       mpz_clear(d_val_gmp);
     }
-    if (!bv1.is_zero())
+    if (bv0.is_inline())
+    {
+      if (!bv1.is_zero())
+      {
+        limbs_udivrem(nullptr,
+                      d_val_limbs,
+                      bv0.d_val_limbs,
+                      bv1.d_val_limbs,
+                      limbs_size(size));
+      }
+      else
+      {
+        copy_limbs(bv0);
+      }
+    }
+    else if (!bv1.is_zero())
     {
       d_val_uint64 =
           uint64_fdiv_r_2exp(size, bv0.d_val_uint64 % bv1.d_val_uint64);
@@ -2434,20 +3146,13 @@ BitVector::ibvconcat(const BitVector& bv0, const BitVector& bv1)
     b1 = &bv1;
   }
 
-  if (size > s_native_size)
+  if (size > s_max_inline_size)
   {
     if (!is_gmp())
     {
       mpz_init(d_val_gmp);
     }
-    if (b0->is_gmp())
-    {
-      mpz_set(d_val_gmp, b0->d_val_gmp);
-    }
-    else
-    {
-      mpz_set_ui(d_val_gmp, b0->d_val_uint64);
-    }
+    b0->to_mpz(d_val_gmp);
     mpz_mul_2exp_ull(d_val_gmp, d_val_gmp, b1->d_size);
     if (b1->is_gmp())
     {
@@ -2455,9 +3160,12 @@ BitVector::ibvconcat(const BitVector& bv0, const BitVector& bv1)
     }
     else
     {
-      mpz_add_ui(d_val_gmp, d_val_gmp, b1->d_val_uint64);
+      mpz_t tmp;
+      mpz_init(tmp);
+      b1->to_mpz(tmp);
+      mpz_add(d_val_gmp, d_val_gmp, tmp);
+      mpz_clear(tmp);
     }
-    mpz_fdiv_r_2exp_ull(d_val_gmp, d_val_gmp, size);
   }
   else
   {
@@ -2465,8 +3173,23 @@ BitVector::ibvconcat(const BitVector& bv0, const BitVector& bv1)
     {
       mpz_clear(d_val_gmp);
     }
-    d_val_uint64 = b0->d_val_uint64 << b1->d_size;
-    d_val_uint64 = uint64_fdiv_r_2exp(size, d_val_uint64 + b1->d_val_uint64);
+    if (size > s_native_size)
+    {
+      uint64_t n = limbs_size(size);
+      limbs_fill(d_val_limbs, n, 0);
+      std::copy_n(b0->d_val_limbs, limbs_size(b0->d_size), d_val_limbs);
+      limbs_shl(d_val_limbs, d_val_limbs, n, b1->d_size);
+      for (uint64_t i = 0, n1 = limbs_size(b1->d_size); i < n1; ++i)
+      {
+        d_val_limbs[i] |= b1->d_val_limbs[i];
+      }
+    }
+    else
+    {
+      d_val_uint64 = b0->d_val_uint64 << b1->d_size;
+      d_val_uint64 =
+          uint64_fdiv_r_2exp(size, d_val_uint64 + b1->d_val_uint64);
+    }
   }
   d_size = size;
   return *this;
@@ -2480,57 +3203,53 @@ BitVector::ibvextract(const BitVector& bv, uint64_t idx_hi, uint64_t idx_lo)
   assert(idx_hi < bv.size());
   uint64_t size = idx_hi - idx_lo + 1;
 
-  if (is_gmp())
-  {
-    if (bv.is_gmp())
-    {
-      mpz_set(d_val_gmp, bv.d_val_gmp);
-    }
-    else
-    {
-      mpz_set_ui(d_val_gmp, bv.d_val_uint64);
-    }
-    mpz_fdiv_r_2exp_ull(d_val_gmp, d_val_gmp, idx_hi + 1);
-    mpz_fdiv_q_2exp_ull(d_val_gmp, d_val_gmp, idx_lo);
-    if (size <= s_native_size)
-    {
-      uint64_t val = mpz_get_ui(d_val_gmp);
-      mpz_clear(d_val_gmp);
-      d_val_uint64 = val;
-    }
-  }
-  else
+  if (bv.is_gmp())
   {
-    if (size > s_native_size)
+    if (size > s_max_inline_size)
     {
-      mpz_init(d_val_gmp);
-      if (bv.is_gmp())
-      {
-        mpz_set(d_val_gmp, bv.d_val_gmp);
-      }
-      else
+      if (!is_gmp())
       {
-        mpz_set_ui(d_val_gmp, bv.d_val_uint64);
+        mpz_init(d_val_gmp);
       }
-      mpz_fdiv_r_2exp_ull(d_val_gmp, d_val_gmp, idx_hi + 1);
+      mpz_fdiv_r_2exp_ull(d_val_gmp, bv.d_val_gmp, idx_hi + 1);
       mpz_fdiv_q_2exp_ull(d_val_gmp, d_val_gmp, idx_lo);
     }
     else
     {
-      if (bv.is_gmp())
+      mpz_t tmp;
+      mpz_init(tmp);
+      mpz_fdiv_r_2exp_ull(tmp, bv.d_val_gmp, idx_hi + 1);
+      mpz_fdiv_q_2exp_ull(tmp, tmp, idx_lo);
+      if (is_gmp())
       {
-        mpz_t tmp;
-        mpz_init_set(tmp, bv.d_val_gmp);
-        mpz_fdiv_r_2exp_ull(tmp, tmp, idx_hi + 1);
-        mpz_fdiv_q_2exp_ull(tmp, tmp, idx_lo);
-        d_val_uint64 = mpz_get_ui(tmp);
-        mpz_clear(tmp);
+        mpz_clear(d_val_gmp);
+      }
+      if (size > s_native_size)
+      {
+        limbs_from_mpz(d_val_limbs, limbs_size(size), tmp);
       }
       else
       {
-        d_val_uint64 = uint64_fdiv_r_2exp(idx_hi + 1, bv.d_val_uint64);
-        d_val_uint64 >>= idx_lo;
+        d_val_uint64 = mpz_get_ull(tmp);
       }
+      mpz_clear(tmp);
+    }
+  }
+  else
+  {
+    if (is_gmp())
+    {
+      mpz_clear(d_val_gmp);
+    }
+    if (bv.is_inline())
+    {
+      limbs_shr(d_val_limbs, bv.d_val_limbs, limbs_size(bv.d_size), idx_lo);
+      limbs_normalize(d_val_limbs, size);
+    }
+    else
+    {
+      d_val_uint64 = uint64_fdiv_r_2exp(idx_hi + 1, bv.d_val_uint64);
+      d_val_uint64 >>= idx_lo;
     }
   }
   d_size = size;
@@ -2546,48 +3265,44 @@ BitVector::ibvzext(const BitVector& bv, uint64_t n)
 
   uint64_t size = bv.d_size + n;
 
-  if (is_gmp())
+  if (size > s_max_inline_size)
   {
     if (bv.is_gmp())
     {
-      mpz_set(d_val_gmp, bv.d_val_gmp);
+      if (&bv != this)
+      {
+        if (!is_gmp())
+        {
+          mpz_init(d_val_gmp);
+        }
+        mpz_set(d_val_gmp, bv.d_val_gmp);
+      }
     }
     else
     {
-      mpz_set_ui(d_val_gmp, bv.d_val_uint64);
-    }
-    if (size <= s_native_size)
-    {
-      uint64_t val = mpz_get_ui(d_val_gmp);
-      mpz_clear(d_val_gmp);
-      d_val_uint64 = val;
+      /* convert first to guard for bv == *this */
+      mpz_t tmp;
+      mpz_init(tmp);
+      bv.to_mpz(tmp);
+      if (!is_gmp())
+      {
+        mpz_init(d_val_gmp);
+      }
+      mpz_swap(d_val_gmp, tmp);
+      mpz_clear(tmp);
     }
   }
   else
   {
+    if (is_gmp())
+    {
+      mpz_clear(d_val_gmp);
+    }
     if (size > s_native_size)
     {
-      /* copy to guard for bv == *this */
-      const BitVector* b;
-      BitVector bb;
-      if (&bv == this)
-      {
-        bb = bv;
-        b  = &bb;
-      }
-      else
-      {
-        b = &bv;
-      }
-      mpz_init(d_val_gmp);
-      if (b->is_gmp())
-      {
-        mpz_set(d_val_gmp, b->d_val_gmp);
-      }
-      else
-      {
-        mpz_set_ui(d_val_gmp, b->d_val_uint64);
-      }
+      copy_limbs(bv);
+      uint64_t nbv = limbs_size(bv.d_size);
+      limbs_fill(d_val_limbs + nbv, limbs_size(size) - nbv, 0);
     }
     else
     {
@@ -2605,103 +3320,39 @@ BitVector::ibvsext(const BitVector& bv, uint64_t n)
 
   if (n > 0)
   {
-    /* copy to guard for bv == *this */
-    const BitVector* b;
-    BitVector bb;
-    if (&bv == this)
-    {
-      bb = bv;
-      b  = &bb;
-    }
-    else
-    {
-      b = &bv;
-    }
-    if (b->msb())
+    bool is_neg     = bv.msb();
+    uint64_t b_size = bv.d_size;
+    ibvzext(bv, n);
+    if (is_neg)
     {
-      uint64_t b_size = b->d_size;
-      uint64_t size   = b_size + n;
+      /* set the n most significant bits to one */
       if (is_gmp())
       {
-        mpz_set_ui(d_val_gmp, 1);
-        mpz_mul_2exp_ull(d_val_gmp, d_val_gmp, n);
-        mpz_sub_ui(d_val_gmp, d_val_gmp, 1);
-        mpz_mul_2exp_ull(d_val_gmp, d_val_gmp, b_size);
-        if (b->is_gmp())
-        {
-          mpz_add(d_val_gmp, d_val_gmp, b->d_val_gmp);
-        }
-        else
-        {
-          mpz_add_ui(d_val_gmp, d_val_gmp, b->d_val_uint64);
-        }
-        mpz_fdiv_r_2exp_ull(d_val_gmp, d_val_gmp, size);
-        if (size <= s_native_size)
-        {
-          uint64_t val = mpz_get_ui(d_val_gmp);
-          mpz_clear(d_val_gmp);
-          d_val_uint64 = val;
-        }
+        mpz_t ones;
+        mpz_init_set_ui(ones, 1);
+        mpz_mul_2exp_ull(ones, ones, n);
+        mpz_sub_ui(ones, ones, 1);
+        mpz_mul_2exp_ull(ones, ones, b_size);
+        mpz_ior(d_val_gmp, d_val_gmp, ones);
+        mpz_clear(ones);
+      }
+      else if (is_inline())
+      {
+        uint64_t i = b_size / 64;
+        d_val_limbs[i] |= UINT64_MAX << (b_size % 64);
+        limbs_fill(d_val_limbs + i + 1, limbs_size(d_size) - i - 1, UINT64_MAX);
+        limbs_normalize(d_val_limbs, d_size);
       }
       else
       {
-        if (size > s_native_size)
-        {
-          mpz_init_set_ui(d_val_gmp, 1);
-          mpz_mul_2exp_ull(d_val_gmp, d_val_gmp, n);
-          mpz_sub_ui(d_val_gmp, d_val_gmp, 1);
-          mpz_mul_2exp_ull(d_val_gmp, d_val_gmp, b_size);
-          if (b->is_gmp())
-          {
-            mpz_add(d_val_gmp, d_val_gmp, b->d_val_gmp);
-          }
-          else
-          {
-            mpz_add_ui(d_val_gmp, d_val_gmp, b->d_val_uint64);
-          }
-          mpz_fdiv_r_2exp_ull(d_val_gmp, d_val_gmp, size);
-        }
-        else
-        {
-          d_val_uint64 = UINT64_MAX << b_size;
-          d_val_uint64 =
-              uint64_fdiv_r_2exp(size, d_val_uint64 + b->d_val_uint64);
-        }
+        d_val_uint64 =
+            uint64_fdiv_r_2exp(d_size, d_val_uint64 | (UINT64_MAX << b_size));
       }
-      d_size = size;
-    }
-    else
-    {
-      ibvzext(bv, n);
     }
   }
   else if (&bv != this)
   {
-    if (is_gmp())
-    {
-      if (bv.is_gmp())
-      {
-        mpz_set(d_val_gmp, bv.d_val_gmp);
-      }
-      else
-      {
-        mpz_clear(d_val_gmp);
-        d_val_uint64 = bv.d_val_uint64;
-      }
-    }
-    else
-    {
-      if (bv.is_gmp())
-      {
-        mpz_init(d_val_gmp);
-        mpz_set(d_val_gmp, bv.d_val_gmp);
-      }
-      else
-      {
-        d_val_uint64 = bv.d_val_uint64;
-      }
-    }
-    d_size = bv.d_size;
+    *this = bv;
   }
   return *this;
 }
@@ -2715,47 +3366,14 @@ BitVector::ibvite(const BitVector& c, const BitVector& t, const BitVector& e)
   assert(c.d_size == 1);
   assert(e.d_size == t.d_size);
 
-  uint64_t size = t.d_size;
-
   if (c.is_true())
   {
-    if (t.is_gmp())
-    {
-      if (!is_gmp())
-      {
-        mpz_init(d_val_gmp);
-      }
-      mpz_set(d_val_gmp, t.d_val_gmp);
-    }
-    else
-    {
-      if (is_gmp())
-      {
-        mpz_clear(d_val_gmp);
-      }
-      d_val_uint64 = t.d_val_uint64;
-    }
+    *this = t;
   }
   else
   {
-    if (e.is_gmp())
-    {
-      if (!is_gmp())
-      {
-        mpz_init(d_val_gmp);
-      }
-      mpz_set(d_val_gmp, e.d_val_gmp);
-    }
-    else
-    {
-      if (is_gmp())
-      {
-        mpz_clear(d_val_gmp);
-      }
-      d_val_uint64 = e.d_val_uint64;
-    }
+    *this = e;
   }
-  d_size = size;
   return *this;
 }
 
@@ -2799,6 +3417,10 @@ BitVector::ibvmodinv(const BitVector& bv)
       {
         mpz_clear(d_val_gmp);
       }
+      if (pb->is_inline())
+      {
+        limbs_fill(d_val_limbs, limbs_size(size), 0);
+      }
       d_val_uint64 = 1;
     }
   }
@@ -2817,6 +3439,23 @@ BitVector::ibvmodinv(const BitVector& bv)
       mpz_fdiv_r_2exp_ull(d_val_gmp, d_val_gmp, size);
       mpz_clear(two);
     }
+    else if (pb->is_inline())
+    {
+      if (is_gmp())
+      {
+        mpz_clear(d_val_gmp);
+      }
+      mpz_t two, inv;
+      mpz_init(two);
+      mpz_init(inv);
+      mpz_setbit(two, size);
+      pb->to_mpz(inv);
+      mpz_invert(inv, inv, two);
+      mpz_fdiv_r_2exp_ull(inv, inv, size);
+      limbs_from_mpz(d_val_limbs, limbs_size(size), inv);
+      mpz_clear(two);
+      mpz_clear(inv);
+    }
     else
     {
       if (is_gmp())
@@ -2833,15 +3472,8 @@ BitVector::ibvmodinv(const BitVector& bv)
       BitVector a(esize), b(esize);
 
       a.set_bit(size, 1); /* 2^d_size */
-      /* b is this bit-vector extended to esize */
-      if (esize > s_native_size)
-      {
-        mpz_set_ui(b.d_val_gmp, pb->d_val_uint64);
-      }
-      else
-      {
-        b.d_val_uint64 = pb->d_val_uint64;
-      }
+      /* b is this bit-vector extended to esize (native or inline) */
+      b.d_val_uint64 = pb->d_val_uint64;
 
       BitVector y = mk_one(esize), ty, yq;
       BitVector ly(esize);
@@ -2861,27 +3493,16 @@ BitVector::ibvmodinv(const BitVector& bv)
   }
   d_size = size;
 #ifndef NDEBUG
-  mpz_t ty;
+  mpz_t ty, tmp;
   mpz_init(ty);
-  if (is_gmp())
-  {
-    mpz_mul(ty, pb->d_val_gmp, d_val_gmp);
-  }
-  else
-  {
-    if (pb->is_gmp())
-    {
-      mpz_mul_ui(ty, pb->d_val_gmp, d_val_uint64);
-    }
-    else
-    {
-      mpz_set_ui(ty, pb->d_val_uint64);
-      mpz_mul_ui(ty, ty, d_val_uint64);
-    }
-  }
+  mpz_init(tmp);
+  pb->to_mpz(ty);
+  to_mpz(tmp);
+  mpz_mul(ty, ty, tmp);
   mpz_fdiv_r_2exp_ull(ty, ty, size);
   assert(!mpz_cmp_ui(ty, 1));
   mpz_clear(ty);
+  mpz_clear(tmp);
 #endif
   return *this;
 }
@@ -3226,6 +3847,16 @@ BitVector::bvudivurem(const BitVector& bv,
       mpz_fdiv_r_2exp_ull(quot->d_val_gmp, quot->d_val_gmp, d_size);
       mpz_fdiv_r_2exp_ull(rem->d_val_gmp, rem->d_val_gmp, d_size);
     }
+    else if (is_inline())
+    {
+      uint64_t n = limbs_size(d_size);
+      uint64_t q[s_n_inline_limbs], r[s_n_inline_limbs];
+      limbs_udivrem(q, r, d_val_limbs, bv.d_val_limbs, n);
+      *quot = mk_zero(d_size);
+      *rem  = mk_zero(d_size);
+      std::copy_n(q, n, quot->d_val_limbs);
+      std::copy_n(r, n, rem->d_val_limbs);
+    }
     else
     {
       /* copy to guard for quot == *this and rem == *this */
@@ -3257,6 +3888,29 @@ BitVector::count_leading(bool zeros) const
   uint64_t res = 0;
   mp_limb_t limb;
 
+  if (is_inline())
+  {
+    uint64_t n   = limbs_size(d_size);
+    uint64_t pad = n * 64 - d_size;
+    for (uint64_t i = n; i-- > 0;)
+    {
+      uint64_t l = zeros ? d_val_limbs[i] : ~d_val_limbs[i];
+      if (i == n - 1)
+      {
+        /* discard padding bits of the most significant limb */
+        l <<= pad;
+        if (l) return clz_64(l);
+        res += 64 - pad;
+      }
+      else
+      {
+        if (l) return res + clz_64(l);
+        res += 64;
+      }
+    }
+    return res;
+  }
+
   uint64_t n_bits_per_limb = static_cast<uint64_t>(mp_bits_per_limb);
   /* The number of bits that spill over into the most significant limb,
    * assuming that all bits are represented). Zero if the bit-width is a
@@ -3286,6 +3940,7 @@ uint64_t
 BitVector::get_limb(void* limb, uint64_t nbits_rem, bool zeros) const
 {
   assert(!is_null());
+  assert(!is_inline());
   mp_limb_t* gmp_limb = static_cast<mp_limb_t*>(limb);
   uint64_t i, n_limbs, n_limbs_total;
   mp_limb_t res = 0u, mask;
@@ -3372,6 +4027,13 @@ BitVector::shift_is_uint64(uint64_t* res) const
     return true;
   }
 
+  if (is_inline())
+  {
+    if (!limbs_is_zero(d_val_limbs + 1, limbs_size(d_size) - 1)) return false;
+    *res = d_val_limbs[0];
+    return true;
+  }
+
   uint64_t clz = count_leading_zeros();
   if (clz < d_size - 64) return false;
 
@@ -3381,6 +4043,37 @@ BitVector::shift_is_uint64(uint64_t* res) const
   return true;
 }
 
+void
+BitVector::to_mpz(mpz_t res) const
+{
+  assert(!is_null());
+  if (is_gmp())
+  {
+    mpz_set(res, d_val_gmp);
+  }
+  else if (is_inline())
+  {
+    limbs_to_mpz(res, d_val_limbs, limbs_size(d_size));
+  }
+  else
+  {
+    mpz_set_ull(res, d_val_uint64);
+  }
+}
+
+void
+BitVector::copy_limbs(const BitVector& bv)
+{
+  assert(!bv.is_gmp());
+  if (&bv != this)
+  {
+    /* at least one limb, the value of null bit-vectors is zero */
+    std::copy_n(bv.d_val_limbs,
+                std::max<uint64_t>(limbs_size(bv.d_size), 1),
+                d_val_limbs);
+  }
+}
+
 std::ostream&
 operator<<(std::ostream& out, const BitVector& bv)
 {
@@ -43,6 +43,14 @@ class BitVector
   // 64-bit in d_val_uint64.
   static constexpr size_t s_native_size = sizeof(unsigned long) * 8;
   static_assert(s_native_size == sizeof(mp_bitcnt_t) * 8, "");
+  // Values that exceed s_native_size but require at most s_max_inline_size
+  // bits are stored inline as an array of 64-bit limbs (least significant limb
+  // first) and operated on with hand-written limb kernels, which avoids the
+  // allocation and call overhead of GMP for medium sized bit-vectors. Only
+  // values exceeding s_max_inline_size bits are stored as GMP integer.
+  static constexpr size_t s_max_inline_size = 256;
+  /** The number of limbs of an inline bit-vector value. */
+  static constexpr size_t s_n_inline_limbs = s_max_inline_size / 64;
 
   /**
    * Determine if given string representation of a value in the given numeric
@@ -1698,16 +1706,39 @@ class BitVector
    * @return The number of limbs needed to represent this bit-vector.
    */
   uint64_t get_limb(void* limb, uint64_t nbits_rem, bool zeros) const;
+  /**
+   * Store the value of this bit-vector in the given GMP integer.
+   * @param res The (initialized) GMP integer to store the value in.
+   */
+  void to_mpz(mpz_t res) const;
+  /**
+   * Copy the value of given non-GMP bit-vector into this bit-vector.
+   * @note Does not release the GMP value of this bit-vector and does not
+   *       update the size.
+   * @param bv The bit-vector to copy the value from.
+   */
+  void copy_limbs(const BitVector& bv);
 
   /**
-   * Determine whether value is stored as GMP value or uint64_t. This check
-   * depends on s_native_size, i.e., for 64-bit Windows values exceeding 32
-   * bit are stored as GMP value, for 64-bit Linux and macOS values exceeding
-   * 64 bit are stored as GMP value.
+   * Determine whether value is stored as GMP value. Values exceeding
+   * s_max_inline_size bits are stored as GMP value.
    *
    * @return True if bit-vector wraps a GMPMpz.
    */
-  bool is_gmp() const { return d_size > s_native_size; }
+  bool is_gmp() const { return d_size > s_max_inline_size; }
+  /**
+   * Determine whether value is stored inline as an array of limbs. This check
+   * depends on s_native_size, i.e., for 64-bit Windows values exceeding 32
+   * bit are stored inline, for 64-bit Linux and macOS values exceeding 64 bit
+   * are stored inline (up to s_max_inline_size bits). Values that are neither
+   * stored as GMP value nor inline are stored as uint64_t.
+   *
+   * @return True if bit-vector value is stored in d_val_limbs.
+   */
+  bool is_inline() const
+  {
+    return d_size > s_native_size && d_size <= s_max_inline_size;
+  }
 
   /** The size of this bit-vector. */
   uint64_t d_size = 0;
@@ -1723,6 +1754,12 @@ class BitVector
   union
   {
     uint64_t d_val_uint64;
+    /**
+     * The limbs of an inline value, least significant limb first. Only the
+     * limbs required to represent d_size bits are significant, and bits
+     * exceeding d_size in the most significant limb are always zero.
+     */
+    uint64_t d_val_limbs[s_n_inline_limbs];
     // GMPMpz* d_val_gmp;
     mpz_t d_val_gmp;
   };
@@ -279,17 +279,29 @@ BitVectorDomain::get_factor(RNG *rng,
                             const BitVectorBounds &bounds,
                             uint64_t limit) const
 {
-  WheelFactorizer wf(num, limit);
   std::vector<BitVector> factors;
-
-  while (true)
+  if (rng)
   {
+    factors = factorize(num, limit);
+  }
+  else
+  {
+    WheelFactorizer wf(num, limit);
     const BitVector *fact = wf.next();
-    if (!fact) break;
-    factors.emplace_back(*fact);
-    if (rng == nullptr) break;
+    if (fact)
+    {
+      factors.emplace_back(*fact);
+    }
   }
+  return get_factor(rng, num, std::move(factors), bounds);
+}
 
+BitVector
+BitVectorDomain::get_factor(RNG *rng,
+                            const BitVector &num,
+                            std::vector<BitVector> factors,
+                            const BitVectorBounds &bounds) const
+{
   /* Pick factor from stack. Random (combination) if 'rng' is given. */
   if (!factors.empty())
   {
@@ -347,6 +359,20 @@ BitVectorDomain::get_factor(RNG *rng,
   return BitVector();
 }
 
+std::vector<BitVector>
+BitVectorDomain::factorize(const BitVector &num, uint64_t limit)
+{
+  WheelFactorizer wf(num, limit);
+  std::vector<BitVector> factors;
+  while (true)
+  {
+    const BitVector *fact = wf.next();
+    if (!fact) break;
+    factors.emplace_back(*fact);
+  }
+  return factors;
+}
+
 std::string
 BitVectorDomain::str() const
 {
@@ -11,6 +11,8 @@
 #ifndef BZLA__BV_BITVECTOR_DOMAIN_H
 #define BZLA__BV_BITVECTOR_DOMAIN_H
 
+#include <vector>
+
 #include "bv/bitvector.h"
 
 namespace bzla {
@@ -232,6 +234,30 @@ class BitVectorDomain
                        const BitVector &num,
                        const BitVectorBounds &bounds,
                        uint64_t limit) const;
+  /**
+   * Determine a random factor of `num` from the given (not necessarily
+   * distinct) prime factors of `num` (see factorize()).
+   * @param rng     The associated random number generator.
+   * @param num     The value to factorize.
+   * @param factors The factors of `num`.
+   * @param bounds  The inclusive value bounds for the factor.
+   * @return A null bit-vector if no such factor exists.
+   */
+  BitVector get_factor(RNG *rng,
+                       const BitVector &num,
+                       std::vector<BitVector> factors,
+                       const BitVectorBounds &bounds) const;
+
+  /**
+   * Determine the prime factors of `num` via wheel factorization.
+   * @param num   The value to factorize.
+   * @param limit The maximum numbers of iterations in the wheel factorizer.
+   * @return The factors of `num`, a factor may occur multiple times. Empty
+   *         if computation exceeds `limit` iterations before any factor is
+   *         found.
+   */
+  static std::vector<BitVector> factorize(const BitVector &num,
+                                          uint64_t limit);
 
   /**
    * Get a string representation of this bit-vector domain.
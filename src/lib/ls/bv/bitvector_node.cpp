@@ -10,6 +10,7 @@
 
 #include "ls/bv/bitvector_node.h"
 
+#include <algorithm>
 #include <cassert>
 #include <iostream>
 #include <sstream>
@@ -186,6 +187,66 @@ BitVectorNode::fix_bit(uint64_t idx, bool value)
   d_domain.fix_bit(idx, value);
 }
 
+void
+BitVectorNode::enable_inverse_memo(size_t size,
+                                   uint64_t& num_hits,
+                                   uint64_t& num_misses)
+{
+  assert(size > 0);
+  d_inverse_memo.reset(new InverseMemo(size, num_hits, num_misses));
+}
+
+const std::vector<BitVector>*
+BitVectorNode::inverse_memo_find(const BitVector& t,
+                                 const BitVector& s,
+                                 uint64_t pos_x)
+{
+  if (!d_inverse_memo)
+  {
+    return nullptr;
+  }
+  InverseMemo::Entry& e = d_inverse_memo->slot(t, s, pos_x);
+  if (!e.d_t.is_null() && e.d_pos_x == pos_x && e.d_t.compare(t) == 0
+      && e.d_s.compare(s) == 0)
+  {
+    d_inverse_memo->d_num_hits += 1;
+    return &e.d_result;
+  }
+  d_inverse_memo->d_num_misses += 1;
+  return nullptr;
+}
+
+void
+BitVectorNode::inverse_memo_insert(const BitVector& t,
+                                   const BitVector& s,
+                                   uint64_t pos_x,
+                                   const std::vector<BitVector>& result)
+{
+  assert(std::none_of(result.begin(), result.end(), [](const BitVector& bv) {
+    return bv.is_null();
+  }));
+  if (!d_inverse_memo)
+  {
+    return;
+  }
+  InverseMemo::Entry& e = d_inverse_memo->slot(t, s, pos_x);
+  e.d_t                 = t;
+  e.d_s                 = s;
+  e.d_pos_x             = pos_x;
+  e.d_result            = result;
+}
+
+BitVectorNode::InverseMemo::Entry&
+BitVectorNode::InverseMemo::slot(const BitVector& t,
+                                 const BitVector& s,
+                                 uint64_t pos_x)
+{
+  size_t hash = t.hash();
+  hash        = hash * 31 + s.hash();
+  hash        = hash * 31 + pos_x;
+  return d_entries[hash % d_entries.size()];
+}
+
 void
 BitVectorNode::update_bounds(const BitVector& min,
                              const BitVector& max,
@@ -1397,7 +1458,7 @@ BitVectorMul::is_invertible(const BitVector& t,
         if (s.lsb())
         {
           // IC: odd: mcb(x, t * s^-1)
-          BitVector inv = s.bvmodinv().ibvmul(t);  // s^-1
+          BitVector inv = mod_inverse(t, s, pos_x);  // s^-1
           if (x.match_fixed_bits(inv) && bounds.contains(inv))
           {
             // Inverse value: s^-1
@@ -1417,9 +1478,8 @@ BitVectorMul::is_invertible(const BitVector& t,
         // mcb(x[size - ctz(s) - 1:0], y[size - ctz(s) - 1:0]).
         uint64_t size   = x.size();
         uint64_t ctz    = s.count_trailing_zeros();
-        BitVector y_ext = t.bvshr(ctz)
-                              .ibvmul(s.bvshr(ctz).ibvmodinv())
-                              .ibvextract(size - ctz - 1, 0);
+        BitVector y_ext = mod_inverse(t, s, pos_x);
+        y_ext.ibvextract(size - ctz - 1, 0);
         if (x.bvextract(size - ctz - 1, 0).match_fixed_bits(y_ext))
         {
           // Result domain is x[size - 1:size - ctz] o y[size - ctz(s) - 1:0]
@@ -1471,7 +1531,7 @@ BitVectorMul::is_invertible(const BitVector& t,
     }
     if (s.lsb())
     {
-      BitVector inv = t.bvmul(s.bvmodinv());
+      BitVector inv = mod_inverse(t, s, pos_x);
       if (bounds.contains(inv))
       {
         // Inverse value: s odd : s^-1 (unique solution)
@@ -1499,10 +1559,8 @@ BitVectorMul::is_invertible(const BitVector& t,
       }
       else
       {
-        right = s.bvshr(n)
-                    .ibvmodinv()
-                    .ibvmul(t.bvshr(n))
-                    .ibvextract(size - n - 1, 0);
+        right = mod_inverse(t, s, pos_x);
+        right.ibvextract(size - n - 1, 0);
       }
       BitVectorDomain d = BitVectorDomain(size - right.size()).bvconcat(right);
       BitVectorDomainDualGenerator gen(d, bounds, d_rng);
@@ -1703,6 +1761,26 @@ BitVectorMul::consistent_value(const BitVector& t, uint64_t pos_x)
   return *d_consistent;
 }
 
+BitVector
+BitVectorMul::mod_inverse(const BitVector& t,
+                          const BitVector& s,
+                          uint64_t pos_x)
+{
+  assert(!s.is_zero());
+  const std::vector<BitVector>* memo = inverse_memo_find(t, s, pos_x);
+  if (memo)
+  {
+    assert(memo->size() == 1);
+    return (*memo)[0];
+  }
+  uint64_t ctz = s.count_trailing_zeros();
+  BitVector res =
+      ctz == 0 ? t.bvmul(s.bvmodinv())
+               : t.bvshr(ctz).ibvmul(s.bvshr(ctz).ibvmodinv());
+  inverse_memo_insert(t, s, pos_x, {res});
+  return res;
+}
+
 /* -------------------------------------------------------------------------- */
 
 BitVectorShl::BitVectorShl(RNG* rng,
@@ -5168,8 +5246,10 @@ BitVectorUrem::is_invertible(const BitVector& t,
           assert(!t.is_ones());
           BitVector ones = BitVector::mk_ones(size);
           BitVector inc  = t.bvinc();
-          BitVector bv =
-              x.get_factor(d_rng, n, normalize_bounds({inc, ones}, {}), 10000);
+          BitVector bv   = x.get_factor(d_rng,
+                                      n,
+                                      factorize(t, s, pos_x),
+                                      normalize_bounds({inc, ones}, {}));
           assert(bv.is_null() || x.match_fixed_bits(bv));
           if (bv.is_null())
           {
@@ -5208,8 +5288,10 @@ BitVectorUrem::is_invertible(const BitVector& t,
             assert(!t.is_ones());
             BitVector ones = BitVector::mk_ones(size);
             BitVector inc  = t.bvinc();
-            BitVector bv   = x.get_factor(
-                d_rng, sub, normalize_bounds({inc, ones}, {}), 10000);
+            BitVector bv   = x.get_factor(d_rng,
+                                        sub,
+                                        factorize(t, s, pos_x),
+                                        normalize_bounds({inc, ones}, {}));
             assert(bv.is_null() || x.match_fixed_bits(bv));
             if (!bv.is_null())
             {
@@ -5248,6 +5330,23 @@ BitVectorUrem::is_invertible(const BitVector& t,
   return ic;
 }
 
+std::vector<BitVector>
+BitVectorUrem::factorize(const BitVector& t,
+                         const BitVector& s,
+                         uint64_t pos_x)
+{
+  assert(pos_x == 1);
+  assert(s.compare(t) > 0);
+  const std::vector<BitVector>* memo = inverse_memo_find(t, s, pos_x);
+  if (memo)
+  {
+    return *memo;
+  }
+  std::vector<BitVector> res = BitVectorDomain::factorize(s.bvsub(t), 10000);
+  inverse_memo_insert(t, s, pos_x, res);
+  return res;
+}
+
 bool
 BitVectorUrem::is_consistent(const BitVector& t, uint64_t pos_x)
 {
@@ -5948,7 +6047,7 @@ BitVectorIte::select_path(const BitVector& t, std::vector<uint64_t>& ess_inputs)
   bool checked_essential = false;
   /* select essential input if any and path selection based on essential
    * inputs is enabled. */
-  if (s_path_sel_essential && d_rng->pick_with_prob(s_prob_pick_ess_input))
+  if (d_path_sel_essential && d_rng->pick_with_prob(d_prob_pick_ess_input))
   {
     /* determine essential inputs, disabled branches are excluded */
     checked_essential = true;
@@ -11,6 +11,7 @@
 #ifndef BZLA__LS_BITVECTOR_NODE_H
 #define BZLA__LS_BITVECTOR_NODE_H
 
+#include <memory>
 #include <vector>
 
 #include "bv/bitvector.h"
@@ -142,6 +143,19 @@ class BitVectorNode : public Node<BitVector>
    */
   void reset_bounds();
 
+  /**
+   * Enable memoization of expensive (sub)computations of inverse values.
+   * Only deterministic computations may be memoized, results that depend on
+   * random choices must not be reused. The memo is bounded and direct-mapped,
+   * i.e., an entry is replaced by any later entry that maps to the same slot.
+   * @param size       The number of entries of the memo.
+   * @param num_hits   The counter to increment on memo hits.
+   * @param num_misses The counter to increment on memo misses.
+   */
+  void enable_inverse_memo(size_t size,
+                           uint64_t& num_hits,
+                           uint64_t& num_misses);
+
  protected:
   /**
    * Tighten signed and/or unsigned bounds of this node wrt. to the given
@@ -233,6 +247,31 @@ class BitVectorNode : public Node<BitVector>
   virtual std::tuple<BitVectorRange, BitVectorRange> compute_min_max_bounds(
       const BitVector& t, uint64_t pos_x);
 
+  /**
+   * Look up the memoized result of an inverse value computation for the
+   * given key (see enable_inverse_memo()).
+   * @param t     The target value.
+   * @param s     The assignment of the other operand.
+   * @param pos_x The index of operand `x`.
+   * @return The memoized result, nullptr if there is none or memoization is
+   *         disabled.
+   */
+  const std::vector<BitVector>* inverse_memo_find(const BitVector& t,
+                                                  const BitVector& s,
+                                                  uint64_t pos_x);
+  /**
+   * Memoize the result of an inverse value computation for the given key
+   * (see inverse_memo_find()).
+   * @param t      The target value.
+   * @param s      The assignment of the other operand.
+   * @param pos_x  The index of operand `x`.
+   * @param result The result, a list of values, none of which may be null.
+   */
+  void inverse_memo_insert(const BitVector& t,
+                           const BitVector& s,
+                           uint64_t pos_x,
+                           const std::vector<BitVector>& result);
+
   /** The underlying bit-vector domain representing constant bits. */
   BitVectorDomain d_domain;
 
@@ -242,13 +281,42 @@ class BitVectorNode : public Node<BitVector>
   BitVectorRange d_bounds_s;
 
   std::vector<BitVectorExtract*> d_extracts;
+
+ private:
+  /** Memo for inverse value computations, see enable_inverse_memo(). */
+  struct InverseMemo
+  {
+    struct Entry
+    {
+      /** The target value, null if the entry is not used. */
+      BitVector d_t;
+      /** The assignment of the other operand. */
+      BitVector d_s;
+      /** The index of operand `x`. */
+      uint64_t d_pos_x = 0;
+      /** The memoized result. */
+      std::vector<BitVector> d_result;
+    };
+    InverseMemo(size_t size, uint64_t& num_hits, uint64_t& num_misses)
+        : d_entries(size), d_num_hits(num_hits), d_num_misses(num_misses)
+    {
+    }
+    /** @return The entry the given key maps to. */
+    Entry& slot(const BitVector& t, const BitVector& s, uint64_t pos_x);
+
+    std::vector<Entry> d_entries;
+    uint64_t& d_num_hits;
+    uint64_t& d_num_misses;
+  };
+  /** The inverse value memo, null if memoization is disabled. */
+  std::unique_ptr<InverseMemo> d_inverse_memo;
 };
 
 std::ostream& operator<<(std::ostream& out, const BitVectorNode& node);
 
 /* -------------------------------------------------------------------------- */
 
-class BitVectorAdd : public BitVectorNode
+class BitVectorAdd final : public BitVectorNode
 {
  public:
   /** Constructors. */
@@ -319,7 +387,7 @@ class BitVectorAdd : public BitVectorNode
 
 /* -------------------------------------------------------------------------- */
 
-class BitVectorAnd : public BitVectorNode
+class BitVectorAnd final : public BitVectorNode
 {
  public:
   /** Constructors. */
@@ -400,7 +468,7 @@ class BitVectorAnd : public BitVectorNode
 
 /* -------------------------------------------------------------------------- */
 
-class BitVectorConcat : public BitVectorNode
+class BitVectorConcat final : public BitVectorNode
 {
  public:
   /** Constructors. */
@@ -480,7 +548,7 @@ class BitVectorConcat : public BitVectorNode
 
 /* -------------------------------------------------------------------------- */
 
-class BitVectorEq : public BitVectorNode
+class BitVectorEq final : public BitVectorNode
 {
  public:
   /** Constructors. */
@@ -553,7 +621,7 @@ class BitVectorEq : public BitVectorNode
 
 /* -------------------------------------------------------------------------- */
 
-class BitVectorMul : public BitVectorNode
+class BitVectorMul final : public BitVectorNode
 {
  public:
   /** Constructors. */
@@ -601,6 +669,18 @@ class BitVectorMul : public BitVectorNode
       const BitVector& t, uint64_t pos_x) override;
 
  private:
+  /**
+   * Helper for is_invertible() to compute y = (t >> c) * (s >> c)^-1 with
+   * c = ctz(s), the (unique for odd s) solution for the lower size - c bits
+   * of `x` with x * s = t. Memoized if enabled, see enable_inverse_memo().
+   * @param t     The target value.
+   * @param s     The assignment of the other operand, must not be zero.
+   * @param pos_x The index of operand `x`.
+   * @return The value y.
+   */
+  BitVector mod_inverse(const BitVector& t,
+                        const BitVector& s,
+                        uint64_t pos_x);
   /**
    * Evaluate the assignment of this node.
    *
@@ -633,7 +713,7 @@ class BitVectorMul : public BitVectorNode
 
 /* -------------------------------------------------------------------------- */
 
-class BitVectorShl : public BitVectorNode
+class BitVectorShl final : public BitVectorNode
 {
  public:
   /** Constructors. */
@@ -714,7 +794,7 @@ class BitVectorShl : public BitVectorNode
 
 /* -------------------------------------------------------------------------- */
 
-class BitVectorShr : public BitVectorNode
+class BitVectorShr final : public BitVectorNode
 {
  public:
   /**
@@ -815,7 +895,7 @@ class BitVectorShr : public BitVectorNode
 
 /* -------------------------------------------------------------------------- */
 
-class BitVectorAshr : public BitVectorNode
+class BitVectorAshr final : public BitVectorNode
 {
  public:
   /** Constructors. */
@@ -905,7 +985,7 @@ class BitVectorAshr : public BitVectorNode
 
 /* -------------------------------------------------------------------------- */
 
-class BitVectorUdiv : public BitVectorNode
+class BitVectorUdiv final : public BitVectorNode
 {
  public:
   /** Constructors. */
@@ -1008,7 +1088,7 @@ class BitVectorUdiv : public BitVectorNode
 
 /* -------------------------------------------------------------------------- */
 
-class BitVectorUlt : public BitVectorNode
+class BitVectorUlt final : public BitVectorNode
 {
  public:
   /**
@@ -1154,7 +1234,7 @@ class BitVectorUlt : public BitVectorNode
 
 /* -------------------------------------------------------------------------- */
 
-class BitVectorSlt : public BitVectorNode
+class BitVectorSlt final : public BitVectorNode
 {
  public:
   /** Constructors. */
@@ -1288,7 +1368,7 @@ class BitVectorSlt : public BitVectorNode
 
 /* -------------------------------------------------------------------------- */
 
-class BitVectorUrem : public BitVectorNode
+class BitVectorUrem final : public BitVectorNode
 {
  public:
   /** Constructors. */
@@ -1348,6 +1428,19 @@ class BitVectorUrem : public BitVectorNode
                                     uint64_t pos_x) override;
 
  private:
+  /**
+   * Helper for is_invertible() to compute the prime factors of s - t via
+   * wheel factorization, the candidates for `x` with s % x = t are
+   * combinations of these factors. Memoized if enabled, see
+   * enable_inverse_memo().
+   * @param t     The target value.
+   * @param s     The assignment of the other operand, must be greater than t.
+   * @param pos_x The index of operand `x`, must be 1.
+   * @return The factors of s - t.
+   */
+  std::vector<BitVector> factorize(const BitVector& t,
+                                   const BitVector& s,
+                                   uint64_t pos_x);
   /**
    * Evaluate the assignment of this node.
    *
@@ -1388,7 +1481,7 @@ class BitVectorUrem : public BitVectorNode
 
 /* -------------------------------------------------------------------------- */
 
-class BitVectorXor : public BitVectorNode
+class BitVectorXor final : public BitVectorNode
 {
  public:
   /** Constructors. */
@@ -1459,7 +1552,7 @@ class BitVectorXor : public BitVectorNode
 
 /* -------------------------------------------------------------------------- */
 
-class BitVectorIte : public BitVectorNode
+class BitVectorIte final : public BitVectorNode
 {
  public:
   /** Constructors. */
@@ -1556,7 +1649,7 @@ class BitVectorIte : public BitVectorNode
 
 /* -------------------------------------------------------------------------- */
 
-class BitVectorNot : public BitVectorNode
+class BitVectorNot final : public BitVectorNode
 {
  public:
   /** Constructors. */
@@ -1623,7 +1716,7 @@ class BitVectorNot : public BitVectorNode
 
 /* -------------------------------------------------------------------------- */
 
-class BitVectorExtract : public BitVectorNode
+class BitVectorExtract final : public BitVectorNode
 {
  public:
   /**
@@ -1778,7 +1871,7 @@ class BitVectorExtract : public BitVectorNode
 
 /* -------------------------------------------------------------------------- */
 
-class BitVectorSignExtend : public BitVectorNode
+class BitVectorSignExtend final : public BitVectorNode
 {
  public:
   /** Constructors. */
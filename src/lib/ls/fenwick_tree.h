@@ -0,0 +1,118 @@
+/***
+ * Bitwuzla: Satisfiability Modulo Theories (SMT) solver.
+ *
+ * Copyright (C) 2024 by the authors listed in the AUTHORS file at
+ * https://github.com/bitwuzla/bitwuzla/blob/main/AUTHORS
+ *
+ * This file is part of Bitwuzla under the MIT license. See COPYING for more
+ * information at https://github.com/bitwuzla/bitwuzla/blob/main/COPYING
+ */
+
+#ifndef BZLA__LS_FENWICK_TREE_H
+#define BZLA__LS_FENWICK_TREE_H
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace bzla::ls {
+
+/**
+ * Fenwick tree (binary indexed tree) over non-negative integer values indexed
+ * by node id.
+ *
+ * Supports updating a value and selecting the index at which the prefix sum of
+ * the values exceeds a given value in logarithmic time, and maintains the sum
+ * of all values. This allows to pick an index with probability proportional
+ * to its value. The tree grows with the largest index, new values are zero.
+ */
+class FenwickTree
+{
+ public:
+  /** @return The number of values. */
+  size_t size() const { return d_tree.size(); }
+
+  /**
+   * Grow the tree to given number of values, new values are zero.
+   * @param size The new number of values, must not be smaller than size().
+   */
+  void resize(size_t size)
+  {
+    assert(size >= d_tree.size());
+    d_tree.reserve(size);
+    while (d_tree.size() < size)
+    {
+      // Entry i (1-based) stores the sum of the values in (i - lsb(i), i].
+      size_t i = d_tree.size() + 1;
+      d_tree.push_back(prefix(i - 1) - prefix(i - (i & (~i + 1))));
+    }
+  }
+
+  /**
+   * Add given delta to the value at given index.
+   * @param idx   The index.
+   * @param delta The delta, the resulting value must not be negative.
+   */
+  void add(size_t idx, int64_t delta)
+  {
+    assert(idx < d_tree.size());
+    uint64_t d = static_cast<uint64_t>(delta);
+    d_total += d;
+    for (size_t i = idx + 1, n = d_tree.size(); i <= n; i += i & (~i + 1))
+    {
+      d_tree[i - 1] += d;
+    }
+  }
+
+  /** @return The sum of all values. */
+  uint64_t total() const { return d_total; }
+
+  /**
+   * Get the smallest index at which the prefix sum of the values (including
+   * the value at that index) is greater than `r`.
+   * @param r The value to select the index for, must be less than total().
+   * @return The index.
+   */
+  size_t find(uint64_t r) const
+  {
+    assert(r < d_total);
+    size_t pos  = 0;
+    size_t step = 1;
+    while ((step << 1) <= d_tree.size())
+    {
+      step <<= 1;
+    }
+    for (; step > 0; step >>= 1)
+    {
+      if (pos + step <= d_tree.size() && d_tree[pos + step - 1] <= r)
+      {
+        pos += step;
+        r -= d_tree[pos - 1];
+      }
+    }
+    assert(pos < d_tree.size());
+    return pos;
+  }
+
+ private:
+  /** @return The sum of the first `n` values. */
+  uint64_t prefix(size_t n) const
+  {
+    uint64_t res = 0;
+    for (size_t i = n; i > 0; i -= i & (~i + 1))
+    {
+      res += d_tree[i - 1];
+    }
+    return res;
+  }
+
+  /** The tree entries, see resize(). */
+  std::vector<uint64_t> d_tree;
+  /** The sum of all values. */
+  uint64_t d_total = 0;
+};
+
+}  // namespace bzla::ls
+
+#endif
@@ -0,0 +1,676 @@
+/***
+ * Bitwuzla: Satisfiability Modulo Theories (SMT) solver.
+ *
+ * Copyright (C) 2024 by the authors listed in the AUTHORS file at
+ * https://github.com/bitwuzla/bitwuzla/blob/main/AUTHORS
+ *
+ * This file is part of Bitwuzla under the MIT license. See COPYING for more
+ * information at https://github.com/bitwuzla/bitwuzla/blob/main/COPYING
+ */
+
+#include "ls/fp/floating_point_bv.h"
+
+#include <algorithm>
+#include <cassert>
+
+#include "rng/rng.h"
+
+namespace bzla::ls {
+
+namespace {
+
+/**
+ * Zero-extend or truncate a bit-vector to the given size.
+ * @note Only truncates leading zeros.
+ */
+BitVector
+resize(const BitVector& bv, uint64_t size)
+{
+  if (bv.size() == size)
+  {
+    return bv;
+  }
+  if (bv.size() < size)
+  {
+    return bv.bvzext(size - bv.size());
+  }
+  assert(bv.count_leading_zeros() >= bv.size() - size);
+  return bv.bvextract(size - 1, 0);
+}
+
+/** @return The number of significant bits of `bv`. */
+uint64_t
+num_bits(const BitVector& bv)
+{
+  return bv.size() - bv.count_leading_zeros();
+}
+
+}  // namespace
+
+/* -------------------------------------------------------------------------- */
+
+BitVector
+FloatingPointBV::mk_rm(RoundingMode rm)
+{
+  assert(rm != RoundingMode::NUM_RM);
+  return BitVector::from_ui(s_rm_size, static_cast<uint64_t>(rm));
+}
+
+FloatingPointBV::RoundingMode
+FloatingPointBV::to_rm(const BitVector& rm)
+{
+  assert(rm.size() == s_rm_size);
+  if (!is_rm(rm))
+  {
+    return RoundingMode::RNE;
+  }
+  return static_cast<RoundingMode>(rm.to_uint64());
+}
+
+bool
+FloatingPointBV::is_rm(const BitVector& rm)
+{
+  assert(rm.size() == s_rm_size);
+  return rm.to_uint64() < static_cast<uint64_t>(RoundingMode::NUM_RM);
+}
+
+FloatingPointBV::FloatingPointBV(uint64_t exp_size, uint64_t sig_size)
+    : d_exp_size(exp_size),
+      d_sig_size(sig_size),
+      d_bias((int64_t(1) << (exp_size - 1)) - 1),
+      d_exp_max((uint64_t(1) << exp_size) - 1)
+{
+  assert(exp_size > 1);
+  assert(exp_size < 32);
+  assert(sig_size > 1);
+}
+
+BitVector
+FloatingPointBV::mk_nan() const
+{
+  BitVector sig = BitVector::mk_zero(d_sig_size - 1);
+  sig.set_bit(d_sig_size - 2, true);
+  return pack(false, d_exp_max, sig);
+}
+
+BitVector
+FloatingPointBV::mk_inf(bool sign) const
+{
+  return pack(sign, d_exp_max, BitVector::mk_zero(d_sig_size - 1));
+}
+
+BitVector
+FloatingPointBV::mk_zero(bool sign) const
+{
+  return pack(sign, 0, BitVector::mk_zero(d_sig_size - 1));
+}
+
+BitVector
+FloatingPointBV::mk_one(bool sign) const
+{
+  return pack(sign, d_bias, BitVector::mk_zero(d_sig_size - 1));
+}
+
+BitVector
+FloatingPointBV::mk_max(bool sign) const
+{
+  return pack(sign, d_exp_max - 1, BitVector::mk_ones(d_sig_size - 1));
+}
+
+BitVector
+FloatingPointBV::mk_random(RNG& rng) const
+{
+  bool sign = rng.flip_coin();
+  BitVector sig(d_sig_size - 1, rng);
+  uint64_t exp;
+  switch (rng.pick<uint32_t>(0, 7))
+  {
+    // zero and subnormal values
+    case 0: exp = 0; break;
+    // infinity and NaN
+    case 1: exp = d_exp_max; break;
+    // normal values
+    case 2:
+    case 3: exp = rng.pick<uint64_t>(1, d_exp_max - 1); break;
+    // normal values close to one
+    default: {
+      int64_t range = static_cast<int64_t>(d_sig_size + 2);
+      int64_t lo    = std::max<int64_t>(1, d_bias - range);
+      int64_t hi =
+          std::min<int64_t>(static_cast<int64_t>(d_exp_max) - 1,
+                            d_bias + range);
+      exp = static_cast<uint64_t>(rng.pick<int64_t>(lo, hi));
+    }
+  }
+  return pack(sign, exp, sig);
+}
+
+/* -------------------------------------------------------------------------- */
+
+bool
+FloatingPointBV::is_nan(const BitVector& x) const
+{
+  return exp_field(x) == d_exp_max && !sig_field(x).is_zero();
+}
+
+bool
+FloatingPointBV::is_inf(const BitVector& x) const
+{
+  return exp_field(x) == d_exp_max && sig_field(x).is_zero();
+}
+
+bool
+FloatingPointBV::is_zero(const BitVector& x) const
+{
+  return exp_field(x) == 0 && sig_field(x).is_zero();
+}
+
+bool
+FloatingPointBV::is_normal(const BitVector& x) const
+{
+  uint64_t exp = exp_field(x);
+  return exp != 0 && exp != d_exp_max;
+}
+
+bool
+FloatingPointBV::is_subnormal(const BitVector& x) const
+{
+  return exp_field(x) == 0 && !sig_field(x).is_zero();
+}
+
+bool
+FloatingPointBV::is_neg(const BitVector& x) const
+{
+  return sign(x) && !is_nan(x);
+}
+
+bool
+FloatingPointBV::is_pos(const BitVector& x) const
+{
+  return !sign(x) && !is_nan(x);
+}
+
+/* -------------------------------------------------------------------------- */
+
+bool
+FloatingPointBV::eq(const BitVector& x, const BitVector& y) const
+{
+  if (is_nan(x) || is_nan(y))
+  {
+    return false;
+  }
+  if (is_zero(x) && is_zero(y))
+  {
+    return true;
+  }
+  return x.compare(y) == 0;
+}
+
+bool
+FloatingPointBV::lt(const BitVector& x, const BitVector& y) const
+{
+  if (is_nan(x) || is_nan(y) || (is_zero(x) && is_zero(y)))
+  {
+    return false;
+  }
+  bool sign_x = sign(x);
+  if (sign_x != sign(y))
+  {
+    return sign_x;
+  }
+  uint64_t hi = size() - 2;
+  int32_t cmp = x.bvextract(hi, 0).compare(y.bvextract(hi, 0));
+  return sign_x ? cmp > 0 : cmp < 0;
+}
+
+bool
+FloatingPointBV::leq(const BitVector& x, const BitVector& y) const
+{
+  return lt(x, y) || eq(x, y);
+}
+
+bool
+FloatingPointBV::smt_eq(const BitVector& x, const BitVector& y) const
+{
+  bool nan_x = is_nan(x);
+  if (nan_x || is_nan(y))
+  {
+    return nan_x && is_nan(y);
+  }
+  return x.compare(y) == 0;
+}
+
+/* -------------------------------------------------------------------------- */
+
+BitVector
+FloatingPointBV::neg(const BitVector& x) const
+{
+  if (is_nan(x))
+  {
+    return mk_nan();
+  }
+  BitVector res(x);
+  res.flip_bit(size() - 1);
+  return res;
+}
+
+BitVector
+FloatingPointBV::abs(const BitVector& x) const
+{
+  if (is_nan(x))
+  {
+    return mk_nan();
+  }
+  BitVector res(x);
+  res.set_bit(size() - 1, false);
+  return res;
+}
+
+BitVector
+FloatingPointBV::add(RoundingMode rm,
+                     const BitVector& x,
+                     const BitVector& y) const
+{
+  if (is_nan(x) || is_nan(y))
+  {
+    return mk_nan();
+  }
+  bool inf_x = is_inf(x);
+  bool inf_y = is_inf(y);
+  if (inf_x && inf_y)
+  {
+    return sign(x) == sign(y) ? x : mk_nan();
+  }
+  if (inf_x)
+  {
+    return x;
+  }
+  if (inf_y)
+  {
+    return y;
+  }
+  bool zero_x = is_zero(x);
+  bool zero_y = is_zero(y);
+  if (zero_x && zero_y)
+  {
+    return sign(x) == sign(y) ? x : mk_zero(rm == RoundingMode::RTN);
+  }
+  if (zero_x)
+  {
+    return y;
+  }
+  if (zero_y)
+  {
+    return x;
+  }
+
+  Unpacked ux = unpack(x);
+  Unpacked uy = unpack(y);
+  if (ux.d_exp < uy.d_exp)
+  {
+    std::swap(ux, uy);
+  }
+  // If the exponent difference is large enough, the smaller operand only
+  // contributes to the sticky bit. Since the exponents of unpacked values are
+  // at least the exponent of the smallest subnormal, the larger operand is
+  // normalized in this case, and it is sufficient to replace the smaller
+  // operand with a single bit below the guard bits.
+  uint64_t p    = d_sig_size;
+  uint64_t max  = p + 3;
+  uint64_t size = 2 * p + 5;
+  uint64_t diff = static_cast<uint64_t>(ux.d_exp - uy.d_exp);
+  BitVector sig_x, sig_y;
+  int64_t exp;
+  if (diff > max)
+  {
+    sig_x = resize(ux.d_sig, size).ibvshl(max);
+    sig_y = BitVector::mk_one(size);
+    exp   = ux.d_exp - static_cast<int64_t>(max);
+  }
+  else
+  {
+    sig_x = resize(ux.d_sig, size).ibvshl(diff);
+    sig_y = resize(uy.d_sig, size);
+    exp   = uy.d_exp;
+  }
+
+  if (ux.d_sign == uy.d_sign)
+  {
+    return round(rm, ux.d_sign, sig_x.ibvadd(sig_y), exp);
+  }
+  int32_t cmp = sig_x.compare(sig_y);
+  if (cmp == 0)
+  {
+    return mk_zero(rm == RoundingMode::RTN);
+  }
+  if (cmp > 0)
+  {
+    return round(rm, ux.d_sign, sig_x.ibvsub(sig_y), exp);
+  }
+  return round(rm, uy.d_sign, sig_y.ibvsub(sig_x), exp);
+}
+
+BitVector
+FloatingPointBV::mul(RoundingMode rm,
+                     const BitVector& x,
+                     const BitVector& y) const
+{
+  if (is_nan(x) || is_nan(y))
+  {
+    return mk_nan();
+  }
+  bool sign_res = sign(x) != sign(y);
+  bool inf_x    = is_inf(x);
+  bool inf_y    = is_inf(y);
+  bool zero_x   = is_zero(x);
+  bool zero_y   = is_zero(y);
+  if ((inf_x && zero_y) || (zero_x && inf_y))
+  {
+    return mk_nan();
+  }
+  if (inf_x || inf_y)
+  {
+    return mk_inf(sign_res);
+  }
+  if (zero_x || zero_y)
+  {
+    return mk_zero(sign_res);
+  }
+  Unpacked ux = unpack(x);
+  Unpacked uy = unpack(y);
+  uint64_t size = 2 * d_sig_size;
+  return round(rm,
+               sign_res,
+               resize(ux.d_sig, size).ibvmul(resize(uy.d_sig, size)),
+               ux.d_exp + uy.d_exp);
+}
+
+BitVector
+FloatingPointBV::div(RoundingMode rm,
+                     const BitVector& x,
+                     const BitVector& y) const
+{
+  if (is_nan(x) || is_nan(y))
+  {
+    return mk_nan();
+  }
+  bool sign_res = sign(x) != sign(y);
+  bool inf_x    = is_inf(x);
+  bool inf_y    = is_inf(y);
+  bool zero_x   = is_zero(x);
+  bool zero_y   = is_zero(y);
+  if ((inf_x && inf_y) || (zero_x && zero_y))
+  {
+    return mk_nan();
+  }
+  if (inf_x || zero_y)
+  {
+    return mk_inf(sign_res);
+  }
+  if (inf_y || zero_x)
+  {
+    return mk_zero(sign_res);
+  }
+  // Shift the dividend such that the quotient has at least p + 2 significant
+  // bits, the remainder then only contributes to the sticky bit.
+  Unpacked ux    = unpack(x);
+  Unpacked uy    = unpack(y);
+  uint64_t p     = d_sig_size;
+  uint64_t shift = 2 * p + 1;
+  uint64_t size  = 3 * p + 3;
+  BitVector dividend = resize(ux.d_sig, size).ibvshl(shift);
+  BitVector divisor  = resize(uy.d_sig, size);
+  BitVector quot     = dividend.bvudiv(divisor);
+  bool sticky        = !dividend.bvurem(divisor).is_zero();
+  quot.ibvshl(1);
+  quot.set_bit(0, sticky);
+  return round(rm,
+               sign_res,
+               quot,
+               ux.d_exp - uy.d_exp - static_cast<int64_t>(shift) - 1);
+}
+
+BitVector
+FloatingPointBV::from_fp(RoundingMode rm,
+                         const BitVector& x,
+                         const FloatingPointBV& format) const
+{
+  assert(x.size() == format.size());
+  if (format.is_nan(x))
+  {
+    return mk_nan();
+  }
+  if (format.is_inf(x))
+  {
+    return mk_inf(format.sign(x));
+  }
+  if (format.is_zero(x))
+  {
+    return mk_zero(format.sign(x));
+  }
+  Unpacked ux = format.unpack(x);
+  return round(rm, ux.d_sign, ux.d_sig, ux.d_exp);
+}
+
+BitVector
+FloatingPointBV::from_bv(RoundingMode rm,
+                         const BitVector& x,
+                         bool is_signed) const
+{
+  if (x.is_zero())
+  {
+    return mk_zero(false);
+  }
+  bool sign = is_signed && x.msb();
+  // Note: the negation of the minimum signed value interpreted as unsigned is
+  //       its magnitude.
+  return round(rm, sign, sign ? x.bvneg() : x, 0);
+}
+
+BitVector
+FloatingPointBV::to_bv(const BitVector& x, uint64_t size, bool is_signed) const
+{
+  if (is_nan(x) || is_inf(x))
+  {
+    return BitVector();
+  }
+  if (is_zero(x))
+  {
+    return BitVector::mk_zero(size);
+  }
+  Unpacked ux    = unpack(x);
+  uint64_t limit = is_signed ? size - 1 : size;
+  BitVector mag;
+  if (ux.d_exp >= 0)
+  {
+    uint64_t shift = static_cast<uint64_t>(ux.d_exp);
+    if (num_bits(ux.d_sig) + shift > limit)
+    {
+      return BitVector();
+    }
+    mag = resize(ux.d_sig, std::max(size, d_sig_size)).ibvshl(shift);
+  }
+  else
+  {
+    uint64_t shift = static_cast<uint64_t>(-ux.d_exp);
+    if (shift >= d_sig_size)
+    {
+      mag = BitVector::mk_zero(d_sig_size);
+    }
+    else
+    {
+      mag = ux.d_sig.bvshr(shift);
+    }
+    if (num_bits(mag) > limit)
+    {
+      return BitVector();
+    }
+  }
+  mag = resize(mag, size);
+  if (ux.d_sign && !mag.is_zero())
+  {
+    if (!is_signed)
+    {
+      return BitVector();
+    }
+    mag.ibvneg();
+  }
+  return mag;
+}
+
+BitVector
+FloatingPointBV::next_up(const BitVector& x) const
+{
+  if (is_nan(x) || (is_inf(x) && !sign(x)))
+  {
+    return x;
+  }
+  if (is_zero(x))
+  {
+    return pack(false, 0, BitVector::mk_one(d_sig_size - 1));
+  }
+  // The magnitude of the successor of a positive value is the magnitude of
+  // the value incremented by one, and decremented by one for negative values.
+  return sign(x) ? x.bvdec() : x.bvinc();
+}
+
+BitVector
+FloatingPointBV::next_down(const BitVector& x) const
+{
+  if (is_nan(x))
+  {
+    return x;
+  }
+  return neg(next_up(neg(x)));
+}
+
+/* -------------------------------------------------------------------------- */
+
+uint64_t
+FloatingPointBV::exp_field(const BitVector& x) const
+{
+  assert(x.size() == size());
+  return x.bvextract(size() - 2, d_sig_size - 1).to_uint64();
+}
+
+BitVector
+FloatingPointBV::sig_field(const BitVector& x) const
+{
+  assert(x.size() == size());
+  return x.bvextract(d_sig_size - 2, 0);
+}
+
+BitVector
+FloatingPointBV::pack(bool sign, uint64_t exp, const BitVector& sig) const
+{
+  assert(exp <= d_exp_max);
+  assert(sig.size() == d_sig_size - 1);
+  return BitVector::from_ui(1, sign)
+      .ibvconcat(BitVector::from_ui(d_exp_size, exp))
+      .ibvconcat(sig);
+}
+
+FloatingPointBV::Unpacked
+FloatingPointBV::unpack(const BitVector& x) const
+{
+  assert(!is_nan(x) && !is_inf(x) && !is_zero(x));
+  uint64_t exp  = exp_field(x);
+  int64_t emin  = 1 - d_bias;
+  int64_t shift = static_cast<int64_t>(d_sig_size) - 1;
+  if (exp == 0)
+  {
+    return {sign(x), sig_field(x).bvzext(1), emin - shift};
+  }
+  return {sign(x),
+          BitVector::mk_one(1).ibvconcat(sig_field(x)),
+          static_cast<int64_t>(exp) - d_bias - shift};
+}
+
+BitVector
+FloatingPointBV::round(RoundingMode rm,
+                       bool sign,
+                       const BitVector& sig,
+                       int64_t exp) const
+{
+  assert(!sig.is_zero());
+
+  uint64_t p   = d_sig_size;
+  uint64_t n   = num_bits(sig);
+  int64_t emin = 1 - d_bias;
+  // The exponent of the most significant bit.
+  int64_t e = exp + static_cast<int64_t>(n) - 1;
+  // The exponent of the least significant bit of the rounded significand,
+  // subnormal values have a fixed exponent.
+  int64_t lsb   = std::max(e, emin) - static_cast<int64_t>(p - 1);
+  int64_t shift = lsb - exp;
+
+  // The rounded significand, with one extra bit for overflow on rounding up.
+  BitVector m;
+  bool guard = false, sticky = false;
+  if (shift <= 0)
+  {
+    m = resize(resize(sig, std::max(sig.size(), p + 1))
+                   .ibvshl(static_cast<uint64_t>(-shift)),
+               p + 1);
+  }
+  else
+  {
+    uint64_t s = static_cast<uint64_t>(shift);
+    uint64_t w = sig.size();
+    if (s > w)
+    {
+      m      = BitVector::mk_zero(p + 1);
+      sticky = true;
+    }
+    else
+    {
+      guard  = sig.bit(s - 1);
+      sticky = s > 1 && !sig.bvextract(s - 2, 0).is_zero();
+      m = s == w ? BitVector::mk_zero(p + 1)
+                 : resize(sig.bvextract(w - 1, s), p + 1);
+    }
+  }
+
+  bool inc = false;
+  switch (rm)
+  {
+    case RoundingMode::RNA: inc = guard; break;
+    case RoundingMode::RNE: inc = guard && (sticky || m.lsb()); break;
+    case RoundingMode::RTN: inc = sign && (guard || sticky); break;
+    case RoundingMode::RTP: inc = !sign && (guard || sticky); break;
+    default: assert(rm == RoundingMode::RTZ);
+  }
+  if (inc)
+  {
+    m.ibvinc();
+    if (m.bit(p))
+    {
+      m.ibvshr(1);
+      lsb += 1;
+    }
+  }
+
+  if (m.is_zero())
+  {
+    return mk_zero(sign);
+  }
+  if (!m.bit(p - 1))
+  {
+    // subnormal
+    assert(lsb == emin - static_cast<int64_t>(p - 1));
+    return pack(sign, 0, m.bvextract(p - 2, 0));
+  }
+  int64_t exp_res = lsb + static_cast<int64_t>(p - 1);
+  if (exp_res > d_bias)
+  {
+    // overflow
+    bool to_inf = rm == RoundingMode::RNA || rm == RoundingMode::RNE
+                  || (rm == RoundingMode::RTN && sign)
+                  || (rm == RoundingMode::RTP && !sign);
+    return to_inf ? mk_inf(sign) : mk_max(sign);
+  }
+  return pack(
+      sign, static_cast<uint64_t>(exp_res + d_bias), m.bvextract(p - 2, 0));
+}
+
+}  // namespace bzla::ls
@@ -0,0 +1,235 @@
+/***
+ * Bitwuzla: Satisfiability Modulo Theories (SMT) solver.
+ *
+ * Copyright (C) 2024 by the authors listed in the AUTHORS file at
+ * https://github.com/bitwuzla/bitwuzla/blob/main/AUTHORS
+ *
+ * This file is part of Bitwuzla under the MIT license. See COPYING for more
+ * information at https://github.com/bitwuzla/bitwuzla/blob/main/COPYING
+ */
+
+#ifndef BZLA__LS_FLOATING_POINT_BV_H
+#define BZLA__LS_FLOATING_POINT_BV_H
+
+#include <cstdint>
+
+#include "bv/bitvector.h"
+
+namespace bzla {
+
+class RNG;
+
+namespace ls {
+
+/**
+ * IEEE 754 floating-point arithmetic on bit-vectors.
+ *
+ * An instance of this class represents a floating-point format with exponent
+ * size `eb` and significand size `sb` (including the hidden bit). Values of
+ * this format are bit-vectors of size eb + sb in IEEE 754 interchange format,
+ * i.e., the concatenation of the sign bit, the biased exponent and the
+ * trailing significand, as in SMT-LIB. Operations are computed exactly and
+ * rounded according to the given rounding mode, following the semantics of
+ * the SMT-LIB theory of floating-point arithmetic. Any bit-vector with all
+ * exponent bits set and a non-zero trailing significand is NaN, and
+ * operations that produce NaN always produce the canonical NaN (sign bit 0,
+ * trailing significand 10...0).
+ *
+ * Rounding modes are represented as bit-vectors of size s_rm_size, encoded
+ * as in the word-blaster of Bitwuzla (see RoundingMode). All other values of
+ * that size are invalid rounding modes.
+ */
+class FloatingPointBV
+{
+ public:
+  /** The rounding modes, in the order of their bit-vector encoding. */
+  enum class RoundingMode
+  {
+    RNA,  // roundNearestTiesToAway
+    RNE,  // roundNearestTiesToEven
+    RTN,  // roundTowardNegative
+    RTP,  // roundTowardPositive
+    RTZ,  // roundTowardZero
+    NUM_RM,
+  };
+
+  /** The size of bit-vectors representing rounding modes. */
+  static constexpr uint64_t s_rm_size = 3;
+
+  /**
+   * Create the bit-vector representation of a rounding mode.
+   * @param rm The rounding mode.
+   * @return A bit-vector of size s_rm_size.
+   */
+  static BitVector mk_rm(RoundingMode rm);
+  /**
+   * Get the rounding mode represented by a bit-vector.
+   * @param rm A bit-vector of size s_rm_size.
+   * @return The rounding mode, RNE if `rm` is not a valid rounding mode.
+   */
+  static RoundingMode to_rm(const BitVector& rm);
+  /**
+   * Determine if a bit-vector represents a valid rounding mode.
+   * @param rm A bit-vector of size s_rm_size.
+   * @return True if `rm` represents a rounding mode.
+   */
+  static bool is_rm(const BitVector& rm);
+
+  /**
+   * Constructor.
+   * @param exp_size The exponent size.
+   * @param sig_size The significand size, including the hidden bit.
+   */
+  FloatingPointBV(uint64_t exp_size, uint64_t sig_size);
+
+  /** @return The exponent size. */
+  uint64_t exp_size() const { return d_exp_size; }
+  /** @return The significand size, including the hidden bit. */
+  uint64_t sig_size() const { return d_sig_size; }
+  /** @return The size of bit-vectors representing values of this format. */
+  uint64_t size() const { return d_exp_size + d_sig_size; }
+
+  /** @return The canonical NaN. */
+  BitVector mk_nan() const;
+  /**
+   * @param sign True to create negative infinity.
+   * @return Positive or negative infinity.
+   */
+  BitVector mk_inf(bool sign) const;
+  /**
+   * @param sign True to create negative zero.
+   * @return Positive or negative zero.
+   */
+  BitVector mk_zero(bool sign) const;
+  /**
+   * @param sign True to create -1.0.
+   * @return 1.0 or -1.0.
+   */
+  BitVector mk_one(bool sign) const;
+  /**
+   * @param sign True to create the negative value.
+   * @return The largest (or smallest, if negative) finite value.
+   */
+  BitVector mk_max(bool sign) const;
+  /**
+   * Create a random value.
+   * @param rng The random number generator.
+   * @return A random value, where the exponent is chosen such that special,
+   *         subnormal and normal values close to one are picked with higher
+   *         probability than uniformly distributed bit-vectors.
+   */
+  BitVector mk_random(RNG& rng) const;
+
+  /** @return The sign bit of `x`. */
+  bool sign(const BitVector& x) const { return x.msb(); }
+
+  /** Classification, see fp.isNaN, fp.isInfinite, ... */
+  bool is_nan(const BitVector& x) const;
+  bool is_inf(const BitVector& x) const;
+  bool is_zero(const BitVector& x) const;
+  bool is_normal(const BitVector& x) const;
+  bool is_subnormal(const BitVector& x) const;
+  bool is_neg(const BitVector& x) const;
+  bool is_pos(const BitVector& x) const;
+
+  /** fp.eq: IEEE equality. */
+  bool eq(const BitVector& x, const BitVector& y) const;
+  /** fp.lt: IEEE less than. */
+  bool lt(const BitVector& x, const BitVector& y) const;
+  /** fp.leq: IEEE less than or equal. */
+  bool leq(const BitVector& x, const BitVector& y) const;
+  /** SMT-LIB equality, i.e., all NaNs are equal, +0 and -0 are distinct. */
+  bool smt_eq(const BitVector& x, const BitVector& y) const;
+
+  /** fp.neg */
+  BitVector neg(const BitVector& x) const;
+  /** fp.abs */
+  BitVector abs(const BitVector& x) const;
+  /** fp.add */
+  BitVector add(RoundingMode rm, const BitVector& x, const BitVector& y) const;
+  /** fp.mul */
+  BitVector mul(RoundingMode rm, const BitVector& x, const BitVector& y) const;
+  /** fp.div */
+  BitVector div(RoundingMode rm, const BitVector& x, const BitVector& y) const;
+
+  /**
+   * Convert a value of another format to this format.
+   * @param rm The rounding mode.
+   * @param x A value of format `format`.
+   * @param format The format of `x`.
+   * @return The converted value.
+   */
+  BitVector from_fp(RoundingMode rm,
+                    const BitVector& x,
+                    const FloatingPointBV& format) const;
+  /**
+   * Convert a signed or unsigned bit-vector to this format.
+   * @param rm The rounding mode.
+   * @param x The bit-vector.
+   * @param is_signed True if `x` is interpreted as signed.
+   * @return The converted value.
+   */
+  BitVector from_bv(RoundingMode rm, const BitVector& x, bool is_signed) const;
+  /**
+   * Convert a finite value to a signed or unsigned bit-vector, rounding
+   * toward zero.
+   * @param x The value.
+   * @param size The size of the resulting bit-vector.
+   * @param is_signed True to convert to a signed bit-vector.
+   * @return The converted value, or a null bit-vector if `x` is not finite or
+   *         its integral part is not representable.
+   */
+  BitVector to_bv(const BitVector& x, uint64_t size, bool is_signed) const;
+
+  /** @return The least value greater than `x` (NaN and +oo are returned). */
+  BitVector next_up(const BitVector& x) const;
+  /** @return The greatest value less than `x` (NaN and -oo are returned). */
+  BitVector next_down(const BitVector& x) const;
+
+ private:
+  /**
+   * A finite, non-zero value (-1)^sign * sig * 2^exp with an unbounded
+   * significand and exponent.
+   */
+  struct Unpacked
+  {
+    bool d_sign;
+    BitVector d_sig;
+    int64_t d_exp;
+  };
+
+  /** @return The biased exponent of `x`. */
+  uint64_t exp_field(const BitVector& x) const;
+  /** @return The trailing significand of `x`. */
+  BitVector sig_field(const BitVector& x) const;
+  /** @return The value with given fields. */
+  BitVector pack(bool sign, uint64_t exp, const BitVector& sig) const;
+  /** @return The unpacked representation of finite non-zero value `x`. */
+  Unpacked unpack(const BitVector& x) const;
+  /**
+   * Round (-1)^sign * sig * 2^exp to this format.
+   * @param rm The rounding mode.
+   * @param sign The sign.
+   * @param sig The significand, must not be zero.
+   * @param exp The exponent.
+   * @return The rounded value.
+   */
+  BitVector round(RoundingMode rm,
+                  bool sign,
+                  const BitVector& sig,
+                  int64_t exp) const;
+
+  /** The exponent size. */
+  uint64_t d_exp_size;
+  /** The significand size, including the hidden bit. */
+  uint64_t d_sig_size;
+  /** The exponent bias. */
+  int64_t d_bias;
+  /** The biased exponent of infinity and NaN. */
+  uint64_t d_exp_max;
+};
+
+}  // namespace ls
+}  // namespace bzla
+
+#endif
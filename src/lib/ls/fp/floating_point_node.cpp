@@ -0,0 +1,1011 @@
+/***
+ * Bitwuzla: Satisfiability Modulo Theories (SMT) solver.
+ *
+ * Copyright (C) 2024 by the authors listed in the AUTHORS file at
+ * https://github.com/bitwuzla/bitwuzla/blob/main/AUTHORS
+ *
+ * This file is part of Bitwuzla under the MIT license. See COPYING for more
+ * information at https://github.com/bitwuzla/bitwuzla/blob/main/COPYING
+ */
+
+#include "ls/fp/floating_point_node.h"
+
+#include <cassert>
+
+#include "rng/rng.h"
+
+namespace bzla::ls {
+
+/* -------------------------------------------------------------------------- */
+
+// Note: These macros should never be (member) functions, see
+//       bitvector_node.cpp.
+#define BV_NODE_CACHE_CONSISTENT(val) d_consistent.reset(new BitVector(val))
+#define BV_NODE_CACHE_INVERSE(val) d_inverse.reset(new BitVector(val))
+#define BV_NODE_CACHE_INVERSE_IF(val) \
+  if (!is_essential_check)            \
+  {                                   \
+    BV_NODE_CACHE_INVERSE(val);       \
+  }
+
+using RoundingMode = FloatingPointBV::RoundingMode;
+
+/* -------------------------------------------------------------------------- */
+
+FloatingPointNode::FloatingPointNode(RNG* rng,
+                                     const BitVectorDomain& domain,
+                                     uint64_t exp_size,
+                                     uint64_t sig_size,
+                                     BitVectorNode* child0)
+    : BitVectorNode(rng, domain, child0), d_fp(exp_size, sig_size)
+{
+}
+
+FloatingPointNode::FloatingPointNode(RNG* rng,
+                                     const BitVectorDomain& domain,
+                                     uint64_t exp_size,
+                                     uint64_t sig_size,
+                                     BitVectorNode* child0,
+                                     BitVectorNode* child1)
+    : BitVectorNode(rng, domain, child0, child1), d_fp(exp_size, sig_size)
+{
+}
+
+FloatingPointNode::FloatingPointNode(RNG* rng,
+                                     const BitVectorDomain& domain,
+                                     uint64_t exp_size,
+                                     uint64_t sig_size,
+                                     BitVectorNode* child0,
+                                     BitVectorNode* child1,
+                                     BitVectorNode* child2)
+    : BitVectorNode(rng, domain, child0, child1, child2),
+      d_fp(exp_size, sig_size)
+{
+}
+
+void
+FloatingPointNode::evaluate()
+{
+  Operands ops{};
+  for (uint32_t i = 0; i < d_arity; ++i)
+  {
+    ops[i] = &child(i)->assignment();
+  }
+  d_assignment.iset(compute(ops));
+}
+
+void
+FloatingPointNode::evaluate_and_set_domain()
+{
+  evaluate();
+  if (d_all_value)
+  {
+    if (!d_is_value)
+    {
+      d_domain.fix(d_assignment);
+      d_is_value = true;
+    }
+  }
+  // we cannot assert that the assignment matches const bits, see
+  // BitVectorAdd::_evaluate_and_set_domain()
+}
+
+bool
+FloatingPointNode::is_essential(const BitVector& t, uint64_t pos_x)
+{
+  for (uint32_t i = 0; i < d_arity; ++i)
+  {
+    if (i != pos_x && is_invertible(t, i, true))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool
+FloatingPointNode::is_invertible(const BitVector& t,
+                                 uint64_t pos_x,
+                                 bool is_essential_check)
+{
+  d_inverse.reset(nullptr);
+  d_consistent.reset(nullptr);
+
+  /**
+   * IC: exists candidate c with mfb(x, c) and the value of this node with
+   *     x = c matches t
+   */
+
+  std::vector<BitVector> candidates;
+  if (is_rm_operand(pos_x))
+  {
+    uint64_t num_rm = static_cast<uint64_t>(RoundingMode::NUM_RM);
+    uint64_t offset = d_rng->pick<uint64_t>(0, num_rm - 1);
+    for (uint64_t i = 0; i < num_rm; ++i)
+    {
+      candidates.push_back(FloatingPointBV::mk_rm(
+          static_cast<RoundingMode>((offset + i) % num_rm)));
+    }
+  }
+  else
+  {
+    inverse_candidates(t, pos_x, candidates);
+  }
+
+  const BitVectorDomain& x = child(pos_x)->domain();
+  for (BitVector& c : candidates)
+  {
+    if (x.match_fixed_bits(c) && matches(compute_with(pos_x, c), t))
+    {
+      BV_NODE_CACHE_INVERSE_IF(std::move(c));
+      return true;
+    }
+  }
+  return false;
+}
+
+bool
+FloatingPointNode::is_consistent(const BitVector& t, uint64_t pos_x)
+{
+  d_inverse.reset(nullptr);
+  d_consistent.reset(nullptr);
+
+  /**
+   * CC: true
+   *
+   * Consistent value: random value, or an operator specific approximation
+   *                   of an inverse value
+   */
+
+  const BitVectorDomain& x = child(pos_x)->domain();
+  if (x.is_fixed())
+  {
+    BV_NODE_CACHE_CONSISTENT(x.lo());
+    return true;
+  }
+  if (!is_rm_operand(pos_x))
+  {
+    BitVector res = consistent_candidate(t, pos_x);
+    if (x.match_fixed_bits(res))
+    {
+      BV_NODE_CACHE_CONSISTENT(std::move(res));
+      return true;
+    }
+  }
+  BV_NODE_CACHE_CONSISTENT(random_value(pos_x));
+  return true;
+}
+
+const BitVector&
+FloatingPointNode::inverse_value(const BitVector& t, uint64_t pos_x)
+{
+  (void) t;
+  (void) pos_x;
+#ifndef NDEBUG
+  assert(d_inverse);
+  assert(child(pos_x)->domain().match_fixed_bits(*d_inverse));
+  assert(matches(compute_with(pos_x, *d_inverse), t));
+#endif
+  return *d_inverse;
+}
+
+const BitVector&
+FloatingPointNode::consistent_value(const BitVector& t, uint64_t pos_x)
+{
+  (void) t;
+  (void) pos_x;
+#ifndef NDEBUG
+  assert(d_consistent);
+  assert(child(pos_x)->domain().match_fixed_bits(*d_consistent));
+#endif
+  return *d_consistent;
+}
+
+BitVector
+FloatingPointNode::consistent_candidate(const BitVector& t, uint64_t pos_x)
+{
+  (void) t;
+  return random_operand(pos_x);
+}
+
+BitVector
+FloatingPointNode::random_operand(uint64_t pos)
+{
+  (void) pos;
+  return d_fp.mk_random(*d_rng);
+}
+
+bool
+FloatingPointNode::is_rm_operand(uint64_t pos) const
+{
+  (void) pos;
+  return false;
+}
+
+BitVector
+FloatingPointNode::inverse_candidate_or_random(const BitVector& t,
+                                               uint64_t pos_x)
+{
+  if (d_rng->flip_coin())
+  {
+    std::vector<BitVector> candidates;
+    inverse_candidates(t, pos_x, candidates);
+    if (!candidates.empty())
+    {
+      return candidates[0];
+    }
+  }
+  return random_operand(pos_x);
+}
+
+void
+FloatingPointNode::add_neighbors(const FloatingPointBV& fp,
+                                 const BitVector& x,
+                                 uint64_t n,
+                                 std::vector<BitVector>& res) const
+{
+  res.push_back(x);
+  BitVector up = x, down = x;
+  for (uint64_t i = 0; i < n; ++i)
+  {
+    up   = fp.next_up(up);
+    down = fp.next_down(down);
+    res.push_back(up);
+    res.push_back(down);
+  }
+}
+
+BitVector
+FloatingPointNode::compute_with(uint64_t pos_x, const BitVector& x) const
+{
+  Operands ops{};
+  for (uint32_t i = 0; i < d_arity; ++i)
+  {
+    ops[i] = i == pos_x ? &x : &child(i)->assignment();
+  }
+  return compute(ops);
+}
+
+bool
+FloatingPointNode::matches(const BitVector& value, const BitVector& t) const
+{
+  if (size() == d_fp.size())
+  {
+    return d_fp.smt_eq(value, t);
+  }
+  return value.compare(t) == 0;
+}
+
+BitVector
+FloatingPointNode::random_value(uint64_t pos_x)
+{
+  const BitVectorDomain& x = child(pos_x)->domain();
+  if (x.is_fixed())
+  {
+    return x.lo();
+  }
+  if (x.has_fixed_bits())
+  {
+    BitVectorDomainGenerator gen(x, d_rng);
+    return gen.random();
+  }
+  if (is_rm_operand(pos_x))
+  {
+    uint64_t num_rm = static_cast<uint64_t>(RoundingMode::NUM_RM);
+    return FloatingPointBV::mk_rm(
+        static_cast<RoundingMode>(d_rng->pick<uint64_t>(0, num_rm - 1)));
+  }
+  return random_operand(pos_x);
+}
+
+/* -------------------------------------------------------------------------- */
+
+FloatingPointAbs::FloatingPointAbs(RNG* rng,
+                                   const BitVectorDomain& domain,
+                                   uint64_t exp_size,
+                                   uint64_t sig_size,
+                                   BitVectorNode* child0)
+    : FloatingPointNode(rng, domain, exp_size, sig_size, child0)
+{
+  assert(domain.size() == d_fp.size());
+  assert(child0->size() == d_fp.size());
+  evaluate_and_set_domain();
+}
+
+bool
+FloatingPointAbs::is_consistent(const BitVector& t, uint64_t pos_x)
+{
+  if (d_fp.is_neg(t))
+  {
+    d_inverse.reset(nullptr);
+    d_consistent.reset(nullptr);
+    return false;
+  }
+  return FloatingPointNode::is_consistent(t, pos_x);
+}
+
+BitVector
+FloatingPointAbs::compute(const Operands& ops) const
+{
+  return d_fp.abs(*ops[0]);
+}
+
+void
+FloatingPointAbs::inverse_candidates(const BitVector& t,
+                                     uint64_t pos_x,
+                                     std::vector<BitVector>& res)
+{
+  (void) pos_x;
+  if (d_fp.is_nan(t))
+  {
+    res.push_back(d_fp.mk_nan());
+  }
+  else if (!d_fp.sign(t))
+  {
+    bool neg = d_rng->flip_coin();
+    res.push_back(neg ? d_fp.neg(t) : t);
+    res.push_back(neg ? t : d_fp.neg(t));
+  }
+}
+
+/* -------------------------------------------------------------------------- */
+
+FloatingPointNeg::FloatingPointNeg(RNG* rng,
+                                   const BitVectorDomain& domain,
+                                   uint64_t exp_size,
+                                   uint64_t sig_size,
+                                   BitVectorNode* child0)
+    : FloatingPointNode(rng, domain, exp_size, sig_size, child0)
+{
+  assert(domain.size() == d_fp.size());
+  assert(child0->size() == d_fp.size());
+  evaluate_and_set_domain();
+}
+
+BitVector
+FloatingPointNeg::compute(const Operands& ops) const
+{
+  return d_fp.neg(*ops[0]);
+}
+
+void
+FloatingPointNeg::inverse_candidates(const BitVector& t,
+                                     uint64_t pos_x,
+                                     std::vector<BitVector>& res)
+{
+  (void) pos_x;
+  res.push_back(d_fp.neg(t));
+}
+
+/* -------------------------------------------------------------------------- */
+
+FloatingPointAdd::FloatingPointAdd(RNG* rng,
+                                   const BitVectorDomain& domain,
+                                   uint64_t exp_size,
+                                   uint64_t sig_size,
+                                   BitVectorNode* child0,
+                                   BitVectorNode* child1,
+                                   BitVectorNode* child2)
+    : FloatingPointNode(
+        rng, domain, exp_size, sig_size, child0, child1, child2)
+{
+  assert(domain.size() == d_fp.size());
+  assert(child0->size() == FloatingPointBV::s_rm_size);
+  assert(child1->size() == d_fp.size());
+  assert(child2->size() == d_fp.size());
+  evaluate_and_set_domain();
+}
+
+BitVector
+FloatingPointAdd::compute(const Operands& ops) const
+{
+  return d_fp.add(FloatingPointBV::to_rm(*ops[0]), *ops[1], *ops[2]);
+}
+
+void
+FloatingPointAdd::inverse_candidates(const BitVector& t,
+                                     uint64_t pos_x,
+                                     std::vector<BitVector>& res)
+{
+  assert(pos_x == 1 || pos_x == 2);
+  const BitVector& s = child(3 - pos_x)->assignment();
+  RoundingMode rm    = FloatingPointBV::to_rm(child(0)->assignment());
+
+  if (d_fp.is_nan(t))
+  {
+    res.push_back(d_fp.mk_nan());
+    return;
+  }
+  if (d_fp.is_inf(t))
+  {
+    res.push_back(t);
+    return;
+  }
+  if (d_fp.is_nan(s) || d_fp.is_inf(s))
+  {
+    return;
+  }
+  // Inverse value: t - s
+  add_neighbors(d_fp, d_fp.add(rm, t, d_fp.neg(s)), 2, res);
+  if (d_fp.is_zero(t))
+  {
+    // the sign of zero results depends on the signs of the operands
+    res.push_back(t);
+  }
+}
+
+BitVector
+FloatingPointAdd::consistent_candidate(const BitVector& t, uint64_t pos_x)
+{
+  return inverse_candidate_or_random(t, pos_x);
+}
+
+/* -------------------------------------------------------------------------- */
+
+FloatingPointMul::FloatingPointMul(RNG* rng,
+                                   const BitVectorDomain& domain,
+                                   uint64_t exp_size,
+                                   uint64_t sig_size,
+                                   BitVectorNode* child0,
+                                   BitVectorNode* child1,
+                                   BitVectorNode* child2)
+    : FloatingPointNode(
+        rng, domain, exp_size, sig_size, child0, child1, child2)
+{
+  assert(domain.size() == d_fp.size());
+  assert(child0->size() == FloatingPointBV::s_rm_size);
+  assert(child1->size() == d_fp.size());
+  assert(child2->size() == d_fp.size());
+  evaluate_and_set_domain();
+}
+
+BitVector
+FloatingPointMul::compute(const Operands& ops) const
+{
+  return d_fp.mul(FloatingPointBV::to_rm(*ops[0]), *ops[1], *ops[2]);
+}
+
+void
+FloatingPointMul::inverse_candidates(const BitVector& t,
+                                     uint64_t pos_x,
+                                     std::vector<BitVector>& res)
+{
+  assert(pos_x == 1 || pos_x == 2);
+  const BitVector& s = child(3 - pos_x)->assignment();
+  RoundingMode rm    = FloatingPointBV::to_rm(child(0)->assignment());
+
+  if (d_fp.is_nan(t))
+  {
+    res.push_back(d_fp.mk_nan());
+    return;
+  }
+  if (d_fp.is_nan(s))
+  {
+    return;
+  }
+  bool sign = d_fp.sign(t) != d_fp.sign(s);
+  if (d_fp.is_inf(t))
+  {
+    if (d_fp.is_inf(s))
+    {
+      res.push_back(d_fp.mk_one(sign));
+    }
+    res.push_back(d_fp.mk_inf(sign));
+    return;
+  }
+  if (d_fp.is_zero(t))
+  {
+    res.push_back(d_fp.mk_zero(sign));
+    return;
+  }
+  if (d_fp.is_zero(s) || d_fp.is_inf(s))
+  {
+    return;
+  }
+  // Inverse value: t / s
+  add_neighbors(d_fp, d_fp.div(rm, t, s), 2, res);
+}
+
+BitVector
+FloatingPointMul::consistent_candidate(const BitVector& t, uint64_t pos_x)
+{
+  return inverse_candidate_or_random(t, pos_x);
+}
+
+/* -------------------------------------------------------------------------- */
+
+FloatingPointDiv::FloatingPointDiv(RNG* rng,
+                                   const BitVectorDomain& domain,
+                                   uint64_t exp_size,
+                                   uint64_t sig_size,
+                                   BitVectorNode* child0,
+                                   BitVectorNode* child1,
+                                   BitVectorNode* child2)
+    : FloatingPointNode(
+        rng, domain, exp_size, sig_size, child0, child1, child2)
+{
+  assert(domain.size() == d_fp.size());
+  assert(child0->size() == FloatingPointBV::s_rm_size);
+  assert(child1->size() == d_fp.size());
+  assert(child2->size() == d_fp.size());
+  evaluate_and_set_domain();
+}
+
+BitVector
+FloatingPointDiv::compute(const Operands& ops) const
+{
+  return d_fp.div(FloatingPointBV::to_rm(*ops[0]), *ops[1], *ops[2]);
+}
+
+void
+FloatingPointDiv::inverse_candidates(const BitVector& t,
+                                     uint64_t pos_x,
+                                     std::vector<BitVector>& res)
+{
+  assert(pos_x == 1 || pos_x == 2);
+  const BitVector& s = child(3 - pos_x)->assignment();
+  RoundingMode rm    = FloatingPointBV::to_rm(child(0)->assignment());
+
+  if (d_fp.is_nan(t))
+  {
+    res.push_back(d_fp.mk_nan());
+    return;
+  }
+  if (d_fp.is_nan(s))
+  {
+    return;
+  }
+  bool sign   = d_fp.sign(t) != d_fp.sign(s);
+  bool inf_t  = d_fp.is_inf(t);
+  bool zero_t = d_fp.is_zero(t);
+  bool inf_s  = d_fp.is_inf(s);
+  bool zero_s = d_fp.is_zero(s);
+  if (pos_x == 1)
+  {
+    // x / s = t
+    if (inf_t)
+    {
+      res.push_back(zero_s ? d_fp.mk_one(sign) : d_fp.mk_inf(sign));
+    }
+    else if (zero_t)
+    {
+      res.push_back(inf_s ? d_fp.mk_one(sign) : d_fp.mk_zero(sign));
+    }
+    else if (!inf_s && !zero_s)
+    {
+      // Inverse value: t * s
+      add_neighbors(d_fp, d_fp.mul(rm, t, s), 2, res);
+    }
+  }
+  else
+  {
+    // s / x = t
+    if (inf_t)
+    {
+      res.push_back(inf_s ? d_fp.mk_one(sign) : d_fp.mk_zero(sign));
+    }
+    else if (zero_t)
+    {
+      res.push_back(zero_s ? d_fp.mk_one(sign) : d_fp.mk_inf(sign));
+    }
+    else if (!inf_s && !zero_s)
+    {
+      // Inverse value: s / t
+      add_neighbors(d_fp, d_fp.div(rm, s, t), 2, res);
+    }
+  }
+}
+
+BitVector
+FloatingPointDiv::consistent_candidate(const BitVector& t, uint64_t pos_x)
+{
+  return inverse_candidate_or_random(t, pos_x);
+}
+
+/* -------------------------------------------------------------------------- */
+
+FloatingPointEq::FloatingPointEq(RNG* rng,
+                                 const BitVectorDomain& domain,
+                                 uint64_t exp_size,
+                                 uint64_t sig_size,
+                                 BitVectorNode* child0,
+                                 BitVectorNode* child1)
+    : FloatingPointNode(rng, domain, exp_size, sig_size, child0, child1)
+{
+  assert(domain.size() == 1);
+  assert(child0->size() == d_fp.size());
+  assert(child1->size() == d_fp.size());
+  evaluate_and_set_domain();
+}
+
+BitVector
+FloatingPointEq::compute(const Operands& ops) const
+{
+  return d_fp.smt_eq(*ops[0], *ops[1]) ? BitVector::mk_true()
+                                       : BitVector::mk_false();
+}
+
+void
+FloatingPointEq::inverse_candidates(const BitVector& t,
+                                    uint64_t pos_x,
+                                    std::vector<BitVector>& res)
+{
+  const BitVector& s = child(1 - pos_x)->assignment();
+  if (t.is_true())
+  {
+    res.push_back(d_fp.is_nan(s) ? d_fp.mk_nan() : s);
+  }
+  else
+  {
+    res.push_back(d_fp.mk_random(*d_rng));
+    res.push_back(d_fp.next_up(s));
+    res.push_back(d_fp.next_down(s));
+    res.push_back(d_fp.is_nan(s) ? d_fp.mk_zero(false) : d_fp.mk_nan());
+  }
+}
+
+/* -------------------------------------------------------------------------- */
+
+FloatingPointEqual::FloatingPointEqual(RNG* rng,
+                                       const BitVectorDomain& domain,
+                                       uint64_t exp_size,
+                                       uint64_t sig_size,
+                                       BitVectorNode* child0,
+                                       BitVectorNode* child1)
+    : FloatingPointNode(rng, domain, exp_size, sig_size, child0, child1)
+{
+  assert(domain.size() == 1);
+  assert(child0->size() == d_fp.size());
+  assert(child1->size() == d_fp.size());
+  evaluate_and_set_domain();
+}
+
+BitVector
+FloatingPointEqual::compute(const Operands& ops) const
+{
+  return d_fp.eq(*ops[0], *ops[1]) ? BitVector::mk_true()
+                                   : BitVector::mk_false();
+}
+
+void
+FloatingPointEqual::inverse_candidates(const BitVector& t,
+                                       uint64_t pos_x,
+                                       std::vector<BitVector>& res)
+{
+  const BitVector& s = child(1 - pos_x)->assignment();
+  if (t.is_true())
+  {
+    res.push_back(s);
+    if (d_fp.is_zero(s))
+    {
+      res.push_back(d_fp.neg(s));
+    }
+  }
+  else
+  {
+    res.push_back(d_fp.mk_random(*d_rng));
+    res.push_back(d_fp.next_up(s));
+    res.push_back(d_fp.next_down(s));
+    res.push_back(d_fp.mk_nan());
+  }
+}
+
+/* -------------------------------------------------------------------------- */
+
+FloatingPointLeq::FloatingPointLeq(RNG* rng,
+                                   const BitVectorDomain& domain,
+                                   uint64_t exp_size,
+                                   uint64_t sig_size,
+                                   BitVectorNode* child0,
+                                   BitVectorNode* child1)
+    : FloatingPointNode(rng, domain, exp_size, sig_size, child0, child1)
+{
+  assert(domain.size() == 1);
+  assert(child0->size() == d_fp.size());
+  assert(child1->size() == d_fp.size());
+  evaluate_and_set_domain();
+}
+
+BitVector
+FloatingPointLeq::compute(const Operands& ops) const
+{
+  return d_fp.leq(*ops[0], *ops[1]) ? BitVector::mk_true()
+                                    : BitVector::mk_false();
+}
+
+void
+FloatingPointLeq::inverse_candidates(const BitVector& t,
+                                     uint64_t pos_x,
+                                     std::vector<BitVector>& res)
+{
+  const BitVector& s = child(1 - pos_x)->assignment();
+  BitVector r        = d_fp.mk_random(*d_rng);
+  // Pick random values or values close to s with equal probability.
+  bool random_first = d_rng->flip_coin();
+  if (random_first)
+  {
+    res.push_back(std::move(r));
+  }
+  if (t.is_true())
+  {
+    // x <= s or s <= x
+    res.push_back(s);
+  }
+  else
+  {
+    // s < x or x < s
+    res.push_back(pos_x == 0 ? d_fp.next_up(s) : d_fp.next_down(s));
+    res.push_back(d_fp.mk_nan());
+  }
+  if (!random_first)
+  {
+    res.push_back(std::move(r));
+  }
+}
+
+/* -------------------------------------------------------------------------- */
+
+FloatingPointLt::FloatingPointLt(RNG* rng,
+                                 const BitVectorDomain& domain,
+                                 uint64_t exp_size,
+                                 uint64_t sig_size,
+                                 BitVectorNode* child0,
+                                 BitVectorNode* child1)
+    : FloatingPointNode(rng, domain, exp_size, sig_size, child0, child1)
+{
+  assert(domain.size() == 1);
+  assert(child0->size() == d_fp.size());
+  assert(child1->size() == d_fp.size());
+  evaluate_and_set_domain();
+}
+
+BitVector
+FloatingPointLt::compute(const Operands& ops) const
+{
+  return d_fp.lt(*ops[0], *ops[1]) ? BitVector::mk_true()
+                                   : BitVector::mk_false();
+}
+
+void
+FloatingPointLt::inverse_candidates(const BitVector& t,
+                                    uint64_t pos_x,
+                                    std::vector<BitVector>& res)
+{
+  const BitVector& s = child(1 - pos_x)->assignment();
+  BitVector r        = d_fp.mk_random(*d_rng);
+  // Pick random values or values close to s with equal probability.
+  bool random_first = d_rng->flip_coin();
+  if (random_first)
+  {
+    res.push_back(std::move(r));
+  }
+  if (t.is_true())
+  {
+    // x < s or s < x
+    res.push_back(pos_x == 0 ? d_fp.next_down(s) : d_fp.next_up(s));
+  }
+  else
+  {
+    // s <= x or x <= s
+    res.push_back(s);
+    res.push_back(d_fp.mk_nan());
+  }
+  if (!random_first)
+  {
+    res.push_back(std::move(r));
+  }
+}
+
+/* -------------------------------------------------------------------------- */
+
+FloatingPointIsClass::FloatingPointIsClass(RNG* rng,
+                                           const BitVectorDomain& domain,
+                                           NodeKind kind,
+                                           uint64_t exp_size,
+                                           uint64_t sig_size,
+                                           BitVectorNode* child0)
+    : FloatingPointNode(rng, domain, exp_size, sig_size, child0), d_kind(kind)
+{
+  assert(domain.size() == 1);
+  assert(child0->size() == d_fp.size());
+  assert(kind == NodeKind::FP_IS_INF || kind == NodeKind::FP_IS_NAN
+         || kind == NodeKind::FP_IS_NEG || kind == NodeKind::FP_IS_NORMAL
+         || kind == NodeKind::FP_IS_POS || kind == NodeKind::FP_IS_SUBNORMAL
+         || kind == NodeKind::FP_IS_ZERO);
+  evaluate_and_set_domain();
+}
+
+BitVector
+FloatingPointIsClass::compute(const Operands& ops) const
+{
+  const BitVector& x = *ops[0];
+  bool res;
+  switch (d_kind)
+  {
+    case NodeKind::FP_IS_INF: res = d_fp.is_inf(x); break;
+    case NodeKind::FP_IS_NAN: res = d_fp.is_nan(x); break;
+    case NodeKind::FP_IS_NEG: res = d_fp.is_neg(x); break;
+    case NodeKind::FP_IS_NORMAL: res = d_fp.is_normal(x); break;
+    case NodeKind::FP_IS_POS: res = d_fp.is_pos(x); break;
+    case NodeKind::FP_IS_SUBNORMAL: res = d_fp.is_subnormal(x); break;
+    default:
+      assert(d_kind == NodeKind::FP_IS_ZERO);
+      res = d_fp.is_zero(x);
+  }
+  return res ? BitVector::mk_true() : BitVector::mk_false();
+}
+
+void
+FloatingPointIsClass::inverse_candidates(const BitVector& t,
+                                         uint64_t pos_x,
+                                         std::vector<BitVector>& res)
+{
+  (void) pos_x;
+  bool sign = d_rng->flip_coin();
+  // A random value is a good candidate for all predicates but fp.isNaN,
+  // fp.isInfinite, fp.isZero and fp.isSubnormal with target value true.
+  res.push_back(d_fp.mk_random(*d_rng));
+  if (t.is_false())
+  {
+    res.push_back(d_kind == NodeKind::FP_IS_ZERO ? d_fp.mk_one(sign)
+                                                 : d_fp.mk_zero(sign));
+    res.push_back(d_fp.mk_nan());
+    return;
+  }
+  switch (d_kind)
+  {
+    case NodeKind::FP_IS_INF: res.push_back(d_fp.mk_inf(sign)); break;
+    case NodeKind::FP_IS_NAN: res.push_back(d_fp.mk_nan()); break;
+    case NodeKind::FP_IS_NEG:
+      res.push_back(d_fp.neg(d_fp.abs(res[0])));
+      res.push_back(d_fp.mk_one(true));
+      break;
+    case NodeKind::FP_IS_NORMAL: res.push_back(d_fp.mk_one(sign)); break;
+    case NodeKind::FP_IS_POS:
+      res.push_back(d_fp.abs(res[0]));
+      res.push_back(d_fp.mk_one(false));
+      break;
+    case NodeKind::FP_IS_SUBNORMAL: {
+      // clear the exponent of the random value
+      BitVector x = res[0];
+      for (uint64_t i = d_fp.sig_size() - 1, n = d_fp.size() - 1; i < n; ++i)
+      {
+        x.set_bit(i, false);
+      }
+      if (d_fp.is_zero(x))
+      {
+        x.set_bit(0, true);
+      }
+      res.push_back(std::move(x));
+    }
+    break;
+    default:
+      assert(d_kind == NodeKind::FP_IS_ZERO);
+      res.push_back(d_fp.mk_zero(sign));
+  }
+}
+
+/* -------------------------------------------------------------------------- */
+
+FloatingPointToFpFromFp::FloatingPointToFpFromFp(RNG* rng,
+                                                 const BitVectorDomain& domain,
+                                                 uint64_t exp_size,
+                                                 uint64_t sig_size,
+                                                 uint64_t src_exp_size,
+                                                 uint64_t src_sig_size,
+                                                 BitVectorNode* child0,
+                                                 BitVectorNode* child1)
+    : FloatingPointNode(rng, domain, exp_size, sig_size, child0, child1),
+      d_fp_src(src_exp_size, src_sig_size)
+{
+  assert(domain.size() == d_fp.size());
+  assert(child0->size() == FloatingPointBV::s_rm_size);
+  assert(child1->size() == d_fp_src.size());
+  evaluate_and_set_domain();
+}
+
+BitVector
+FloatingPointToFpFromFp::compute(const Operands& ops) const
+{
+  return d_fp.from_fp(FloatingPointBV::to_rm(*ops[0]), *ops[1], d_fp_src);
+}
+
+void
+FloatingPointToFpFromFp::inverse_candidates(const BitVector& t,
+                                            uint64_t pos_x,
+                                            std::vector<BitVector>& res)
+{
+  (void) pos_x;
+  assert(pos_x == 1);
+  RoundingMode rm = FloatingPointBV::to_rm(child(0)->assignment());
+  // Inverse value: t converted to the source format
+  add_neighbors(d_fp_src, d_fp_src.from_fp(rm, t, d_fp), 1, res);
+}
+
+BitVector
+FloatingPointToFpFromFp::consistent_candidate(const BitVector& t,
+                                              uint64_t pos_x)
+{
+  return inverse_candidate_or_random(t, pos_x);
+}
+
+BitVector
+FloatingPointToFpFromFp::random_operand(uint64_t pos)
+{
+  (void) pos;
+  return d_fp_src.mk_random(*d_rng);
+}
+
+/* -------------------------------------------------------------------------- */
+
+FloatingPointToFpFromBv::FloatingPointToFpFromBv(RNG* rng,
+                                                 const BitVectorDomain& domain,
+                                                 uint64_t exp_size,
+                                                 uint64_t sig_size,
+                                                 bool is_signed,
+                                                 BitVectorNode* child0,
+                                                 BitVectorNode* child1)
+    : FloatingPointNode(rng, domain, exp_size, sig_size, child0, child1),
+      d_signed(is_signed)
+{
+  assert(domain.size() == d_fp.size());
+  assert(child0->size() == FloatingPointBV::s_rm_size);
+  evaluate_and_set_domain();
+}
+
+BitVector
+FloatingPointToFpFromBv::compute(const Operands& ops) const
+{
+  return d_fp.from_bv(FloatingPointBV::to_rm(*ops[0]), *ops[1], d_signed);
+}
+
+void
+FloatingPointToFpFromBv::inverse_candidates(const BitVector& t,
+                                            uint64_t pos_x,
+                                            std::vector<BitVector>& res)
+{
+  (void) pos_x;
+  assert(pos_x == 1);
+  uint64_t size = child(1)->size();
+  if (d_fp.is_nan(t) || (!d_signed && d_fp.is_neg(t) && !d_fp.is_zero(t)))
+  {
+    return;
+  }
+  BitVector x = d_fp.to_bv(t, size, d_signed);
+  if (x.is_null())
+  {
+    // t is infinite or out of range, try the values with largest magnitude
+    if (!d_signed)
+    {
+      res.push_back(BitVector::mk_ones(size));
+    }
+    else
+    {
+      res.push_back(d_fp.sign(t) ? BitVector::mk_min_signed(size)
+                                 : BitVector::mk_max_signed(size));
+    }
+    return;
+  }
+  // Inverse value: t converted to a bit-vector, or its neighbors if t is
+  // rounded
+  res.push_back(x);
+  res.push_back(x.bvinc());
+  res.push_back(x.bvdec());
+}
+
+BitVector
+FloatingPointToFpFromBv::consistent_candidate(const BitVector& t,
+                                              uint64_t pos_x)
+{
+  return inverse_candidate_or_random(t, pos_x);
+}
+
+BitVector
+FloatingPointToFpFromBv::random_operand(uint64_t pos)
+{
+  return BitVector(child(pos)->size(), *d_rng);
+}
+
+/* -------------------------------------------------------------------------- */
+
+}  // namespace bzla::ls
@@ -0,0 +1,497 @@
+/***
+ * Bitwuzla: Satisfiability Modulo Theories (SMT) solver.
+ *
+ * Copyright (C) 2024 by the authors listed in the AUTHORS file at
+ * https://github.com/bitwuzla/bitwuzla/blob/main/AUTHORS
+ *
+ * This file is part of Bitwuzla under the MIT license. See COPYING for more
+ * information at https://github.com/bitwuzla/bitwuzla/blob/main/COPYING
+ */
+
+#ifndef BZLA__LS_FLOATING_POINT_NODE_H
+#define BZLA__LS_FLOATING_POINT_NODE_H
+
+#include <array>
+#include <vector>
+
+#include "ls/bv/bitvector_node.h"
+#include "ls/fp/floating_point_bv.h"
+
+namespace bzla::ls {
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * Base class for floating-point operators.
+ *
+ * Floating-point and rounding mode values are represented as bit-vectors (see
+ * FloatingPointBV), which allows to mix floating-point operators with
+ * bit-vector operators in the same local search graph.
+ *
+ * Inverse values are computed by enumerating a small set of candidate values
+ * that are derived from the target value and the assignment of the other
+ * operands (e.g., t - s for fp.add), of which the first candidate that
+ * produces the target value is picked. Rounding mode operands are inverted by
+ * enumerating all rounding modes. Since rounding is not invertible in general,
+ * candidates include neighboring values of the exact inverse.
+ */
+class FloatingPointNode : public BitVectorNode
+{
+ public:
+  bool is_essential(const BitVector& t, uint64_t pos_x) override;
+
+  bool is_invertible(const BitVector& t,
+                     uint64_t pos_x,
+                     bool is_essential_check = false) override;
+
+  bool is_consistent(const BitVector& t, uint64_t pos_x) override;
+
+  const BitVector& inverse_value(const BitVector& t, uint64_t pos_x) override;
+
+  const BitVector& consistent_value(const BitVector& t,
+                                    uint64_t pos_x) override;
+
+  void evaluate() override;
+
+  /**
+   * Get the floating-point format of this node.
+   * @return The format of the value of this node if it is a floating-point
+   *         operator, and the format of its operands if it is a predicate.
+   */
+  const FloatingPointBV& format() const { return d_fp; }
+
+ protected:
+  /** The operand values passed to compute(). */
+  using Operands = std::array<const BitVector*, 3>;
+
+  FloatingPointNode(RNG* rng,
+                    const BitVectorDomain& domain,
+                    uint64_t exp_size,
+                    uint64_t sig_size,
+                    BitVectorNode* child0);
+  FloatingPointNode(RNG* rng,
+                    const BitVectorDomain& domain,
+                    uint64_t exp_size,
+                    uint64_t sig_size,
+                    BitVectorNode* child0,
+                    BitVectorNode* child1);
+  FloatingPointNode(RNG* rng,
+                    const BitVectorDomain& domain,
+                    uint64_t exp_size,
+                    uint64_t sig_size,
+                    BitVectorNode* child0,
+                    BitVectorNode* child1,
+                    BitVectorNode* child2);
+
+  /**
+   * Compute the value of this node for the given operand values.
+   * @param ops The operand values, in the order of the children.
+   * @return The value.
+   */
+  virtual BitVector compute(const Operands& ops) const = 0;
+  /**
+   * Collect candidates for an inverse value of the operand at index `pos_x`
+   * wrt. to target value `t` and the current assignment of the other
+   * operands. Candidates are checked by the caller.
+   * @param t     The target value.
+   * @param pos_x The index of operand `x`, not a rounding mode operand.
+   * @param res   The resulting candidates, in order of preference.
+   */
+  virtual void inverse_candidates(const BitVector& t,
+                                  uint64_t pos_x,
+                                  std::vector<BitVector>& res) = 0;
+  /**
+   * Get a candidate for a consistent value of the operand at index `pos_x`.
+   * @param t     The target value.
+   * @param pos_x The index of operand `x`, not a rounding mode operand.
+   * @return A random value of the operand by default.
+   */
+  virtual BitVector consistent_candidate(const BitVector& t, uint64_t pos_x);
+  /**
+   * Get a random value for the operand at index `pos`.
+   * @param pos The index of the operand, not a rounding mode operand.
+   * @return A random floating-point value of this format by default.
+   */
+  virtual BitVector random_operand(uint64_t pos);
+  /** @return True if the operand at index `pos` is a rounding mode. */
+  virtual bool is_rm_operand(uint64_t pos) const;
+
+  /**
+   * Evaluate the assignment and fix the domain on construction when all
+   * operands are constant. Must be called from the constructors of derived
+   * classes (compute() is pure virtual and cannot be called from the
+   * constructor of this class).
+   */
+  void evaluate_and_set_domain();
+  /**
+   * Helper for consistent value computation of operators where the first
+   * inverse candidate is a good approximation even if it does not produce
+   * the target value (e.g., due to rounding).
+   * @return The first inverse candidate with probability 0.5 if there is any,
+   *         else a random value.
+   */
+  BitVector inverse_candidate_or_random(const BitVector& t, uint64_t pos_x);
+  /**
+   * Add `x` and its `n` next greater and smaller values (of given format) to
+   * the given candidates.
+   */
+  void add_neighbors(const FloatingPointBV& fp,
+                     const BitVector& x,
+                     uint64_t n,
+                     std::vector<BitVector>& res) const;
+
+  /** The floating-point format, see format(). */
+  FloatingPointBV d_fp;
+
+ private:
+  /**
+   * Compute the value of this node with the assignment of the operand at
+   * index `pos_x` replaced by `x`.
+   */
+  BitVector compute_with(uint64_t pos_x, const BitVector& x) const;
+  /**
+   * Determine if `value` matches target value `t`. For floating-point
+   * operators, all NaNs match.
+   */
+  bool matches(const BitVector& value, const BitVector& t) const;
+  /** @return A random value for the operand at `pos_x` within its domain. */
+  BitVector random_value(uint64_t pos_x);
+};
+
+/* -------------------------------------------------------------------------- */
+
+class FloatingPointAbs final : public FloatingPointNode
+{
+ public:
+  FloatingPointAbs(RNG* rng,
+                   const BitVectorDomain& domain,
+                   uint64_t exp_size,
+                   uint64_t sig_size,
+                   BitVectorNode* child0);
+
+  NodeKind kind() const override { return NodeKind::FP_ABS; }
+
+  /**
+   * CC: t is not negative
+   */
+  bool is_consistent(const BitVector& t, uint64_t pos_x) override;
+
+ protected:
+  BitVector compute(const Operands& ops) const override;
+  void inverse_candidates(const BitVector& t,
+                          uint64_t pos_x,
+                          std::vector<BitVector>& res) override;
+};
+
+/* -------------------------------------------------------------------------- */
+
+class FloatingPointNeg final : public FloatingPointNode
+{
+ public:
+  FloatingPointNeg(RNG* rng,
+                   const BitVectorDomain& domain,
+                   uint64_t exp_size,
+                   uint64_t sig_size,
+                   BitVectorNode* child0);
+
+  NodeKind kind() const override { return NodeKind::FP_NEG; }
+
+ protected:
+  BitVector compute(const Operands& ops) const override;
+  void inverse_candidates(const BitVector& t,
+                          uint64_t pos_x,
+                          std::vector<BitVector>& res) override;
+};
+
+/* -------------------------------------------------------------------------- */
+
+/** Floating-point addition, with the rounding mode as operand 0. */
+class FloatingPointAdd final : public FloatingPointNode
+{
+ public:
+  FloatingPointAdd(RNG* rng,
+                   const BitVectorDomain& domain,
+                   uint64_t exp_size,
+                   uint64_t sig_size,
+                   BitVectorNode* child0,
+                   BitVectorNode* child1,
+                   BitVectorNode* child2);
+
+  NodeKind kind() const override { return NodeKind::FP_ADD; }
+
+ protected:
+  BitVector compute(const Operands& ops) const override;
+  /**
+   * Inverse value candidates: t - s and its neighbors
+   */
+  void inverse_candidates(const BitVector& t,
+                          uint64_t pos_x,
+                          std::vector<BitVector>& res) override;
+  BitVector consistent_candidate(const BitVector& t, uint64_t pos_x) override;
+  bool is_rm_operand(uint64_t pos) const override { return pos == 0; }
+};
+
+/* -------------------------------------------------------------------------- */
+
+/** Floating-point multiplication, with the rounding mode as operand 0. */
+class FloatingPointMul final : public FloatingPointNode
+{
+ public:
+  FloatingPointMul(RNG* rng,
+                   const BitVectorDomain& domain,
+                   uint64_t exp_size,
+                   uint64_t sig_size,
+                   BitVectorNode* child0,
+                   BitVectorNode* child1,
+                   BitVectorNode* child2);
+
+  NodeKind kind() const override { return NodeKind::FP_MUL; }
+
+ protected:
+  BitVector compute(const Operands& ops) const override;
+  /**
+   * Inverse value candidates: t / s and its neighbors
+   */
+  void inverse_candidates(const BitVector& t,
+                          uint64_t pos_x,
+                          std::vector<BitVector>& res) override;
+  BitVector consistent_candidate(const BitVector& t, uint64_t pos_x) override;
+  bool is_rm_operand(uint64_t pos) const override { return pos == 0; }
+};
+
+/* -------------------------------------------------------------------------- */
+
+/** Floating-point division, with the rounding mode as operand 0. */
+class FloatingPointDiv final : public FloatingPointNode
+{
+ public:
+  FloatingPointDiv(RNG* rng,
+                   const BitVectorDomain& domain,
+                   uint64_t exp_size,
+                   uint64_t sig_size,
+                   BitVectorNode* child0,
+                   BitVectorNode* child1,
+                   BitVectorNode* child2);
+
+  NodeKind kind() const override { return NodeKind::FP_DIV; }
+
+ protected:
+  BitVector compute(const Operands& ops) const override;
+  /**
+   * Inverse value candidates:
+   *   pos_x = 1: t * s and its neighbors
+   *   pos_x = 2: s / t and its neighbors
+   */
+  void inverse_candidates(const BitVector& t,
+                          uint64_t pos_x,
+                          std::vector<BitVector>& res) override;
+  BitVector consistent_candidate(const BitVector& t, uint64_t pos_x) override;
+  bool is_rm_operand(uint64_t pos) const override { return pos == 0; }
+};
+
+/* -------------------------------------------------------------------------- */
+
+/** SMT-LIB equality over floating-point values, i.e., all NaNs are equal. */
+class FloatingPointEq final : public FloatingPointNode
+{
+ public:
+  FloatingPointEq(RNG* rng,
+                  const BitVectorDomain& domain,
+                  uint64_t exp_size,
+                  uint64_t sig_size,
+                  BitVectorNode* child0,
+                  BitVectorNode* child1);
+
+  NodeKind kind() const override { return NodeKind::FP_EQ; }
+
+ protected:
+  BitVector compute(const Operands& ops) const override;
+  void inverse_candidates(const BitVector& t,
+                          uint64_t pos_x,
+                          std::vector<BitVector>& res) override;
+};
+
+/* -------------------------------------------------------------------------- */
+
+/** IEEE equality (fp.eq). */
+class FloatingPointEqual final : public FloatingPointNode
+{
+ public:
+  FloatingPointEqual(RNG* rng,
+                     const BitVectorDomain& domain,
+                     uint64_t exp_size,
+                     uint64_t sig_size,
+                     BitVectorNode* child0,
+                     BitVectorNode* child1);
+
+  NodeKind kind() const override { return NodeKind::FP_EQUAL; }
+
+ protected:
+  BitVector compute(const Operands& ops) const override;
+  void inverse_candidates(const BitVector& t,
+                          uint64_t pos_x,
+                          std::vector<BitVector>& res) override;
+};
+
+/* -------------------------------------------------------------------------- */
+
+class FloatingPointLeq final : public FloatingPointNode
+{
+ public:
+  FloatingPointLeq(RNG* rng,
+                   const BitVectorDomain& domain,
+                   uint64_t exp_size,
+                   uint64_t sig_size,
+                   BitVectorNode* child0,
+                   BitVectorNode* child1);
+
+  NodeKind kind() const override { return NodeKind::FP_LEQ; }
+
+ protected:
+  BitVector compute(const Operands& ops) const override;
+  void inverse_candidates(const BitVector& t,
+                          uint64_t pos_x,
+                          std::vector<BitVector>& res) override;
+};
+
+/* -------------------------------------------------------------------------- */
+
+class FloatingPointLt final : public FloatingPointNode
+{
+ public:
+  FloatingPointLt(RNG* rng,
+                  const BitVectorDomain& domain,
+                  uint64_t exp_size,
+                  uint64_t sig_size,
+                  BitVectorNode* child0,
+                  BitVectorNode* child1);
+
+  NodeKind kind() const override { return NodeKind::FP_LT; }
+
+ protected:
+  BitVector compute(const Operands& ops) const override;
+  void inverse_candidates(const BitVector& t,
+                          uint64_t pos_x,
+                          std::vector<BitVector>& res) override;
+};
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * Floating-point classification predicates (fp.isInfinite, fp.isNaN,
+ * fp.isNegative, fp.isNormal, fp.isPositive, fp.isSubnormal, fp.isZero).
+ */
+class FloatingPointIsClass final : public FloatingPointNode
+{
+ public:
+  /**
+   * Constructor.
+   * @param kind The kind of the predicate, one of NodeKind::FP_IS_*.
+   */
+  FloatingPointIsClass(RNG* rng,
+                       const BitVectorDomain& domain,
+                       NodeKind kind,
+                       uint64_t exp_size,
+                       uint64_t sig_size,
+                       BitVectorNode* child0);
+
+  NodeKind kind() const override { return d_kind; }
+
+ protected:
+  BitVector compute(const Operands& ops) const override;
+  void inverse_candidates(const BitVector& t,
+                          uint64_t pos_x,
+                          std::vector<BitVector>& res) override;
+
+ private:
+  /** The kind of the predicate. */
+  NodeKind d_kind;
+};
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * Conversion from another floating-point format, with the rounding mode as
+ * operand 0.
+ */
+class FloatingPointToFpFromFp final : public FloatingPointNode
+{
+ public:
+  /**
+   * Constructor.
+   * @param exp_size     The exponent size of the target format.
+   * @param sig_size     The significand size of the target format.
+   * @param src_exp_size The exponent size of the source format.
+   * @param src_sig_size The significand size of the source format.
+   */
+  FloatingPointToFpFromFp(RNG* rng,
+                          const BitVectorDomain& domain,
+                          uint64_t exp_size,
+                          uint64_t sig_size,
+                          uint64_t src_exp_size,
+                          uint64_t src_sig_size,
+                          BitVectorNode* child0,
+                          BitVectorNode* child1);
+
+  NodeKind kind() const override { return NodeKind::FP_TO_FP_FROM_FP; }
+
+ protected:
+  BitVector compute(const Operands& ops) const override;
+  void inverse_candidates(const BitVector& t,
+                          uint64_t pos_x,
+                          std::vector<BitVector>& res) override;
+  BitVector consistent_candidate(const BitVector& t, uint64_t pos_x) override;
+  BitVector random_operand(uint64_t pos) override;
+  bool is_rm_operand(uint64_t pos) const override { return pos == 0; }
+
+ private:
+  /** The source format. */
+  FloatingPointBV d_fp_src;
+};
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * Conversion from a signed or unsigned bit-vector, with the rounding mode as
+ * operand 0.
+ */
+class FloatingPointToFpFromBv final : public FloatingPointNode
+{
+ public:
+  /**
+   * Constructor.
+   * @param is_signed True to interpret the bit-vector operand as signed.
+   */
+  FloatingPointToFpFromBv(RNG* rng,
+                          const BitVectorDomain& domain,
+                          uint64_t exp_size,
+                          uint64_t sig_size,
+                          bool is_signed,
+                          BitVectorNode* child0,
+                          BitVectorNode* child1);
+
+  NodeKind kind() const override
+  {
+    return d_signed ? NodeKind::FP_TO_FP_FROM_SBV
+                    : NodeKind::FP_TO_FP_FROM_UBV;
+  }
+
+ protected:
+  BitVector compute(const Operands& ops) const override;
+  void inverse_candidates(const BitVector& t,
+                          uint64_t pos_x,
+                          std::vector<BitVector>& res) override;
+  BitVector consistent_candidate(const BitVector& t, uint64_t pos_x) override;
+  BitVector random_operand(uint64_t pos) override;
+  bool is_rm_operand(uint64_t pos) const override { return pos == 0; }
+
+ private:
+  /** True if the bit-vector operand is interpreted as signed. */
+  bool d_signed;
+};
+
+/* -------------------------------------------------------------------------- */
+
+}  // namespace bzla::ls
+
+#endif
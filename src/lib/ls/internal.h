@@ -33,6 +33,15 @@ struct LocalSearch<VALUE>::StatisticsInternal
 
   uint64_t& num_conflicts;
 
+  uint64_t& num_weight_increases;
+  uint64_t& num_weight_smoothings;
+  uint64_t& num_score_updates;
+
+  uint64_t& num_restarts;
+
+  uint64_t& num_inverse_memo_hits;
+  uint64_t& num_inverse_memo_misses;
+
 #ifndef NDEBUG
   util::HistogramStatistic& num_inv_values;
   util::HistogramStatistic& num_cons_values;
@@ -59,6 +68,17 @@ LocalSearch<VALUE>::StatisticsInternal::StatisticsInternal(
       num_props_inv(stats.new_stat<uint64_t>(prefix + "num_props_inv")),
       num_props_cons(stats.new_stat<uint64_t>(prefix + "num_props_cons")),
       num_conflicts(stats.new_stat<uint64_t>(prefix + "num_conflicts")),
+      num_weight_increases(
+          stats.new_stat<uint64_t>(prefix + "num_weight_increases")),
+      num_weight_smoothings(
+          stats.new_stat<uint64_t>(prefix + "num_weight_smoothings")),
+      num_score_updates(
+          stats.new_stat<uint64_t>(prefix + "num_score_updates")),
+      num_restarts(stats.new_stat<uint64_t>(prefix + "num_restarts")),
+      num_inverse_memo_hits(
+          stats.new_stat<uint64_t>(prefix + "num_inverse_memo_hits")),
+      num_inverse_memo_misses(
+          stats.new_stat<uint64_t>(prefix + "num_inverse_memo_misses")),
 #ifndef NDEBUG
       num_inv_values(
           stats.new_stat<util::HistogramStatistic>(prefix + "num_inv_values")),
@@ -33,6 +33,62 @@ class OstreamVoider
 
 /* -------------------------------------------------------------------------- */
 
+namespace {
+
+/**
+ * Call `fun` on given node. Generic fallback for non-bit-vector nodes, which
+ * are called through the virtual interface.
+ */
+template <class VALUE, class Fun>
+decltype(auto)
+dispatch(NodeKind kind, Node<VALUE>* node, Fun&& fun)
+{
+  (void) kind;
+  return fun(node);
+}
+
+/**
+ * Call `fun` on given bit-vector node, cast to its concrete type according to
+ * its kind. Bit-vector node classes are final, thus the calls to evaluate(),
+ * is_invertible() etc. in `fun` (and the virtual calls these make on the node
+ * itself) are resolved statically. Leaf and floating-point nodes are called
+ * through the virtual interface.
+ * @param kind The kind of the node (see LocalSearch::d_kinds).
+ * @param node The node.
+ * @param fun  The function to call, with the (cast) node as argument.
+ */
+template <class Fun>
+decltype(auto)
+dispatch(NodeKind kind, Node<BitVector>* node, Fun&& fun)
+{
+  BitVectorNode* n = static_cast<BitVectorNode*>(node);
+  switch (kind)
+  {
+    case NodeKind::BV_ADD: return fun(static_cast<BitVectorAdd*>(n));
+    case NodeKind::BV_AND: return fun(static_cast<BitVectorAnd*>(n));
+    case NodeKind::BV_ASHR: return fun(static_cast<BitVectorAshr*>(n));
+    case NodeKind::BV_CONCAT: return fun(static_cast<BitVectorConcat*>(n));
+    case NodeKind::BV_EXTRACT: return fun(static_cast<BitVectorExtract*>(n));
+    case NodeKind::BV_MUL: return fun(static_cast<BitVectorMul*>(n));
+    case NodeKind::BV_NOT: return fun(static_cast<BitVectorNot*>(n));
+    case NodeKind::BV_SEXT: return fun(static_cast<BitVectorSignExtend*>(n));
+    case NodeKind::BV_SHL: return fun(static_cast<BitVectorShl*>(n));
+    case NodeKind::BV_SHR: return fun(static_cast<BitVectorShr*>(n));
+    case NodeKind::BV_SLT: return fun(static_cast<BitVectorSlt*>(n));
+    case NodeKind::BV_UDIV: return fun(static_cast<BitVectorUdiv*>(n));
+    case NodeKind::BV_ULT: return fun(static_cast<BitVectorUlt*>(n));
+    case NodeKind::BV_UREM: return fun(static_cast<BitVectorUrem*>(n));
+    case NodeKind::BV_XOR: return fun(static_cast<BitVectorXor*>(n));
+    case NodeKind::EQ: return fun(static_cast<BitVectorEq*>(n));
+    case NodeKind::ITE: return fun(static_cast<BitVectorIte*>(n));
+    default: return fun(n);
+  }
+}
+
+}  // namespace
+
+/* -------------------------------------------------------------------------- */
+
 std::ostream&
 operator<<(std::ostream& out, const NodeKind& kind)
 {
@@ -42,6 +98,31 @@ operator<<(std::ostream& out, const NodeKind& kind)
 
 /* -------------------------------------------------------------------------- */
 
+namespace {
+/**
+ * Compute the i-th element of the Luby sequence 1, 1, 2, 1, 1, 2, 4, ...
+ * @param i The index of the element, starting at 1.
+ * @return The i-th element of the Luby sequence.
+ */
+uint64_t
+luby(uint64_t i)
+{
+  assert(i > 0);
+  uint64_t k = 1;
+  while ((uint64_t{1} << k) - 1 < i)
+  {
+    ++k;
+  }
+  if ((uint64_t{1} << k) - 1 == i)
+  {
+    return uint64_t{1} << (k - 1);
+  }
+  return luby(i - (uint64_t{1} << (k - 1)) + 1);
+}
+}  // namespace
+
+/* -------------------------------------------------------------------------- */
+
 template <class VALUE>
 struct LocalSearchMove
 {
@@ -144,6 +225,8 @@ LocalSearch<VALUE>::statistics() const
           stats.num_props_inv,
           stats.num_props_cons,
           stats.num_conflicts,
+          stats.num_inverse_memo_hits,
+          stats.num_inverse_memo_misses,
 #ifndef NDEBUG
           num_inv_values,
           num_cons_values,
@@ -156,8 +239,11 @@ template <class VALUE>
 void
 LocalSearch<VALUE>::init()
 {
-  Node<VALUE>::s_path_sel_essential  = d_options.use_path_sel_essential;
-  Node<VALUE>::s_prob_pick_ess_input = d_options.prob_pick_ess_input;
+  for (size_t i = 0, size = d_nodes.size(); i < size; ++i)
+  {
+    d_nodes[i]->set_path_sel(d_options.use_path_sel_essential,
+                             d_options.prob_pick_ess_input);
+  }
 }
 
 template <class VALUE>
@@ -207,7 +293,10 @@ LocalSearch<VALUE>::pop()
       assert(it != d_roots_cnt.end());
       if (it->second == 1)
       {
-        d_roots_unsat.erase(id);
+        if (d_roots_unsat.erase(id) && d_options.use_root_weights)
+        {
+          d_weights_unsat.add(id, -static_cast<int64_t>(d_root_weights[id]));
+        }
         d_roots_ineq.erase(root);
         root->set_is_root(false);
         d_roots_cnt.erase(it);
@@ -217,6 +306,10 @@ LocalSearch<VALUE>::pop()
         it->second -= 1;
       }
     }
+    if (d_options.use_restarts)
+    {
+      init_best();
+    }
   }
 }
 
@@ -265,6 +358,15 @@ LocalSearch<VALUE>::register_root(uint64_t id, bool fixed)
   {
     it->second += 1;
   }
+  else if (d_options.use_root_weights)
+  {
+    if (d_root_weights.size() <= id)
+    {
+      d_root_weights.resize(id + 1, 1);
+      d_weights_unsat.resize(id + 1);
+    }
+    set_root_weight(id, 1);
+  }
   // register inequality root
   if (root->is_inequality())
   {
@@ -276,6 +378,41 @@ LocalSearch<VALUE>::register_root(uint64_t id, bool fixed)
   }
   // update set of unsat roots
   update_unsat_roots(root);
+  if (d_options.use_restarts)
+  {
+    init_best();
+  }
+}
+
+template <class VALUE>
+void
+LocalSearch<VALUE>::init_best()
+{
+  d_best_diff.clear();
+  d_best_num_unsat = d_roots_unsat.size();
+  d_best_num_moves = 0;
+  d_num_restarts   = 0;
+  d_restart_limit  = d_options.restart_base * luby(1);
+}
+
+template <class VALUE>
+void
+LocalSearch<VALUE>::restore_best()
+{
+  if (!d_options.use_restarts)
+  {
+    return;
+  }
+  StatisticsInternal& stats = d_internal->d_stats;
+  // The assignments of all other nodes are determined by the assignments of
+  // the inputs, hence restoring the inputs restores the best assignment.
+  for (const auto& [input, assignment] : d_best_diff)
+  {
+    stats.num_updates += update_cone(input, assignment);
+  }
+  d_best_diff.clear();
+  d_best_num_moves = 0;
+  assert(d_roots_unsat.size() == d_best_num_unsat);
 }
 
 template <class VALUE>
@@ -303,7 +440,7 @@ LocalSearch<VALUE>::get_node(uint64_t id) const
 {
   assert(id < d_nodes.size());
   assert(d_nodes[id]->id() == id);
-  return d_nodes[id].get();
+  return d_nodes[id];
 }
 
 template <class VALUE>
@@ -372,9 +509,13 @@ LocalSearch<VALUE>::select_move(Node<VALUE>* root, const VALUE& t_root)
       }
       Log(1) << "    *> target value: " << t;
 
+      NodeKind kind = d_kinds[cur->id()];
+
       /* Select path */
       auto [pos_x, all_but_one_const, checked_essential] =
-          cur->select_path(t, ess_inputs);
+          dispatch(kind, cur, [&](auto* n) {
+            return n->select_path(t, ess_inputs);
+          });
       assert(pos_x < arity);
 
       Log(1) << "    *> select path: node[" << pos_x << "]";
@@ -431,18 +572,26 @@ LocalSearch<VALUE>::select_move(Node<VALUE>* root, const VALUE& t_root)
 
       if ((all_but_one_const
            || d_rng->pick_with_prob(d_options.prob_pick_inv_value))
-          && cur->is_invertible(t, pos_x))
+          && dispatch(kind, cur, [&](auto* n) {
+               return n->is_invertible(t, pos_x, false);
+             }))
       {
-        t = cur->inverse_value(t, pos_x);
+        t = dispatch(kind, cur, [&](auto* n) -> const VALUE& {
+          return n->inverse_value(t, pos_x);
+        });
         Log(1) << "    *> select inverse value: " << t;
         stats.num_props_inv += 1;
 #ifndef NDEBUG
         stats.num_inv_values << cur->kind();
 #endif
       }
-      else if (cur->is_consistent(t, pos_x))
+      else if (dispatch(kind, cur, [&](auto* n) {
+                 return n->is_consistent(t, pos_x);
+               }))
       {
-        t = cur->consistent_value(t, pos_x);
+        t = dispatch(kind, cur, [&](auto* n) -> const VALUE& {
+          return n->consistent_value(t, pos_x);
+        });
         Log(1) << "    *> select consistent value: " << t;
         stats.num_props_cons += 1;
 #ifndef NDEBUG
@@ -479,19 +628,22 @@ LocalSearch<VALUE>::update_unsat_roots(Node<VALUE>* root)
   assert(root->is_root());
 
   uint64_t id = root->id();
-  auto it     = d_roots_unsat.find(id);
-  if (it != d_roots_unsat.end())
+  if (root->assignment().is_true())
   {
-    if (root->assignment().is_true())
+    /* remove from unsatisfied roots list */
+    if (d_roots_unsat.erase(id) && d_options.use_root_weights)
     {
-      /* remove from unsatisfied roots list */
-      d_roots_unsat.erase(it);
+      d_weights_unsat.add(id, -static_cast<int64_t>(d_root_weights[id]));
     }
   }
-  else if (root->assignment().is_false())
+  else
   {
     /* add to unsatisfied roots list */
-    d_roots_unsat.insert(id);
+    assert(root->assignment().is_false());
+    if (d_roots_unsat.insert(id) && d_options.use_root_weights)
+    {
+      d_weights_unsat.add(id, static_cast<int64_t>(d_root_weights[id]));
+    }
   }
 }
 
@@ -502,7 +654,9 @@ LocalSearch<VALUE>::normalize_ids()
   if (d_roots.empty()) return;
 
   uint64_t id = 0;
-  std::unordered_map<Node<VALUE>*, bool> cache;
+  // Visit marks indexed by node id: 0 = not visited, 1 = visited, 2 = done.
+  // Node ids are dense, which avoids hashing on this hot path.
+  std::vector<uint8_t> cache(d_nodes.size(), 0);
 
   std::vector<Node<VALUE>*> visit;
   for (auto root : d_roots)
@@ -512,25 +666,82 @@ LocalSearch<VALUE>::normalize_ids()
 
   do
   {
-    Node<VALUE>* cur    = visit.back();
-    auto [it, inserted] = cache.emplace(cur, true);
-    if (inserted)
+    Node<VALUE>* cur = visit.back();
+    uint8_t& mark    = cache[cur->id()];
+    if (mark == 0)
     {
+      mark = 1;
       for (uint32_t i = 0, n = cur->arity(); i < n; ++i)
       {
         visit.push_back((*cur)[i]);
       }
       continue;
     }
-    else if (it->second)
+    else if (mark == 1)
     {
-      it->second = false;
+      mark = 2;
       cur->set_normalized_id(id++);
     }
     visit.pop_back();
   } while (!visit.empty());
 }
 
+template <class VALUE>
+void
+LocalSearch<VALUE>::collect_cone(Node<VALUE>* node)
+{
+  if (d_cone_marks.size() < d_nodes.size())
+  {
+    d_cone_marks.resize(d_nodes.size(), 0);
+    d_cone_pending.resize(d_nodes.size(), 0);
+  }
+  if (++d_cone_epoch == 0)
+  {
+    std::fill(d_cone_marks.begin(), d_cone_marks.end(), 0);
+    d_cone_epoch = 1;
+  }
+
+  /* collect cone and count number of children in cone */
+  assert(d_cone_visit.empty());
+  d_cone_visit.push_back(node);
+  d_cone_marks[node->id()] = d_cone_epoch;
+  while (!d_cone_visit.empty())
+  {
+    Node<VALUE>* cur = d_cone_visit.back();
+    d_cone_visit.pop_back();
+    for (uint64_t p : d_parents.parents(cur->id()))
+    {
+      d_cone_pending[p] += 1;
+      if (d_cone_marks[p] != d_cone_epoch)
+      {
+        d_cone_marks[p] = d_cone_epoch;
+        d_cone_visit.push_back(get_node(p));
+      }
+    }
+  }
+
+  /* order cone topologically */
+  d_cone.clear();
+  d_cone_visit.push_back(node);
+  while (!d_cone_visit.empty())
+  {
+    Node<VALUE>* cur = d_cone_visit.back();
+    d_cone_visit.pop_back();
+    if (cur != node)
+    {
+      d_cone.push_back(cur);
+    }
+    for (uint64_t p : d_parents.parents(cur->id()))
+    {
+      assert(d_cone_pending[p] > 0);
+      if (--d_cone_pending[p] == 0)
+      {
+        d_cone_visit.push_back(get_node(p));
+      }
+    }
+  }
+}
+
 template <class VALUE>
 uint64_t
 LocalSearch<VALUE>::update_cone(Node<VALUE>* node, const VALUE& assignment)
@@ -556,32 +767,7 @@ LocalSearch<VALUE>::update_cone(Node<VALUE>* node, const VALUE& assignment)
   node->set_assignment(assignment);
   uint64_t nupdates = 1;
 
-  std::vector<Node<VALUE>*> cone;
-  std::vector<Node<VALUE>*> to_visit;
-  std::unordered_set<Node<VALUE>*> visited;
-
-  /* reset cone */
-  const std::unordered_set<uint64_t>& parents = d_parents.at(node->id());
-  for (uint64_t p : parents)
-  {
-    to_visit.push_back(get_node(p));
-  }
-
-  while (!to_visit.empty())
-  {
-    Node<VALUE>* cur = to_visit.back();
-    to_visit.pop_back();
-
-    if (visited.find(cur) != visited.end()) continue;
-    visited.insert(cur);
-    cone.push_back(cur);
-
-    const std::unordered_set<uint64_t>& parents = d_parents.at(cur->id());
-    for (uint64_t p : parents)
-    {
-      to_visit.push_back(get_node(p));
-    }
-  }
+  collect_cone(node);
 
   /* update assignments of cone */
   if (node->is_root())
@@ -589,15 +775,10 @@ LocalSearch<VALUE>::update_cone(Node<VALUE>* node, const VALUE& assignment)
     update_unsat_roots(node);
   }
 
-  std::sort(
-      cone.begin(), cone.end(), [](const Node<VALUE>* a, const Node<VALUE>* b) {
-        return a->normalized_id() < b->normalized_id();
-      });
-
-  for (Node<VALUE>* cur : cone)
+  for (Node<VALUE>* cur : d_cone)
   {
     Log(2) << "  node: " << *cur;
-    cur->evaluate();
+    dispatch(d_kinds[cur->id()], cur, [](auto* n) { n->evaluate(); });
     Log(2) << "      -> new assignment: " << cur->assignment();
     nupdates += 1;
     if (d_logger.is_log_enabled(2))
@@ -623,6 +804,219 @@ LocalSearch<VALUE>::update_cone(Node<VALUE>* node, const VALUE& assignment)
   return nupdates;
 }
 
+template <class VALUE>
+Node<VALUE>*
+LocalSearch<VALUE>::select_root()
+{
+  assert(!d_roots_unsat.empty());
+  if (!d_options.use_root_weights)
+  {
+    return get_node(
+        d_rng->pick_from_indexed<SparseSet, uint64_t>(d_roots_unsat));
+  }
+  /* pick unsatisfied root with probability proportional to its weight */
+  uint64_t r  = d_rng->pick<uint64_t>(0, weighted_unsat() - 1);
+  uint64_t id = d_weights_unsat.find(r);
+  assert(d_roots_unsat.contains(id));
+  return get_node(id);
+}
+
+template <class VALUE>
+Result
+LocalSearch<VALUE>::select_root_move(LocalSearchMove<VALUE>& m)
+{
+  StatisticsInternal& stats = d_internal->d_stats;
+  do
+  {
+    if (d_max_nprops > 0 && stats.num_props >= d_max_nprops)
+    {
+      return Result::UNKNOWN;
+    }
+    if (d_max_nupdates > 0 && stats.num_updates >= d_max_nupdates)
+    {
+      return Result::UNKNOWN;
+    }
+
+    Node<VALUE>* root = select_root();
+
+    if (root->is_value_false())
+    {
+      // Store root responsible for unsat result.
+      d_false_root = root->id();
+      return Result::UNSAT;
+    }
+
+    Log(1);
+    Log(1) << " ** select constraint: " << *root;
+
+    m = select_move(root, *d_true);
+    stats.num_props += m.d_nprops;
+    stats.num_updates += m.d_nupdates;
+  } while (m.d_input == nullptr);
+  return Result::UNKNOWN;
+}
+
+template <class VALUE>
+uint64_t
+LocalSearch<VALUE>::weighted_unsat() const
+{
+  assert(d_options.use_root_weights);
+#ifndef NDEBUG
+  uint64_t res = 0;
+  for (uint64_t id : d_roots_unsat)
+  {
+    assert(id < d_root_weights.size());
+    res += d_root_weights[id];
+  }
+  assert(res == d_weights_unsat.total());
+#endif
+  return d_weights_unsat.total();
+}
+
+template <class VALUE>
+void
+LocalSearch<VALUE>::set_root_weight(uint64_t id, uint64_t weight)
+{
+  assert(d_options.use_root_weights);
+  assert(id < d_root_weights.size());
+  if (d_roots_unsat.contains(id))
+  {
+    d_weights_unsat.add(id,
+                        static_cast<int64_t>(weight)
+                            - static_cast<int64_t>(d_root_weights[id]));
+  }
+  d_root_weights[id] = weight;
+}
+
+template <class VALUE>
+uint64_t
+LocalSearch<VALUE>::score_move(const LocalSearchMove<VALUE>& m)
+{
+  Node<VALUE>* input = m.d_input;
+  uint64_t res       = weighted_unsat();
+  if (input->assignment().compare(m.d_assignment) == 0)
+  {
+    return res;
+  }
+
+  /* account for roots that become satisfied (make) or unsatisfied (break) */
+  auto score = [this, &res](Node<VALUE>* cur) {
+    if (cur->is_root())
+    {
+      uint64_t id = cur->id();
+      bool unsat  = cur->assignment().is_false();
+      if (unsat != d_roots_unsat.contains(id))
+      {
+        res = unsat ? res + d_root_weights[id] : res - d_root_weights[id];
+      }
+    }
+  };
+
+  collect_cone(input);
+  size_t size = d_cone.size();
+  if (d_score_saved.size() < size + 1)
+  {
+    d_score_saved.resize(size + 1);
+  }
+  d_score_saved[size] = input->assignment();
+  input->restore_assignment(m.d_assignment);
+  score(input);
+  for (size_t i = 0; i < size; ++i)
+  {
+    Node<VALUE>* cur = d_cone[i];
+    d_score_saved[i] = cur->assignment();
+    dispatch(d_kinds[cur->id()], cur, [](auto* n) { n->evaluate(); });
+    score(cur);
+  }
+
+  /* restore assignments */
+  input->restore_assignment(d_score_saved[size]);
+  for (size_t i = 0; i < size; ++i)
+  {
+    d_cone[i]->restore_assignment(d_score_saved[i]);
+  }
+  d_internal->d_stats.num_score_updates += size + 1;
+  return res;
+}
+
+template <class VALUE>
+void
+LocalSearch<VALUE>::restart()
+{
+  Log(1) << "*** restart: " << d_num_restarts + 1;
+  d_internal->d_stats.num_restarts += 1;
+  restore_best();
+  d_num_restarts += 1;
+  d_restart_limit = d_options.restart_base * luby(d_num_restarts + 1);
+}
+
+template <class VALUE>
+Result
+LocalSearch<VALUE>::select_weighted_move(LocalSearchMove<VALUE>& m)
+{
+  StatisticsInternal& stats = d_internal->d_stats;
+
+  /* random walk, perform given move */
+  if (d_rng->pick_with_prob(d_options.prob_random_walk))
+  {
+    return Result::UNKNOWN;
+  }
+
+  uint64_t cur  = weighted_unsat();
+  uint64_t best = score_move(m);
+  Log(1) << " ** weighted score: " << best << " (current: " << cur << ")";
+  for (uint32_t i = 1; i < d_options.num_weighted_moves; ++i)
+  {
+    LocalSearchMove<VALUE> candidate;
+    Result res = select_root_move(candidate);
+    if (candidate.d_input == nullptr)
+    {
+      if (res == Result::UNSAT)
+      {
+        return res;
+      }
+      /* limit reached, use best move so far */
+      break;
+    }
+    uint64_t score = score_move(candidate);
+    Log(1) << " ** weighted score: " << score << " (current: " << cur << ")";
+    if (score < best)
+    {
+      best = score;
+      m    = std::move(candidate);
+    }
+  }
+
+  /* No move improves the weighted number of unsatisfied roots, we are in a
+   * local minimum. Escape by increasing the weights of all unsatisfied roots,
+   * or, with probability prob_smooth_weights, by decreasing the weights of
+   * satisfied roots. */
+  if (best >= cur)
+  {
+    if (d_rng->pick_with_prob(d_options.prob_smooth_weights))
+    {
+      for (const auto& [id, cnt] : d_roots_cnt)
+      {
+        (void) cnt;
+        if (d_root_weights[id] > 1 && !d_roots_unsat.contains(id))
+        {
+          set_root_weight(id, d_root_weights[id] - 1);
+        }
+      }
+      stats.num_weight_smoothings += 1;
+    }
+    else
+    {
+      for (uint64_t id : d_roots_unsat)
+      {
+        set_root_weight(id, d_root_weights[id] + 1);
+      }
+      stats.num_weight_increases += 1;
+    }
+  }
+  return Result::UNKNOWN;
+}
+
 template <class VALUE>
 Result
 LocalSearch<VALUE>::move()
@@ -646,44 +1040,34 @@ LocalSearch<VALUE>::move()
     Log(1) << "    satisfied roots:";
     for (uint64_t id : d_roots)
     {
-      if (d_roots_unsat.find(id) != d_roots_unsat.end()) continue;
+      if (d_roots_unsat.contains(id)) continue;
       Log(1) << "      + " << *get_node(id);
     }
   }
 
   if (d_roots_unsat.empty()) return Result::SAT;
 
-  LocalSearchMove<VALUE> m;
-  do
+  if (d_options.use_restarts && d_best_num_moves >= d_restart_limit)
   {
-    if (d_max_nprops > 0 && stats.num_props >= d_max_nprops)
-    {
-      return Result::UNKNOWN;
-    }
-    if (d_max_nupdates > 0 && stats.num_updates >= d_max_nupdates)
-    {
-      return Result::UNKNOWN;
-    }
-
-    Node<VALUE>* root =
-        get_node(d_rng->pick_from_set<std::unordered_set<uint64_t>, uint64_t>(
-            d_roots_unsat));
+    restart();
+  }
 
-    if (root->is_value_false())
+  LocalSearchMove<VALUE> m;
+  Result res = select_root_move(m);
+  if (m.d_input == nullptr)
+  {
+    return res;
+  }
+  if (d_options.use_root_weights)
+  {
+    res = select_weighted_move(m);
+    if (res == Result::UNSAT)
     {
-      // Store root responsible for unsat result.
-      d_false_root = root->id();
-      return Result::UNSAT;
+      return res;
     }
+  }
 
-    Log(1);
-    Log(1) << " ** select constraint: " << *root;
-
-    m = select_move(root, *d_true);
-    stats.num_props += m.d_nprops;
-    stats.num_updates += m.d_nupdates;
-  } while (m.d_input == nullptr);
-
+  assert(m.d_input);
   assert(!m.d_assignment.is_null());
 
   Log(1);
@@ -693,8 +1077,27 @@ LocalSearch<VALUE>::move()
   Log(1) << "  | new   assignment: " << m.d_assignment;
   Log(1);
 
+  if (d_options.use_restarts)
+  {
+    // Only the first assignment since the best assignment was seen is kept.
+    d_best_diff.emplace(m.d_input, m.d_input->assignment());
+  }
+
   stats.num_moves += 1;
   stats.num_updates += update_cone(m.d_input, m.d_assignment);
+  if (d_options.use_restarts)
+  {
+    if (d_roots_unsat.size() < d_best_num_unsat)
+    {
+      d_best_diff.clear();
+      d_best_num_unsat = d_roots_unsat.size();
+      d_best_num_moves = 0;
+    }
+    else
+    {
+      d_best_num_moves += 1;
+    }
+  }
   stats.num_roots       = d_roots.size();
   stats.num_roots_ineq  = d_roots_ineq.size();
   stats.num_roots_unsat = d_roots_unsat.size();
@@ -745,6 +1148,25 @@ to_string(bzla::ls::NodeKind kind)
     case bzla::ls::NodeKind::BV_ULT: return "bvult";
     case bzla::ls::NodeKind::BV_UREM: return "bvurem";
     case bzla::ls::NodeKind::BV_XOR: return "bvxor";
+    case bzla::ls::NodeKind::FP_ABS: return "fp.abs";
+    case bzla::ls::NodeKind::FP_ADD: return "fp.add";
+    case bzla::ls::NodeKind::FP_DIV: return "fp.div";
+    case bzla::ls::NodeKind::FP_EQ: return "fp.=";
+    case bzla::ls::NodeKind::FP_EQUAL: return "fp.eq";
+    case bzla::ls::NodeKind::FP_IS_INF: return "fp.isInfinite";
+    case bzla::ls::NodeKind::FP_IS_NAN: return "fp.isNaN";
+    case bzla::ls::NodeKind::FP_IS_NEG: return "fp.isNegative";
+    case bzla::ls::NodeKind::FP_IS_NORMAL: return "fp.isNormal";
+    case bzla::ls::NodeKind::FP_IS_POS: return "fp.isPositive";
+    case bzla::ls::NodeKind::FP_IS_SUBNORMAL: return "fp.isSubnormal";
+    case bzla::ls::NodeKind::FP_IS_ZERO: return "fp.isZero";
+    case bzla::ls::NodeKind::FP_LEQ: return "fp.leq";
+    case bzla::ls::NodeKind::FP_LT: return "fp.lt";
+    case bzla::ls::NodeKind::FP_MUL: return "fp.mul";
+    case bzla::ls::NodeKind::FP_NEG: return "fp.neg";
+    case bzla::ls::NodeKind::FP_TO_FP_FROM_FP: return "to_fp_from_fp";
+    case bzla::ls::NodeKind::FP_TO_FP_FROM_SBV: return "to_fp_from_sbv";
+    case bzla::ls::NodeKind::FP_TO_FP_FROM_UBV: return "to_fp_from_ubv";
     default: assert(false);
   }
   return "";
@@ -18,6 +18,11 @@
 #include <unordered_set>
 #include <vector>
 
+#include "ls/fenwick_tree.h"
+#include "ls/node_arena.h"
+#include "ls/parents_graph.h"
+#include "ls/sparse_set.h"
+
 namespace bzla {
 
 class RNG;
@@ -80,6 +85,31 @@ enum class NodeKind
   // BV_XNOR,
   BV_XOR,
   // BV_ZEXT,
+
+  /* Floating-point operators, see ls/fp/floating_point_node.h. Indices are
+   * the exponent and significand size {eb, sb} of the format of the result,
+   * or of the operands for predicates. FP_TO_FP_FROM_FP additionally expects
+   * the format of the source operand, i.e., {eb, sb, src_eb, src_sb}.
+   * Rounding modes are bit-vectors of size 3, see FloatingPointBV. */
+  FP_ABS,
+  FP_ADD,
+  FP_DIV,
+  FP_EQ,
+  FP_EQUAL,
+  FP_IS_INF,
+  FP_IS_NAN,
+  FP_IS_NEG,
+  FP_IS_NORMAL,
+  FP_IS_POS,
+  FP_IS_SUBNORMAL,
+  FP_IS_ZERO,
+  FP_LEQ,
+  FP_LT,
+  FP_MUL,
+  FP_NEG,
+  FP_TO_FP_FROM_FP,
+  FP_TO_FP_FROM_SBV,
+  FP_TO_FP_FROM_UBV,
   /* must be last */
   NUM_OPS,
 };
@@ -106,9 +136,7 @@ template <class VALUE>
 class LocalSearch
 {
  public:
-  using NodesIdTable = std::vector<std::unique_ptr<Node<VALUE>>>;
-  using ParentsSet   = std::unordered_set<uint64_t>;
-  using ParentsMap   = std::unordered_map<uint64_t, ParentsSet>;
+  using NodesIdTable = NodeArena<Node<VALUE>>;
 
   struct Statistics
   {
@@ -120,6 +148,8 @@ class LocalSearch
     uint64_t& num_props_inv;
     uint64_t& num_props_cons;
     uint64_t& num_conflicts;
+    uint64_t& num_inverse_memo_hits;
+    uint64_t& num_inverse_memo_misses;
 #ifndef NDEBUG
     std::unordered_map<std::string, uint64_t> num_inv_values;
     std::unordered_map<std::string, uint64_t> num_cons_values;
@@ -177,6 +207,55 @@ class LocalSearch
      * a random input (see use_path_sel_essential).
      */
     uint32_t prob_pick_ess_input = 990;
+    /**
+     * True to maintain weights for roots and select moves based on the
+     * weighted number of unsatisfied roots.
+     *
+     * Unsatisfied roots are selected with probability proportional to their
+     * weight. For each move (except for random walk moves, see
+     * `prob_random_walk`), `num_weighted_moves` candidate moves are
+     * generated via propagation and the move that minimizes the sum of the
+     * weights of the unsatisfied roots is performed. If no candidate improves
+     * this sum, the weights of all unsatisfied roots are increased (or, with
+     * probability `prob_smooth_weights`, the weights of satisfied roots are
+     * decreased) to escape the local minimum. Must be set before any roots
+     * are registered, root weights are not maintained otherwise.
+     */
+    bool use_root_weights = false;
+    /** The number of candidate moves to score if root weights are used. */
+    uint32_t num_weighted_moves = 4;
+    /**
+     * Probability for decreasing the weights of satisfied roots rather than
+     * increasing the weights of unsatisfied roots when stuck in a local
+     * minimum (see use_root_weights). Interpreted as prob_smooth_weights *
+     * 1/10 %.
+     */
+    uint32_t prob_smooth_weights = 100;
+    /**
+     * Probability for performing the move selected via propagation from a
+     * (weighted) random unsatisfied root without scoring candidate moves if
+     * root weights are used. This avoids cycling between the same best
+     * scoring moves. Interpreted as prob_random_walk * 1/10 %.
+     */
+    uint32_t prob_random_walk = 300;
+    /**
+     * True to track the best assignment seen, i.e., the assignment with the
+     * fewest unsatisfied roots since the last call to init_best(), and to
+     * restart from the best assignment after a number of moves without
+     * improvement. The number of moves between restarts follows the Luby
+     * sequence, scaled by `restart_base`.
+     */
+    bool use_restarts = false;
+    /** The base number of moves without improvement between restarts. */
+    uint64_t restart_base = 1000;
+    /**
+     * True to memoize expensive inverse value computations (multiplicative
+     * inverses of bvmul, wheel factorizations of bvurem) per node, keyed by
+     * target value, assignment of the other operand and operand position.
+     */
+    bool use_inverse_memo = false;
+    /** The number of entries of the inverse value memo of a node. */
+    uint32_t inverse_memo_size = 16;
   } d_options;
 
   /**
@@ -205,8 +284,9 @@ class LocalSearch
 
   /**
    * Initialize local search module.
-   * Must be called after all options are configured and before nodes are
-   * created.
+   * Must be called after all options are configured. Path selection options
+   * are configured per node, on creation and for already created nodes in
+   * this call.
    */
   void init();
 
@@ -236,6 +316,16 @@ class LocalSearch
    * @param max The maximum number of updates.
    */
   void set_max_nupdates(uint64_t max) { d_max_nupdates = max; }
+  /**
+   * Get the maximum number of propagations to perform.
+   * @return The maximum number of propagations, 0 for unlimited.
+   */
+  uint64_t max_nprops() const { return d_max_nprops; }
+  /**
+   * Get the maximum number of updates to perform.
+   * @return The maximum number of updates, 0 for unlimited.
+   */
+  uint64_t max_nupdates() const { return d_max_nupdates; }
 
   /**
    * Get the current statistics.
@@ -300,6 +390,23 @@ class LocalSearch
    * Get the root responsible for returning unsat.
    */
   uint64_t get_false_root() const { return d_false_root; }
+  /**
+   * Start tracking the best assignment seen with the current assignment (see
+   * use_restarts). Called whenever roots are registered or popped.
+   */
+  void init_best();
+  /**
+   * Restore the best assignment seen since the last call to init_best().
+   * @note Only has an effect if use_restarts is enabled.
+   */
+  void restore_best();
+  /**
+   * Get the number of unsat roots of the best assignment seen since the last
+   * call to init_best().
+   * @return The number of unsat roots.
+   */
+  uint64_t get_num_roots_unsat_best() const { return d_best_num_unsat; }
+
   // TODO: - we might want to exclude nodes that are not in the formula from
   //         cone updates
 
@@ -362,11 +469,12 @@ class LocalSearch
    *
    * Nodes maintain two ids, the main identifier which is accessed via
    * Node::id() and passed to the user and used to internally, uniquely
-   * identify a node, and the normalized id, which is relevant for cone updates.
-   * If a normalization performs any (semi-)destructive rewriting resulting in
-   * children with a higher id than their parent, this function must be called
-   * after normalization (in LocalSearch::normalize()) to recompute their
-   * normalized ids in a post-order DAG traversal manner.
+   * identify a node, and the normalized id, which reflects a post-order DAG
+   * traversal of the node's cone. If a normalization performs any
+   * (semi-)destructive rewriting resulting in children with a higher id than
+   * their parent, this function must be called after normalization (in
+   * LocalSearch::normalize()) to recompute their normalized ids in a
+   * post-order DAG traversal manner.
    */
   void normalize_ids();
   /**
@@ -379,9 +487,21 @@ class LocalSearch
    * @param node The node.
    */
   virtual void compute_bounds(Node<VALUE>* node) = 0;
+  /**
+   * Collect the cone of influence of the given node (excluding the node
+   * itself) in topological order into `d_cone`.
+   *
+   * The cone is collected while counting for each node of the cone the number
+   * of its children in the cone. Nodes are then ordered such that they occur
+   * after all of their children in the cone.
+   *
+   * @param node The node.
+   */
+  void collect_cone(Node<VALUE>* node);
   /**
    * Update the assignment of the given node to the given assignment, and
-   * recompute the assignment of all nodes in its cone of influence
+   * recompute the assignment of all nodes in its cone of influence in
+   * topological order (see collect_cone()).
    *
    * @param node The node to update.
    * @param assignment The new assignment of the given node.
@@ -398,12 +518,67 @@ class LocalSearch
    * @return An object encapsulating all information necessary for that move.
    */
   LocalSearchMove<VALUE> select_move(Node<VALUE>* root, const VALUE& t_root);
+  /**
+   * Select an unsatisfied root to propagate from. Roots are selected
+   * uniformly at random, or with probability proportional to their weight if
+   * root weights are enabled.
+   * @return The selected root.
+   */
+  Node<VALUE>* select_root();
+  /**
+   * Select a move by propagating from randomly selected unsatisfied roots
+   * until a move is found.
+   * @param m The resulting move, its input is null if no move was found.
+   * @return Result::UNSAT if a selected root is false, and else
+   *         Result::UNKNOWN.
+   */
+  Result select_root_move(LocalSearchMove<VALUE>& m);
+  /**
+   * Select the move with the best weighted score among the given move and
+   * further candidate moves, and update root weights if no candidate
+   * improves the weighted number of unsatisfied roots.
+   * @param m The initial candidate move, updated to the selected move.
+   * @return Result::UNSAT if a selected root is false, and else
+   *         Result::UNKNOWN.
+   */
+  Result select_weighted_move(LocalSearchMove<VALUE>& m);
+  /**
+   * Determine the weighted score of the given move, i.e., the sum of the
+   * weights of the unsatisfied roots after performing the move.
+   *
+   * The move is not performed: the cone of the input is evaluated under the
+   * new assignment and restored afterwards, and only the roots in the cone
+   * that become satisfied (make) or unsatisfied (break) are accounted for.
+   * The set of unsatisfied roots is not modified.
+   *
+   * @param m The move to score.
+   * @return The weighted score.
+   */
+  uint64_t score_move(const LocalSearchMove<VALUE>& m);
+  /** @return The sum of the weights of all unsatisfied roots. */
+  uint64_t weighted_unsat() const;
+  /**
+   * Set the weight of the given root.
+   * @param id     The id of the root.
+   * @param weight The weight.
+   */
+  void set_root_weight(uint64_t id, uint64_t weight);
+  /**
+   * Restore the best assignment seen and determine the number of moves
+   * without improvement until the next restart (see use_restarts).
+   */
+  void restart();
 
   /** The random number generator. */
   std::unique_ptr<RNG> d_rng;
 
-  /** Map from node id to nodes. */
+  /** Map from node id to nodes, owns the nodes. */
   NodesIdTable d_nodes;
+  /**
+   * Map from node id to node kind, cached on creation. Allows to dispatch on
+   * the kind of a node in hot loops without a virtual call.
+   */
+  std::vector<NodeKind> d_kinds;
 
   /**
    * The set of currently active roots, organized into assertion levels.
@@ -425,7 +600,16 @@ class LocalSearch
   std::unordered_map<uint64_t, uint64_t> d_roots_cnt;
 
   /** The set of unsatisfied roots. */
-  std::unordered_set<uint64_t> d_roots_unsat;
+  SparseSet d_roots_unsat;
+  /** The weights of the roots, indexed by node id (see use_root_weights). */
+  std::vector<uint64_t> d_root_weights;
+  /**
+   * The weights of the unsatisfied roots, indexed by node id, zero for all
+   * other nodes. Maintains the weighted number of unsatisfied roots and
+   * allows to select unsatisfied roots proportionally to their weight in
+   * logarithmic time.
+   */
+  FenwickTree d_weights_unsat;
   /** Root responsible for unsat result. */
   uint64_t d_false_root;
 
@@ -439,8 +623,38 @@ class LocalSearch
    */
   std::unordered_map<const Node<VALUE>*, bool> d_roots_ineq;
 
-  /** Map nodes to their parent nodes. */
-  ParentsMap d_parents;
+  /** The parents of each node. */
+  ParentsGraph d_parents;
+
+  /**
+   * Cone update scratch data, indexed by node id. Nodes are marked as visited
+   * in the current cone update if their mark equals d_cone_epoch.
+   */
+  std::vector<uint32_t> d_cone_marks;
+  /** The number of not yet updated children in the current cone update. */
+  std::vector<uint32_t> d_cone_pending;
+  /** The epoch of the current cone update. */
+  uint32_t d_cone_epoch = 0;
+  /** Work list for cone updates. */
+  std::vector<Node<VALUE>*> d_cone_visit;
+  /** The cone collected by collect_cone(), in topological order. */
+  std::vector<Node<VALUE>*> d_cone;
+  /** The saved assignments of the cone while scoring a move. */
+  std::vector<VALUE> d_score_saved;
+
+  /**
+   * Map inputs updated since the best assignment was seen to their
+   * assignment in the best assignment (see use_restarts).
+   */
+  std::unordered_map<Node<VALUE>*, VALUE> d_best_diff;
+  /** The number of unsatisfied roots of the best assignment. */
+  uint64_t d_best_num_unsat = 0;
+  /** The number of moves since the best assignment was seen. */
+  uint64_t d_best_num_moves = 0;
+  /** The number of moves without improvement until the next restart. */
+  uint64_t d_restart_limit = 0;
+  /** The number of restarts since the last call to init_best(). */
+  uint64_t d_num_restarts = 0;
 
   /** The target value for each root. */
   std::unique_ptr<VALUE> d_true;
@@ -10,6 +10,7 @@
 
 #include "ls/ls_bv.h"
 
+#include <algorithm>
 #include <cassert>
 #include <functional>
 #include <iostream>
@@ -19,6 +20,7 @@
 #include "bv/bitvector.h"
 #include "bv/domain/bitvector_domain.h"
 #include "ls/bv/bitvector_node.h"
+#include "ls/fp/floating_point_node.h"
 #include "ls/internal.h"
 
 namespace bzla::ls {
@@ -72,14 +74,15 @@ LocalSearchBV::mk_node(const BitVector& assignment,
 {
   assert(assignment.size() == domain.size());  // API check
   uint64_t id = d_nodes.size();
-  std::unique_ptr<BitVectorNode> res(
-      new BitVectorNode(d_rng.get(), assignment, domain));
+  BitVectorNode* res =
+      d_nodes.emplace_back<BitVectorNode>(d_rng.get(), assignment, domain);
   res->set_id(id);
   res->set_symbol(symbol);
-  d_nodes.push_back(std::move(res));
-  assert(get_node(id) == d_nodes.back().get());
-  assert(d_parents.find(id) == d_parents.end());
-  d_parents[id] = {};
+  assert(get_node(id) == res);
+  assert(d_parents.size() == id);
+  d_parents.add_node();
+  assert(d_kinds.size() == id);
+  d_kinds.push_back(res->kind());
   return id;
 }
 
@@ -132,11 +135,11 @@ LocalSearchBV::_mk_node(NodeKind kind,
   for (uint64_t c : children)
   {
     assert(c < id);  // API check
-    assert(d_parents.find(c) != d_parents.end());
-    d_parents.at(c).insert(id);
+    assert(c < d_parents.size());
+    d_parents.add_parent(c, id);
   }
 
-  std::unique_ptr<BitVectorNode> res;
+  BitVectorNode* res = nullptr;
 
   switch (kind)
   {
@@ -148,104 +151,108 @@ LocalSearchBV::_mk_node(NodeKind kind,
     case NodeKind::EQ:
       assert(children.size() == 2);  // API check
       assert(indices.size() == 0);   // API check
-      res.reset(new BitVectorEq(
-          d_rng.get(), domain, get_node(children[0]), get_node(children[1])));
+      res = d_nodes.emplace_back<BitVectorEq>(
+          d_rng.get(), domain, get_node(children[0]), get_node(children[1]));
       break;
     case NodeKind::ITE:
       assert(children.size() == 3);  // API check
       assert(indices.size() == 0);   // API check
-      res.reset(new BitVectorIte(d_rng.get(),
-                                 domain,
-                                 get_node(children[0]),
-                                 get_node(children[1]),
-                                 get_node(children[2])));
+      res = d_nodes.emplace_back<BitVectorIte>(
+          d_rng.get(),
+          domain,
+          get_node(children[0]),
+          get_node(children[1]),
+          get_node(children[2]));
       break;
     case NodeKind::BV_ADD:
       assert(children.size() == 2);  // API check
       assert(indices.size() == 0);   // API check
-      res.reset(new BitVectorAdd(
-          d_rng.get(), domain, get_node(children[0]), get_node(children[1])));
+      res = d_nodes.emplace_back<BitVectorAdd>(
+          d_rng.get(), domain, get_node(children[0]), get_node(children[1]));
       break;
 
     case NodeKind::AND:
     case NodeKind::BV_AND:
       assert(children.size() == 2);  // API check
       assert(indices.size() == 0);   // API check
-      res.reset(new BitVectorAnd(
-          d_rng.get(), domain, get_node(children[0]), get_node(children[1])));
+      res = d_nodes.emplace_back<BitVectorAnd>(
+          d_rng.get(), domain, get_node(children[0]), get_node(children[1]));
       break;
     case NodeKind::BV_ASHR:
       assert(children.size() == 2);  // API check
       assert(indices.size() == 0);   // API check
-      res.reset(new BitVectorAshr(
-          d_rng.get(), domain, get_node(children[0]), get_node(children[1])));
+      res = d_nodes.emplace_back<BitVectorAshr>(
+          d_rng.get(), domain, get_node(children[0]), get_node(children[1]));
       break;
     case NodeKind::BV_CONCAT:
       assert(children.size() == 2);  // API check
       assert(indices.size() == 0);   // API check
-      res.reset(new BitVectorConcat(
-          d_rng.get(), domain, get_node(children[0]), get_node(children[1])));
+      res = d_nodes.emplace_back<BitVectorConcat>(
+          d_rng.get(), domain, get_node(children[0]), get_node(children[1]));
       break;
     case NodeKind::BV_MUL:
       assert(children.size() == 2);  // API check
       assert(indices.size() == 0);   // API check
-      res.reset(new BitVectorMul(
-          d_rng.get(), domain, get_node(children[0]), get_node(children[1])));
+      res = d_nodes.emplace_back<BitVectorMul>(
+          d_rng.get(), domain, get_node(children[0]), get_node(children[1]));
       break;
     case NodeKind::NOT:
     case NodeKind::BV_NOT:
       assert(children.size() == 1);  // API check
       assert(indices.size() == 0);   // API check
-      res.reset(new BitVectorNot(d_rng.get(), domain, get_node(children[0])));
+      res = d_nodes.emplace_back<BitVectorNot>(
+          d_rng.get(), domain, get_node(children[0]));
       break;
     case NodeKind::BV_SHL:
       assert(children.size() == 2);  // API check
       assert(indices.size() == 0);   // API check
-      res.reset(new BitVectorShl(
-          d_rng.get(), domain, get_node(children[0]), get_node(children[1])));
+      res = d_nodes.emplace_back<BitVectorShl>(
+          d_rng.get(), domain, get_node(children[0]), get_node(children[1]));
       break;
     case NodeKind::BV_SHR:
       assert(children.size() == 2);  // API check
       assert(indices.size() == 0);   // API check
-      res.reset(new BitVectorShr(
-          d_rng.get(), domain, get_node(children[0]), get_node(children[1])));
+      res = d_nodes.emplace_back<BitVectorShr>(
+          d_rng.get(), domain, get_node(children[0]), get_node(children[1]));
       break;
     case NodeKind::BV_SLT:
       assert(children.size() == 2);  // API check
       assert(indices.size() == 0);   // API check
-      res.reset(new BitVectorSlt(d_rng.get(),
-                                 domain,
-                                 get_node(children[0]),
-                                 get_node(children[1]),
-                                 d_options.use_opt_lt_concat_sext));
+      res = d_nodes.emplace_back<BitVectorSlt>(
+          d_rng.get(),
+          domain,
+          get_node(children[0]),
+          get_node(children[1]),
+          d_options.use_opt_lt_concat_sext);
       break;
     case NodeKind::BV_UDIV:
       assert(children.size() == 2);  // API check
       assert(indices.size() == 0);   // API check
-      res.reset(new BitVectorUdiv(
-          d_rng.get(), domain, get_node(children[0]), get_node(children[1])));
+      res = d_nodes.emplace_back<BitVectorUdiv>(
+          d_rng.get(), domain, get_node(children[0]), get_node(children[1]));
       break;
     case NodeKind::BV_ULT:
       assert(children.size() == 2);  // API check
       assert(indices.size() == 0);   // API check
-      res.reset(new BitVectorUlt(d_rng.get(),
-                                 domain,
-                                 get_node(children[0]),
-                                 get_node(children[1]),
-                                 d_options.use_opt_lt_concat_sext));
+      res = d_nodes.emplace_back<BitVectorUlt>(
+          d_rng.get(),
+          domain,
+          get_node(children[0]),
+          get_node(children[1]),
+          d_options.use_opt_lt_concat_sext);
       break;
     case NodeKind::BV_UREM:
       assert(children.size() == 2);  // API check
       assert(indices.size() == 0);   // API check
-      res.reset(new BitVectorUrem(
-          d_rng.get(), domain, get_node(children[0]), get_node(children[1])));
+      res = d_nodes.emplace_back<BitVectorUrem>(
+          d_rng.get(), domain, get_node(children[0]), get_node(children[1]));
       break;
     case NodeKind::XOR:
     case NodeKind::BV_XOR:
       assert(children.size() == 2);  // API check
       assert(indices.size() == 0);   // API check
-      res.reset(new BitVectorXor(
-          d_rng.get(), domain, get_node(children[0]), get_node(children[1])));
+      res = d_nodes.emplace_back<BitVectorXor>(
+          d_rng.get(), domain, get_node(children[0]), get_node(children[1]));
       break;
 
     case NodeKind::BV_EXTRACT: {
@@ -254,8 +261,8 @@ LocalSearchBV::_mk_node(NodeKind kind,
       assert(indices[0] >= indices[1]);  // API check
       assert(indices[0] < get_node(children[0])->size());
       BitVectorNode* child0 = get_node(children[0]);
-      res.reset(new BitVectorExtract(
-          d_rng.get(), domain, child0, indices[0], indices[1], normalize));
+      res = d_nodes.emplace_back<BitVectorExtract>(
+          d_rng.get(), domain, child0, indices[0], indices[1], normalize);
       if (normalize)
       {
         d_to_normalize_nodes.insert(child0);
@@ -266,18 +273,160 @@ LocalSearchBV::_mk_node(NodeKind kind,
     case NodeKind::BV_SEXT:
       assert(children.size() == 1);  // API check
       assert(indices.size() == 1);   // API check
-      res.reset(new BitVectorSignExtend(
-          d_rng.get(), domain, get_node(children[0]), indices[0]));
+      res = d_nodes.emplace_back<BitVectorSignExtend>(
+          d_rng.get(), domain, get_node(children[0]), indices[0]);
+      break;
+
+    case NodeKind::FP_ABS:
+      assert(children.size() == 1);  // API check
+      assert(indices.size() == 2);   // API check
+      res = d_nodes.emplace_back<FloatingPointAbs>(
+          d_rng.get(), domain, indices[0], indices[1], get_node(children[0]));
+      break;
+    case NodeKind::FP_NEG:
+      assert(children.size() == 1);  // API check
+      assert(indices.size() == 2);   // API check
+      res = d_nodes.emplace_back<FloatingPointNeg>(
+          d_rng.get(), domain, indices[0], indices[1], get_node(children[0]));
+      break;
+    case NodeKind::FP_IS_INF:
+    case NodeKind::FP_IS_NAN:
+    case NodeKind::FP_IS_NEG:
+    case NodeKind::FP_IS_NORMAL:
+    case NodeKind::FP_IS_POS:
+    case NodeKind::FP_IS_SUBNORMAL:
+    case NodeKind::FP_IS_ZERO:
+      assert(children.size() == 1);  // API check
+      assert(indices.size() == 2);   // API check
+      res = d_nodes.emplace_back<FloatingPointIsClass>(d_rng.get(),
+                                                       domain,
+                                                       kind,
+                                                       indices[0],
+                                                       indices[1],
+                                                       get_node(children[0]));
+      break;
+    case NodeKind::FP_ADD:
+      assert(children.size() == 3);  // API check
+      assert(indices.size() == 2);   // API check
+      res = d_nodes.emplace_back<FloatingPointAdd>(d_rng.get(),
+                                                   domain,
+                                                   indices[0],
+                                                   indices[1],
+                                                   get_node(children[0]),
+                                                   get_node(children[1]),
+                                                   get_node(children[2]));
+      break;
+    case NodeKind::FP_DIV:
+      assert(children.size() == 3);  // API check
+      assert(indices.size() == 2);   // API check
+      res = d_nodes.emplace_back<FloatingPointDiv>(d_rng.get(),
+                                                   domain,
+                                                   indices[0],
+                                                   indices[1],
+                                                   get_node(children[0]),
+                                                   get_node(children[1]),
+                                                   get_node(children[2]));
+      break;
+    case NodeKind::FP_MUL:
+      assert(children.size() == 3);  // API check
+      assert(indices.size() == 2);   // API check
+      res = d_nodes.emplace_back<FloatingPointMul>(d_rng.get(),
+                                                   domain,
+                                                   indices[0],
+                                                   indices[1],
+                                                   get_node(children[0]),
+                                                   get_node(children[1]),
+                                                   get_node(children[2]));
+      break;
+    case NodeKind::FP_EQ:
+      assert(children.size() == 2);  // API check
+      assert(indices.size() == 2);   // API check
+      res = d_nodes.emplace_back<FloatingPointEq>(d_rng.get(),
+                                                  domain,
+                                                  indices[0],
+                                                  indices[1],
+                                                  get_node(children[0]),
+                                                  get_node(children[1]));
+      break;
+    case NodeKind::FP_EQUAL:
+      assert(children.size() == 2);  // API check
+      assert(indices.size() == 2);   // API check
+      res = d_nodes.emplace_back<FloatingPointEqual>(d_rng.get(),
+                                                     domain,
+                                                     indices[0],
+                                                     indices[1],
+                                                     get_node(children[0]),
+                                                     get_node(children[1]));
+      break;
+    case NodeKind::FP_LEQ:
+      assert(children.size() == 2);  // API check
+      assert(indices.size() == 2);   // API check
+      res = d_nodes.emplace_back<FloatingPointLeq>(d_rng.get(),
+                                                   domain,
+                                                   indices[0],
+                                                   indices[1],
+                                                   get_node(children[0]),
+                                                   get_node(children[1]));
+      break;
+    case NodeKind::FP_LT:
+      assert(children.size() == 2);  // API check
+      assert(indices.size() == 2);   // API check
+      res = d_nodes.emplace_back<FloatingPointLt>(d_rng.get(),
+                                                  domain,
+                                                  indices[0],
+                                                  indices[1],
+                                                  get_node(children[0]),
+                                                  get_node(children[1]));
+      break;
+    case NodeKind::FP_TO_FP_FROM_FP:
+      assert(children.size() == 2);  // API check
+      assert(indices.size() == 4);   // API check
+      res = d_nodes.emplace_back<FloatingPointToFpFromFp>(
+          d_rng.get(),
+          domain,
+          indices[0],
+          indices[1],
+          indices[2],
+          indices[3],
+          get_node(children[0]),
+          get_node(children[1]));
+      break;
+    case NodeKind::FP_TO_FP_FROM_SBV:
+    case NodeKind::FP_TO_FP_FROM_UBV:
+      assert(children.size() == 2);  // API check
+      assert(indices.size() == 2);   // API check
+      res = d_nodes.emplace_back<FloatingPointToFpFromBv>(
+          d_rng.get(),
+          domain,
+          indices[0],
+          indices[1],
+          kind == NodeKind::FP_TO_FP_FROM_SBV,
+          get_node(children[0]),
+          get_node(children[1]));
       break;
 
     default: assert(0);  // API check
   }
+  res->set_path_sel(d_options.use_path_sel_essential,
+                    d_options.prob_pick_ess_input);
+  // Memoize multiplicative inverses of bvmul and factorizations of bvurem,
+  // the only inverse value subcomputations that are both expensive and
+  // deterministic.
+  if (d_options.use_inverse_memo
+      && (kind == NodeKind::BV_MUL || kind == NodeKind::BV_UREM))
+  {
+    StatisticsInternal& stats = d_internal->d_stats;
+    res->enable_inverse_memo(d_options.inverse_memo_size,
+                             stats.num_inverse_memo_hits,
+                             stats.num_inverse_memo_misses);
+  }
   res->set_id(id);
   res->set_symbol(symbol);
-  d_nodes.push_back(std::move(res));
-  assert(get_node(id) == d_nodes.back().get());
-  assert(d_parents.find(id) == d_parents.end());
-  d_parents[id] = {};
+  assert(get_node(id) == res);
+  assert(d_parents.size() == id);
+  d_parents.add_node();
+  assert(d_kinds.size() == id);
+  d_kinds.push_back(res->kind());
 
   return id;
 }
@@ -397,9 +546,8 @@ LocalSearchBV::compute_bounds(Node<BitVector>* node)
   }
   for (uint32_t i = 0, arity = node->arity(); i < arity; ++i)
   {
-    const BitVectorNode* child                  = n->child(i);
-    const std::unordered_set<uint64_t>& parents = d_parents.at(child->id());
-    for (uint64_t pid : parents)
+    const BitVectorNode* child = n->child(i);
+    for (uint64_t pid : d_parents.parents(child->id()))
     {
       BitVectorNode* p = get_node(pid);
 #ifndef NDEBUG
@@ -559,6 +707,11 @@ LocalSearchBV::normalize_extracts(BitVectorNode* node)
   if (extracts.size() < 2) return;
 
   std::vector<std::pair<uint64_t, uint64_t>> sorted_idxs = split_indices(node);
+#ifndef NDEBUG
+  // The normalized extracts, checked after all edits since querying the
+  // parents graph compacts it after each modification.
+  std::vector<BitVectorExtract*> normalized_extracts;
+#endif
 
   for (BitVectorExtract* ex : extracts)
   {
@@ -590,17 +743,28 @@ LocalSearchBV::normalize_extracts(BitVectorNode* node)
     }
     if (normalized)
     {
-      uint64_t id = normalized->id();
-      assert(d_parents[id].empty());
       // The normalized node is uniquely created for each normalized child1
       // of an extract, thus only that extract is its parent.
-      d_parents[id] = {ex->id()};
+      d_parents.add_parent(normalized->id(), ex->id());
       // Remove this extract from the parents list of the normalized child
-      assert(!d_parents[ex->child(0)->id()].empty());
-      d_parents[ex->child(0)->id()].erase(ex->id());
+      d_parents.erase_parent(ex->child(0)->id(), ex->id());
       ex->normalize(normalized);
+#ifndef NDEBUG
+      normalized_extracts.push_back(ex);
+#endif
     }
   }
+
+#ifndef NDEBUG
+  for (BitVectorExtract* ex : normalized_extracts)
+  {
+    auto parents = d_parents.parents(ex->child(0)->id());
+    assert(parents.size() == 1 && *parents.begin() == ex->id());
+    auto node_parents = d_parents.parents(node->id());
+    assert(std::find(node_parents.begin(), node_parents.end(), ex->id())
+           == node_parents.end());
+  }
+#endif
 }
 
 void
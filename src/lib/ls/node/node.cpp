@@ -39,7 +39,7 @@ Node<VALUE>::Node(RNG* rng,
                   Node<VALUE>* child0,
                   bool is_value,
                   const std::optional<std::string>& symbol)
-    : d_children({child0}),
+    : d_children{child0, nullptr, nullptr},
       d_rng(rng),
       d_assignment(assignment),
       d_arity(1),
@@ -56,7 +56,7 @@ Node<VALUE>::Node(RNG* rng,
                   Node<VALUE>* child1,
                   bool is_value,
                   const std::optional<std::string>& symbol)
-    : d_children({child0, child1}),
+    : d_children{child0, child1, nullptr},
       d_rng(rng),
       d_assignment(assignment),
       d_arity(2),
@@ -74,7 +74,7 @@ Node<VALUE>::Node(RNG* rng,
                   Node<VALUE>* child2,
                   bool is_value,
                   const std::optional<std::string>& symbol)
-    : d_children({child0, child1, child2}),
+    : d_children{child0, child1, child2},
       d_rng(rng),
       d_assignment(assignment),
       d_arity(3),
@@ -169,7 +169,7 @@ Node<VALUE>::select_path(const VALUE& t, std::vector<uint64_t>& ess_inputs)
   bool checked_essential = false;
   /* select essential input if any and path selection based on essential
    * inputs is enabled. */
-  if (s_path_sel_essential && d_rng->pick_with_prob(s_prob_pick_ess_input))
+  if (d_path_sel_essential && d_rng->pick_with_prob(d_prob_pick_ess_input))
   {
     /* determine essential inputs */
     checked_essential = true;
@@ -203,7 +203,6 @@ Node<VALUE>*
 Node<VALUE>::operator[](uint64_t pos) const
 {
   assert(pos < arity());
-  assert(d_children.size() == arity());
   return d_children[pos];
 }
 
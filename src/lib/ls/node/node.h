@@ -11,6 +11,7 @@
 #ifndef BZLA__LS_NODE_H
 #define BZLA__LS_NODE_H
 
+#include <array>
 #include <optional>
 #include <string>
 #include <vector>
@@ -28,18 +29,6 @@ template <class VALUE>
 class Node
 {
  public:
-  /**
-   * Path selection mode.
-   * True if path is to be selected based on essential inputs, false if it is
-   * to be selected randomly.
-   */
-  static inline bool s_path_sel_essential = true;
-  /**
-   * Probability for picking an essential input if there is one, and else
-   * a random input (see use_path_sel_essential).
-   */
-  static inline uint32_t s_prob_pick_ess_input = 990;
-
   /** Destructor. */
   virtual ~Node();
 
@@ -85,6 +74,20 @@ class Node
    */
   void set_is_root(bool value) { d_is_root = value; }
 
+  /**
+   * Configure path selection of this node (see select_path()).
+   * @param essential           True if path is to be selected based on
+   *                            essential inputs, false if it is to be selected
+   *                            randomly.
+   * @param prob_pick_ess_input The probability for picking an essential input
+   *                            if there is one, and else a random input.
+   */
+  void set_path_sel(bool essential, uint32_t prob_pick_ess_input)
+  {
+    d_path_sel_essential  = essential;
+    d_prob_pick_ess_input = prob_pick_ess_input;
+  }
+
   /**
    * Determine if this node is a value.
    * @note For bit-vector nodes, this checks if the underlying domain is fixed.
@@ -202,6 +205,15 @@ class Node
    * @return The assignment of this node.
    */
   const VALUE& assignment() const { return d_assignment; }
+  /**
+   * Restore the assignment of this node to given value, without checking it
+   * against constant bits. Used to undo speculative evaluations.
+   * @param assignment The assignment to restore.
+   */
+  void restore_assignment(const VALUE& assignment)
+  {
+    d_assignment = assignment;
+  }
 
   /**
    * Set id of this node.
@@ -286,8 +298,11 @@ class Node
    */
   uint64_t d_normalized_id = 0;
 
-  /** The children of this node. */
-  std::vector<Node<VALUE>*> d_children;
+  /**
+   * The children of this node, stored inline since nodes have at most three
+   * children. Unused entries are null.
+   */
+  std::array<Node<VALUE>*, 3> d_children{};
 
   /** The associated random number generator. */
   RNG* d_rng;
@@ -297,6 +312,11 @@ class Node
 
   /** The arity of this node. */
   uint32_t d_arity = 0;
+  /**
+   * Probability for picking an essential input if there is one, and else
+   * a random input (see d_path_sel_essential).
+   */
+  uint32_t d_prob_pick_ess_input = 990;
 
   /** True if this node is a root node. */
   bool d_is_root = false;
@@ -309,6 +329,12 @@ class Node
   bool d_is_value = false;
   /** True if all children of this node are values. */
   bool d_all_value = false;
+  /**
+   * Path selection mode.
+   * True if path is to be selected based on essential inputs, false if it is
+   * to be selected randomly.
+   */
+  bool d_path_sel_essential = true;
 
   /** Cached inverse value result. */
   std::unique_ptr<VALUE> d_inverse;
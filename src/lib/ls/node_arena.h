@@ -0,0 +1,119 @@
+/***
+ * Bitwuzla: Satisfiability Modulo Theories (SMT) solver.
+ *
+ * Copyright (C) 2024 by the authors listed in the AUTHORS file at
+ * https://github.com/bitwuzla/bitwuzla/blob/main/AUTHORS
+ *
+ * This file is part of Bitwuzla under the MIT license. See COPYING for more
+ * information at https://github.com/bitwuzla/bitwuzla/blob/main/COPYING
+ */
+
+#ifndef BZLA__LS_NODE_ARENA_H
+#define BZLA__LS_NODE_ARENA_H
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace bzla::ls {
+
+/**
+ * Arena owning the nodes of a local search graph, indexed by node id.
+ *
+ * Nodes are constructed in place into large, contiguously allocated chunks of
+ * memory in the order of their creation. Since nodes are created after their
+ * children, consecutive ids are laid out in topological order, which keeps
+ * nodes that are traversed together (e.g., during cone updates) close in
+ * memory and avoids one heap allocation per node. Nodes are never freed
+ * individually, they are destroyed together with the arena.
+ */
+template <class TNode>
+class NodeArena
+{
+ public:
+  NodeArena() = default;
+  NodeArena(const NodeArena&)            = delete;
+  NodeArena& operator=(const NodeArena&) = delete;
+
+  ~NodeArena()
+  {
+    for (size_t i = d_nodes.size(); i > 0; --i)
+    {
+      d_nodes[i - 1]->~TNode();
+    }
+  }
+
+  /** @return The number of nodes. */
+  size_t size() const { return d_nodes.size(); }
+
+  /** @return The node with given id. */
+  TNode* operator[](size_t id) const
+  {
+    assert(id < d_nodes.size());
+    return d_nodes[id];
+  }
+
+  /** @return The most recently created node. */
+  TNode* back() const
+  {
+    assert(!d_nodes.empty());
+    return d_nodes.back();
+  }
+
+  /**
+   * Construct a new node of type T with the given constructor arguments.
+   * The id of the new node is the number of nodes before its creation.
+   * @return The new node.
+   */
+  template <class T, class... Args>
+  T* emplace_back(Args&&... args)
+  {
+    static_assert(std::is_base_of_v<TNode, T>);
+    void* mem = allocate(sizeof(T), alignof(T));
+    T* res    = new (mem) T(std::forward<Args>(args)...);
+    d_nodes.push_back(res);
+    return res;
+  }
+
+ private:
+  /** The minimum size of a chunk in bytes. */
+  static constexpr size_t s_chunk_size = 1 << 16;
+
+  /** Allocate memory for an object of given size and alignment. */
+  void* allocate(size_t size, size_t align)
+  {
+    assert(align <= alignof(std::max_align_t));
+    size_t pad = (align - reinterpret_cast<uintptr_t>(d_cur) % align) % align;
+    if (d_cur == nullptr || pad + size > d_avail)
+    {
+      size_t n = std::max(size, s_chunk_size);
+      d_chunks.emplace_back(new std::byte[n]);
+      d_cur   = d_chunks.back().get();
+      d_avail = n;
+      pad     = 0;
+    }
+    void* res = d_cur + pad;
+    d_cur += pad + size;
+    d_avail -= pad + size;
+    return res;
+  }
+
+  /** The nodes, indexed by id. */
+  std::vector<TNode*> d_nodes;
+  /** The allocated chunks. */
+  std::vector<std::unique_ptr<std::byte[]>> d_chunks;
+  /** The first unused byte of the current chunk. */
+  std::byte* d_cur = nullptr;
+  /** The number of unused bytes in the current chunk. */
+  size_t d_avail = 0;
+};
+
+}  // namespace bzla::ls
+
+#endif
@@ -0,0 +1,135 @@
+/***
+ * Bitwuzla: Satisfiability Modulo Theories (SMT) solver.
+ *
+ * Copyright (C) 2024 by the authors listed in the AUTHORS file at
+ * https://github.com/bitwuzla/bitwuzla/blob/main/AUTHORS
+ *
+ * This file is part of Bitwuzla under the MIT license. See COPYING for more
+ * information at https://github.com/bitwuzla/bitwuzla/blob/main/COPYING
+ */
+
+#ifndef BZLA__LS_PARENTS_GRAPH_H
+#define BZLA__LS_PARENTS_GRAPH_H
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+namespace bzla::ls {
+
+/**
+ * Parent adjacency of the nodes of a local search graph, indexed by node id.
+ *
+ * Parents are collected into per-node lists while the graph is constructed.
+ * For traversal, the lists are compacted into a single array in compressed
+ * sparse row (CSR) format on the first query after a modification, where the
+ * parents of node `id` are stored at indices [d_start[id], d_start[id + 1]).
+ */
+class ParentsGraph
+{
+ public:
+  /** Range over the parents of a node. */
+  class Range
+  {
+   public:
+    Range(const uint64_t* begin, const uint64_t* end)
+        : d_begin(begin), d_end(end)
+    {
+    }
+    const uint64_t* begin() const { return d_begin; }
+    const uint64_t* end() const { return d_end; }
+    size_t size() const { return d_end - d_begin; }
+    bool empty() const { return d_begin == d_end; }
+
+   private:
+    const uint64_t* d_begin;
+    const uint64_t* d_end;
+  };
+
+  /** @return The number of nodes. */
+  size_t size() const { return d_lists.size(); }
+
+  /**
+   * Add node without parents.
+   * @return The id of the new node.
+   */
+  uint64_t add_node()
+  {
+    d_lists.emplace_back();
+    d_dirty = true;
+    return d_lists.size() - 1;
+  }
+
+  /**
+   * Add parent to the parents of the node given by id.
+   * @note Adding the most recently added parent of a node again has no
+   *       effect, any other duplicates are not allowed.
+   */
+  void add_parent(uint64_t id, uint64_t parent)
+  {
+    assert(id < d_lists.size());
+    std::vector<uint64_t>& parents = d_lists[id];
+    if (parents.empty() || parents.back() != parent)
+    {
+      assert(std::find(parents.begin(), parents.end(), parent)
+             == parents.end());
+      parents.push_back(parent);
+      d_dirty = true;
+    }
+  }
+
+  /** Remove parent from the parents of the node given by id. */
+  void erase_parent(uint64_t id, uint64_t parent)
+  {
+    assert(id < d_lists.size());
+    std::vector<uint64_t>& parents = d_lists[id];
+    auto it = std::find(parents.begin(), parents.end(), parent);
+    if (it != parents.end())
+    {
+      parents.erase(it);
+      d_dirty = true;
+    }
+  }
+
+  /** @return The parents of the node given by id. */
+  Range parents(uint64_t id) const
+  {
+    assert(id < d_lists.size());
+    if (d_dirty)
+    {
+      compact();
+    }
+    const uint64_t* data = d_parents.data();
+    return Range(data + d_start[id], data + d_start[id + 1]);
+  }
+
+ private:
+  /** Compact parent lists into CSR format. */
+  void compact() const
+  {
+    size_t n = d_lists.size();
+    d_start.resize(n + 1);
+    d_parents.clear();
+    for (size_t i = 0; i < n; ++i)
+    {
+      d_start[i] = d_parents.size();
+      d_parents.insert(d_parents.end(), d_lists[i].begin(), d_lists[i].end());
+    }
+    d_start[n] = d_parents.size();
+    d_dirty    = false;
+  }
+
+  /** The parent lists, indexed by node id. */
+  std::vector<std::vector<uint64_t>> d_lists;
+  /** Start indices of parent ranges in d_parents, indexed by node id. */
+  mutable std::vector<uint64_t> d_start;
+  /** The parents of all nodes, ordered by node id. */
+  mutable std::vector<uint64_t> d_parents;
+  /** True if d_lists was modified since the last compaction. */
+  mutable bool d_dirty = false;
+};
+
+}  // namespace bzla::ls
+
+#endif
@@ -0,0 +1,105 @@
+/***
+ * Bitwuzla: Satisfiability Modulo Theories (SMT) solver.
+ *
+ * Copyright (C) 2024 by the authors listed in the AUTHORS file at
+ * https://github.com/bitwuzla/bitwuzla/blob/main/AUTHORS
+ *
+ * This file is part of Bitwuzla under the MIT license. See COPYING for more
+ * information at https://github.com/bitwuzla/bitwuzla/blob/main/COPYING
+ */
+
+#ifndef BZLA__LS_SPARSE_SET_H
+#define BZLA__LS_SPARSE_SET_H
+
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+namespace bzla::ls {
+
+/**
+ * Set of node ids with constant time insertion, removal, membership test and
+ * access by index.
+ *
+ * Elements are stored densely in insertion order, and a position map indexed
+ * by id maps elements to their index in the dense storage. Removing an
+ * element moves the last element into its position, hence the order of
+ * elements is not preserved. Since node ids are dense, the position map is a
+ * vector that grows with the largest inserted id.
+ */
+class SparseSet
+{
+ public:
+  using const_iterator = std::vector<uint64_t>::const_iterator;
+
+  /** @return True if the set contains given id. */
+  bool contains(uint64_t id) const
+  {
+    return id < d_pos.size() && d_pos[id] != s_none;
+  }
+
+  /**
+   * Insert id into the set.
+   * @return True if the id was inserted, false if it was already contained.
+   */
+  bool insert(uint64_t id)
+  {
+    if (id >= d_pos.size())
+    {
+      d_pos.resize(id + 1, s_none);
+    }
+    else if (d_pos[id] != s_none)
+    {
+      return false;
+    }
+    d_pos[id] = d_elements.size();
+    d_elements.push_back(id);
+    return true;
+  }
+
+  /**
+   * Remove id from the set.
+   * @return True if the id was removed, false if it was not contained.
+   */
+  bool erase(uint64_t id)
+  {
+    if (!contains(id))
+    {
+      return false;
+    }
+    uint64_t pos  = d_pos[id];
+    uint64_t last = d_elements.back();
+    d_elements[pos] = last;
+    d_pos[last]     = pos;
+    d_elements.pop_back();
+    d_pos[id] = s_none;
+    return true;
+  }
+
+  /** @return The element at given index. */
+  uint64_t operator[](size_t idx) const
+  {
+    assert(idx < d_elements.size());
+    return d_elements[idx];
+  }
+
+  /** @return The number of elements in the set. */
+  size_t size() const { return d_elements.size(); }
+  /** @return True if the set is empty. */
+  bool empty() const { return d_elements.empty(); }
+
+  const_iterator begin() const { return d_elements.begin(); }
+  const_iterator end() const { return d_elements.end(); }
+
+ private:
+  /** Position map value for ids that are not contained in the set. */
+  static constexpr uint64_t s_none = UINT64_MAX;
+  /** The elements of the set. */
+  std::vector<uint64_t> d_elements;
+  /** Map from id to its index in d_elements, s_none if not contained. */
+  std::vector<uint64_t> d_pos;
+};
+
+}  // namespace bzla::ls
+
+#endif
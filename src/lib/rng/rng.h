@@ -97,6 +97,12 @@ class RNG
   /** Pick random element from given set/vector. */
   template <typename TSet, typename TPicked>
   TPicked pick_from_set(const TSet& data);
+  /**
+   * Pick random element from given container with constant time access by
+   * index, e.g., a vector.
+   */
+  template <typename TContainer, typename TPicked>
+  TPicked pick_from_indexed(const TContainer& data);
 
   /** Get a pointer to the gmp_randstate_t. */
   gmp_randstate_t* get_gmp_state() { return &d_gmp_randstate; }
@@ -120,6 +126,14 @@ RNG::pick_from_set(const TSet& set)
   return *it;
 }
 
+template <typename TContainer, typename TPicked>
+TPicked
+RNG::pick_from_indexed(const TContainer& data)
+{
+  assert(!data.empty());
+  return data[pick<uint32_t>() % data.size()];
+}
+
 }  // namespace bzla
 
 #endif
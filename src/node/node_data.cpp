@@ -19,15 +19,12 @@ namespace bzla::node {
 /* --- NodeData public ----------------------------------------------------- */
 
 NodeData*
-NodeData::alloc(Kind kind, const std::optional<std::string>& symbol)
+NodeData::alloc(NodeDataAllocator& allocator,
+                Kind kind,
+                const std::optional<std::string>& symbol)
 {
-  size_t size = sizeof(NodeData) + sizeof(PayloadSymbol);
-
-  NodeData* data = static_cast<NodeData*>(std::calloc(1, size));
-  if (data == nullptr)
-  {
-    throw std::bad_alloc();
-  }
+  NodeData* data =
+      static_cast<NodeData*>(allocator.allocate(alloc_size_symbol()));
   data->d_kind     = kind;
   auto& payload    = data->payload_symbol();
   payload.d_symbol = symbol;
@@ -35,31 +32,13 @@ NodeData::alloc(Kind kind, const std::optional<std::string>& symbol)
 }
 
 NodeData*
-NodeData::alloc(Kind kind,
+NodeData::alloc(NodeDataAllocator& allocator,
+                Kind kind,
                 const std::vector<Node>& children,
                 const std::vector<uint64_t>& indices)
 {
-  size_t size         = sizeof(NodeData);
-  size_t payload_size = 0;
-
-  if (!children.empty())
-  {
-    payload_size += sizeof(PayloadChildren);
-    payload_size +=
-        sizeof(PayloadChildren::d_children[0]) * (children.size() - 1);
-  }
-
-  if (!indices.empty())
-  {
-    payload_size += sizeof(PayloadIndexed);
-    payload_size += sizeof(PayloadIndexed::d_indices[0]) * (indices.size() - 1);
-  }
-
-  NodeData* data = static_cast<NodeData*>(std::calloc(1, size + payload_size));
-  if (data == nullptr)
-  {
-    throw std::bad_alloc();
-  }
+  NodeData* data = static_cast<NodeData*>(allocator.allocate(
+      alloc_size_children(children.size(), indices.size())));
   data->d_kind = kind;
 
   // Connect children payload
@@ -101,10 +80,13 @@ NodeData::alloc(Kind kind,
 }
 
 void
-NodeData::dealloc(NodeData* data)
+NodeData::dealloc(NodeDataAllocator& allocator, NodeData* data)
 {
+  // Note: Size must be determined before destructing the node data since it
+  //       depends on the type of values.
+  size_t size = data->alloc_size();
   data->~NodeData();
-  std::free(data);
+  allocator.deallocate(data, size);
 }
 
 NodeData::~NodeData()
@@ -226,10 +208,67 @@ NodeData::end() const
   return nullptr;
 }
 
+/* --- NodeData private ---------------------------------------------------- */
+
+size_t
+NodeData::alloc_size_children(size_t num_children, size_t num_indices)
+{
+  size_t size = sizeof(NodeData);
+
+  if (num_children > 0)
+  {
+    size += sizeof(PayloadChildren);
+    size += sizeof(PayloadChildren::d_children[0]) * (num_children - 1);
+  }
+
+  if (num_indices > 0)
+  {
+    size += sizeof(PayloadIndexed);
+    size += sizeof(PayloadIndexed::d_indices[0]) * (num_indices - 1);
+  }
+  return size;
+}
+
+size_t
+NodeData::alloc_size() const
+{
+  if (d_kind == Kind::CONSTANT || d_kind == Kind::VARIABLE)
+  {
+    return alloc_size_symbol();
+  }
+  if (d_kind == Kind::VALUE)
+  {
+    if (d_type.is_bool())
+    {
+      return alloc_size_value<bool>();
+    }
+    if (d_type.is_bv())
+    {
+      return alloc_size_value<BitVector>();
+    }
+    if (d_type.is_rm())
+    {
+      return alloc_size_value<RoundingMode>();
+    }
+    assert(d_type.is_fp());
+    return alloc_size_value<FloatingPoint>();
+  }
+  return alloc_size_children(get_num_children(), get_num_indices());
+}
+
 void
 NodeData::gc()
 {
   d_nm->garbage_collect(this);
 }
 
+void
+NodeData::dec_ref_thread_safe()
+{
+  if (d_nm->release(this))
+  {
+    gc();
+  }
+}
+
 }  // namespace bzla::node
@@ -11,6 +11,7 @@
 #ifndef BZLA_NODE_NODE_DATA_H_INCLUDED
 #define BZLA_NODE_NODE_DATA_H_INCLUDED
 
+#include <atomic>
 #include <cassert>
 #include <cstddef>
 #include <cstdint>
@@ -19,6 +20,7 @@
 #include "bv/bitvector.h"
 #include "node/kind_info.h"
 #include "node/node.h"
+#include "node/node_data_allocator.h"
 #include "type/type.h"
 
 namespace bzla::node {
@@ -64,26 +66,22 @@ class NodeData
   using iterator = const Node*;
 
   /** Allocate node data for constants and variables. */
-  static NodeData* alloc(Kind kind, const std::optional<std::string>& symbol);
+  static NodeData* alloc(NodeDataAllocator& allocator,
+                         Kind kind,
+                         const std::optional<std::string>& symbol);
 
   /** Allocate node data for nodes with children. */
-  static NodeData* alloc(Kind kind,
+  static NodeData* alloc(NodeDataAllocator& allocator,
+                         Kind kind,
                          const std::vector<Node>& children,
                          const std::vector<uint64_t>& indices);
 
   /** Allocate node data for values. */
   template <class T>
-  static NodeData* alloc(const T& value)
+  static NodeData* alloc(NodeDataAllocator& allocator, const T& value)
   {
-    size_t size         = sizeof(NodeData);
-    size_t payload_size = sizeof(PayloadValue<T>);
-
     NodeData* data =
-        static_cast<NodeData*>(std::calloc(1, size + payload_size));
-    if (data == nullptr)
-    {
-      throw std::bad_alloc();
-    }
+        static_cast<NodeData*>(allocator.allocate(alloc_size_value<T>()));
     data->d_kind = Kind::VALUE;
 
     auto& payload   = data->payload_value<T>();
@@ -92,7 +90,7 @@ class NodeData
   }
 
   /** Deallocate node data. */
-  static void dealloc(NodeData* data);
+  static void dealloc(NodeDataAllocator& allocator, NodeData* data);
 
   NodeData() = delete;
   ~NodeData();
@@ -184,7 +182,20 @@ class NodeData
   std::optional<std::reference_wrapper<const std::string>> get_symbol() const;
 
   /** Increase the reference count by one. */
-  void inc_ref() { ++d_refs; }
+  void inc_ref()
+  {
+    if (d_thread_safe)
+    {
+      d_refs.fetch_add(1, std::memory_order_relaxed);
+    }
+    else
+    {
+      // Note: Plain load/store avoids the cost of an atomic read-modify-write
+      //       if the node manager is not shared between threads.
+      d_refs.store(d_refs.load(std::memory_order_relaxed) + 1,
+                   std::memory_order_relaxed);
+    }
+  }
 
   /**
    * Decrease the reference count by one.
@@ -194,9 +205,15 @@ class NodeData
    */
   void dec_ref()
   {
-    assert(d_refs > 0);
-    --d_refs;
-    if (d_refs == 0)
+    if (d_thread_safe)
+    {
+      dec_ref_thread_safe();
+      return;
+    }
+    uint32_t refs = d_refs.load(std::memory_order_relaxed);
+    assert(refs > 0);
+    d_refs.store(refs - 1, std::memory_order_relaxed);
+    if (refs == 1)
     {
       gc();
     }
@@ -219,6 +236,25 @@ class NodeData
   auto& info() { return d_info; }
 
  private:
+  /** @return The allocation size of node data for constants and variables. */
+  static size_t alloc_size_symbol()
+  {
+    return sizeof(NodeData) + sizeof(PayloadSymbol);
+  }
+
+  /** @return The allocation size of node data with children and indices. */
+  static size_t alloc_size_children(size_t num_children, size_t num_indices);
+
+  /** @return The allocation size of node data for values of type T. */
+  template <class T>
+  static size_t alloc_size_value()
+  {
+    return sizeof(NodeData) + sizeof(PayloadValue<T>);
+  }
+
+  /** @return The allocation size of this node data. */
+  size_t alloc_size() const;
+
   /** @return Children payload of this node. */
   PayloadChildren& payload_children()
   {
@@ -279,20 +315,23 @@ class NodeData
   /** Garbage collect this node. */
   void gc();
 
+  /** Decrease the reference count of node data shared between threads. */
+  void dec_ref_thread_safe();
+
   /** Associated node manager. */
   NodeManager* d_nm = nullptr;
-  /** Next node in unique table collision chain. */
-  NodeData* d_next = nullptr;
   /** Node id. */
   uint64_t d_id = 0;
   /** Node type. */
   Type d_type;
   /** Number of references. */
-  uint32_t d_refs = 0;
+  std::atomic<uint32_t> d_refs = 0;
   /** Node kind. */
   Kind d_kind;
   /** Node info flags. */
   NodeInfo d_info;
+  /** True if the associated node manager is in thread-safe mode. */
+  bool d_thread_safe = false;
 
   /**
    * Payload placeholder.
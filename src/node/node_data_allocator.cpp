@@ -0,0 +1,112 @@
+/***
+ * Bitwuzla: Satisfiability Modulo Theories (SMT) solver.
+ *
+ * Copyright (C) 2024 by the authors listed in the AUTHORS file at
+ * https://github.com/bitwuzla/bitwuzla/blob/main/AUTHORS
+ *
+ * This file is part of Bitwuzla under the MIT license. See COPYING for more
+ * information at https://github.com/bitwuzla/bitwuzla/blob/main/COPYING
+ */
+
+#include "node/node_data_allocator.h"
+
+#include <cassert>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+namespace bzla::node {
+
+/* --- NodeDataAllocator public -------------------------------------------- */
+
+NodeDataAllocator::~NodeDataAllocator()
+{
+  for (uint8_t* chunk : d_chunks)
+  {
+    std::free(chunk);
+  }
+}
+
+void*
+NodeDataAllocator::allocate(size_t size)
+{
+  assert(size > 0);
+
+  if (size > s_max_slab_size)
+  {
+    void* ptr = std::calloc(1, size);
+    if (ptr == nullptr)
+    {
+      throw std::bad_alloc();
+    }
+    d_bytes_in_use += size;
+    return ptr;
+  }
+
+  size_t sc        = size_class(size);
+  size_t slot_size = (sc + 1) * s_alignment;
+  void* ptr;
+
+  // Reuse previously released slot of the same size class if possible.
+  if (d_free_lists[sc] != nullptr)
+  {
+    FreeSlot* slot   = d_free_lists[sc];
+    d_free_lists[sc] = slot->d_next;
+    ptr              = slot;
+  }
+  else
+  {
+    if (d_cur + slot_size > d_end)
+    {
+      new_chunk();
+    }
+    ptr = d_cur;
+    d_cur += slot_size;
+  }
+  std::memset(ptr, 0, slot_size);
+  d_bytes_in_use += slot_size;
+  return ptr;
+}
+
+void
+NodeDataAllocator::deallocate(void* ptr, size_t size)
+{
+  assert(ptr != nullptr);
+
+  if (size > s_max_slab_size)
+  {
+    assert(d_bytes_in_use >= size);
+    d_bytes_in_use -= size;
+    std::free(ptr);
+    return;
+  }
+
+  size_t sc        = size_class(size);
+  size_t slot_size = (sc + 1) * s_alignment;
+  assert(d_bytes_in_use >= slot_size);
+  d_bytes_in_use -= slot_size;
+
+  FreeSlot* slot   = static_cast<FreeSlot*>(ptr);
+  slot->d_next     = d_free_lists[sc];
+  d_free_lists[sc] = slot;
+}
+
+/* --- NodeDataAllocator private ------------------------------------------- */
+
+void
+NodeDataAllocator::new_chunk()
+{
+  // Note: The remainder of the current chunk is not reclaimed. It is at most
+  //       s_max_slab_size bytes and thus negligible compared to the chunk
+  //       size.
+  uint8_t* chunk = static_cast<uint8_t*>(std::malloc(s_chunk_size));
+  if (chunk == nullptr)
+  {
+    throw std::bad_alloc();
+  }
+  d_chunks.push_back(chunk);
+  d_cur = chunk;
+  d_end = chunk + s_chunk_size;
+}
+
+}  // namespace bzla::node
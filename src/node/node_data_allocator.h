@@ -0,0 +1,99 @@
+/***
+ * Bitwuzla: Satisfiability Modulo Theories (SMT) solver.
+ *
+ * Copyright (C) 2024 by the authors listed in the AUTHORS file at
+ * https://github.com/bitwuzla/bitwuzla/blob/main/AUTHORS
+ *
+ * This file is part of Bitwuzla under the MIT license. See COPYING for more
+ * information at https://github.com/bitwuzla/bitwuzla/blob/main/COPYING
+ */
+
+#ifndef BZLA_NODE_NODE_DATA_ALLOCATOR_H_INCLUDED
+#define BZLA_NODE_NODE_DATA_ALLOCATOR_H_INCLUDED
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace bzla::node {
+
+/**
+ * Slab allocator for node data.
+ *
+ * Node data objects of up to `s_max_slab_size` bytes are carved out of large,
+ * contiguously allocated chunks and are recycled via per size class free
+ * lists. Size classes are multiples of `s_alignment` bytes, which covers node
+ * data with a small number of children and indices as well as all value
+ * payloads. Larger node data objects (e.g., n-ary nodes with many children)
+ * are allocated directly via std::calloc().
+ *
+ * All memory returned by allocate() is zero-initialized.
+ */
+class NodeDataAllocator
+{
+ public:
+  NodeDataAllocator() = default;
+  ~NodeDataAllocator();
+  NodeDataAllocator(const NodeDataAllocator&)            = delete;
+  NodeDataAllocator& operator=(const NodeDataAllocator&) = delete;
+
+  /**
+   * Allocate zero-initialized memory for a node data object.
+   * @param size The size of the node data object in bytes.
+   * @return Pointer to the allocated memory.
+   */
+  void* allocate(size_t size);
+
+  /**
+   * Release memory of a node data object.
+   * @param ptr  Pointer to memory previously returned by allocate().
+   * @param size The size that was passed to allocate() for `ptr`.
+   */
+  void deallocate(void* ptr, size_t size);
+
+  /** @return The number of bytes currently allocated for node data. */
+  uint64_t bytes_in_use() const { return d_bytes_in_use; }
+
+ private:
+  /** Alignment and granularity of size classes. */
+  static constexpr size_t s_alignment = alignof(std::max_align_t) < 8
+                                            ? 8
+                                            : alignof(std::max_align_t);
+  /** Maximum size of node data allocated in slabs. */
+  static constexpr size_t s_max_slab_size = 256;
+  /** Number of size classes. */
+  static constexpr size_t s_num_size_classes = s_max_slab_size / s_alignment;
+  /** Size of slab chunks in bytes. */
+  static constexpr size_t s_chunk_size = 1 << 18;
+
+  /** Free list entry, stored in-place in released slots. */
+  struct FreeSlot
+  {
+    FreeSlot* d_next;
+  };
+
+  /** @return The size class of a node data object of given size. */
+  static size_t size_class(size_t size)
+  {
+    return (size + s_alignment - 1) / s_alignment - 1;
+  }
+
+  /** Allocate a new chunk for the slab region. */
+  void new_chunk();
+
+  /** Free lists of released slots, indexed by size class. */
+  std::array<FreeSlot*, s_num_size_classes> d_free_lists{};
+  /** Allocated chunks. */
+  std::vector<uint8_t*> d_chunks;
+  /** Next free byte in the current chunk. */
+  uint8_t* d_cur = nullptr;
+  /** End of the current chunk. */
+  uint8_t* d_end = nullptr;
+  /** Number of bytes currently in use by node data. */
+  uint64_t d_bytes_in_use = 0;
+};
+
+}  // namespace bzla::node
+
+#endif
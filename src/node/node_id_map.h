@@ -0,0 +1,294 @@
+/***
+ * Bitwuzla: Satisfiability Modulo Theories (SMT) solver.
+ *
+ * Copyright (C) 2024 by the authors listed in the AUTHORS file at
+ * https://github.com/bitwuzla/bitwuzla/blob/main/AUTHORS
+ *
+ * This file is part of Bitwuzla under the MIT license. See COPYING for more
+ * information at https://github.com/bitwuzla/bitwuzla/blob/main/COPYING
+ */
+
+#ifndef BZLA_NODE_NODE_ID_MAP_H_INCLUDED
+#define BZLA_NODE_NODE_ID_MAP_H_INCLUDED
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "node/node.h"
+
+namespace bzla::node {
+
+/**
+ * Map from nodes to values of type T, indexed by node id.
+ *
+ * Drop-in replacement for std::unordered_map<Node, T> for per-node caches.
+ * Entries are stored in lazily allocated pages of consecutive node ids, which
+ * avoids hashing on lookup and keeps entries of nodes with nearby ids (e.g.,
+ * nodes of the same DAG) close in memory. Like std::unordered_map, the map
+ * keeps a reference to its keys, and references to entries stay valid until
+ * the entry is erased.
+ *
+ * @note T must be default constructible. Iteration visits entries in order
+ *       of increasing node id and is linear in the number of allocated pages.
+ */
+template <class T>
+class NodeIdMap
+{
+ public:
+  using key_type    = Node;
+  using mapped_type = T;
+  using value_type  = std::pair<Node, T>;
+
+  template <bool is_const>
+  class Iterator
+  {
+    friend NodeIdMap;
+    friend class Iterator<!is_const>;
+
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type        = NodeIdMap::value_type;
+    using difference_type   = std::ptrdiff_t;
+    using map_type = std::conditional_t<is_const, const NodeIdMap, NodeIdMap>;
+    using pointer =
+        std::conditional_t<is_const, const value_type*, value_type*>;
+    using reference =
+        std::conditional_t<is_const, const value_type&, value_type&>;
+
+    Iterator() = default;
+    /** Conversion from non-const to const iterator. */
+    template <bool c = is_const, class = std::enable_if_t<c>>
+    Iterator(const Iterator<false>& other)
+        : d_map(other.d_map), d_index(other.d_index)
+    {
+    }
+
+    reference operator*() const { return d_map->entry(d_index); }
+    pointer operator->() const { return &d_map->entry(d_index); }
+
+    Iterator& operator++()
+    {
+      d_index = d_map->next(d_index + 1);
+      return *this;
+    }
+
+    Iterator operator++(int)
+    {
+      Iterator res = *this;
+      ++(*this);
+      return res;
+    }
+
+    bool operator==(const Iterator& other) const
+    {
+      return d_index == other.d_index;
+    }
+    bool operator!=(const Iterator& other) const
+    {
+      return d_index != other.d_index;
+    }
+
+   private:
+    Iterator(map_type* map, size_t index) : d_map(map), d_index(index) {}
+
+    /** The associated map. */
+    map_type* d_map = nullptr;
+    /** The index (node id) of the current entry. */
+    size_t d_index = 0;
+  };
+
+  using iterator       = Iterator<false>;
+  using const_iterator = Iterator<true>;
+
+  /** @return The number of entries in the map. */
+  size_t size() const { return d_size; }
+
+  /** @return True if the map has no entries. */
+  bool empty() const { return d_size == 0; }
+
+  /** Remove all entries from the map and release its memory. */
+  void clear()
+  {
+    d_pages.clear();
+    d_size = 0;
+  }
+
+  /**
+   * Insert entry for `key` if it does not exist yet.
+   * @param key The node.
+   * @param args The arguments to construct the value from.
+   * @return A pair of the iterator to the entry for `key` and a Boolean that
+   *         indicates whether the entry was inserted.
+   */
+  template <class... Args>
+  std::pair<iterator, bool> emplace(const Node& key, Args&&... args)
+  {
+    assert(!key.is_null());
+    uint64_t id      = key.id();
+    value_type& elem = get_or_create(id);
+    if (!elem.first.is_null())
+    {
+      return std::make_pair(iterator(this, id), false);
+    }
+    elem.first  = key;
+    elem.second = T(std::forward<Args>(args)...);
+    ++d_size;
+    return std::make_pair(iterator(this, id), true);
+  }
+
+  /** Insert entry if key does not exist yet (see emplace()). */
+  std::pair<iterator, bool> insert(const value_type& value)
+  {
+    return emplace(value.first, value.second);
+  }
+
+  /**
+   * @return A reference to the value of `key`. Inserts a default constructed
+   *         value if `key` is not in the map.
+   */
+  T& operator[](const Node& key) { return emplace(key).first->second; }
+
+  /** @return A reference to the value of `key`, throws if not in the map. */
+  T& at(const Node& key)
+  {
+    return const_cast<T&>(std::as_const(*this).at(key));
+  }
+
+  const T& at(const Node& key) const
+  {
+    const value_type* elem = lookup(key);
+    if (elem == nullptr)
+    {
+      throw std::out_of_range("NodeIdMap::at");
+    }
+    return elem->second;
+  }
+
+  /** @return An iterator to the entry of `key` or end() if not in the map. */
+  iterator find(const Node& key)
+  {
+    return lookup(key) ? iterator(this, key.id()) : end();
+  }
+
+  const_iterator find(const Node& key) const
+  {
+    return lookup(key) ? const_iterator(this, key.id()) : end();
+  }
+
+  /** @return 1 if `key` is in the map and 0 otherwise. */
+  size_t count(const Node& key) const { return lookup(key) ? 1 : 0; }
+
+  /** @return True if `key` is in the map. */
+  bool contains(const Node& key) const { return lookup(key) != nullptr; }
+
+  /**
+   * Remove entry of `key`.
+   * @return The number of removed entries.
+   */
+  size_t erase(const Node& key)
+  {
+    value_type* elem = const_cast<value_type*>(lookup(key));
+    if (elem == nullptr)
+    {
+      return 0;
+    }
+    *elem = value_type();
+    --d_size;
+    return 1;
+  }
+
+  iterator begin() { return iterator(this, next(0)); }
+  iterator end() { return iterator(this, end_index()); }
+  const_iterator begin() const { return const_iterator(this, next(0)); }
+  const_iterator end() const { return const_iterator(this, end_index()); }
+
+ private:
+  /** Number of entries per page, must be a power of two. */
+  static constexpr size_t s_page_size = 1024;
+
+  using Page = std::array<value_type, s_page_size>;
+
+  /** @return The index one past the last possible entry. */
+  size_t end_index() const { return d_pages.size() * s_page_size; }
+
+  /** @return Entry at given index, which must be allocated. */
+  value_type& entry(size_t index)
+  {
+    return (*d_pages[index / s_page_size])[index % s_page_size];
+  }
+  const value_type& entry(size_t index) const
+  {
+    return (*d_pages[index / s_page_size])[index % s_page_size];
+  }
+
+  /** @return The entry of `key` or nullptr if not in the map. */
+  const value_type* lookup(const Node& key) const
+  {
+    assert(!key.is_null());
+    uint64_t id = key.id();
+    size_t page = id / s_page_size;
+    if (page >= d_pages.size() || d_pages[page] == nullptr)
+    {
+      return nullptr;
+    }
+    const value_type& elem = (*d_pages[page])[id % s_page_size];
+    if (elem.first.is_null())
+    {
+      return nullptr;
+    }
+    assert(elem.first == key);
+    return &elem;
+  }
+
+  /** @return The entry at index `id`, allocates its page if necessary. */
+  value_type& get_or_create(uint64_t id)
+  {
+    size_t page = id / s_page_size;
+    if (page >= d_pages.size())
+    {
+      d_pages.resize(page + 1);
+    }
+    if (d_pages[page] == nullptr)
+    {
+      d_pages[page].reset(new Page());
+    }
+    return (*d_pages[page])[id % s_page_size];
+  }
+
+  /** @return The index of the first entry at or after `index`. */
+  size_t next(size_t index) const
+  {
+    size_t end = end_index();
+    while (index < end)
+    {
+      const auto& page = d_pages[index / s_page_size];
+      if (page == nullptr)
+      {
+        index = (index / s_page_size + 1) * s_page_size;
+        continue;
+      }
+      if (!(*page)[index % s_page_size].first.is_null())
+      {
+        break;
+      }
+      ++index;
+    }
+    return index < end ? index : end;
+  }
+
+  /** Pages of entries, indexed by node id / s_page_size. */
+  std::vector<std::unique_ptr<Page>> d_pages;
+  /** Number of entries in the map. */
+  size_t d_size = 0;
+};
+
+}  // namespace bzla::node
+
+#endif
@@ -24,6 +24,16 @@ using namespace node;
 
 /* --- NodeManager public -------------------------------------------------- */
 
+NodeManager::NodeManager(bool thread_safe)
+    : d_thread_safe(thread_safe), d_tm(thread_safe)
+{
+  size_t num_shards = thread_safe ? s_num_shards : 1;
+  for (size_t i = 0; i < num_shards; ++i)
+  {
+    d_shards.emplace_back(new Shard());
+  }
+}
+
 NodeManager::~NodeManager()
 {
   // Cleanup remaining node data for constants and variables.
@@ -34,7 +44,7 @@ NodeManager::~NodeManager()
   //       node data before destructing the node manager.
   for (NodeData* d : d_alloc_nodes)
   {
-    NodeData::dealloc(d);
+    NodeData::dealloc(d_node_allocator, d);
   }
 }
 
@@ -47,13 +57,7 @@ NodeManager::tm()
 Node
 NodeManager::mk_const(const Type& t, const std::optional<std::string>& symbol)
 {
-  assert(!t.is_null());
-  assert(t.tm() == &d_tm);
-  NodeData* data = NodeData::alloc(Kind::CONSTANT, symbol);
-  data->d_type   = t;
-  init_id(data);
-  d_alloc_nodes.emplace(data);
-  return Node(data);
+  return mk_symbol_node(Kind::CONSTANT, t, symbol);
 }
 
 Node
@@ -66,73 +70,39 @@ NodeManager::mk_const_array(const Type& t, const Node& term)
   assert(t.tm() == &d_tm);
   assert(term.nm() == this);
 
-  NodeData* data = find_or_insert_node(Kind::CONST_ARRAY, t, {term}, {});
-  return Node(data);
+  return find_or_insert_node(Kind::CONST_ARRAY, t, {term}, {});
 }
 
 Node
 NodeManager::mk_var(const Type& t, const std::optional<std::string>& symbol)
 {
-  assert(!t.is_null());
-  assert(t.tm() == &d_tm);
-  NodeData* data = NodeData::alloc(Kind::VARIABLE, symbol);
-  data->d_type   = t;
-  init_id(data);
-  d_alloc_nodes.emplace(data);
-  return Node(data);
+  return mk_symbol_node(Kind::VARIABLE, t, symbol);
 }
 
 Node
 NodeManager::mk_value(bool value)
 {
-  Type type             = mk_bool_type();
-  auto [inserted, data] = d_unique_table.find_or_insert(type, value);
-  if (inserted)
-  {
-    init_id(data);
-    data->d_type = std::move(type);
-  }
-  return Node(data);
+  return find_or_insert_value(mk_bool_type(), value);
 }
 
 Node
 NodeManager::mk_value(const BitVector& value)
 {
-  Type type             = mk_bv_type(value.size());
-  auto [inserted, data] = d_unique_table.find_or_insert(type, value);
-  if (inserted)
-  {
-    init_id(data);
-    data->d_type = std::move(type);
-  }
-  return Node(data);
+  return find_or_insert_value(mk_bv_type(value.size()), value);
 }
 
 Node
 NodeManager::mk_value(const RoundingMode value)
 {
-  Type type             = mk_rm_type();
-  auto [inserted, data] = d_unique_table.find_or_insert(type, value);
-  if (inserted)
-  {
-    init_id(data);
-    data->d_type = std::move(type);
-  }
-  return Node(data);
+  return find_or_insert_value(mk_rm_type(), value);
 }
 
 Node
 NodeManager::mk_value(const FloatingPoint& value)
 {
-  Type type =
-      mk_fp_type(value.get_exponent_size(), value.get_significand_size());
-  auto [inserted, data] = d_unique_table.find_or_insert(type, value);
-  if (inserted)
-  {
-    init_id(data);
-    data->d_type = std::move(type);
-  }
-  return Node(data);
+  return find_or_insert_value(
+      mk_fp_type(value.get_exponent_size(), value.get_significand_size()),
+      value);
 }
 
 Node
@@ -148,8 +118,7 @@ NodeManager::mk_node(Kind kind,
     return c.nm() == this;
   }));
 
-  NodeData* data = find_or_insert_node(kind, Type(), children, indices);
-  return Node(data);
+  return find_or_insert_node(kind, Type(), children, indices);
 }
 
 Node
@@ -793,27 +762,58 @@ NodeManager::check_type(Kind kind,
   return std::make_pair(true, "");
 }
 
+uint64_t
+NodeManager::node_data_bytes() const
+{
+  uint64_t bytes = d_node_allocator.bytes_in_use();
+  for (const auto& shard : d_shards)
+  {
+    bytes += shard->d_allocator.bytes_in_use();
+  }
+  return bytes;
+}
+
 /* --- NodeManager private ------------------------------------------------- */
 
 void
 NodeManager::init_id(NodeData* data)
 {
-  assert(d_node_id_counter < UINT64_MAX);
   assert(data != nullptr);
   assert(data->d_id == 0);
-  data->d_id = d_node_id_counter++;
-  data->d_nm = this;
-  ++d_stats.d_num_node_data;
+  if (d_thread_safe)
+  {
+    data->d_id = d_node_id_counter.fetch_add(1, std::memory_order_relaxed);
+    d_stats.d_num_node_data.fetch_add(1, std::memory_order_relaxed);
+  }
+  else
+  {
+    data->d_id = d_node_id_counter.load(std::memory_order_relaxed);
+    d_node_id_counter.store(data->d_id + 1, std::memory_order_relaxed);
+    d_stats.d_num_node_data.store(
+        d_stats.d_num_node_data.load(std::memory_order_relaxed) + 1,
+        std::memory_order_relaxed);
+  }
+  assert(data->d_id < UINT64_MAX);
+  data->d_nm          = this;
+  data->d_thread_safe = d_thread_safe;
 }
 
-NodeData*
+Node
 NodeManager::find_or_insert_node(node::Kind kind,
                                  const Type& type,
                                  const std::vector<Node>& children,
                                  const std::vector<uint64_t>& indices)
 {
+  Shard& s =
+      d_thread_safe
+          ? shard(d_shards[0]->d_unique_table.hash(kind, children, indices))
+          : *d_shards[0];
+  // Note: New node data must be initialized and referenced before the lock is
+  //       released, otherwise it could be observed uninitialized or garbage
+  //       collected by concurrent threads.
+  auto guard = lock(s.d_mutex);
   auto [inserted, data] =
-      d_unique_table.find_or_insert(kind, type, children, indices);
+      s.d_unique_table.find_or_insert(kind, type, children, indices);
   if (inserted)
   {
     // Initialize new node
@@ -827,16 +827,53 @@ NodeManager::find_or_insert_node(node::Kind kind,
       data->d_type = type;
     }
   }
-  return data;
+  return Node(data);
+}
+
+template <class T>
+Node
+NodeManager::find_or_insert_value(Type&& type, const T& value)
+{
+  Shard& s = d_thread_safe
+                 ? shard(d_shards[0]->d_unique_table.hash_value(value))
+                 : *d_shards[0];
+  auto guard            = lock(s.d_mutex);
+  auto [inserted, data] = s.d_unique_table.find_or_insert(type, value);
+  if (inserted)
+  {
+    init_id(data);
+    data->d_type = std::move(type);
+  }
+  return Node(data);
+}
+
+Node
+NodeManager::mk_symbol_node(Kind kind,
+                            const Type& t,
+                            const std::optional<std::string>& symbol)
+{
+  assert(kind == Kind::CONSTANT || kind == Kind::VARIABLE);
+  assert(!t.is_null());
+  assert(t.tm() == &d_tm);
+  auto guard     = lock(d_alloc_mutex);
+  NodeData* data = NodeData::alloc(d_node_allocator, kind, symbol);
+  data->d_type   = t;
+  init_id(data);
+  d_alloc_nodes.emplace(data);
+  return Node(data);
 }
 
 void
 NodeManager::garbage_collect(NodeData* data)
 {
   assert(data->d_refs == 0);
-  assert(!d_in_gc_mode);
 
-  d_in_gc_mode = true;
+  // Note: Garbage collection may run concurrently in thread-safe mode.
+  if (!d_thread_safe)
+  {
+    assert(!d_in_gc_mode);
+    d_in_gc_mode = true;
+  }
 
   std::deque<NodeData*> visit{data};
 
@@ -848,11 +885,17 @@ NodeManager::garbage_collect(NodeData* data)
 
     size_t num_children = cur->get_num_children();
     Kind kind           = cur->get_kind();
+    bool in_table       = num_children > 0 || kind == Kind::VALUE;
+
+    // Note: The shard has to be determined before we modify the children
+    //       since the hash value depends on them.
+    Shard* s = in_table ? &shard(cur) : nullptr;
 
-    // Erase node data before we modify children.
-    if (num_children > 0 || kind == Kind::VALUE)
+    // Erase node data before we modify children. In thread-safe mode, node
+    // data was already erased by release().
+    if (in_table && !d_thread_safe)
     {
-      d_unique_table.erase(cur);
+      s->d_unique_table.erase(cur);
     }
 
     if (num_children > 0)
@@ -862,28 +905,104 @@ NodeManager::garbage_collect(NodeData* data)
       {
         Node& child = payload.d_children[i];
         auto d      = child.d_data;
+        child.d_data = nullptr;
+
+        if (d_thread_safe)
+        {
+          if (release(d))
+          {
+            visit.push_back(d);
+          }
+          continue;
+        }
 
         // Manually decrement reference count to not trigger decrement of
         // NodeData reference. This will avoid recursive calls to
         // garbage_collect().
-        --d->d_refs;
-        child.d_data = nullptr;
-        if (d->d_refs == 0)
+        uint32_t refs = d->d_refs.load(std::memory_order_relaxed) - 1;
+        d->d_refs.store(refs, std::memory_order_relaxed);
+        if (refs == 0)
         {
           visit.push_back(d);
         }
       }
     }
-    else if (kind == Kind::CONSTANT || kind == Kind::VARIABLE)
+
+    if (in_table)
+    {
+      auto guard = lock(s->d_mutex);
+      NodeData::dealloc(s->d_allocator, cur);
+    }
+    else
     {
+      assert(kind == Kind::CONSTANT || kind == Kind::VARIABLE);
+      auto guard = lock(d_alloc_mutex);
       d_alloc_nodes.erase(cur);
+      NodeData::dealloc(d_node_allocator, cur);
+    }
+    if (d_thread_safe)
+    {
+      d_stats.d_num_node_data.fetch_sub(1, std::memory_order_relaxed);
+      d_stats.d_num_node_data_dealloc.fetch_add(1, std::memory_order_relaxed);
+    }
+    else
+    {
+      d_stats.d_num_node_data.store(
+          d_stats.d_num_node_data.load(std::memory_order_relaxed) - 1,
+          std::memory_order_relaxed);
+      d_stats.d_num_node_data_dealloc.store(
+          d_stats.d_num_node_data_dealloc.load(std::memory_order_relaxed) + 1,
+          std::memory_order_relaxed);
     }
-    NodeData::dealloc(cur);
-    --d_stats.d_num_node_data;
-    ++d_stats.d_num_node_data_dealloc;
   } while (!visit.empty());
 
-  d_in_gc_mode = false;
+  if (!d_thread_safe)
+  {
+    d_in_gc_mode = false;
+  }
+}
+
+bool
+NodeManager::release(NodeData* d)
+{
+  assert(d_thread_safe);
+
+  // Fast path: reference count does not drop to zero, no lock required.
+  uint32_t refs = d->d_refs.load(std::memory_order_relaxed);
+  while (refs > 1)
+  {
+    if (d->d_refs.compare_exchange_weak(
+            refs, refs - 1, std::memory_order_acq_rel))
+    {
+      return false;
+    }
+  }
+
+  // Constants and variables are not hash consed and can't be resurrected.
+  Kind kind = d->get_kind();
+  if (kind == Kind::CONSTANT || kind == Kind::VARIABLE)
+  {
+    return d->d_refs.fetch_sub(1, std::memory_order_acq_rel) == 1;
+  }
+
+  Shard& s = shard(d);
+  std::lock_guard<std::mutex> guard(s.d_mutex);
+  if (d->d_refs.fetch_sub(1, std::memory_order_acq_rel) != 1)
+  {
+    return false;
+  }
+  s.d_unique_table.erase(d);
+  return true;
+}
+
+NodeManager::Shard&
+NodeManager::shard(const NodeData* d)
+{
+  if (!d_thread_safe)
+  {
+    return *d_shards[0];
+  }
+  return shard(d_shards[0]->d_unique_table.hash(d));
 }
 
 const std::optional<std::reference_wrapper<const std::string>>
@@ -11,9 +11,11 @@
 #ifndef BZLA_NODE_NODE_MANAGER_H_INCLUDED
 #define BZLA_NODE_NODE_MANAGER_H_INCLUDED
 
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <string>
 #include <unordered_map>
@@ -36,7 +38,15 @@ class NodeManager
   friend node::NodeData;
 
  public:
-  NodeManager() = default;
+  /**
+   * Constructor.
+   *
+   * @param thread_safe True to allow constructing and releasing nodes from
+   *                    multiple threads concurrently. In this mode, the unique
+   *                    table is split into independently locked shards and
+   *                    reference counts are updated atomically.
+   */
+  explicit NodeManager(bool thread_safe = false);
   ~NodeManager();
   NodeManager(const NodeManager&)            = delete;
   NodeManager& operator=(const NodeManager&) = delete;
@@ -188,11 +198,17 @@ class NodeManager
 
 #ifndef NDEBUG
   /** @return Current maximum node id. */
-  uint64_t max_node_id() const { return d_node_id_counter; }
+  uint64_t max_node_id() const { return d_node_id_counter.load(); }
 #endif
 
   const auto& statistics() const { return d_stats; }
 
+  /** @return The number of bytes currently allocated for node data. */
+  uint64_t node_data_bytes() const;
+
+  /** @return True if this node manager may be used from multiple threads. */
+  bool is_thread_safe() const { return d_thread_safe; }
+
  private:
   /**
    * Initialize node data.
@@ -205,18 +221,40 @@ class NodeManager
   void init_id(node::NodeData* d);
 
   /**
-   * Find or insert new node data based on given criteria.
+   * Find or insert new node based on given criteria.
    *
    * @param kind The node kind.
    * @param type The node type (needed for CONST_ARRAY).
    * @param children The node children.
    * @param indices The indices for indexed nodes.
-   * @return The node data pointer.
+   * @return The node.
+   */
+  Node find_or_insert_node(node::Kind kind,
+                           const Type& type,
+                           const std::vector<Node>& children,
+                           const std::vector<uint64_t>& indices);
+
+  /**
+   * Find or insert value node.
+   *
+   * @param type The type of the value.
+   * @param value The value.
+   * @return The value node.
    */
-  node::NodeData* find_or_insert_node(node::Kind kind,
-                                      const Type& type,
-                                      const std::vector<Node>& children,
-                                      const std::vector<uint64_t>& indices);
+  template <class T>
+  Node find_or_insert_value(Type&& type, const T& value);
+
+  /**
+   * Create constant or variable node data.
+   *
+   * @param kind The node kind (CONSTANT or VARIABLE).
+   * @param t The type of the node.
+   * @param symbol The symbol of the node.
+   * @return The node.
+   */
+  Node mk_symbol_node(node::Kind kind,
+                      const Type& t,
+                      const std::optional<std::string>& symbol);
 
   /** Compute type for a node. */
   Type compute_type(node::Kind kind,
@@ -233,28 +271,93 @@ class NodeManager
    */
   void garbage_collect(node::NodeData* d);
 
+  /**
+   * Release a reference to node data in thread-safe mode.
+   *
+   * A reference count that drops to zero is only decremented while holding
+   * the lock of the shard the node data belongs to, which guarantees that it
+   * cannot be resurrected by a concurrent lookup. Such node data is removed
+   * from its unique table.
+   *
+   * @param d The node data.
+   * @return True if the reference count of `d` dropped to zero and `d` must
+   *         be garbage collected.
+   */
+  bool release(node::NodeData* d);
+
+  /** Unique table shard with its own lock and node data allocator. */
+  struct Shard
+  {
+    /** Lock for the unique table and allocator of this shard. */
+    std::mutex d_mutex;
+    /**
+     * Allocator for node data.
+     *
+     * @note Must be declared before d_unique_table since the unique table
+     *       releases its remaining node data on destruction.
+     */
+    node::NodeDataAllocator d_allocator;
+    /** Lookup data structure for hash consing of node data. */
+    node::NodeUniqueTable d_unique_table{d_allocator};
+  };
+
+  /** @return The shard for node data with given hash value. */
+  Shard& shard(size_t hash)
+  {
+    return *d_shards[hash & (d_shards.size() - 1)];
+  }
+
+  /** @return The shard that stores the given node data. */
+  Shard& shard(const node::NodeData* d);
+
+  /**
+   * @return A lock for the given mutex, which is only acquired if the node
+   *         manager is in thread-safe mode.
+   */
+  std::unique_lock<std::mutex> lock(std::mutex& mutex)
+  {
+    return d_thread_safe ? std::unique_lock<std::mutex>(mutex)
+                         : std::unique_lock<std::mutex>();
+  }
+
+  /** Number of unique table shards in thread-safe mode. */
+  static constexpr size_t s_num_shards = 64;
+
   const std::optional<std::reference_wrapper<const std::string>> get_symbol(
       const node::NodeData* d) const;
 
+  /** True if this node manager may be used from multiple threads. */
+  const bool d_thread_safe;
+
   /** Type manager. */
   type::TypeManager d_tm;
 
   /** Node id counter. */
-  uint64_t d_node_id_counter = 1;
+  std::atomic<uint64_t> d_node_id_counter = 1;
 
   /** Indicates whether node manager is in garbage collection mode. */
   bool d_in_gc_mode = false;
 
+  /** Lock for d_alloc_nodes and d_node_allocator. */
+  std::mutex d_alloc_mutex;
+
   /** Stores allocated node data objects for constants and variables. */
   std::unordered_set<node::NodeData*> d_alloc_nodes;
 
-  /** Lookup data structure for hash consing of node data. */
-  node::NodeUniqueTable d_unique_table;
+  /** Allocator for node data of constants and variables. */
+  node::NodeDataAllocator d_node_allocator;
+
+  /**
+   * Unique table shards for hash consing of node data.
+   *
+   * @note Only one shard is used if not in thread-safe mode.
+   */
+  std::vector<std::unique_ptr<Shard>> d_shards;
 
   struct Statistics
   {
-    uint64_t d_num_node_data = 0;
-    uint64_t d_num_node_data_dealloc = 0;
+    std::atomic<uint64_t> d_num_node_data = 0;
+    std::atomic<uint64_t> d_num_node_data_dealloc = 0;
   } d_stats;
 };
 
@@ -6,7 +6,11 @@ namespace bzla::node {
 
 /* --- NodeUniqueTable public ----------------------------------------------- */
 
-NodeUniqueTable::NodeUniqueTable() { d_buckets.resize(16, nullptr); }
+NodeUniqueTable::NodeUniqueTable(NodeDataAllocator& allocator)
+    : d_allocator(allocator)
+{
+  d_slots.resize(16);
+}
 
 NodeUniqueTable::~NodeUniqueTable()
 {
@@ -16,23 +20,22 @@ NodeUniqueTable::~NodeUniqueTable()
   //       data leaks. However, nodes that are stored in static memory do not
   //       get garbage collected. Hence, we have to make sure to invalidate all
   //       node data before destructing the unique table.
-  for (size_t i = 0, size = d_buckets.size(); i < size; ++i)
+  for (const Slot& slot : d_slots)
   {
-    NodeData* cur = d_buckets[i];
-    while (cur != nullptr)
+    NodeData* cur = slot.d_data;
+    if (cur == nullptr)
+    {
+      continue;
+    }
+    if (cur->has_children())
     {
-      NodeData* next = cur->d_next;
-      if (cur->has_children())
+      auto& payload = cur->payload_children();
+      for (size_t j = 0; j < payload.d_num_children; ++j)
       {
-        auto& payload = cur->payload_children();
-        for (size_t j = 0; j < payload.d_num_children; ++j)
-        {
-          payload.d_children[j].d_data = nullptr;
-        }
+        payload.d_children[j].d_data = nullptr;
       }
-      NodeData::dealloc(cur);
-      cur = next;
     }
+    NodeData::dealloc(d_allocator, cur);
   }
 }
 
@@ -44,66 +47,67 @@ NodeUniqueTable::find_or_insert(Kind kind,
 {
   assert(kind != Kind::VALUE);
 
-  size_t hd     = hash(kind, children, indices);
-  size_t h      = bucket_hash(hd);
-  NodeData* cur = d_buckets[h];
+  size_t hd = hash(kind, children, indices);
 
-  // Check collision chain.
-  while (cur)
+  // Probe slots until we hit an empty slot.
+  for (size_t i = slot_index(hd);; i = next_slot(i))
   {
+    const Slot& slot = d_slots[i];
+    if (slot.d_data == nullptr)
+    {
+      break;
+    }
     // Found existing node
-    if (equals(*cur, kind, type, children, indices))
+    if (slot.d_hash == hd
+        && equals(*slot.d_data, kind, type, children, indices))
     {
-      return std::make_pair(false, cur);
+      return std::make_pair(false, slot.d_data);
     }
-    cur = cur->d_next;
   }
 
   // Create new node and insert
-  NodeData* d = NodeData::alloc(kind, children, indices);
+  NodeData* d = NodeData::alloc(d_allocator, kind, children, indices);
   if (needs_resize())
   {
     resize();
-    h = bucket_hash(hd);
   }
-  assert(d->d_next == nullptr);
-  d->d_next    = d_buckets[h];
-  d_buckets[h] = d;
-
-  ++d_num_elements;
+  insert(hd, d);
   return std::make_pair(true, d);
 }
 
 void
 NodeUniqueTable::erase(const NodeData* d)
 {
-  size_t h       = bucket_hash(hash(d));
-  NodeData* cur  = d_buckets[h];
-  NodeData* prev = nullptr;
-  assert(cur != nullptr);
+  size_t i = slot_index(hash(d));
 
-  // Find data in collision chain.
-  while (cur)
+  // Find slot of data in probe sequence.
+  // Note: No need to use equals() here, we can safely compare the pointers.
+  while (d_slots[i].d_data != d)
   {
-    // Note: No need to use equals() here, we can safely compare the pointers.
-    if (cur == d)
-    {
-      break;
-    }
-    prev = cur;
-    cur  = cur->d_next;
+    assert(d_slots[i].d_data != nullptr);
+    i = next_slot(i);
   }
-  assert(cur);
 
-  // Update collision chain.
-  if (prev == nullptr)
-  {
-    d_buckets[h] = cur->d_next;
-  }
-  else
+  // Backward shift deletion: Move subsequent entries of the probe sequence
+  // into the freed slot if the freed slot lies between their home slot and
+  // their current slot. This avoids tombstones and keeps probe sequences
+  // short.
+  size_t mask = d_slots.size() - 1;
+  for (size_t j = next_slot(i);; j = next_slot(j))
   {
-    prev->d_next = cur->d_next;
+    const Slot& slot = d_slots[j];
+    if (slot.d_data == nullptr)
+    {
+      break;
+    }
+    size_t home = slot_index(slot.d_hash);
+    if (((j - home) & mask) >= ((j - i) & mask))
+    {
+      d_slots[i] = slot;
+      i          = j;
+    }
   }
+  d_slots[i] = Slot();
   --d_num_elements;
 }
 
@@ -112,24 +116,32 @@ NodeUniqueTable::erase(const NodeData* d)
 void
 NodeUniqueTable::resize()
 {
-  size_t new_size = d_buckets.capacity() * 2;
-  std::vector<NodeData*> buckets(new_size, nullptr);
+  std::vector<Slot> slots(d_slots.size() * 2);
+  std::swap(slots, d_slots);
+  --d_shift;
 
-  // Rehash elements.
-  size_t mask = new_size - 1;
-  for (auto cur : d_buckets)
+  // Rehash elements. Hash values are cached, no need to access node data.
+  d_num_elements = 0;
+  for (const Slot& slot : slots)
   {
-    while (cur)
+    if (slot.d_data != nullptr)
     {
-      size_t h     = bucket_hash(hash(cur), mask);
-      auto next    = cur->d_next;
-      cur->d_next  = buckets[h];
-      buckets[h]   = cur;
-      cur          = next;
+      insert(slot.d_hash, slot.d_data);
     }
   }
+}
 
-  d_buckets = std::move(buckets);
+void
+NodeUniqueTable::insert(size_t hash, NodeData* d)
+{
+  size_t i = slot_index(hash);
+  while (d_slots[i].d_data != nullptr)
+  {
+    i = next_slot(i);
+  }
+  d_slots[i].d_hash = hash;
+  d_slots[i].d_data = d;
+  ++d_num_elements;
 }
 
 size_t
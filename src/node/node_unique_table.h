@@ -11,6 +11,7 @@
 #ifndef BZLA_NODE_NODE_UNIQUE_TABLE_H_INCLUDED
 #define BZLA_NODE_NODE_UNIQUE_TABLE_H_INCLUDED
 
+#include <cstdint>
 #include <iostream>
 #include <vector>
 
@@ -21,7 +22,11 @@ namespace bzla::node {
 class NodeUniqueTable
 {
  public:
-  NodeUniqueTable();
+  /**
+   * Constructor.
+   * @param allocator The allocator used for allocating new node data.
+   */
+  NodeUniqueTable(NodeDataAllocator& allocator);
   ~NodeUniqueTable();
 
   /**
@@ -41,59 +46,106 @@ class NodeUniqueTable
   template <class T>
   std::pair<bool, NodeData*> find_or_insert(const Type& type, const T& value)
   {
-    size_t hd     = hash_value(value);
-    size_t h      = bucket_hash(hd);
-    NodeData* cur = d_buckets[h];
+    size_t hd = hash_value(value);
 
-    // Check collision chain.
-    while (cur)
+    // Probe slots until we hit an empty slot.
+    for (size_t i = slot_index(hd);; i = next_slot(i))
     {
-      if (cur->d_kind == Kind::VALUE && cur->get_type() == type)
+      const Slot& slot = d_slots[i];
+      if (slot.d_data == nullptr)
+      {
+        break;
+      }
+      // Note: Node data is only accessed if the cached hash values match.
+      if (slot.d_hash == hd && slot.d_data->d_kind == Kind::VALUE
+          && slot.d_data->get_type() == type)
       {
-        const auto& payload = cur->payload_value<T>();
+        const auto& payload = slot.d_data->payload_value<T>();
         if (payload.d_value == value)
         {
-          return std::make_pair(false, cur);
+          return std::make_pair(false, slot.d_data);
         }
       }
-      cur = cur->d_next;
     }
 
     // Create new node and insert
-    NodeData* d = NodeData::alloc(value);
+    NodeData* d = NodeData::alloc(d_allocator, value);
     if (needs_resize())
     {
       resize();
-      h = bucket_hash(hd);
     }
-    assert(d->d_next == nullptr);
-    d->d_next    = d_buckets[h];
-    d_buckets[h] = d;
-
-    ++d_num_elements;
+    insert(hd, d);
     return std::make_pair(true, d);
   }
 
   /** Delete node data from unique table. */
   void erase(const NodeData* d);
 
+  /** Hash node data. */
+  size_t hash(const NodeData* d) const;
+
+  /** Compute hash value of node lookup data. */
+  size_t hash(Kind kind,
+              const std::vector<Node>& children,
+              const std::vector<uint64_t>& indices) const;
+
+  /** Compute hash value of value node lookup data. */
+  template <class T>
+  size_t hash_value(const T& value) const
+  {
+    return static_cast<size_t>(Kind::VALUE) + std::hash<T>{}(value);
+  }
+
  private:
   static constexpr std::array<size_t, 4> s_primes = {
       333444569u, 76891121u, 456790003u, 111130391u};
 
-  /** Check whether unique table needs to be resized. */
-  bool needs_resize() const { return d_num_elements >= d_buckets.capacity(); }
+  /** Multiplier for Fibonacci hashing of slot indices. */
+  static constexpr uint64_t s_fib_mult = 11400714819323198485u;
+
+  /**
+   * Hash table slot.
+   *
+   * Stores the hash value of the node data alongside the pointer to avoid
+   * dereferencing node data of non-matching slots while probing.
+   */
+  struct Slot
+  {
+    /** The cached hash value of the node data. */
+    size_t d_hash = 0;
+    /** The node data, nullptr if slot is empty. */
+    NodeData* d_data = nullptr;
+  };
+
+  /**
+   * Check whether unique table needs to be resized.
+   *
+   * The load factor of the table is kept below 3/4 to keep probe sequences
+   * short.
+   */
+  bool needs_resize() const
+  {
+    return (d_num_elements + 1) * 4 > d_slots.size() * 3;
+  }
 
   /** Resizes unique table and rehashes node data. */
   void resize();
 
-  /** Hash node data. */
-  size_t hash(const NodeData* d) const;
+  /**
+   * Insert node data into the first empty slot of its probe sequence.
+   * @note Does not check for duplicates or resize the table.
+   */
+  void insert(size_t hash, NodeData* d);
 
-  /** Compute hash value of node lookup data. */
-  size_t hash(Kind kind,
-              const std::vector<Node>& children,
-              const std::vector<uint64_t>& indices) const;
+  /** Compute home slot index in d_slots based on hash value. */
+  size_t slot_index(size_t hash) const
+  {
+    return static_cast<size_t>((static_cast<uint64_t>(hash) * s_fib_mult)
+                               >> d_shift);
+  }
+
+  /** @return The index of the slot following slot `i` (wraps around). */
+  size_t next_slot(size_t i) const { return (i + 1) & (d_slots.size() - 1); }
 
   /** Compare node data against node lookup data. */
   bool equals(const NodeData& data,
@@ -102,23 +154,6 @@ class NodeUniqueTable
               const std::vector<Node>& children,
               const std::vector<uint64_t>& indices) const;
 
-  /** Compute position in d_buckets based on hash value. */
-  size_t bucket_hash(size_t hash, size_t mask = 0) const
-  {
-    if (mask == 0)
-    {
-      mask = d_buckets.capacity() - 1;
-    }
-    return hash & mask;
-  }
-
-  /** Compute has value of value node lookup data. */
-  template <class T>
-  size_t hash_value(const T& value)
-  {
-    return static_cast<size_t>(Kind::VALUE) + std::hash<T>{}(value);
-  }
-
   inline size_t hash_children(size_t hash,
                               size_t size,
                               const Node* children) const
@@ -141,10 +176,14 @@ class NodeUniqueTable
     return hash;
   }
 
+  /** The allocator for node data. */
+  NodeDataAllocator& d_allocator;
   /** Number of nodes stored in unique table. */
   size_t d_num_elements = 0;
-  /** Hash table buckets. */
-  std::vector<NodeData*> d_buckets;
+  /** Shift amount to map 64-bit hashes to slot indices. */
+  size_t d_shift = 60;
+  /** Hash table slots (open addressing with linear probing). */
+  std::vector<Slot> d_slots;
 };
 
 }  // namespace bzla::node
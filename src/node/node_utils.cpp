@@ -40,6 +40,41 @@ _is_bv_sext_aux(const Node& ite, const Node& ext, size_t idx)
   }
   return false;
 }
+
+template <class T>
+Node
+_rebuild_node(NodeManager& nm, const Node& node, const T& cache)
+{
+  std::vector<Node> children;
+
+  bool changed = false;
+  for (const Node& child : node)
+  {
+    auto iit = cache.find(child);
+    assert(iit != cache.end());
+    assert(!iit->second.is_null());
+    children.push_back(iit->second);
+    changed |= iit->second != child;
+  }
+
+  if (!changed || node.num_children() == 0)
+  {
+    return node;
+  }
+  else if (node.kind() == Kind::CONST_ARRAY)
+  {
+    assert(children.size() == 1);
+    return nm.mk_const_array(node.type(), children[0]);
+  }
+  else
+  {
+    if (node.num_indices() > 0)
+    {
+      return nm.mk_node(node.kind(), children, node.indices());
+    }
+    return nm.mk_node(node.kind(), children);
+  }
+}
 }  // namespace
 
 bool
@@ -231,35 +266,13 @@ rebuild_node(NodeManager& nm,
              const Node& node,
              const std::unordered_map<Node, Node>& cache)
 {
-  std::vector<Node> children;
-
-  bool changed = false;
-  for (const Node& child : node)
-  {
-    auto iit = cache.find(child);
-    assert(iit != cache.end());
-    assert(!iit->second.is_null());
-    children.push_back(iit->second);
-    changed |= iit->second != child;
-  }
+  return _rebuild_node(nm, node, cache);
+}
 
-  if (!changed || node.num_children() == 0)
-  {
-    return node;
-  }
-  else if (node.kind() == Kind::CONST_ARRAY)
-  {
-    assert(children.size() == 1);
-    return nm.mk_const_array(node.type(), children[0]);
-  }
-  else
-  {
-    if (node.num_indices() > 0)
-    {
-      return nm.mk_node(node.kind(), children, node.indices());
-    }
-    return nm.mk_node(node.kind(), children);
-  }
+Node
+rebuild_node(NodeManager& nm, const Node& node, const NodeIdMap<Node>& cache)
+{
+  return _rebuild_node(nm, node, cache);
 }
 
 }  // namespace bzla::node::utils
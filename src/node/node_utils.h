@@ -14,6 +14,7 @@
 #include <unordered_map>
 
 #include "node/node.h"
+#include "node/node_id_map.h"
 
 namespace bzla::node::utils {
 
@@ -84,6 +85,17 @@ Node rebuild_node(NodeManager& nm,
 Node rebuild_node(NodeManager& nm,
                   const Node& node,
                   const std::unordered_map<Node, Node>& cache);
+
+/**
+ * Rebuild node with same kind and indices but new children taken from cache.
+ *
+ * @param node The node to rebuild.
+ * @param cache The node cache for children.
+ * @return Rebuilt node.
+ */
+Node rebuild_node(NodeManager& nm,
+                  const Node& node,
+                  const NodeIdMap<Node>& cache);
 }
 
 #endif
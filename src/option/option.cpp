@@ -172,15 +172,70 @@ Options::Options()
                  {BvSolver::PREPROP, "preprop"}},
                 "bv solver engine",
                 "bv-solver"),
+      bv_aig_opt(this,
+                 Option::BV_AIG_OPT,
+                 false,
+                 "optimize bit-blasted AIGs with balancing, rewriting and "
+                 "refactoring before CNF encoding",
+                 "bv-aig-opt"),
+      bv_aig_fraig(this,
+                   Option::BV_AIG_FRAIG,
+                   false,
+                   "merge equivalent nodes of bit-blasted AIGs via random "
+                   "simulation and bounded SAT checks before CNF encoding",
+                   "bv-aig-fraig"),
+      bv_cnf_pg(this,
+                Option::BV_CNF_PG,
+                false,
+                "only encode the polarities in which bit-blasted AIG nodes "
+                "are used to CNF (Plaisted-Greenbaum encoding)",
+                "bv-cnf-pg"),
+      bv_mul_enc(this,
+                 Option::BV_MUL_ENC,
+                 BvMulEncoding::ARRAY,
+                 {{BvMulEncoding::ARRAY, "array"},
+                  {BvMulEncoding::WALLACE, "wallace"},
+                  {BvMulEncoding::DADDA, "dadda"},
+                  {BvMulEncoding::BOOTH, "booth"},
+                  {BvMulEncoding::AUTO, "auto"}},
+                 "encoding of bit-vector multiplication for bit-blasting",
+                 "bv-mul-enc"),
+      bv_div_reciprocal(this,
+                        Option::BV_DIV_RECIPROCAL,
+                        false,
+                        "encode bit-vector division by a value as "
+                        "multiplication with its reciprocal",
+                        "bv-div-reciprocal"),
+      preprop_parallel(this,
+                       Option::PREPROP_PARALLEL,
+                       false,
+                       "run local search and bit-blasting of bv solver engine "
+                       "preprop concurrently",
+                       "preprop-parallel"),
+      preprop_warm_start(this,
+                         Option::PREPROP_WARM_START,
+                         true,
+                         "seed the phases of the SAT solver of bv solver "
+                         "engine preprop with local search assignments",
+                         "preprop-warm-start"),
       sat_solver(this,
                  Option::SAT_SOLVER,
                  SatSolver::CADICAL,
                  {{SatSolver::CADICAL, "cadical"},
                   {SatSolver::CRYPTOMINISAT, "cms"},
-                  {SatSolver::KISSAT, "kissat"}},
+                  {SatSolver::KISSAT, "kissat"},
+                  {SatSolver::PORTFOLIO, "portfolio"}},
                  "backend SAT solver",
                  "sat-solver",
                  "S"),
+      threads(this,
+              Option::THREADS,
+              0,
+              0,
+              UINT16_MAX,
+              "number of threads used by parallel engines, 0 for one thread "
+              "per available hardware thread",
+              "threads"),
       rewrite_level(this,
                     Option::REWRITE_LEVEL,
                     REWRITE_LEVEL_MAX,
@@ -262,6 +317,40 @@ Options::Options()
                      false,
                      "enable normalization for local search",
                      "prop-normalize"),
+      prop_portfolio(this,
+                     Option::PROP_PORTFOLIO,
+                     false,
+                     "run a parallel portfolio of local search instances with "
+                     "different seeds for propagation-based local search "
+                     "engine",
+                     "prop-portfolio"),
+      prop_root_weights(this,
+                        Option::PROP_ROOT_WEIGHTS,
+                        false,
+                        "maintain root weights and select moves based on "
+                        "weighted scores for propagation-based local search "
+                        "engine",
+                        "prop-root-weights"),
+      prop_fp(this,
+              Option::PROP_FP,
+              false,
+              "handle floating-point operators natively (without "
+              "word-blasting) in propagation-based local search engine, only "
+              "effective with bv-solver=prop",
+              "prop-fp"),
+      prop_restarts(this,
+                    Option::PROP_RESTARTS,
+                    false,
+                    "restart propagation-based local search engine from the "
+                    "best assignment seen and continue incremental checks "
+                    "from it",
+                    "prop-restarts"),
+      prop_inv_memo(this,
+                    Option::PROP_INV_MEMO,
+                    false,
+                    "memoize expensive inverse value computations in "
+                    "propagation-based local search engine",
+                    "prop-inv-memo"),
       abstraction(this,
                   Option::ABSTRACTION,
                   false,
@@ -665,8 +754,9 @@ Options::finalize()
     produce_unsat_cores.set(true);
   }
   // configure default values for number of propagations and updates in case
-  // of sequential portfolio bv solver configuration PREPROP
-  if (bv_solver() == BvSolver::PREPROP)
+  // of sequential portfolio bv solver configuration PREPROP, local search is
+  // not limited if it runs in parallel to bit-blasting
+  if (bv_solver() == BvSolver::PREPROP && !preprop_parallel())
   {
     if (!prop_nprops.d_is_user_set)
     {
@@ -705,6 +795,7 @@ Options::data(Option opt)
     case Option::PRODUCE_UNSAT_ASSUMPTIONS: return &produce_unsat_assumptions;
     case Option::PRODUCE_UNSAT_CORES: return &produce_unsat_cores;
     case Option::SAT_SOLVER: return &sat_solver;
+    case Option::THREADS: return &threads;
     case Option::SEED: return &seed;
     case Option::VERBOSITY: return &verbosity;
     case Option::TIME_LIMIT_PER: return &time_limit_per;
@@ -712,6 +803,13 @@ Options::data(Option opt)
     case Option::RELEVANT_TERMS: return &relevant_terms;
 
     case Option::BV_SOLVER: return &bv_solver;
+    case Option::BV_AIG_OPT: return &bv_aig_opt;
+    case Option::BV_AIG_FRAIG: return &bv_aig_fraig;
+    case Option::BV_CNF_PG: return &bv_cnf_pg;
+    case Option::BV_MUL_ENC: return &bv_mul_enc;
+    case Option::BV_DIV_RECIPROCAL: return &bv_div_reciprocal;
+    case Option::PREPROP_PARALLEL: return &preprop_parallel;
+    case Option::PREPROP_WARM_START: return &preprop_warm_start;
     case Option::REWRITE_LEVEL: return &rewrite_level;
 
     case Option::PROP_NPROPS: return &prop_nprops;
@@ -725,6 +823,11 @@ Options::data(Option opt)
     case Option::PROP_OPT_LT_CONCAT_SEXT: return &prop_opt_lt_concat_sext;
     case Option::PROP_SEXT: return &prop_sext;
     case Option::PROP_NORMALIZE: return &prop_normalize;
+    case Option::PROP_PORTFOLIO: return &prop_portfolio;
+    case Option::PROP_ROOT_WEIGHTS: return &prop_root_weights;
+    case Option::PROP_FP: return &prop_fp;
+    case Option::PROP_RESTARTS: return &prop_restarts;
+    case Option::PROP_INV_MEMO: return &prop_inv_memo;
     case Option::ABSTRACTION: return &abstraction;
     case Option::ABSTRACTION_BV_SIZE: return &abstraction_bv_size;
     case Option::ABSTRACTION_EAGER_REFINE: return &abstraction_eager_refine;
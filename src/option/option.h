@@ -34,9 +34,17 @@ enum class Option
   MEMORY_LIMIT,               // numeric
   RELEVANT_TERMS,             // bool
 
-  BV_SOLVER,      // enum
-  REWRITE_LEVEL,  // numeric
-  SAT_SOLVER,     // enum
+  BV_SOLVER,           // enum
+  BV_AIG_OPT,          // bool
+  BV_AIG_FRAIG,        // bool
+  BV_CNF_PG,           // bool
+  BV_MUL_ENC,          // enum
+  BV_DIV_RECIPROCAL,   // bool
+  PREPROP_PARALLEL,    // bool
+  PREPROP_WARM_START,  // bool
+  REWRITE_LEVEL,       // numeric
+  SAT_SOLVER,          // enum
+  THREADS,             // numeric
 
   PROP_NPROPS,                  // numeric
   PROP_NUPDATES,                // numeric
@@ -48,6 +56,11 @@ enum class Option
   PROP_OPT_LT_CONCAT_SEXT,      // bool
   PROP_SEXT,                    // bool
   PROP_NORMALIZE,               // bool
+  PROP_PORTFOLIO,               // bool
+  PROP_ROOT_WEIGHTS,            // bool
+  PROP_FP,                      // bool
+  PROP_RESTARTS,                // bool
+  PROP_INV_MEMO,                // bool
 
   // Abstraction module
   ABSTRACTION,                 // bool
@@ -112,11 +125,21 @@ enum class BvSolver
   PREPROP,
 };
 
+enum class BvMulEncoding
+{
+  ARRAY,
+  WALLACE,
+  DADDA,
+  BOOTH,
+  AUTO,
+};
+
 enum class SatSolver
 {
   CADICAL,
   CRYPTOMINISAT,
   KISSAT,
+  PORTFOLIO,
 };
 
 enum class PropPathSelection
@@ -478,7 +501,15 @@ class Options
 
   // Bitwuzla-specific options
   OptionModeT<BvSolver> bv_solver;
+  OptionBool bv_aig_opt;
+  OptionBool bv_aig_fraig;
+  OptionBool bv_cnf_pg;
+  OptionModeT<BvMulEncoding> bv_mul_enc;
+  OptionBool bv_div_reciprocal;
+  OptionBool preprop_parallel;
+  OptionBool preprop_warm_start;
   OptionModeT<SatSolver> sat_solver;
+  OptionNumeric threads;
   OptionNumeric rewrite_level;
 
   // BV: propagation-based local search engine
@@ -492,6 +523,11 @@ class Options
   OptionBool prop_opt_lt_concat_sext;
   OptionBool prop_sext;
   OptionBool prop_normalize;
+  OptionBool prop_portfolio;
+  OptionBool prop_root_weights;
+  OptionBool prop_fp;
+  OptionBool prop_restarts;
+  OptionBool prop_inv_memo;
 
   OptionBool abstraction;
   OptionNumeric abstraction_bv_size;
@@ -463,10 +463,7 @@ Preprocessor::print_statistics(const std::string& pass)
          << std::setw(8) << ""
          << std::setw(10) << nm_stats.d_num_node_data
          << std::setw(10) << nm_stats.d_num_node_data_dealloc
-         << std::setw(8)
-         // Note: this is just a lower bound since it does not consider the
-         //       payload memory of node data.
-         << nm_stats.d_num_node_data * sizeof(node::NodeData) / mb;
+         << std::setw(8) << d_env.nm().node_data_bytes() / mb;
   // clang-format on
 }
 
@@ -0,0 +1,714 @@
+/***
+ * Bitwuzla: Satisfiability Modulo Theories (SMT) solver.
+ *
+ * Copyright (C) 2024 by the authors listed in the AUTHORS file at
+ * https://github.com/bitwuzla/bitwuzla/blob/main/AUTHORS
+ *
+ * This file is part of Bitwuzla under the MIT license. See COPYING for more
+ * information at https://github.com/bitwuzla/bitwuzla/blob/main/COPYING
+ */
+
+#include "rewrite/batch_evaluator.h"
+
+#include <algorithm>
+
+#include "bv/bitvector.h"
+#include "node/node_ref_vector.h"
+#include "node/unordered_node_ref_map.h"
+#include "rng/rng.h"
+
+namespace bzla {
+
+using namespace node;
+
+namespace {
+constexpr BatchEvaluator::Word ONES = ~BatchEvaluator::Word{0};
+}
+
+BatchEvaluator::BatchEvaluator(const std::vector<Node>& terms) : d_terms(terms)
+{
+  d_supported = compile(terms);
+  if (!d_supported)
+  {
+    d_inputs.clear();
+    d_instructions.clear();
+    d_operands.clear();
+    d_term_map.clear();
+    d_words.clear();
+  }
+}
+
+/* --- BatchEvaluator public ------------------------------------------------ */
+
+void
+BatchEvaluator::set_value(const Node& input, size_t lane, const Node& value)
+{
+  assert(value.is_value());
+  if (value.type().is_bool())
+  {
+    set_value(input, lane, value.value<bool>());
+  }
+  else
+  {
+    set_value(input, lane, value.value<BitVector>());
+  }
+}
+
+void
+BatchEvaluator::set_value(const Node& input,
+                          size_t lane,
+                          const BitVector& value)
+{
+  assert(d_supported);
+  assert(input.is_const());
+  assert(lane < NUM_LANES);
+  const Operand& op = operand(input);
+  assert(value.size() == op.size);
+  Word mask = Word{1} << lane;
+  Word* w   = &d_words[op.offset];
+  for (uint32_t i = 0; i < op.size; ++i)
+  {
+    w[i] = value.bit(i) ? (w[i] | mask) : (w[i] & ~mask);
+  }
+}
+
+void
+BatchEvaluator::set_value(const Node& input, size_t lane, bool value)
+{
+  assert(d_supported);
+  assert(input.is_const());
+  assert(lane < NUM_LANES);
+  const Operand& op = operand(input);
+  assert(op.size == 1);
+  Word mask = Word{1} << lane;
+  Word& w   = d_words[op.offset];
+  w         = value ? (w | mask) : (w & ~mask);
+}
+
+void
+BatchEvaluator::set_random(const Node& input, RNG& rng)
+{
+  assert(d_supported);
+  assert(input.is_const());
+  const Operand& op = operand(input);
+  for (uint32_t i = 0; i < op.size; ++i)
+  {
+    d_words[op.offset + i] = rng.pick<Word>();
+  }
+}
+
+void
+BatchEvaluator::evaluate()
+{
+  assert(d_supported);
+  for (const Instruction& instr : d_instructions)
+  {
+    execute(instr);
+  }
+}
+
+BatchEvaluator::Word
+BatchEvaluator::lanes(const Node& term) const
+{
+  assert(d_supported);
+  assert(term.type().is_bool());
+  return d_words[operand(term).offset];
+}
+
+BitVector
+BatchEvaluator::value(const Node& term, size_t lane) const
+{
+  assert(d_supported);
+  assert(lane < NUM_LANES);
+  const Operand& op = operand(term);
+  BitVector res(op.size);
+  for (uint32_t i = 0; i < op.size; ++i)
+  {
+    if ((d_words[op.offset + i] >> lane) & 1)
+    {
+      res.set_bit(i, true);
+    }
+  }
+  return res;
+}
+
+BatchEvaluator::Word
+BatchEvaluator::satisfied() const
+{
+  assert(d_supported);
+  Word res = ONES;
+  for (const Node& term : d_terms)
+  {
+    if (term.type().is_bool())
+    {
+      res &= lanes(term);
+    }
+  }
+  return res;
+}
+
+/* --- BatchEvaluator private ----------------------------------------------- */
+
+bool
+BatchEvaluator::is_supported_node(const Node& node)
+{
+  const Type& type = node.type();
+  if (!type.is_bool() && !type.is_bv())
+  {
+    return false;
+  }
+  switch (node.kind())
+  {
+    case Kind::CONSTANT:
+    case Kind::VALUE:
+    case Kind::DISTINCT:
+    case Kind::EQUAL:
+    case Kind::ITE:
+    case Kind::AND:
+    case Kind::IMPLIES:
+    case Kind::NOT:
+    case Kind::OR:
+    case Kind::XOR:
+    case Kind::BV_AND:
+    case Kind::BV_ASHR:
+    case Kind::BV_COMP:
+    case Kind::BV_DEC:
+    case Kind::BV_EXTRACT:
+    case Kind::BV_INC:
+    case Kind::BV_NAND:
+    case Kind::BV_NEG:
+    case Kind::BV_NOR:
+    case Kind::BV_NOT:
+    case Kind::BV_OR:
+    case Kind::BV_REDAND:
+    case Kind::BV_REDOR:
+    case Kind::BV_REDXOR:
+    case Kind::BV_REPEAT:
+    case Kind::BV_ROLI:
+    case Kind::BV_RORI:
+    case Kind::BV_SDIV:
+    case Kind::BV_SGE:
+    case Kind::BV_SGT:
+    case Kind::BV_SHL:
+    case Kind::BV_SHR:
+    case Kind::BV_SIGN_EXTEND:
+    case Kind::BV_SLE:
+    case Kind::BV_SLT:
+    case Kind::BV_SMOD:
+    case Kind::BV_SREM:
+    case Kind::BV_SUB:
+    case Kind::BV_UADDO:
+    case Kind::BV_UDIV:
+    case Kind::BV_UGE:
+    case Kind::BV_UGT:
+    case Kind::BV_ULE:
+    case Kind::BV_ULT:
+    case Kind::BV_UREM:
+    case Kind::BV_USUBO:
+    case Kind::BV_XNOR:
+    case Kind::BV_XOR:
+    case Kind::BV_ZERO_EXTEND: return true;
+
+    // Arithmetic operators are only evaluated in their binary form.
+    case Kind::BV_ADD:
+    case Kind::BV_CONCAT:
+    case Kind::BV_MUL: return node.num_children() == 2;
+
+    default: return false;
+  }
+}
+
+bool
+BatchEvaluator::compile(const std::vector<Node>& terms)
+{
+  node_ref_vector visit(terms.begin(), terms.end());
+  unordered_node_ref_map<bool> cache;
+  uint32_t max_size = 0;
+
+  while (!visit.empty())
+  {
+    const Node& cur = visit.back();
+    auto [it, inserted] = cache.emplace(cur, false);
+    if (inserted)
+    {
+      if (!is_supported_node(cur))
+      {
+        return false;
+      }
+      visit.insert(visit.end(), cur.begin(), cur.end());
+      continue;
+    }
+    else if (!it->second)
+    {
+      it->second = true;
+
+      uint32_t res  = alloc(cur);
+      uint32_t size = d_term_map.at(cur).size;
+      max_size      = std::max(max_size, size);
+      Kind kind     = cur.kind();
+
+      if (kind == Kind::CONSTANT)
+      {
+        d_inputs.push_back(cur);
+      }
+      else if (kind == Kind::VALUE)
+      {
+        // Values are broadcast to all lanes once.
+        if (cur.type().is_bool())
+        {
+          d_words[res] = cur.value<bool>() ? ONES : 0;
+        }
+        else
+        {
+          const BitVector& bv = cur.value<BitVector>();
+          for (uint32_t i = 0; i < size; ++i)
+          {
+            d_words[res + i] = bv.bit(i) ? ONES : 0;
+          }
+        }
+      }
+      else
+      {
+        Instruction instr;
+        instr.kind    = kind;
+        instr.res     = res;
+        instr.size    = size;
+        instr.ops     = static_cast<uint32_t>(d_operands.size());
+        instr.num_ops = static_cast<uint32_t>(cur.num_children());
+        if (cur.num_indices() > 0)
+        {
+          instr.idx0 = cur.index(0);
+          if (cur.num_indices() > 1)
+          {
+            instr.idx1 = cur.index(1);
+          }
+        }
+        for (const Node& child : cur)
+        {
+          d_operands.push_back(d_term_map.at(child));
+        }
+        d_instructions.push_back(instr);
+      }
+    }
+    visit.pop_back();
+  }
+
+  // Division needs five scratch vectors (absolute values, quotient,
+  // remainder, difference), shifts need one.
+  d_scratch.resize(5 * static_cast<size_t>(max_size));
+  return true;
+}
+
+uint32_t
+BatchEvaluator::alloc(const Node& node)
+{
+  uint32_t size = node.type().is_bool() ? 1 : node.type().bv_size();
+  auto offset   = static_cast<uint32_t>(d_words.size());
+  d_words.resize(d_words.size() + size, 0);
+  d_term_map.emplace(node, Operand{offset, size});
+  return offset;
+}
+
+const BatchEvaluator::Operand&
+BatchEvaluator::operand(const Node& term) const
+{
+  auto it = d_term_map.find(term);
+  assert(it != d_term_map.end());
+  return it->second;
+}
+
+void
+BatchEvaluator::execute(const Instruction& instr)
+{
+  Word* r            = &d_words[instr.res];
+  const Operand* ops = &d_operands[instr.ops];
+  uint32_t size      = instr.size;
+  const Word* a      = &d_words[ops[0].offset];
+  const Word* b = instr.num_ops > 1 ? &d_words[ops[1].offset] : nullptr;
+  Word* s       = d_scratch.data();
+
+  switch (instr.kind)
+  {
+    case Kind::NOT:
+    case Kind::BV_NOT:
+      for (uint32_t i = 0; i < size; ++i) r[i] = ~a[i];
+      break;
+
+    case Kind::AND:
+    case Kind::BV_AND:
+      std::copy(a, a + size, r);
+      for (uint32_t j = 1; j < instr.num_ops; ++j)
+      {
+        const Word* c = &d_words[ops[j].offset];
+        for (uint32_t i = 0; i < size; ++i) r[i] &= c[i];
+      }
+      break;
+
+    case Kind::OR:
+    case Kind::BV_OR:
+      std::copy(a, a + size, r);
+      for (uint32_t j = 1; j < instr.num_ops; ++j)
+      {
+        const Word* c = &d_words[ops[j].offset];
+        for (uint32_t i = 0; i < size; ++i) r[i] |= c[i];
+      }
+      break;
+
+    case Kind::XOR:
+    case Kind::BV_XOR:
+      std::copy(a, a + size, r);
+      for (uint32_t j = 1; j < instr.num_ops; ++j)
+      {
+        const Word* c = &d_words[ops[j].offset];
+        for (uint32_t i = 0; i < size; ++i) r[i] ^= c[i];
+      }
+      break;
+
+    case Kind::IMPLIES: r[0] = ~a[0] | b[0]; break;
+
+    case Kind::BV_NAND:
+      for (uint32_t i = 0; i < size; ++i) r[i] = ~(a[i] & b[i]);
+      break;
+
+    case Kind::BV_NOR:
+      for (uint32_t i = 0; i < size; ++i) r[i] = ~(a[i] | b[i]);
+      break;
+
+    case Kind::BV_XNOR:
+      for (uint32_t i = 0; i < size; ++i) r[i] = ~(a[i] ^ b[i]);
+      break;
+
+    case Kind::EQUAL:
+    case Kind::BV_COMP:
+      // EQUAL is chainable.
+      r[0] = ONES;
+      for (uint32_t j = 1; j < instr.num_ops; ++j)
+      {
+        r[0] &= eq(&d_words[ops[j - 1].offset],
+                   &d_words[ops[j].offset],
+                   ops[j].size);
+      }
+      break;
+
+    case Kind::DISTINCT:
+      r[0] = ONES;
+      for (uint32_t j = 0; j < instr.num_ops; ++j)
+      {
+        for (uint32_t k = j + 1; k < instr.num_ops; ++k)
+        {
+          r[0] &= ~eq(&d_words[ops[j].offset],
+                      &d_words[ops[k].offset],
+                      ops[j].size);
+        }
+      }
+      break;
+
+    case Kind::ITE:
+      ite(r, a[0], b, &d_words[ops[2].offset], size);
+      break;
+
+    case Kind::BV_ADD: add(r, a, b, 0, size); break;
+    case Kind::BV_SUB: add_not(r, a, b, ONES, size); break;
+    case Kind::BV_NEG: neg(r, a, size); break;
+
+    case Kind::BV_INC:
+    {
+      Word carry = ONES;
+      for (uint32_t i = 0; i < size; ++i)
+      {
+        r[i]  = a[i] ^ carry;
+        carry = a[i] & carry;
+      }
+    }
+    break;
+
+    case Kind::BV_DEC:
+    {
+      Word borrow = ONES;
+      for (uint32_t i = 0; i < size; ++i)
+      {
+        r[i]   = a[i] ^ borrow;
+        borrow = ~a[i] & borrow;
+      }
+    }
+    break;
+
+    case Kind::BV_MUL: mul(r, a, b, size); break;
+
+    case Kind::BV_UADDO: r[0] = add(s, a, b, 0, ops[0].size); break;
+    case Kind::BV_USUBO:
+    case Kind::BV_ULT: r[0] = ult(a, b, ops[0].size); break;
+    case Kind::BV_ULE: r[0] = ~ult(b, a, ops[0].size); break;
+    case Kind::BV_UGT: r[0] = ult(b, a, ops[0].size); break;
+    case Kind::BV_UGE: r[0] = ~ult(a, b, ops[0].size); break;
+    case Kind::BV_SLT: r[0] = slt(a, b, ops[0].size); break;
+    case Kind::BV_SLE: r[0] = ~slt(b, a, ops[0].size); break;
+    case Kind::BV_SGT: r[0] = slt(b, a, ops[0].size); break;
+    case Kind::BV_SGE: r[0] = ~slt(a, b, ops[0].size); break;
+
+    case Kind::BV_UDIV: udiv_urem(r, s, a, b, size, s + size); break;
+    case Kind::BV_UREM: udiv_urem(s, r, a, b, size, s + size); break;
+
+    case Kind::BV_SDIV:
+    case Kind::BV_SREM:
+    case Kind::BV_SMOD:
+    {
+      Word sign_a = a[size - 1];
+      Word sign_b = b[size - 1];
+      Word* abs_a = s;
+      Word* abs_b = s + size;
+      Word* quot  = s + 2 * size;
+      Word* rem   = s + 3 * size;
+      neg(abs_a, a, size);
+      ite(abs_a, sign_a, abs_a, a, size);
+      neg(abs_b, b, size);
+      ite(abs_b, sign_b, abs_b, b, size);
+      udiv_urem(quot, rem, abs_a, abs_b, size, s + 4 * size);
+      if (instr.kind == Kind::BV_SDIV)
+      {
+        neg(r, quot, size);
+        ite(r, sign_a ^ sign_b, r, quot, size);
+      }
+      else
+      {
+        neg(r, rem, size);
+        ite(r, sign_a, r, rem, size);
+        if (instr.kind == Kind::BV_SMOD)
+        {
+          // smod additionally adds the divisor if the remainder is not zero
+          // and the signs of the operands differ.
+          Word nonzero = 0;
+          for (uint32_t i = 0; i < size; ++i) nonzero |= rem[i];
+          add(quot, r, b, 0, size);
+          ite(r, nonzero & (sign_a ^ sign_b), quot, r, size);
+        }
+      }
+    }
+    break;
+
+    case Kind::BV_SHL:
+    case Kind::BV_SHR:
+    case Kind::BV_ASHR: shift(r, a, b, size, instr.kind, s); break;
+
+    case Kind::BV_CONCAT:
+      std::copy(b, b + ops[1].size, r);
+      std::copy(a, a + ops[0].size, r + ops[1].size);
+      break;
+
+    case Kind::BV_EXTRACT:
+      std::copy(a + instr.idx1, a + instr.idx0 + 1, r);
+      break;
+
+    case Kind::BV_ZERO_EXTEND:
+      std::copy(a, a + ops[0].size, r);
+      std::fill(r + ops[0].size, r + size, 0);
+      break;
+
+    case Kind::BV_SIGN_EXTEND:
+      std::copy(a, a + ops[0].size, r);
+      std::fill(r + ops[0].size, r + size, a[ops[0].size - 1]);
+      break;
+
+    case Kind::BV_REPEAT:
+      for (uint32_t i = 0; i < size; ++i) r[i] = a[i % ops[0].size];
+      break;
+
+    case Kind::BV_ROLI:
+      for (uint32_t i = 0; i < size; ++i) r[(i + instr.idx0) % size] = a[i];
+      break;
+
+    case Kind::BV_RORI:
+      for (uint32_t i = 0; i < size; ++i) r[i] = a[(i + instr.idx0) % size];
+      break;
+
+    case Kind::BV_REDAND:
+      r[0] = ONES;
+      for (uint32_t i = 0; i < ops[0].size; ++i) r[0] &= a[i];
+      break;
+
+    case Kind::BV_REDOR:
+      r[0] = 0;
+      for (uint32_t i = 0; i < ops[0].size; ++i) r[0] |= a[i];
+      break;
+
+    case Kind::BV_REDXOR:
+      r[0] = 0;
+      for (uint32_t i = 0; i < ops[0].size; ++i) r[0] ^= a[i];
+      break;
+
+    default: assert(false);
+  }
+}
+
+/* --- Bit-sliced circuits -------------------------------------------------- */
+
+BatchEvaluator::Word
+BatchEvaluator::add(
+    Word* res, const Word* a, const Word* b, Word carry, uint32_t size)
+{
+  for (uint32_t i = 0; i < size; ++i)
+  {
+    Word x = a[i] ^ b[i];
+    Word c = (a[i] & b[i]) | (x & carry);
+    res[i] = x ^ carry;
+    carry  = c;
+  }
+  return carry;
+}
+
+BatchEvaluator::Word
+BatchEvaluator::add_not(
+    Word* res, const Word* a, const Word* b, Word carry, uint32_t size)
+{
+  for (uint32_t i = 0; i < size; ++i)
+  {
+    Word nb = ~b[i];
+    Word x  = a[i] ^ nb;
+    Word c  = (a[i] & nb) | (x & carry);
+    res[i]  = x ^ carry;
+    carry   = c;
+  }
+  return carry;
+}
+
+BatchEvaluator::Word
+BatchEvaluator::eq(const Word* a, const Word* b, uint32_t size)
+{
+  Word res = ONES;
+  for (uint32_t i = 0; i < size; ++i)
+  {
+    res &= ~(a[i] ^ b[i]);
+  }
+  return res;
+}
+
+BatchEvaluator::Word
+BatchEvaluator::ult(const Word* a, const Word* b, uint32_t size)
+{
+  // a < b iff there is no carry out of a + ~b + 1.
+  Word carry = ONES;
+  for (uint32_t i = 0; i < size; ++i)
+  {
+    Word nb = ~b[i];
+    carry   = (a[i] & nb) | ((a[i] ^ nb) & carry);
+  }
+  return ~carry;
+}
+
+BatchEvaluator::Word
+BatchEvaluator::slt(const Word* a, const Word* b, uint32_t size)
+{
+  uint32_t msb = size - 1;
+  Word lt      = msb > 0 ? ult(a, b, msb) : 0;
+  return (a[msb] & ~b[msb]) | (~(a[msb] ^ b[msb]) & lt);
+}
+
+void
+BatchEvaluator::neg(Word* res, const Word* a, uint32_t size)
+{
+  Word carry = ONES;
+  for (uint32_t i = 0; i < size; ++i)
+  {
+    Word na = ~a[i];
+    res[i]  = na ^ carry;
+    carry   = na & carry;
+  }
+}
+
+void
+BatchEvaluator::ite(
+    Word* res, Word c, const Word* a, const Word* b, uint32_t size)
+{
+  for (uint32_t i = 0; i < size; ++i)
+  {
+    res[i] = (c & a[i]) | (~c & b[i]);
+  }
+}
+
+void
+BatchEvaluator::mul(Word* res, const Word* a, const Word* b, uint32_t size)
+{
+  // Shift-and-add, the partial products are truncated to size bits.
+  std::fill(res, res + size, 0);
+  for (uint32_t i = 0; i < size; ++i)
+  {
+    Word bi    = b[i];
+    Word carry = 0;
+    for (uint32_t j = 0; i + j < size; ++j)
+    {
+      Word pp    = a[j] & bi;
+      Word sum   = res[i + j];
+      Word x     = sum ^ pp;
+      res[i + j] = x ^ carry;
+      carry      = (sum & pp) | (x & carry);
+    }
+  }
+}
+
+void
+BatchEvaluator::udiv_urem(Word* quot,
+                          Word* rem,
+                          const Word* a,
+                          const Word* b,
+                          uint32_t size,
+                          Word* tmp)
+{
+  // Restoring division. Division by zero yields quotient ~0 and remainder a,
+  // as required by the SMT-LIB semantics.
+  std::fill(rem, rem + size, 0);
+  for (uint32_t i = size; i-- > 0;)
+  {
+    Word top = rem[size - 1];
+    std::copy_backward(rem, rem + size - 1, rem + size);
+    rem[0]  = a[i];
+    Word ge = top | add_not(tmp, rem, b, ONES, size);
+    ite(rem, ge, tmp, rem, size);
+    quot[i] = ge;
+  }
+}
+
+void
+BatchEvaluator::shift(Word* res,
+                      const Word* a,
+                      const Word* b,
+                      uint32_t size,
+                      Kind kind,
+                      Word* tmp)
+{
+  Word fill = kind == Kind::BV_ASHR ? a[size - 1] : 0;
+  std::copy(a, a + size, res);
+
+  // Barrel shifter, stage k shifts by 2^k if bit k of b is set.
+  uint32_t k = 0;
+  for (uint64_t dist = 1; dist < size; ++k, dist <<= 1)
+  {
+    Word sel = b[k];
+    for (uint32_t i = 0; i < size; ++i)
+    {
+      Word src;
+      if (kind == Kind::BV_SHL)
+      {
+        src = i >= dist ? res[i - dist] : 0;
+      }
+      else
+      {
+        src = i + dist < size ? res[i + dist] : fill;
+      }
+      tmp[i] = (sel & src) | (~sel & res[i]);
+    }
+    std::copy(tmp, tmp + size, res);
+  }
+
+  // Shift amounts >= size shift out all bits.
+  Word overflow = 0;
+  for (; k < size; ++k)
+  {
+    overflow |= b[k];
+  }
+  for (uint32_t i = 0; i < size; ++i)
+  {
+    res[i] = (overflow & fill) | (~overflow & res[i]);
+  }
+}
+
+}  // namespace bzla
@@ -0,0 +1,200 @@
+/***
+ * Bitwuzla: Satisfiability Modulo Theories (SMT) solver.
+ *
+ * Copyright (C) 2024 by the authors listed in the AUTHORS file at
+ * https://github.com/bitwuzla/bitwuzla/blob/main/AUTHORS
+ *
+ * This file is part of Bitwuzla under the MIT license. See COPYING for more
+ * information at https://github.com/bitwuzla/bitwuzla/blob/main/COPYING
+ */
+
+#ifndef BZLA_REWRITE_BATCH_EVALUATOR_H_INCLUDED
+#define BZLA_REWRITE_BATCH_EVALUATOR_H_INCLUDED
+
+#include <cstdint>
+#include <vector>
+
+#include "node/node.h"
+#include "node/node_id_map.h"
+
+namespace bzla {
+
+class BitVector;
+class RNG;
+
+/**
+ * Bit-sliced evaluator for Boolean and bit-vector terms.
+ *
+ * The DAG of a given set of terms is compiled into a flat, topologically
+ * ordered array of instructions, which is then evaluated over NUM_LANES
+ * assignments at once. Every bit of a term is represented as one machine
+ * word, where the i-th bit of the word holds the value of that bit under the
+ * i-th assignment (lane). Word-level operators are evaluated as circuits over
+ * these words, e.g., additions as ripple-carry adders.
+ *
+ * Inputs are the constants occurring in the given terms. Terms that contain
+ * operators or types that are not supported (e.g., floating-point terms,
+ * arrays, functions or quantifiers) can not be compiled, which is indicated
+ * by is_supported().
+ */
+class BatchEvaluator
+{
+ public:
+  /** The type of a bit-sliced word. */
+  using Word = uint64_t;
+  /** The number of assignments evaluated at once. */
+  static constexpr size_t NUM_LANES = sizeof(Word) * 8;
+
+  /**
+   * Constructor. Compiles the DAGs of the given terms.
+   * @param terms The Boolean or bit-vector terms to evaluate.
+   */
+  BatchEvaluator(const std::vector<Node>& terms);
+
+  /** @return True if all terms given on construction could be compiled. */
+  bool is_supported() const { return d_supported; }
+
+  /** @return The inputs (constants) of the compiled terms. */
+  const std::vector<Node>& inputs() const { return d_inputs; }
+
+  /**
+   * Set the value of an input in a given lane.
+   * @param input The input.
+   * @param lane  The lane.
+   * @param value The value, a Boolean or bit-vector value node.
+   */
+  void set_value(const Node& input, size_t lane, const Node& value);
+  /**
+   * Set the value of a bit-vector input in a given lane.
+   * @param input The input.
+   * @param lane  The lane.
+   * @param value The bit-vector value.
+   */
+  void set_value(const Node& input, size_t lane, const BitVector& value);
+  /**
+   * Set the value of a Boolean input in a given lane.
+   * @param input The input.
+   * @param lane  The lane.
+   * @param value The Boolean value.
+   */
+  void set_value(const Node& input, size_t lane, bool value);
+  /**
+   * Assign random values to an input in all lanes.
+   * @param input The input.
+   * @param rng   The random number generator.
+   */
+  void set_random(const Node& input, RNG& rng);
+
+  /** Evaluate all compiled terms in all lanes. */
+  void evaluate();
+
+  /**
+   * Get the values of a Boolean term in all lanes.
+   * @param term A Boolean term, must be one of the terms given on
+   *             construction or one of their subterms.
+   * @return A word where the i-th bit is the value of the term in lane i.
+   */
+  Word lanes(const Node& term) const;
+  /**
+   * Get the value of a Boolean or bit-vector term in a given lane.
+   * @param term A term, must be one of the terms given on construction or one
+   *             of their subterms.
+   * @param lane The lane.
+   * @return The value of the term as a bit-vector (of size 1 if the term is
+   *         Boolean).
+   */
+  BitVector value(const Node& term, size_t lane) const;
+  /**
+   * @return A word where the i-th bit is set if all Boolean terms given on
+   *         construction evaluate to true in lane i.
+   */
+  Word satisfied() const;
+
+  /** @return The number of compiled instructions. */
+  size_t num_instructions() const { return d_instructions.size(); }
+
+ private:
+  /** An instruction that computes the words of a single term. */
+  struct Instruction
+  {
+    node::Kind kind;
+    /** Offset of the first word of the result. */
+    uint32_t res;
+    /** Size of the result in bits. */
+    uint32_t size;
+    /** Index of the first operand in d_operands. */
+    uint32_t ops;
+    /** The number of operands. */
+    uint32_t num_ops;
+    /** Indices of the term (extract, extends, repeat, rotate). */
+    uint64_t idx0 = 0;
+    uint64_t idx1 = 0;
+  };
+  /** A term operand, i.e., the position of its words in d_words. */
+  struct Operand
+  {
+    uint32_t offset;
+    uint32_t size;
+  };
+
+  /** @return True if the given node is supported. */
+  static bool is_supported_node(const Node& node);
+  /**
+   * Compile the DAGs of given terms.
+   * @return False if an unsupported term was encountered.
+   */
+  bool compile(const std::vector<Node>& terms);
+  /** Allocate the words for given term. */
+  uint32_t alloc(const Node& node);
+  /** @return The operand for given (compiled) term. */
+  const Operand& operand(const Node& term) const;
+
+  /** Execute given instruction. */
+  void execute(const Instruction& instr);
+
+  /** Bit-sliced circuits over word arrays of given size. */
+  static Word add(
+      Word* res, const Word* a, const Word* b, Word carry, uint32_t size);
+  static Word add_not(
+      Word* res, const Word* a, const Word* b, Word carry, uint32_t size);
+  static Word eq(const Word* a, const Word* b, uint32_t size);
+  static Word ult(const Word* a, const Word* b, uint32_t size);
+  static Word slt(const Word* a, const Word* b, uint32_t size);
+  static void neg(Word* res, const Word* a, uint32_t size);
+  static void ite(
+      Word* res, Word c, const Word* a, const Word* b, uint32_t size);
+  static void mul(Word* res, const Word* a, const Word* b, uint32_t size);
+  static void udiv_urem(Word* quot,
+                        Word* rem,
+                        const Word* a,
+                        const Word* b,
+                        uint32_t size,
+                        Word* tmp);
+  static void shift(Word* res,
+                    const Word* a,
+                    const Word* b,
+                    uint32_t size,
+                    node::Kind kind,
+                    Word* tmp);
+
+  /** True if all terms could be compiled. */
+  bool d_supported = true;
+  /** The terms given on construction. */
+  std::vector<Node> d_terms;
+  /** The inputs of the compiled terms. */
+  std::vector<Node> d_inputs;
+  /** The instructions in topological order. */
+  std::vector<Instruction> d_instructions;
+  /** The operands of all instructions. */
+  std::vector<Operand> d_operands;
+  /** Maps compiled terms to their operand. */
+  node::NodeIdMap<Operand> d_term_map;
+  /** The bit-sliced words of all terms. */
+  std::vector<Word> d_words;
+  /** Scratch words for multi-word circuits (division, shifts). */
+  std::vector<Word> d_scratch;
+};
+
+}  // namespace bzla
+
+#endif
@@ -17,6 +17,7 @@
 #endif
 
 #include "node/node.h"
+#include "node/node_id_map.h"
 #include "util/statistics.h"
 
 namespace bzla {
@@ -255,7 +256,7 @@ class Rewriter
   /** True to enable rewriting, false to only enable operator elimination. */
   uint8_t d_level;
   /** Cache for rewritten nodes, maps node to its rewritten form. */
-  std::unordered_map<Node, Node> d_cache;
+  node::NodeIdMap<Node> d_cache;
 #ifndef NDEBUG
   /** Cache for detecting rewrite cycles in debug mode. */
   std::unordered_set<Node> d_rec_cache;
@@ -28,9 +28,17 @@ CadicalTerminator::terminate()
 
 /* Cadical public ----------------------------------------------------------- */
 
-Cadical::Cadical()
+Cadical::Cadical(const char* config, int32_t seed)
 {
   d_solver.reset(new CaDiCaL::Solver());
+  if (config)
+  {
+    d_solver->configure(config);
+  }
+  if (seed)
+  {
+    d_solver->set("seed", seed);
+  }
   d_solver->set("shrink", 0);
   d_solver->set("quiet", 1);
 }
@@ -68,6 +76,36 @@ Cadical::fixed(int32_t lit)
   return d_solver->fixed(lit);
 }
 
+void
+Cadical::freeze(int32_t lit)
+{
+  d_solver->freeze(lit);
+}
+
+void
+Cadical::melt(int32_t lit)
+{
+  d_solver->melt(lit);
+}
+
+void
+Cadical::phase(int32_t lit)
+{
+  d_solver->phase(lit);
+}
+
+void
+Cadical::unphase(int32_t lit)
+{
+  d_solver->unphase(lit);
+}
+
+void
+Cadical::limit_conflicts(int32_t limit)
+{
+  d_solver->limit("conflicts", limit);
+}
+
 Result
 Cadical::solve()
 {
@@ -33,13 +33,25 @@ class CadicalTerminator : public CaDiCaL::Terminator
 class Cadical : public SatSolver
 {
  public:
-  Cadical();
+  /**
+   * Constructor.
+   * @param config The name of the CaDiCaL configuration to use (see
+   *               `CaDiCaL::Solver::configure()`), nullptr for the default
+   *               configuration.
+   * @param seed   The seed for the random number generator of CaDiCaL.
+   */
+  Cadical(const char* config = nullptr, int32_t seed = 0);
 
   void add(int32_t lit) override;
   void assume(int32_t lit) override;
   int32_t value(int32_t lit) override;
   bool failed(int32_t lit) override;
   int32_t fixed(int32_t lit) override;
+  void freeze(int32_t lit) override;
+  void melt(int32_t lit) override;
+  void phase(int32_t lit) override;
+  void unphase(int32_t lit) override;
+  void limit_conflicts(int32_t limit) override;
   Result solve() override;
   void configure_terminator(Terminator* terminator) override;
   const char *get_name() const override { return "CaDiCaL"; }
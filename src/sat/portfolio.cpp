@@ -0,0 +1,261 @@
+/***
+ * Bitwuzla: Satisfiability Modulo Theories (SMT) solver.
+ *
+ * Copyright (C) 2024 by the authors listed in the AUTHORS file at
+ * https://github.com/bitwuzla/bitwuzla/blob/main/AUTHORS
+ *
+ * This file is part of Bitwuzla under the MIT license. See COPYING for more
+ * information at https://github.com/bitwuzla/bitwuzla/blob/main/COPYING
+ */
+
+#include "sat/portfolio.h"
+
+#include <algorithm>
+#include <cassert>
+#include <thread>
+
+#include "sat/cadical.h"
+#include "sat/kissat.h"
+
+namespace bzla::sat {
+
+/* --- Portfolio public ----------------------------------------------------- */
+
+Portfolio::Portfolio(uint64_t num_solvers)
+{
+  if (num_solvers == 0)
+  {
+    num_solvers = std::max(std::thread::hardware_concurrency(), 1u);
+  }
+
+  // CaDiCaL configurations, remaining solvers use the default configuration
+  // with different seeds.
+  const char* configs[] = {nullptr, "sat", "unsat"};
+  for (uint64_t i = 0; i < num_solvers; ++i)
+  {
+#ifdef BZLA_USE_KISSAT
+    if (i == 1)
+    {
+      d_solvers.push_back({std::make_unique<Kissat>(), false});
+      continue;
+    }
+#endif
+    size_t n = d_solvers.size();
+    if (n < sizeof(configs) / sizeof(configs[0]))
+    {
+      d_solvers.push_back({std::make_unique<Cadical>(configs[n]), true});
+    }
+    else
+    {
+      d_solvers.push_back(
+          {std::make_unique<Cadical>(nullptr, static_cast<int32_t>(n)), true});
+    }
+  }
+  for (auto& s : d_solvers)
+  {
+    s.d_solver->configure_terminator(&d_terminator);
+  }
+}
+
+Portfolio::~Portfolio() {}
+
+void
+Portfolio::add(int32_t lit)
+{
+  for (auto& s : d_solvers)
+  {
+    if (s.usable())
+    {
+      s.d_solver->add(lit);
+    }
+  }
+}
+
+void
+Portfolio::assume(int32_t lit)
+{
+  d_assumptions.push_back(lit);
+}
+
+int32_t
+Portfolio::value(int32_t lit)
+{
+  return d_solvers[d_winner].d_solver->value(lit);
+}
+
+bool
+Portfolio::failed(int32_t lit)
+{
+  return d_solvers[d_winner].d_solver->failed(lit);
+}
+
+int32_t
+Portfolio::fixed(int32_t lit)
+{
+  return d_solvers[d_winner].d_solver->fixed(lit);
+}
+
+void
+Portfolio::freeze(int32_t lit)
+{
+  for (auto& s : d_solvers)
+  {
+    if (s.usable())
+    {
+      s.d_solver->freeze(lit);
+    }
+  }
+}
+
+void
+Portfolio::melt(int32_t lit)
+{
+  for (auto& s : d_solvers)
+  {
+    if (s.usable())
+    {
+      s.d_solver->melt(lit);
+    }
+  }
+}
+
+void
+Portfolio::phase(int32_t lit)
+{
+  for (auto& s : d_solvers)
+  {
+    if (s.usable())
+    {
+      s.d_solver->phase(lit);
+    }
+  }
+}
+
+void
+Portfolio::unphase(int32_t lit)
+{
+  for (auto& s : d_solvers)
+  {
+    if (s.usable())
+    {
+      s.d_solver->unphase(lit);
+    }
+  }
+}
+
+Result
+Portfolio::solve()
+{
+  std::vector<size_t> active;
+  for (size_t i = 0, n = d_solvers.size(); i < n; ++i)
+  {
+    Member& s = d_solvers[i];
+    // Release non-incremental solvers that were kept for querying the model
+    // of the previous call.
+    if (s.d_used)
+    {
+      s.d_solver.reset();
+    }
+    if (!s.d_solver || (!s.d_incremental && !d_assumptions.empty()))
+    {
+      continue;
+    }
+    for (int32_t lit : d_assumptions)
+    {
+      s.d_solver->assume(lit);
+    }
+    active.push_back(i);
+  }
+  assert(!active.empty());
+  d_assumptions.clear();
+
+  d_terminator.d_done = false;
+  d_result            = Result::UNKNOWN;
+  d_winner            = active[0];
+
+  if (active.size() == 1)
+  {
+    run(active[0]);
+  }
+  else
+  {
+    std::vector<std::thread> threads;
+    for (size_t i = 1, n = active.size(); i < n; ++i)
+    {
+      threads.emplace_back(&Portfolio::run, this, active[i]);
+    }
+    run(active[0]);
+    for (auto& t : threads)
+    {
+      t.join();
+    }
+  }
+
+  // Non-incremental solvers can only be used once. Keep the winner until the
+  // next call to solve() for querying the model.
+  for (size_t i : active)
+  {
+    Member& s = d_solvers[i];
+    if (!s.d_incremental)
+    {
+      s.d_used = true;
+      if (i != d_winner)
+      {
+        s.d_solver.reset();
+      }
+    }
+  }
+  return d_result;
+}
+
+void
+Portfolio::configure_terminator(Terminator* terminator)
+{
+  std::lock_guard<std::mutex> lock(d_terminator.d_mutex);
+  d_terminator.d_terminator = terminator;
+}
+
+const char*
+Portfolio::get_version() const
+{
+  return d_solvers[0].d_solver->get_version();
+}
+
+const char*
+Portfolio::get_winner_name() const
+{
+  return d_solvers[d_winner].d_solver->get_name();
+}
+
+/* --- Portfolio private ---------------------------------------------------- */
+
+void
+Portfolio::run(size_t idx)
+{
+  Result res = d_solvers[idx].d_solver->solve();
+  if (res != Result::UNKNOWN)
+  {
+    std::lock_guard<std::mutex> lock(d_mutex);
+    if (!d_terminator.d_done)
+    {
+      d_result            = res;
+      d_winner            = idx;
+      d_terminator.d_done = true;
+    }
+  }
+}
+
+bool
+Portfolio::PortfolioTerminator::terminate()
+{
+  if (d_done)
+  {
+    return true;
+  }
+  std::lock_guard<std::mutex> lock(d_mutex);
+  return d_terminator && d_terminator->terminate();
+}
+
+/* -------------------------------------------------------------------------- */
+
+}  // namespace bzla::sat
@@ -0,0 +1,116 @@
+/***
+ * Bitwuzla: Satisfiability Modulo Theories (SMT) solver.
+ *
+ * Copyright (C) 2024 by the authors listed in the AUTHORS file at
+ * https://github.com/bitwuzla/bitwuzla/blob/main/AUTHORS
+ *
+ * This file is part of Bitwuzla under the MIT license. See COPYING for more
+ * information at https://github.com/bitwuzla/bitwuzla/blob/main/COPYING
+ */
+
+#ifndef BZLA_SAT_PORTFOLIO_H_INCLUDED
+#define BZLA_SAT_PORTFOLIO_H_INCLUDED
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "sat/sat_solver.h"
+#include "terminator.h"
+
+namespace bzla::sat {
+
+/**
+ * Parallel portfolio of SAT solvers.
+ *
+ * All clauses are added to every solver of the portfolio, and on solve() all
+ * solvers run concurrently on separate threads. The first definite answer is
+ * returned and the remaining solvers are terminated. Models and failed
+ * assumptions are queried from the solver that determined the answer.
+ *
+ * The portfolio consists of CaDiCaL instances with different configurations
+ * and seeds, and Kissat (if configured). Since Kissat is not incremental, it
+ * only participates in the first call to solve() without assumptions.
+ */
+class Portfolio : public SatSolver
+{
+ public:
+  /**
+   * Constructor.
+   * @param num_solvers The number of solvers in the portfolio, 0 to use one
+   *                    solver per available hardware thread.
+   */
+  Portfolio(uint64_t num_solvers);
+  ~Portfolio();
+
+  void add(int32_t lit) override;
+  void assume(int32_t lit) override;
+  int32_t value(int32_t lit) override;
+  bool failed(int32_t lit) override;
+  int32_t fixed(int32_t lit) override;
+  void freeze(int32_t lit) override;
+  void melt(int32_t lit) override;
+  void phase(int32_t lit) override;
+  void unphase(int32_t lit) override;
+  Result solve() override;
+  void configure_terminator(Terminator* terminator) override;
+  const char* get_name() const override { return "Portfolio"; }
+  const char* get_version() const override;
+
+  /** @return The name of the solver that determined the last answer. */
+  const char* get_winner_name() const;
+
+ private:
+  /**
+   * Terminator shared by all solvers of the portfolio. Terminates if a
+   * solver of the portfolio already determined an answer or the configured
+   * terminator terminates.
+   */
+  class PortfolioTerminator : public Terminator
+  {
+   public:
+    bool terminate() override;
+    /** The configured terminator, called mutually exclusive. */
+    Terminator* d_terminator = nullptr;
+    /** True if a solver determined an answer. */
+    std::atomic<bool> d_done{false};
+    /** Mutex for calls to `d_terminator`. */
+    std::mutex d_mutex;
+  };
+
+  struct Member
+  {
+    std::unique_ptr<SatSolver> d_solver;
+    /** True if the solver supports incremental solving. */
+    bool d_incremental = true;
+    /** True if a non-incremental solver was already solved. */
+    bool d_used = false;
+
+    /** @return True if clauses can be added to the solver. */
+    bool usable() const { return d_solver && !d_used; }
+  };
+
+  /**
+   * Run solver with given index and record its answer if it is the first
+   * definite answer.
+   */
+  void run(size_t idx);
+
+  /** The solvers of the portfolio, released solvers are null. */
+  std::vector<Member> d_solvers;
+  /** The assumptions for the next call to solve(). */
+  std::vector<int32_t> d_assumptions;
+  /** The shared terminator. */
+  PortfolioTerminator d_terminator;
+  /** Mutex for recording the answer. */
+  std::mutex d_mutex;
+  /** The index of the solver that determined the last answer. */
+  size_t d_winner = 0;
+  /** The result of the last call to solve(). */
+  Result d_result = Result::UNKNOWN;
+};
+
+}  // namespace bzla::sat
+
+#endif
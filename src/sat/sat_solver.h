@@ -57,6 +57,42 @@ class SatSolver
    * @return 1 if it is implied, -1 if it is not implied and 0 if unknown.
    */
   virtual int32_t fixed(int32_t lit) = 0;
+  /**
+   * Freeze variable of given valid non-zero literal, i.e., prevent the SAT
+   * solver from eliminating it until it is melted via melt().
+   * @note Only has an effect for SAT solvers that eliminate variables.
+   * @param lit The literal to freeze.
+   */
+  virtual void freeze(int32_t lit) { (void) lit; }
+  /**
+   * Melt variable of given valid non-zero literal that was previously frozen
+   * via freeze(), i.e., allow the SAT solver to eliminate it again.
+   * @note Only has an effect for SAT solvers that eliminate variables.
+   * @param lit The literal to melt.
+   */
+  virtual void melt(int32_t lit) { (void) lit; }
+  /**
+   * Set the initial phase of the variable of given valid non-zero literal,
+   * i.e., make the SAT solver prefer assigning the literal to true when it
+   * decides on its variable, until it is reset via unphase().
+   * @note Only has an effect for SAT solvers that support forcing phases.
+   * @param lit The literal to phase.
+   */
+  virtual void phase(int32_t lit) { (void) lit; }
+  /**
+   * Reset the phase of the variable of given valid non-zero literal that was
+   * previously set via phase().
+   * @note Only has an effect for SAT solvers that support forcing phases.
+   * @param lit The literal to unphase.
+   */
+  virtual void unphase(int32_t lit) { (void) lit; }
+  /**
+   * Limit the number of conflicts of the next call to solve(), which returns
+   * unknown if the limit is reached.
+   * @note Only has an effect for SAT solvers that support limits.
+   * @param limit The conflict limit, a negative value for no limit.
+   */
+  virtual void limit_conflicts(int32_t limit) { (void) limit; }
   /**
    * Check satisfiability of current formula.
    * @return The result of the satisfiability check.
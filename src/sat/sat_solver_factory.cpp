@@ -12,13 +12,18 @@
 
 #include "sat/cadical.h"
 #include "sat/kissat.h"
+#include "sat/portfolio.h"
 
 namespace bzla::sat {
 
 SatSolver*
-new_sat_solver(option::SatSolver kind)
+new_sat_solver(const option::Options& options)
 {
-  (void) kind;
+  option::SatSolver kind = options.sat_solver();
+  if (kind == option::SatSolver::PORTFOLIO)
+  {
+    return new Portfolio(options.threads());
+  }
 #ifdef BZLA_USE_KISSAT
   if (kind == option::SatSolver::KISSAT)
   {
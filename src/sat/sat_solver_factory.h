@@ -16,7 +16,12 @@
 
 namespace bzla::sat {
 
-SatSolver* new_sat_solver(option::SatSolver kind);
+/**
+ * Create a new SAT solver as configured via options.
+ * @param options The options.
+ * @return The SAT solver.
+ */
+SatSolver* new_sat_solver(const option::Options& options);
 
 }
 
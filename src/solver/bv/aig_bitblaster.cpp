@@ -15,6 +15,11 @@
 
 namespace bzla::bv {
 
+AigBitblaster::AigBitblaster(backtrack::BacktrackManager* mgr)
+    : Backtrackable(mgr)
+{
+}
+
 void
 AigBitblaster::bitblast(const Node& t)
 {
@@ -30,6 +35,10 @@ AigBitblaster::bitblast(const Node& t)
     if (it == d_bitblaster_cache.end())
     {
       d_bitblaster_cache.emplace(cur, bitblast::AigBitblaster::Bits());
+      if (!d_control.empty())
+      {
+        d_cache_trail.push_back(cur);
+      }
       if (!BvSolver::is_leaf(cur))
       {
         visit.insert(visit.end(), cur.begin(), cur.end());
@@ -205,10 +214,33 @@ AigBitblaster::bits(const Node& term) const
   return d_bitblaster_cache.at(term);
 }
 
+void
+AigBitblaster::push()
+{
+  d_control.push_back(d_cache_trail.size());
+}
+
+void
+AigBitblaster::pop()
+{
+  assert(!d_control.empty());
+  size_t pop_to = d_control.back();
+  assert(pop_to <= d_cache_trail.size());
+  d_control.pop_back();
+
+  // Erasing the bits releases the AIGs, which are garbage collected by the
+  // AIG manager if they are not referenced anymore.
+  while (d_cache_trail.size() > pop_to)
+  {
+    d_bitblaster_cache.erase(d_cache_trail.back());
+    d_cache_trail.pop_back();
+  }
+}
+
 uint64_t
-AigBitblaster::count_aig_ands(const Node& term, AigNodeRefSet& cache)
+AigBitblaster::count_aig_ands(const Node& term, AigNodeSet& cache)
 {
-  std::vector<std::reference_wrapper<const bitblast::AigNode>> visit;
+  std::vector<bitblast::AigNode> visit;
   bitblast(term);
   const auto& b = bits(term);
   visit.insert(visit.end(), b.begin(), b.end());
@@ -217,7 +249,7 @@ AigBitblaster::count_aig_ands(const Node& term, AigNodeRefSet& cache)
   uint64_t res = 0;
   do
   {
-    const bitblast::AigNode& cur = visit.back();
+    bitblast::AigNode cur = std::move(visit.back());
     visit.pop_back();
 
     if (cache.insert(cur).second)
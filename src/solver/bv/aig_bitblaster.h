@@ -14,17 +14,30 @@
 #include <unordered_set>
 #include <unordered_map>
 
+#include "backtrack/backtrackable.h"
 #include "bitblast/aig_bitblaster.h"
 #include "node/node.h"
+#include "node/node_id_map.h"
 
 namespace bzla::bv {
 
-class AigBitblaster
+/**
+ * Bit-blaster for Boolean and bit-vector terms.
+ *
+ * If a backtrack manager is given, terms bit-blasted in a scope are removed
+ * from the cache when the scope is popped, which releases their AIGs.
+ */
+class AigBitblaster : public backtrack::Backtrackable
 {
  public:
-  using AigNodeRefSet =
-      std::unordered_set<std::reference_wrapper<const bitblast::AigNode>,
-                         std::hash<bitblast::AigNode>>;
+  using AigNodeSet = std::unordered_set<bitblast::AigNode>;
+
+  /**
+   * Constructor.
+   * @param mgr The associated backtrack manager, nullptr if the cache should
+   *            not be backtracked.
+   */
+  AigBitblaster(backtrack::BacktrackManager* mgr = nullptr);
 
   /** Recursively bit-blast `term`. */
   void bitblast(const Node& term);
@@ -33,19 +46,41 @@ class AigBitblaster
   const bitblast::AigBitblaster::Bits& bits(const Node& term) const;
 
   /** Count number of AIG nodes in term. */
-  uint64_t count_aig_ands(const Node& term, AigNodeRefSet& cache);
+  uint64_t count_aig_ands(const Node& term, AigNodeSet& cache);
 
   uint64_t num_aig_ands() const { return d_bitblaster.num_aig_ands(); }
   uint64_t num_aig_consts() const { return d_bitblaster.num_aig_consts(); }
   uint64_t num_aig_shared() const { return d_bitblaster.num_aig_shared(); }
 
+  /** Set the encoding of bit-vector multiplication. */
+  void set_mul_encoding(bitblast::MulEncoding encoding)
+  {
+    d_bitblaster.set_mul_encoding(encoding);
+  }
+
+  /** Configure whether division by values is encoded via multiplication. */
+  void set_div_reciprocal(bool value)
+  {
+    d_bitblaster.set_div_reciprocal(value);
+  }
+
+  /** @return A fresh AIG constant. */
+  bitblast::AigNode mk_bit() { return d_bitblaster.bv_constant(1)[0]; }
+
+  /* --- Backtrackable interface -------------------------------------------- */
+
+  void push() override;
+  void pop() override;
+
  private:
   bitblast::AigBitblaster::Bits d_empty;
 
   /** AIG bit-blaster. */
   bitblast::AigBitblaster d_bitblaster;
   /** Cached to store bit-blasted terms and their encoded bits. */
-  std::unordered_map<Node, bitblast::AigBitblaster::Bits> d_bitblaster_cache;
+  node::NodeIdMap<bitblast::AigBitblaster::Bits> d_bitblaster_cache;
+  /** Terms added to the cache in currently open scopes. */
+  std::vector<Node> d_cache_trail;
 };
 
 }  // namespace bzla::bv
@@ -15,6 +15,7 @@
 #include "node/node_ref_vector.h"
 #include "node/node_utils.h"
 #include "node/unordered_node_ref_map.h"
+#include "sat/cadical.h"
 #include "sat/sat_solver_factory.h"
 #include "solver/bv/bv_solver.h"
 #include "solving_context.h"
@@ -49,18 +50,81 @@ class BvBitblastSolver::BitblastSatSolver : public bitblast::SatInterface
   sat::SatSolver& d_solver;
 };
 
+/** Sat solver wrapper for the equivalence checks of the FRAIG pass. */
+class BvBitblastSolver::FraigSatSolver : public bitblast::FraigSatInterface
+{
+ public:
+  void add(int64_t lit) override { d_solver.add(lit); }
+
+  void add_clause(const std::initializer_list<int64_t>& literals) override
+  {
+    for (int64_t lit : literals)
+    {
+      d_solver.add(lit);
+    }
+    d_solver.add(0);
+  }
+
+  bool value(int64_t lit) override { return d_solver.value(lit) == 1; }
+
+  void assume(int64_t lit) override { d_solver.assume(lit); }
+
+  int32_t solve(uint64_t conflict_limit) override
+  {
+    d_solver.limit_conflicts(
+        conflict_limit == 0 ? -1 : static_cast<int32_t>(conflict_limit));
+    Result res = d_solver.solve();
+    return res == Result::SAT ? 10 : (res == Result::UNSAT ? 20 : 0);
+  }
+
+  void configure_terminator(Terminator* terminator)
+  {
+    d_solver.configure_terminator(terminator);
+  }
+
+ private:
+  sat::Cadical d_solver;
+};
+
 /* --- BvBitblastSolver public ---------------------------------------------- */
 
 BvBitblastSolver::BvBitblastSolver(Env& env, SolverState& state)
     : Solver(env, state),
       d_assertions(state.backtrack_mgr()),
       d_assumptions(state.backtrack_mgr()),
+      d_bitblaster(state.backtrack_mgr()),
+      d_aig_optimizer([this](const bitblast::AigNode& aig) {
+        return d_cnf_encoder->is_encoded(aig);
+      }),
+      d_aig_opt_roots(state.backtrack_mgr()),
       d_last_result(Result::UNKNOWN),
+      d_cnf_backtrack(state.backtrack_mgr(), this),
       d_stats(env.statistics(), "solver::bv::bitblast::")
 {
-  d_sat_solver.reset(sat::new_sat_solver(env.options().sat_solver()));
+  d_sat_solver.reset(sat::new_sat_solver(env.options()));
   d_bitblast_sat_solver.reset(new BitblastSatSolver(*d_sat_solver));
-  d_cnf_encoder.reset(new bitblast::AigCnfEncoder(*d_bitblast_sat_solver));
+  d_cnf_encoder.reset(new bitblast::AigCnfEncoder(*d_bitblast_sat_solver,
+                                                  env.options().bv_cnf_pg()));
+
+  switch (env.options().bv_mul_enc())
+  {
+    case option::BvMulEncoding::ARRAY:
+      d_bitblaster.set_mul_encoding(bitblast::MulEncoding::ARRAY);
+      break;
+    case option::BvMulEncoding::WALLACE:
+      d_bitblaster.set_mul_encoding(bitblast::MulEncoding::WALLACE);
+      break;
+    case option::BvMulEncoding::DADDA:
+      d_bitblaster.set_mul_encoding(bitblast::MulEncoding::DADDA);
+      break;
+    case option::BvMulEncoding::BOOTH:
+      d_bitblaster.set_mul_encoding(bitblast::MulEncoding::BOOTH);
+      break;
+    case option::BvMulEncoding::AUTO:
+      d_bitblaster.set_mul_encoding(bitblast::MulEncoding::AUTO);
+      break;
+  }
+  d_bitblaster.set_div_reciprocal(env.options().bv_div_reciprocal());
 }
 
 BvBitblastSolver::~BvBitblastSolver() {}
@@ -68,18 +132,76 @@ BvBitblastSolver::~BvBitblastSolver() {}
 Result
 BvBitblastSolver::solve()
 {
-  d_sat_solver->configure_terminator(d_env.terminator());
+  return solve(d_env.terminator());
+}
+
+Result
+BvBitblastSolver::solve(Terminator* terminator)
+{
+  d_sat_solver->configure_terminator(terminator);
 
   if (!d_assertions.empty())
   {
-    util::Timer timer(d_stats.time_encode);
+    std::vector<bitblast::AigNode> roots;
     for (const Node& assertion : d_assertions)
     {
       const auto& bits = d_bitblaster.bits(assertion);
       assert(!bits.empty());
-      d_cnf_encoder->encode(bits[0], true);
+      roots.push_back(bits[0]);
     }
     d_assertions.clear();
+
+    // Assertions are only encoded via their reduced and optimized AIGs. Leaf
+    // bits are AIG constants and thus not affected, model values are still
+    // read from the bits of the leaves.
+    const option::Options& options = d_env.options();
+    if (options.bv_aig_fraig())
+    {
+      util::Timer timer(d_stats.time_aig_fraig);
+      if (!d_aig_fraig)
+      {
+        d_fraig_sat_solver.reset(new FraigSatSolver());
+        d_aig_fraig.reset(new bitblast::AigFraig(
+            *d_fraig_sat_solver,
+            [this](const bitblast::AigNode& aig) {
+              return d_cnf_encoder->is_encoded(aig);
+            },
+            1000,
+            options.seed()));
+      }
+      d_fraig_sat_solver->configure_terminator(terminator);
+      d_aig_fraig->fraig(roots);
+    }
+    if (options.bv_aig_opt())
+    {
+      util::Timer timer(d_stats.time_aig_opt);
+      d_aig_optimizer.optimize(roots);
+    }
+    if (options.bv_aig_fraig() || options.bv_aig_opt())
+    {
+      // Keep rebuilt AIGs alive for sharing with later assertions.
+      for (const bitblast::AigNode& root : roots)
+      {
+        d_aig_opt_roots.push_back(root);
+      }
+    }
+
+    util::Timer timer(d_stats.time_encode);
+    for (const bitblast::AigNode& root : roots)
+    {
+      d_cnf_encoder->encode(root, true);
+    }
+  }
+
+  // Clauses encoded in a scope are guarded by the activation literal of the
+  // scope, which allows to disable them when the scope is popped.
+  if (!d_activation.empty() && d_activation.back().get_id() == 0
+      && !d_assumptions.empty())
+  {
+    d_activation.back() = d_bitblaster.mk_bit();
+    d_cnf_encoder->push(d_activation.back());
+    // Prevent the SAT solver from eliminating the activation literal.
+    d_sat_solver->freeze(d_activation.back().get_id());
   }
 
   for (const Node& assumption : d_assumptions)
@@ -91,11 +213,53 @@ BvBitblastSolver::solve()
     d_sat_solver->assume(bits[0].get_id());
   }
 
+  for (const bitblast::AigNode& activation : d_activation)
+  {
+    if (activation.get_id() != 0)
+    {
+      d_sat_solver->assume(activation.get_id());
+    }
+  }
+
+  // Seed the decisions of the SAT solver with the suggested phases. Only
+  // bits that are already encoded are phased, all others do not occur in the
+  // current formula.
+  for (const auto& [term, value] : d_phases)
+  {
+    const auto& bits = d_bitblaster.bits(term);
+    for (size_t i = 0, size = bits.size(); i < size; ++i)
+    {
+      const bitblast::AigNode& bit = bits[i];
+      if (bit.is_true() || bit.is_false() || !d_cnf_encoder->is_encoded(bit))
+      {
+        continue;
+      }
+      bool val = value.type().is_bool()
+                     ? value.value<bool>()
+                     : value.value<BitVector>().bit(size - 1 - i);
+      int32_t id  = static_cast<int32_t>(bit.get_id());
+      int32_t lit = val ? id : -id;
+      d_sat_solver->phase(lit);
+      d_phased_lits.push_back(lit);
+    }
+  }
+  d_phases.clear();
+  d_stats.num_sat_phases += d_phased_lits.size();
+
   // Update CNF statistics
   update_statistics();
 
-  util::Timer timer(d_stats.time_sat);
-  d_last_result = d_sat_solver->solve();
+  {
+    util::Timer timer(d_stats.time_sat);
+    d_last_result = d_sat_solver->solve();
+  }
+
+  // Phases only apply to a single solve() call.
+  for (int32_t lit : d_phased_lits)
+  {
+    d_sat_solver->unphase(lit);
+  }
+  d_phased_lits.clear();
 
   return d_last_result;
 }
@@ -158,6 +322,16 @@ BvBitblastSolver::value(const Node& term)
   return nm.mk_value(val);
 }
 
+void
+BvBitblastSolver::phase(const Node& term, const Node& value)
+{
+  assert(BvSolver::is_leaf(term));
+  assert(term.type().is_bool() || term.type().is_bv());
+  assert(value.is_value());
+  assert(value.type() == term.type());
+  d_phases.emplace_back(term, value);
+}
+
 void
 BvBitblastSolver::unsat_core(std::vector<Node>& core) const
 {
@@ -177,16 +351,48 @@ BvBitblastSolver::unsat_core(std::vector<Node>& core) const
 
 /* --- BvBitblastSolver private --------------------------------------------- */
 
+void
+BvBitblastSolver::push_scope()
+{
+  d_activation.emplace_back();
+}
+
+void
+BvBitblastSolver::pop_scope()
+{
+  assert(!d_activation.empty());
+  const bitblast::AigNode& activation = d_activation.back();
+  if (activation.get_id() != 0)
+  {
+    d_cnf_encoder->pop();
+    d_sat_solver->melt(activation.get_id());
+  }
+  d_activation.pop_back();
+  update_statistics();
+}
+
 void
 BvBitblastSolver::update_statistics()
 {
-  d_stats.num_aig_ands     = d_bitblaster.num_aig_ands();
-  d_stats.num_aig_consts   = d_bitblaster.num_aig_consts();
-  d_stats.num_aig_shared   = d_bitblaster.num_aig_shared();
-  auto& cnf_stats          = d_cnf_encoder->statistics();
+  d_stats.num_aig_ands           = d_bitblaster.num_aig_ands();
+  d_stats.num_aig_consts         = d_bitblaster.num_aig_consts();
+  d_stats.num_aig_shared         = d_bitblaster.num_aig_shared();
+  auto& opt_stats                = d_aig_optimizer.statistics();
+  d_stats.num_aig_opt_before     = opt_stats.num_ands_before;
+  d_stats.num_aig_opt_after      = opt_stats.num_ands_after;
+  d_stats.num_aig_opt_rewritten  = opt_stats.num_rewritten;
+  d_stats.num_aig_opt_refactored = opt_stats.num_refactored;
+  if (d_aig_fraig)
+  {
+    auto& fraig_stats               = d_aig_fraig->statistics();
+    d_stats.num_aig_fraig_merged    = fraig_stats.num_merged;
+    d_stats.num_aig_fraig_sat_calls = fraig_stats.num_sat_calls;
+  }
+  auto& cnf_stats                = d_cnf_encoder->statistics();
   d_stats.num_cnf_vars     = cnf_stats.num_vars;
   d_stats.num_cnf_clauses  = cnf_stats.num_clauses;
   d_stats.num_cnf_literals = cnf_stats.num_literals;
+  d_stats.num_cnf_released = cnf_stats.num_released;
 }
 
 BvBitblastSolver::Statistics::Statistics(util::Statistics& stats,
@@ -197,12 +403,30 @@ BvBitblastSolver::Statistics::Statistics(util::Statistics& stats,
           stats.new_stat<util::TimerStatistic>(prefix + "aig::time_bitblast")),
       time_encode(
           stats.new_stat<util::TimerStatistic>(prefix + "cnf::time_encode")),
+      time_aig_opt(
+          stats.new_stat<util::TimerStatistic>(prefix + "aig::opt::time")),
+      time_aig_fraig(
+          stats.new_stat<util::TimerStatistic>(prefix + "aig::fraig::time")),
       num_aig_ands(stats.new_stat<uint64_t>(prefix + "aig::num_ands")),
       num_aig_consts(stats.new_stat<uint64_t>(prefix + "aig::num_consts")),
       num_aig_shared(stats.new_stat<uint64_t>(prefix + "aig::num_shared")),
+      num_aig_opt_before(
+          stats.new_stat<uint64_t>(prefix + "aig::opt::num_ands_before")),
+      num_aig_opt_after(
+          stats.new_stat<uint64_t>(prefix + "aig::opt::num_ands_after")),
+      num_aig_opt_rewritten(
+          stats.new_stat<uint64_t>(prefix + "aig::opt::num_rewritten")),
+      num_aig_opt_refactored(
+          stats.new_stat<uint64_t>(prefix + "aig::opt::num_refactored")),
+      num_aig_fraig_merged(
+          stats.new_stat<uint64_t>(prefix + "aig::fraig::num_merged")),
+      num_aig_fraig_sat_calls(
+          stats.new_stat<uint64_t>(prefix + "aig::fraig::num_sat_calls")),
       num_cnf_vars(stats.new_stat<uint64_t>(prefix + "cnf::num_vars")),
       num_cnf_clauses(stats.new_stat<uint64_t>(prefix + "cnf::num_clauses")),
-      num_cnf_literals(stats.new_stat<uint64_t>(prefix + "cnf::num_literals"))
+      num_cnf_literals(stats.new_stat<uint64_t>(prefix + "cnf::num_literals")),
+      num_cnf_released(stats.new_stat<uint64_t>(prefix + "cnf::num_released")),
+      num_sat_phases(stats.new_stat<uint64_t>(prefix + "sat::num_phases"))
 {
 }
 
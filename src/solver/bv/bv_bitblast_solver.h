@@ -14,8 +14,11 @@
 #include <unordered_map>
 
 #include "backtrack/assertion_stack.h"
+#include "backtrack/backtrackable.h"
 #include "backtrack/vector.h"
 #include "bitblast/aig/aig_cnf.h"
+#include "bitblast/aig/aig_fraig.h"
+#include "bitblast/aig/aig_optimizer.h"
 #include "sat/sat_solver.h"
 #include "solver/bv/aig_bitblaster.h"
 #include "solver/bv/bv_solver_interface.h"
@@ -26,6 +29,15 @@ namespace bzla::bv {
 
 class BvSolver;
 
+/**
+ * Bit-blasting solver for bit-vector terms.
+ *
+ * Terms bit-blasted in a scope and the clauses of their (non-top-level)
+ * encodings are released on pop. Since AIG ids double as SAT variables and
+ * are never reused, the AIG node storage of the AIG manager, the CNF encoder
+ * state and the number of SAT variables are not shrunk on pop, but still grow
+ * with the number of AIG nodes created over all scopes.
+ */
 class BvBitblastSolver : public Solver, public BvSolverInterface
 {
  public:
@@ -34,6 +46,13 @@ class BvBitblastSolver : public Solver, public BvSolverInterface
 
   Result solve() override;
 
+  /**
+   * Solve with given terminator instead of the terminator of the environment.
+   * @param terminator The terminator to configure the SAT solver with, may be
+   *                   null.
+   */
+  Result solve(Terminator* terminator);
+
   void register_assertion(const Node& assertion,
                           bool top_level,
                           bool is_lemma) override;
@@ -41,6 +60,15 @@ class BvBitblastSolver : public Solver, public BvSolverInterface
   /** Query value of leaf node. */
   Node value(const Node& term) override;
 
+  /**
+   * Suggest given value as initial phase of the bits of given leaf term for
+   * the next solve() call. The phases only affect the decisions of the SAT
+   * solver in the next solve() call and are reset afterwards.
+   * @param term  The leaf term, of Boolean or bit-vector type.
+   * @param value The suggested value of the term.
+   */
+  void phase(const Node& term, const Node& value);
+
   /** Get unsat core of last solve() call. */
   void unsat_core(std::vector<Node>& core) const override;
 
@@ -56,6 +84,31 @@ class BvBitblastSolver : public Solver, public BvSolverInterface
 
   /** Sat interface used for d_cnf_encoder. */
   class BitblastSatSolver;
+  /** Sat interface used for d_aig_fraig. */
+  class FraigSatSolver;
+
+  /** Backtrackable to sync push/pop with the CNF encoder. */
+  class CnfBacktrack : public backtrack::Backtrackable
+  {
+   public:
+    CnfBacktrack(backtrack::BacktrackManager* mgr, BvBitblastSolver* solver)
+        : Backtrackable(mgr), d_solver(solver)
+    {
+    }
+    void push() override { d_solver->push_scope(); }
+    void pop() override { d_solver->pop_scope(); }
+
+   private:
+    BvBitblastSolver* d_solver;
+  };
+
+  /** Open a new scope. */
+  void push_scope();
+  /**
+   * Close the last scope and disable the clauses encoded in the scope via its
+   * activation literal.
+   */
+  void pop_scope();
 
   /** The current set of assertions. */
   backtrack::vector<Node> d_assertions;
@@ -67,12 +120,41 @@ class BvBitblastSolver : public Solver, public BvSolverInterface
 
   /** CNF encoder for AIGs. */
   std::unique_ptr<bitblast::AigCnfEncoder> d_cnf_encoder;
+  /**
+   * AIG optimizer, optimizes the AIGs of assertions before they are encoded.
+   * Already encoded AIGs are treated as inputs.
+   */
+  bitblast::AigOptimizer d_aig_optimizer;
+  /**
+   * The reduced and optimized AIGs of the encoded assertions. Backtracked
+   * together with the clauses encoded in a scope.
+   */
+  backtrack::vector<bitblast::AigNode> d_aig_opt_roots;
+  /** Dedicated SAT solver for the equivalence checks of `d_aig_fraig`. */
+  std::unique_ptr<FraigSatSolver> d_fraig_sat_solver;
+  /**
+   * FRAIG pass, merges equivalent nodes of the AIGs of assertions before they
+   * are optimized and encoded. Created on demand, already encoded AIGs are
+   * treated as inputs.
+   */
+  std::unique_ptr<bitblast::AigFraig> d_aig_fraig;
   /** SAT solver used for solving bit-blasted formula. */
   std::unique_ptr<sat::SatSolver> d_sat_solver;
   /** SAT solver interface for CNF encoder, which wraps `d_sat_solver`. */
   std::unique_ptr<BitblastSatSolver> d_bitblast_sat_solver;
+  /** Pending phase suggestions for the next solve() call. */
+  std::vector<std::pair<Node, Node>> d_phases;
+  /** The SAT literals phased in the current solve() call. */
+  std::vector<int32_t> d_phased_lits;
   /** Result of last solve() call. */
   Result d_last_result;
+  /**
+   * Activation literals of open scopes. Created on demand, i.e., null if no
+   * clauses were encoded in a scope yet.
+   */
+  std::vector<bitblast::AigNode> d_activation;
+  /** Backtrackable for syncing scopes, registered after all other members. */
+  CnfBacktrack d_cnf_backtrack;
 
   struct Statistics
   {
@@ -80,12 +162,22 @@ class BvBitblastSolver : public Solver, public BvSolverInterface
     util::TimerStatistic& time_sat;
     util::TimerStatistic& time_bitblast;
     util::TimerStatistic& time_encode;
+    util::TimerStatistic& time_aig_opt;
+    util::TimerStatistic& time_aig_fraig;
     uint64_t& num_aig_ands;
     uint64_t& num_aig_consts;
     uint64_t& num_aig_shared;
+    uint64_t& num_aig_opt_before;
+    uint64_t& num_aig_opt_after;
+    uint64_t& num_aig_opt_rewritten;
+    uint64_t& num_aig_opt_refactored;
+    uint64_t& num_aig_fraig_merged;
+    uint64_t& num_aig_fraig_sat_calls;
     uint64_t& num_cnf_vars;
     uint64_t& num_cnf_clauses;
     uint64_t& num_cnf_literals;
+    uint64_t& num_cnf_released;
+    uint64_t& num_sat_phases;
   } d_stats;
 };
 
@@ -10,108 +10,259 @@
 
 #include "solver/bv/bv_prop_solver.h"
 
+#include <algorithm>
 #include <iostream>
+#include <thread>
 
 #include "bv/domain/bitvector_domain.h"
+#include "ls/fp/floating_point_bv.h"
 #include "ls/ls_bv.h"
 #include "node/node_manager.h"
 #include "node/node_utils.h"
 #include "node/unordered_node_ref_set.h"
 #include "option/option.h"
 #include "solver/bv/bv_solver.h"
+#include "solver/bv/race_terminator.h"
+#include "solver/fp/floating_point.h"
+#include "solver/fp/rounding_mode.h"
 #include "solver/result.h"
 #include "solving_context.h"
+#include "terminator.h"
 #include "util/logger.h"
 
 namespace bzla::bv {
 
 using namespace bzla::node;
 
+namespace {
+
+/**
+ * @return True if given term is a floating-point operator that is not
+ *         supported natively by the local search engines.
+ */
+bool
+is_fp_unsupported(const Node& term)
+{
+  Kind k = term.kind();
+  return k == Kind::FP_FMA || k == Kind::FP_MAX || k == Kind::FP_MIN
+         || k == Kind::FP_REM || k == Kind::FP_RTI || k == Kind::FP_SQRT
+         || k == Kind::FP_TO_SBV || k == Kind::FP_TO_UBV;
+}
+
+}  // namespace
+
 BvPropSolver::BvPropSolver(Env& env,
                            SolverState& state,
                            BvBitblastSolver& bb_solver)
     : Solver(env, state),
       d_bb_solver(bb_solver),
-      d_ls_backtrack(state.backtrack_mgr(), nullptr),
+      d_ls_backtrack(state.backtrack_mgr(), this),
+      d_registered(state.backtrack_mgr()),
+      d_leaves(state.backtrack_mgr()),
+      d_fp_unsupported(state.backtrack_mgr()),
       d_stats(env.statistics(), "solver::bv::prop::")
 {
   const option::Options& options = d_env.options();
 
-  d_ls.reset(new ls::LocalSearchBV(options.prop_nprops(),
-                                   options.prop_nupdates(),
-                                   options.seed(),
-                                   options.log_level(),
-                                   options.verbosity(),
-                                   "solver::bv::prop::",
-                                   &env.statistics()));
-
-  d_ls->d_options.use_ineq_bounds        = options.prop_ineq_bounds();
-  d_ls->d_options.use_opt_lt_concat_sext = options.prop_opt_lt_concat_sext();
-  d_ls->d_options.prob_pick_inv_value    = options.prop_prob_pick_inv_value();
-  d_ls->d_options.use_path_sel_essential =
-      options.prop_path_sel() == option::PropPathSelection::ESSENTIAL;
+  size_t num_instances = 1;
+  if (options.prop_portfolio())
+  {
+    num_instances = options.threads();
+    if (num_instances == 0)
+    {
+      num_instances = std::max(std::thread::hardware_concurrency(), 1u);
+    }
+  }
 
-  d_ls->d_options.prob_pick_ess_input =
-      1000 - options.prop_prob_pick_random_input();
+  // Probabilities for producing inverse values, path selection modes and
+  // probabilities for picking essential inputs of additional portfolio
+  // instances, the first instance uses the configured options.
+  const uint32_t probs_inv_value[] = {990, 1000, 900, 950};
+  const bool path_sel_essential[]  = {true, true, false, true};
+  const uint32_t probs_ess_input[] = {990, 1000, 990, 900};
 
-  d_ls->init();
+  const size_t num_configs =
+      sizeof(probs_inv_value) / sizeof(probs_inv_value[0]);
 
-  d_ls_backtrack.d_ls = d_ls.get();
+  for (size_t i = 0; i < num_instances; ++i)
+  {
+    // Only the first instance reports its statistics, statistics of the
+    // portfolio are aggregated in d_stats.
+    auto engine = std::make_unique<ls::LocalSearchBV>(
+        options.prop_nprops(),
+        options.prop_nupdates(),
+        options.seed() + static_cast<uint32_t>(i),
+        options.log_level(),
+        options.verbosity(),
+        "solver::bv::prop::",
+        i == 0 ? &env.statistics() : nullptr);
+
+    engine->d_options.use_ineq_bounds = options.prop_ineq_bounds();
+    engine->d_options.use_opt_lt_concat_sext =
+        options.prop_opt_lt_concat_sext();
+    engine->d_options.prob_pick_inv_value =
+        i == 0 ? options.prop_prob_pick_inv_value()
+               : probs_inv_value[i % num_configs];
+    engine->d_options.use_path_sel_essential =
+        i == 0
+            ? options.prop_path_sel() == option::PropPathSelection::ESSENTIAL
+            : path_sel_essential[i % num_configs];
+    engine->d_options.prob_pick_ess_input =
+        i == 0 ? 1000 - options.prop_prob_pick_random_input()
+               : probs_ess_input[i % num_configs];
+    engine->d_options.use_root_weights = options.prop_root_weights();
+    engine->d_options.use_restarts     = options.prop_restarts();
+    engine->d_options.use_inverse_memo = options.prop_inv_memo();
+
+    engine->init();
+    d_ls.push_back(std::move(engine));
+  }
 
-  d_use_sext       = options.prop_sext();
-  d_use_const_bits = options.prop_const_bits();
+  d_use_sext = options.prop_sext();
+  d_use_fp   = options.prop_fp()
+             && options.bv_solver() == option::BvSolver::PROP;
+  // Constant bits are determined via bit-blasting, which does not support
+  // floating-point terms.
+  d_use_const_bits = options.prop_const_bits() && !d_use_fp;
 }
 
 BvPropSolver::~BvPropSolver() {}
 
 Result
 BvPropSolver::solve()
+{
+  return solve(d_env.terminator());
+}
+
+Result
+BvPropSolver::solve(Terminator* terminator)
 {
   util::Timer timer(d_stats.time_check);
 
   ++d_stats.num_checks;
 
-  Result sat_result = Result::UNKNOWN;
+  if (d_fp_unsupported.get())
+  {
+    return Result::UNKNOWN;
+  }
 
-  uint32_t verbosity = d_env.options().verbosity();
-  uint64_t nprops    = d_env.options().prop_nprops();
-  uint64_t nupdates  = d_env.options().prop_nupdates();
+  uint64_t nprops   = d_env.options().prop_nprops();
+  uint64_t nupdates = d_env.options().prop_nupdates();
 
-  uint32_t progress_steps     = 100;
-  uint32_t progress_steps_inc = progress_steps * 10;
+  sync_portfolio();
 
+  // Normalization of the engines is independent and thus done concurrently.
+  auto normalize = [this](size_t idx) { d_ls[idx]->normalize(); };
   if (d_env.options().prop_normalize())
   {
-    d_ls->normalize();
+    std::vector<std::thread> threads;
+    for (size_t i = 1, n = d_ls.size(); i < n; ++i)
+    {
+      threads.emplace_back(normalize, i);
+    }
+    normalize(0);
+    for (auto& t : threads)
+    {
+      t.join();
+    }
   }
 
-  // incremental: increase limit by given nprops/nupdates
-  if (nprops)
+  for (auto& ls : d_ls)
   {
-    nprops += d_ls->num_props();
+    if (ls->d_options.use_restarts)
+    {
+      ls->init_best();
+    }
+    // incremental: increase limit by given nprops/nupdates
+    uint64_t max_nprops   = nprops ? nprops + ls->num_props() : 0;
+    uint64_t max_nupdates = nupdates ? nupdates + ls->num_updates() : 0;
+    ls->set_max_nprops(max_nprops);
+    Log(1) << "set propagation limit to " << max_nprops;
+    ls->set_max_nupdates(max_nupdates);
+    Log(1) << "set cone update limit to " << max_nupdates;
+  }
+
+  Result sat_result = Result::UNKNOWN;
+  d_winner          = 0;
+  if (d_ls.size() == 1)
+  {
+    sat_result = run(0, terminator);
+  }
+  else
+  {
+    // Local search engines do not share any data and can thus run
+    // concurrently. The first engine runs on the calling thread.
+    RaceTerminator race(terminator);
+    std::vector<Result> results(d_ls.size(), Result::UNKNOWN);
+    auto run_instance = [&](size_t idx) {
+      results[idx] = run(idx, &race);
+      if (race.finish(results[idx]))
+      {
+        d_winner = idx;
+      }
+    };
+    std::vector<std::thread> threads;
+    for (size_t i = 1, n = d_ls.size(); i < n; ++i)
+    {
+      threads.emplace_back(run_instance, i);
+    }
+    run_instance(0);
+    for (auto& t : threads)
+    {
+      t.join();
+    }
+    sat_result = results[d_winner];
+
+    d_stats.num_portfolio_moves   = 0;
+    d_stats.num_portfolio_props   = 0;
+    d_stats.num_portfolio_updates = 0;
+    for (const auto& ls : d_ls)
+    {
+      d_stats.num_portfolio_moves += ls->num_moves();
+      d_stats.num_portfolio_props += ls->num_props();
+      d_stats.num_portfolio_updates += ls->num_updates();
+    }
   }
-  d_ls->set_max_nprops(nprops);
-  Log(1) << "set propagation limit to " << nprops;
 
-  if (nupdates)
+  // Continue the next check from the best assignment seen.
+  if (sat_result == Result::UNKNOWN)
   {
-    nupdates += d_ls->num_updates();
+    for (auto& ls : d_ls)
+    {
+      ls->restore_best();
+    }
   }
-  d_ls->set_max_nupdates(nupdates);
-  Log(1) << "set cone update limit to " << nupdates;
+
+  print_progress(*d_ls[d_winner]);
+
+  return sat_result;
+}
+
+Result
+BvPropSolver::run(size_t idx, Terminator* terminator)
+{
+  bzla::ls::LocalSearchBV& ls = *d_ls[idx];
+
+  // Only the first engine prints its progress.
+  uint32_t verbosity = idx == 0 ? d_env.options().verbosity() : 0;
+  uint64_t nprops    = ls.max_nprops();
+  uint64_t nupdates  = ls.max_nupdates();
+
+  uint32_t progress_steps     = 100;
+  uint32_t progress_steps_inc = progress_steps * 10;
 
   for (uint32_t j = 0;; ++j)
   {
-    if (d_env.terminate() || (nprops && d_ls->num_props() >= nprops)
-        || (nupdates && d_ls->num_updates() >= nupdates))
+    if ((terminator && terminator->terminate())
+        || (nprops && ls.num_props() >= nprops)
+        || (nupdates && ls.num_updates() >= nupdates))
     {
-      assert(sat_result == Result::UNKNOWN);
-      goto DONE;
+      return Result::UNKNOWN;
     }
 
     if (verbosity > 0 && j % progress_steps == 0)
     {
-      print_progress();
+      print_progress(ls);
       if (j <= 1000000 && j >= progress_steps_inc)
       {
         progress_steps = progress_steps_inc;
@@ -119,28 +270,18 @@ BvPropSolver::solve()
       }
     }
 
-    bzla::ls::Result res = d_ls->move();
+    bzla::ls::Result res = ls.move();
 
     if (res == bzla::ls::Result::UNSAT)
     {
-      goto UNSAT;
+      return Result::UNSAT;
     }
 
     if (res == bzla::ls::Result::SAT)
     {
-      goto SAT;
+      return Result::SAT;
     }
   }
-
-SAT:
-  sat_result = Result::SAT;
-  goto DONE;
-UNSAT:
-  sat_result = Result::UNSAT;
-DONE:
-  print_progress();
-
-  return sat_result;
 }
 
 void
@@ -165,7 +306,7 @@ BvPropSolver::register_assertion(const Node& assertion,
   {
     const Node& cur = visit.back();
 
-    if (d_node_map.find(cur) != d_node_map.end())
+    if (d_registered.find(cur) != d_registered.end())
     {
       visit.pop_back();
       continue;
@@ -175,21 +316,34 @@ BvPropSolver::register_assertion(const Node& assertion,
 
     if (inserted)
     {
-      if (!BvSolver::is_leaf(cur))
+      if (!is_leaf(cur))
       {
         visit.insert(visit.end(), cur.begin(), cur.end());
       }
     }
     else if (it->second)
     {
-      it->second      = false;
-      d_node_map[cur] = mk_node(cur);
+      it->second = false;
+      // Nodes registered in a popped scope are already mapped.
+      if (d_node_map.find(cur) == d_node_map.end())
+      {
+        d_node_map[cur] = mk_node(cur);
+      }
+      d_registered.insert(cur);
+      if (is_leaf(cur))
+      {
+        d_leaves.push_back(cur);
+        if (d_use_fp && is_fp_unsupported(cur))
+        {
+          d_fp_unsupported = true;
+        }
+      }
       visit.pop_back();
     }
   } while (!visit.empty());
 
   uint64_t id = d_node_map.at(assertion);
-  d_ls->register_root(id, top_level);
+  register_ls_root(id, top_level);
   // Reverse map assertions for unsat cores.
   d_root_id_node_map[id] = assertion;
 }
@@ -204,20 +358,71 @@ BvPropSolver::value(const Node& term)
   {
     return utils::mk_default_value(nm, term.type());
   }
-  const BitVector& value = d_ls->get_assignment(it->second);
-  if (term.type().is_bool())
+  if (d_winner > 0)
+  {
+    sync_portfolio();
+  }
+  const BitVector& value = d_ls[d_winner]->get_assignment(it->second);
+  const Type& type       = term.type();
+  if (type.is_bool())
   {
     return nm.mk_value(value.is_true());
   }
+  if (type.is_rm())
+  {
+    assert(ls::FloatingPointBV::is_rm(value));
+    return nm.mk_value(static_cast<RoundingMode>(value.to_uint64()));
+  }
+  if (type.is_fp())
+  {
+    return nm.mk_value(FloatingPoint(type, value));
+  }
   return nm.mk_value(value);
 }
 
+bool
+BvPropSolver::is_leaf(const Node& term) const
+{
+  if (!d_use_fp)
+  {
+    return BvSolver::is_leaf(term);
+  }
+  if (is_fp_unsupported(term))
+  {
+    return true;
+  }
+  switch (term.kind())
+  {
+    // Floating-point predicates
+    case Kind::FP_EQUAL:
+    case Kind::FP_GEQ:
+    case Kind::FP_GT:
+    case Kind::FP_IS_INF:
+    case Kind::FP_IS_NAN:
+    case Kind::FP_IS_NEG:
+    case Kind::FP_IS_NORMAL:
+    case Kind::FP_IS_POS:
+    case Kind::FP_IS_SUBNORMAL:
+    case Kind::FP_IS_ZERO:
+    case Kind::FP_LEQ:
+    case Kind::FP_LT: return false;
+
+    case Kind::EQUAL: {
+      const Type& type = term[0].type();
+      return !type.is_bool() && !type.is_bv() && !type.is_fp()
+             && !type.is_rm();
+    }
+
+    default: return BvSolver::is_leaf(term);
+  }
+}
+
 void
 BvPropSolver::unsat_core(std::vector<Node>& core) const
 {
   // The LocalSearchBV library can only determine unsat if a single root is
   // false. Hence, the unsat core always consists of one root.
-  auto it = d_root_id_node_map.find(d_ls->get_false_root());
+  auto it = d_root_id_node_map.find(d_ls[d_winner]->get_false_root());
   assert(it != d_root_id_node_map.end());
   core.push_back(it->second);
 }
@@ -227,22 +432,45 @@ BvPropSolver::mk_node(const Node& node)
 {
   util::Timer timer(d_stats.time_mk_node);
 
-  assert(node.type().is_bv() || node.type().is_bool());
+  const Type& type = node.type();
+  assert(type.is_bv() || type.is_bool()
+         || (d_use_fp && (type.is_fp() || type.is_rm())));
 
   uint64_t res  = 0;
-  uint64_t size = node.type().is_bool() ? 1 : node.type().bv_size();
+  uint64_t size = 1;
+  if (type.is_bv())
+  {
+    size = type.bv_size();
+  }
+  else if (type.is_fp())
+  {
+    size = type.fp_exp_size() + type.fp_sig_size();
+  }
+  else if (type.is_rm())
+  {
+    size = ls::FloatingPointBV::s_rm_size;
+  }
 
   BitVectorDomain domain(size);
 
   if (node.is_value())
   {
-    if (node.type().is_bv())
+    if (type.is_bv())
     {
       domain.fix(node.value<BitVector>());
     }
+    else if (type.is_fp())
+    {
+      domain.fix(node.value<FloatingPoint>().as_bv());
+    }
+    else if (type.is_rm())
+    {
+      domain.fix(BitVector::from_ui(
+          size, static_cast<uint64_t>(node.value<RoundingMode>())));
+    }
     else
     {
-      assert(node.type().is_bool());
+      assert(type.is_bool());
       assert(domain.size() == 1);
       domain.fix_bit(0, node.value<bool>());
     }
@@ -276,27 +504,27 @@ BvPropSolver::mk_node(const Node& node)
   {
     case Kind::BV_ADD:
       assert(node.num_children() == 2);
-      res = d_ls->mk_node(bzla::ls::NodeKind::BV_ADD,
-                          domain,
-                          {d_node_map.at(node[0]), d_node_map.at(node[1])},
-                          {},
-                          symbol);
+      res = mk_ls_node(bzla::ls::NodeKind::BV_ADD,
+                       domain,
+                       {d_node_map.at(node[0]), d_node_map.at(node[1])},
+                       {},
+                       symbol);
       break;
     case Kind::BV_AND:
       assert(node.num_children() == 2);
-      res = d_ls->mk_node(bzla::ls::NodeKind::BV_AND,
-                          domain,
-                          {d_node_map.at(node[0]), d_node_map.at(node[1])},
-                          {},
-                          symbol);
+      res = mk_ls_node(bzla::ls::NodeKind::BV_AND,
+                       domain,
+                       {d_node_map.at(node[0]), d_node_map.at(node[1])},
+                       {},
+                       symbol);
       break;
     case Kind::BV_ASHR:
       assert(node.num_children() == 2);
-      res = d_ls->mk_node(bzla::ls::NodeKind::BV_ASHR,
-                          domain,
-                          {d_node_map.at(node[0]), d_node_map.at(node[1])},
-                          {},
-                          symbol);
+      res = mk_ls_node(bzla::ls::NodeKind::BV_ASHR,
+                       domain,
+                       {d_node_map.at(node[0]), d_node_map.at(node[1])},
+                       {},
+                       symbol);
       break;
     case Kind::BV_CONCAT:
       assert(node.num_children() == 2);
@@ -304,165 +532,365 @@ BvPropSolver::mk_node(const Node& node)
         Node child;
         if (d_use_sext && node::utils::is_bv_sext(node, child))
         {
-          res = d_ls->mk_node(bzla::ls::NodeKind::BV_SEXT,
-                              domain,
-                              {d_node_map.at(child)},
-                              {node[0].type().bv_size()},
-                              symbol);
+          res = mk_ls_node(bzla::ls::NodeKind::BV_SEXT,
+                           domain,
+                           {d_node_map.at(child)},
+                           {node[0].type().bv_size()},
+                           symbol);
         }
         else
         {
-          res = d_ls->mk_node(bzla::ls::NodeKind::BV_CONCAT,
-                              domain,
-                              {d_node_map.at(node[0]), d_node_map.at(node[1])},
-                              {},
-                              symbol);
+          res = mk_ls_node(bzla::ls::NodeKind::BV_CONCAT,
+                           domain,
+                           {d_node_map.at(node[0]), d_node_map.at(node[1])},
+                           {},
+                           symbol);
         }
       }
       break;
     case Kind::BV_EXTRACT:
       assert(node.num_children() == 1);
-      res = d_ls->mk_node(bzla::ls::NodeKind::BV_EXTRACT,
-                          domain,
-                          {d_node_map.at(node[0])},
-                          {node.index(0), node.index(1)},
-                          symbol);
+      res = mk_ls_node(bzla::ls::NodeKind::BV_EXTRACT,
+                       domain,
+                       {d_node_map.at(node[0])},
+                       {node.index(0), node.index(1)},
+                       symbol);
       break;
     case Kind::BV_MUL:
       assert(node.num_children() == 2);
-      res = d_ls->mk_node(bzla::ls::NodeKind::BV_MUL,
-                          domain,
-                          {d_node_map.at(node[0]), d_node_map.at(node[1])},
-                          {},
-                          symbol);
+      res = mk_ls_node(bzla::ls::NodeKind::BV_MUL,
+                       domain,
+                       {d_node_map.at(node[0]), d_node_map.at(node[1])},
+                       {},
+                       symbol);
       break;
     case Kind::BV_NOT:
       assert(node.num_children() == 1);
-      res = d_ls->mk_node(bzla::ls::NodeKind::BV_NOT,
-                          domain,
-                          {d_node_map.at(node[0])},
-                          {},
-                          symbol);
+      res = mk_ls_node(bzla::ls::NodeKind::BV_NOT,
+                       domain,
+                       {d_node_map.at(node[0])},
+                       {},
+                       symbol);
       break;
     case Kind::BV_ULT:
       assert(node.num_children() == 2);
-      res = d_ls->mk_node(bzla::ls::NodeKind::BV_ULT,
-                          domain,
-                          {d_node_map.at(node[0]), d_node_map.at(node[1])},
-                          {},
-                          symbol);
+      res = mk_ls_node(bzla::ls::NodeKind::BV_ULT,
+                       domain,
+                       {d_node_map.at(node[0]), d_node_map.at(node[1])},
+                       {},
+                       symbol);
       break;
     case Kind::BV_SHL:
       assert(node.num_children() == 2);
-      res = d_ls->mk_node(bzla::ls::NodeKind::BV_SHL,
-                          domain,
-                          {d_node_map.at(node[0]), d_node_map.at(node[1])},
-                          {},
-                          symbol);
+      res = mk_ls_node(bzla::ls::NodeKind::BV_SHL,
+                       domain,
+                       {d_node_map.at(node[0]), d_node_map.at(node[1])},
+                       {},
+                       symbol);
       break;
     case Kind::BV_SLT:
       assert(node.num_children() == 2);
-      res = d_ls->mk_node(bzla::ls::NodeKind::BV_SLT,
-                          domain,
-                          {d_node_map.at(node[0]), d_node_map.at(node[1])},
-                          {},
-                          symbol);
+      res = mk_ls_node(bzla::ls::NodeKind::BV_SLT,
+                       domain,
+                       {d_node_map.at(node[0]), d_node_map.at(node[1])},
+                       {},
+                       symbol);
       break;
     case Kind::BV_SHR:
       assert(node.num_children() == 2);
-      res = d_ls->mk_node(bzla::ls::NodeKind::BV_SHR,
-                          domain,
-                          {d_node_map.at(node[0]), d_node_map.at(node[1])},
-                          {},
-                          symbol);
+      res = mk_ls_node(bzla::ls::NodeKind::BV_SHR,
+                       domain,
+                       {d_node_map.at(node[0]), d_node_map.at(node[1])},
+                       {},
+                       symbol);
       break;
     case Kind::BV_UDIV:
       assert(node.num_children() == 2);
-      res = d_ls->mk_node(bzla::ls::NodeKind::BV_UDIV,
-                          domain,
-                          {d_node_map.at(node[0]), d_node_map.at(node[1])},
-                          {},
-                          symbol);
+      res = mk_ls_node(bzla::ls::NodeKind::BV_UDIV,
+                       domain,
+                       {d_node_map.at(node[0]), d_node_map.at(node[1])},
+                       {},
+                       symbol);
       break;
     case Kind::BV_UREM:
       assert(node.num_children() == 2);
-      res = d_ls->mk_node(bzla::ls::NodeKind::BV_UREM,
-                          domain,
-                          {d_node_map.at(node[0]), d_node_map.at(node[1])},
-                          {},
-                          symbol);
+      res = mk_ls_node(bzla::ls::NodeKind::BV_UREM,
+                       domain,
+                       {d_node_map.at(node[0]), d_node_map.at(node[1])},
+                       {},
+                       symbol);
       break;
     case Kind::BV_XOR:
       assert(node.num_children() == 2);
-      res = d_ls->mk_node(bzla::ls::NodeKind::BV_XOR,
-                          domain,
-                          {d_node_map.at(node[0]), d_node_map.at(node[1])},
-                          {},
-                          symbol);
+      res = mk_ls_node(bzla::ls::NodeKind::BV_XOR,
+                       domain,
+                       {d_node_map.at(node[0]), d_node_map.at(node[1])},
+                       {},
+                       symbol);
       break;
     case Kind::AND:
       assert(node.num_children() == 2);
-      res = d_ls->mk_node(bzla::ls::NodeKind::AND,
-                          domain,
-                          {d_node_map.at(node[0]), d_node_map.at(node[1])},
-                          {},
-                          symbol);
+      res = mk_ls_node(bzla::ls::NodeKind::AND,
+                       domain,
+                       {d_node_map.at(node[0]), d_node_map.at(node[1])},
+                       {},
+                       symbol);
       break;
     case Kind::BV_COMP:
     case Kind::EQUAL:
       assert(node.num_children() == 2);
-      if (BvSolver::is_leaf(node))
+      if (is_leaf(node))
+      {
+        res = mk_ls_node(domain.lo(), domain, symbol);
+      }
+      else if (node[0].type().is_fp() || node[0].type().is_rm())
       {
-        res = d_ls->mk_node(domain.lo(), domain, symbol);
+        res = mk_fp_node(node, domain, symbol);
       }
       else
       {
-        res = d_ls->mk_node(bzla::ls::NodeKind::EQ,
-                            domain,
-                            {d_node_map.at(node[0]), d_node_map.at(node[1])},
-                            {},
-                            symbol);
+        res = mk_ls_node(bzla::ls::NodeKind::EQ,
+                         domain,
+                         {d_node_map.at(node[0]), d_node_map.at(node[1])},
+                         {},
+                         symbol);
       }
       break;
     case Kind::ITE:
       assert(node.num_children() == 3);
-      res = d_ls->mk_node(bzla::ls::NodeKind::ITE,
-                          domain,
-                          {d_node_map.at(node[0]),
-                           d_node_map.at(node[1]),
-                           d_node_map.at(node[2])},
-                          {},
-                          symbol);
+      res = mk_ls_node(bzla::ls::NodeKind::ITE,
+                       domain,
+                       {d_node_map.at(node[0]),
+                        d_node_map.at(node[1]),
+                        d_node_map.at(node[2])},
+                       {},
+                       symbol);
       break;
     case Kind::NOT:
       assert(node.num_children() == 1);
-      res = d_ls->mk_node(bzla::ls::NodeKind::NOT,
-                          domain,
-                          {d_node_map.at(node[0])},
-                          {},
-                          symbol);
+      res = mk_ls_node(bzla::ls::NodeKind::NOT,
+                       domain,
+                       {d_node_map.at(node[0])},
+                       {},
+                       symbol);
       break;
     default:
-      assert(BvSolver::is_leaf(node));
-      res = d_ls->mk_node(domain.lo(), domain, symbol);
+      if (!is_leaf(node))
+      {
+        res = mk_fp_node(node, domain, symbol);
+        break;
+      }
+      res = mk_ls_node(domain.lo(), domain, symbol);
+      if (d_use_fp && type.is_rm() && !node.is_value())
+      {
+        // Restrict rounding mode leaves to valid rounding modes. This
+        // constraint is independent of the current assertion level.
+        uint64_t num_rm = static_cast<uint64_t>(RoundingMode::NUM_RM);
+        BitVector max   = BitVector::from_ui(size, num_rm);
+        uint64_t id_max = mk_ls_node(max, BitVectorDomain(max), symbol);
+        uint64_t ult    = mk_ls_node(bzla::ls::NodeKind::BV_ULT,
+                                     BitVectorDomain(1),
+                                     {res, id_max},
+                                     {},
+                                     symbol);
+        register_ls_root(ult, true);
+      }
+  }
+
+  return res;
+}
+
+uint64_t
+BvPropSolver::mk_fp_node(const Node& node,
+                         const BitVectorDomain& domain,
+                         const std::string& symbol)
+{
+  assert(d_use_fp);
+  assert(!is_leaf(node));
+
+  const Type& type = node.type();
+  std::vector<uint64_t> children;
+  for (const Node& child : node)
+  {
+    children.push_back(d_node_map.at(child));
+  }
+  // Indices are the format of the result of operators and of the (last)
+  // operand of predicates, empty for equalities over rounding modes.
+  const Type& fp_type =
+      type.is_fp() ? type : node[node.num_children() - 1].type();
+  std::vector<uint64_t> indices;
+  if (fp_type.is_fp())
+  {
+    indices = {fp_type.fp_exp_size(), fp_type.fp_sig_size()};
+  }
+
+  bzla::ls::NodeKind kind;
+  switch (node.kind())
+  {
+    case Kind::EQUAL:
+      assert(node[0].type().is_fp() || node[0].type().is_rm());
+      kind = node[0].type().is_rm() ? bzla::ls::NodeKind::EQ
+                                    : bzla::ls::NodeKind::FP_EQ;
+      break;
+    case Kind::FP_ABS: kind = bzla::ls::NodeKind::FP_ABS; break;
+    case Kind::FP_ADD: kind = bzla::ls::NodeKind::FP_ADD; break;
+    case Kind::FP_DIV: kind = bzla::ls::NodeKind::FP_DIV; break;
+    case Kind::FP_EQUAL: kind = bzla::ls::NodeKind::FP_EQUAL; break;
+    case Kind::FP_IS_INF: kind = bzla::ls::NodeKind::FP_IS_INF; break;
+    case Kind::FP_IS_NAN: kind = bzla::ls::NodeKind::FP_IS_NAN; break;
+    case Kind::FP_IS_NEG: kind = bzla::ls::NodeKind::FP_IS_NEG; break;
+    case Kind::FP_IS_NORMAL: kind = bzla::ls::NodeKind::FP_IS_NORMAL; break;
+    case Kind::FP_IS_POS: kind = bzla::ls::NodeKind::FP_IS_POS; break;
+    case Kind::FP_IS_SUBNORMAL:
+      kind = bzla::ls::NodeKind::FP_IS_SUBNORMAL;
+      break;
+    case Kind::FP_IS_ZERO: kind = bzla::ls::NodeKind::FP_IS_ZERO; break;
+    case Kind::FP_LEQ: kind = bzla::ls::NodeKind::FP_LEQ; break;
+    case Kind::FP_LT: kind = bzla::ls::NodeKind::FP_LT; break;
+    case Kind::FP_MUL: kind = bzla::ls::NodeKind::FP_MUL; break;
+    case Kind::FP_NEG: kind = bzla::ls::NodeKind::FP_NEG; break;
+    case Kind::FP_TO_FP_FROM_SBV:
+      kind = bzla::ls::NodeKind::FP_TO_FP_FROM_SBV;
+      break;
+    case Kind::FP_TO_FP_FROM_UBV:
+      kind = bzla::ls::NodeKind::FP_TO_FP_FROM_UBV;
+      break;
+
+    case Kind::FP_GEQ:
+    case Kind::FP_GT:
+      // x >= y is y <= x, x > y is y < x
+      assert(children.size() == 2);
+      std::swap(children[0], children[1]);
+      kind = node.kind() == Kind::FP_GEQ ? bzla::ls::NodeKind::FP_LEQ
+                                         : bzla::ls::NodeKind::FP_LT;
+      break;
+
+    case Kind::FP_SUB:
+      // x - y is x + (-y)
+      assert(children.size() == 3);
+      children[2] = mk_ls_node(bzla::ls::NodeKind::FP_NEG,
+                               BitVectorDomain(domain.size()),
+                               {children[2]},
+                               indices,
+                               symbol);
+      kind        = bzla::ls::NodeKind::FP_ADD;
+      break;
+
+    case Kind::FP_TO_FP_FROM_FP: {
+      const Type& src_type = node[1].type();
+      indices.push_back(src_type.fp_exp_size());
+      indices.push_back(src_type.fp_sig_size());
+      kind = bzla::ls::NodeKind::FP_TO_FP_FROM_FP;
+    }
+    break;
+
+    case Kind::FP_TO_FP_FROM_BV:
+      // Reinterpretation of the IEEE bit-vector representation.
+      assert(children.size() == 1);
+      return children[0];
+
+    case Kind::FP_FP: {
+      // Concatenation of sign bit, exponent and trailing significand.
+      assert(children.size() == 3);
+      uint64_t size = 1 + node[1].type().bv_size();
+      uint64_t id   = mk_ls_node(bzla::ls::NodeKind::BV_CONCAT,
+                                 BitVectorDomain(size),
+                                 {children[0], children[1]},
+                                 {},
+                                 symbol);
+      return mk_ls_node(
+          bzla::ls::NodeKind::BV_CONCAT, domain, {id, children[2]}, {}, symbol);
+    }
+
+    default: assert(false); return 0;
   }
+  return mk_ls_node(kind, domain, children, indices, symbol);
+}
 
+uint64_t
+BvPropSolver::mk_ls_node(bzla::ls::NodeKind kind,
+                         const BitVectorDomain& domain,
+                         const std::vector<uint64_t>& children,
+                         const std::vector<uint64_t>& indices,
+                         const std::string& symbol)
+{
+  uint64_t res = d_ls[0]->mk_node(kind, domain, children, indices, symbol);
+  if (d_ls.size() > 1)
+  {
+    d_pending.emplace_back([=](bzla::ls::LocalSearchBV& ls) {
+      uint64_t id = ls.mk_node(kind, domain, children, indices, symbol);
+      assert(id == res);
+      (void) id;
+    });
+  }
   return res;
 }
 
+uint64_t
+BvPropSolver::mk_ls_node(const BitVector& assignment,
+                         const BitVectorDomain& domain,
+                         const std::string& symbol)
+{
+  uint64_t res = d_ls[0]->mk_node(assignment, domain, symbol);
+  if (d_ls.size() > 1)
+  {
+    d_pending.emplace_back([=](bzla::ls::LocalSearchBV& ls) {
+      uint64_t id = ls.mk_node(assignment, domain, symbol);
+      assert(id == res);
+      (void) id;
+    });
+  }
+  return res;
+}
+
+void
+BvPropSolver::register_ls_root(uint64_t id, bool fixed)
+{
+  d_ls[0]->register_root(id, fixed);
+  if (d_ls.size() > 1)
+  {
+    d_pending.emplace_back(
+        [=](bzla::ls::LocalSearchBV& ls) { ls.register_root(id, fixed); });
+  }
+}
+
+void
+BvPropSolver::sync_portfolio()
+{
+  if (d_pending.empty())
+  {
+    return;
+  }
+  std::vector<std::thread> threads;
+  for (size_t i = 1, n = d_ls.size(); i < n; ++i)
+  {
+    threads.emplace_back([this, i]() {
+      for (const auto& op : d_pending)
+      {
+        op(*d_ls[i]);
+      }
+    });
+  }
+  for (auto& t : threads)
+  {
+    t.join();
+  }
+  d_pending.clear();
+}
+
 void
-BvPropSolver::print_progress() const
+BvPropSolver::print_progress(const bzla::ls::LocalSearchBV& ls) const
 {
   if (d_logger.is_msg_enabled(2))
   {
-    size_t nroots_sat   = d_ls->get_num_roots_sat();
-    size_t nroots_total = d_ls->get_num_roots();
+    size_t nroots_sat   = ls.get_num_roots_sat();
+    size_t nroots_total = ls.get_num_roots();
     double perc_sat     = static_cast<double>(nroots_sat) / nroots_total * 100;
     Msg(1) << nroots_sat << "/" << nroots_total << " roots satisfied ("
            << std::setprecision(3) << perc_sat
-           << "%), moves: " << d_ls->num_moves()
-           << ", propagation steps: " << d_ls->num_props()
-           << ", updates: " << d_ls->num_updates();
+           << "%), moves: " << ls.num_moves()
+           << ", propagation steps: " << ls.num_props()
+           << ", updates: " << ls.num_updates();
   }
 }
 
@@ -472,6 +900,12 @@ BvPropSolver::Statistics::Statistics(util::Statistics& stats,
       num_assertions(stats.new_stat<uint64_t>(prefix + "num_assertions")),
       num_bits_fixed(stats.new_stat<uint64_t>(prefix + "num_bits_fixed")),
       num_bits_total(stats.new_stat<uint64_t>(prefix + "num_bits_total")),
+      num_portfolio_moves(
+          stats.new_stat<uint64_t>(prefix + "portfolio::num_moves")),
+      num_portfolio_props(
+          stats.new_stat<uint64_t>(prefix + "portfolio::num_props")),
+      num_portfolio_updates(
+          stats.new_stat<uint64_t>(prefix + "portfolio::num_updates")),
       time_mk_node(
           stats.new_stat<util::TimerStatistic>(prefix + "time_mk_node")),
       time_check(stats.new_stat<util::TimerStatistic>(prefix + "time_check"))
@@ -11,9 +11,15 @@
 #ifndef BZLA_SOLVER_BV_BV_PROP_SOLVER_H_INCLUDED
 #define BZLA_SOLVER_BV_BV_PROP_SOLVER_H_INCLUDED
 
+#include <functional>
+
 #include "backtrack/assertion_stack.h"
 #include "backtrack/backtrackable.h"
+#include "backtrack/object.h"
+#include "backtrack/unordered_set.h"
+#include "backtrack/vector.h"
 #include "ls/ls_bv.h"
+#include "node/node_id_map.h"
 #include "node/node_ref_vector.h"
 #include "solver/bv/bv_bitblast_solver.h"
 #include "solver/bv/bv_solver_interface.h"
@@ -33,6 +39,14 @@ class BvPropSolver : public Solver, public BvSolverInterface
 
   Result solve() override;
 
+  /**
+   * Solve with given terminator instead of the terminator of the environment.
+   * Does not create or access any nodes and can thus be run on a separate
+   * thread.
+   * @param terminator The terminator to check for termination, may be null.
+   */
+  Result solve(Terminator* terminator);
+
   void register_assertion(const Node& assertion,
                           bool top_level,
                           bool is_lemma) override;
@@ -42,18 +56,48 @@ class BvPropSolver : public Solver, public BvSolverInterface
   /** Get unsat core of last solve() call. */
   void unsat_core(std::vector<Node>& core) const override;
 
+  /**
+   * Determine if given term is a leaf node for the local search engines.
+   * If floating-point operators are handled natively (option prop_fp), this
+   * excludes floating-point terms and predicates with operators that are
+   * supported by the local search engines. Else, this is equivalent to
+   * BvSolver::is_leaf().
+   * @param term The term to query.
+   * @return True if `term` is a leaf.
+   */
+  bool is_leaf(const Node& term) const;
+
+  /** @return The leaves of all registered assertions. */
+  const backtrack::vector<Node>& leaves() const { return d_leaves; }
+
  private:
-  /** Backtrack manager to sync push/pop with local search engine. */
+  using LsInstances = std::vector<std::unique_ptr<bzla::ls::LocalSearchBV>>;
+
+  /** Backtrack manager to sync push/pop with local search engines. */
   class LsBacktrack : public backtrack::Backtrackable
   {
    public:
-    LsBacktrack(backtrack::BacktrackManager* mgr, bzla::ls::LocalSearchBV* ls)
-        : Backtrackable(mgr), d_ls(ls)
+    LsBacktrack(backtrack::BacktrackManager* mgr, BvPropSolver* solver)
+        : Backtrackable(mgr), d_solver(solver)
     {
     }
-    void push() override { d_ls->push(); }
-    void pop() override { d_ls->pop(); }
-    bzla::ls::LocalSearchBV* d_ls = nullptr;
+    void push() override
+    {
+      d_solver->sync_portfolio();
+      for (auto& ls : d_solver->d_ls)
+      {
+        ls->push();
+      }
+    }
+    void pop() override
+    {
+      d_solver->sync_portfolio();
+      for (auto& ls : d_solver->d_ls)
+      {
+        ls->pop();
+      }
+    }
+    BvPropSolver* d_solver = nullptr;
   };
 
   /**
@@ -63,11 +107,58 @@ class BvPropSolver : public Solver, public BvSolverInterface
    * @return The id of the created LS bit-vector node.
    */
   uint64_t mk_node(const Node& node);
+  /**
+   * Helper for mk_node() to create the LocalSearchBV node representation of
+   * a floating-point operator or predicate. Floating-point and rounding mode
+   * values are represented as bit-vectors, see ls::FloatingPointBV.
+   * @param node The floating-point term or predicate, must not be a leaf.
+   * @param domain The domain of the node.
+   * @param symbol The symbol of the node.
+   * @return The id of the created LS bit-vector node.
+   */
+  uint64_t mk_fp_node(const Node& node,
+                      const BitVectorDomain& domain,
+                      const std::string& symbol);
+  /**
+   * Create LocalSearchBV node in all local search engines.
+   * @return The id of the created node, which is the same in all engines.
+   */
+  uint64_t mk_ls_node(bzla::ls::NodeKind kind,
+                      const BitVectorDomain& domain,
+                      const std::vector<uint64_t>& children,
+                      const std::vector<uint64_t>& indices,
+                      const std::string& symbol);
+  /**
+   * Create LocalSearchBV leaf node in all local search engines.
+   * @return The id of the created node, which is the same in all engines.
+   */
+  uint64_t mk_ls_node(const BitVector& assignment,
+                      const BitVectorDomain& domain,
+                      const std::string& symbol);
+  /**
+   * Register root in all local search engines.
+   * @param id    The id of the root.
+   * @param fixed True if this is a top-level (assertion level 0) root.
+   */
+  void register_ls_root(uint64_t id, bool fixed);
+  /**
+   * Replay the pending operations (see `d_pending`) on the local search
+   * engines other than the first, concurrently on one thread per engine.
+   */
+  void sync_portfolio();
+
+  /**
+   * Run local search engine with given index until it determines an answer,
+   * reaches its limits or is terminated.
+   * @param idx The index of the engine in `d_ls`.
+   * @param terminator The terminator to check for termination, may be null.
+   */
+  Result run(size_t idx, Terminator* terminator);
 
   /**
-   * Print current progress of LocalSearchBV.
+   * Print current progress of given LocalSearchBV engine.
    */
-  void print_progress() const;
+  void print_progress(const bzla::ls::LocalSearchBV& ls) const;
 
   /**
    * The associated bit-blasting solver, for bit-blasting to determine
@@ -75,18 +166,48 @@ class BvPropSolver : public Solver, public BvSolverInterface
    * to avoid redundant bit-blasting work.
    */
   BvBitblastSolver& d_bb_solver;
-  /** The local search engine. */
-  std::unique_ptr<bzla::ls::LocalSearchBV> d_ls;
-  /** The backtrack manager for the local search engine. */
+  /**
+   * The local search engines. All engines maintain the same nodes and roots,
+   * but use different seeds and configurations. If the portfolio is disabled,
+   * this contains a single engine.
+   */
+  LsInstances d_ls;
+  /**
+   * Nodes and roots are created in the first engine immediately and recorded
+   * here for the other engines of the portfolio, which are only synced
+   * before solving and on push/pop. This builds the (independent) graphs of
+   * the engines concurrently rather than one after the other.
+   */
+  std::vector<std::function<void(bzla::ls::LocalSearchBV&)>> d_pending;
+  /** The index of the engine that determined the answer of the last call. */
+  size_t d_winner = 0;
+  /** The backtrack manager for the local search engines. */
   LsBacktrack d_ls_backtrack;
   /** Map Bitwuzla node to LocalSearchBV bit-vector node id. */
-  std::unordered_map<Node, uint64_t> d_node_map;
+  node::NodeIdMap<uint64_t> d_node_map;
+  /**
+   * The nodes reachable from the assertions registered in the current scope.
+   * Nodes (and their local search representation) in `d_node_map` persist on
+   * pop, this determines which of them still need to be visited to collect
+   * the leaves of an assertion.
+   */
+  backtrack::unordered_set<Node> d_registered;
+  /** The leaves of the assertions registered in the current scope. */
+  backtrack::vector<Node> d_leaves;
   /** Map LocalSearchBV root id to Bitwuzla node for unsat cores. */
   std::unordered_map<uint64_t, Node> d_root_id_node_map;
   /** True to enable constant bits propagation. */
   bool d_use_const_bits = false;
   /** True to use sign_extend nodes for concats that represent sign_extends. */
   bool d_use_sext = false;
+  /** True to handle floating-point operators natively. */
+  bool d_use_fp = false;
+  /**
+   * True if a floating-point operator that is not supported natively occurs
+   * in the assertions of the current scope. Such terms are treated as leaves,
+   * hence satisfying assignments found by local search may not be models.
+   */
+  backtrack::object<bool> d_fp_unsupported;
 
   struct Statistics
   {
@@ -95,6 +216,9 @@ class BvPropSolver : public Solver, public BvSolverInterface
     uint64_t& num_assertions;
     uint64_t& num_bits_fixed;
     uint64_t& num_bits_total;
+    uint64_t& num_portfolio_moves;
+    uint64_t& num_portfolio_props;
+    uint64_t& num_portfolio_updates;
     util::TimerStatistic& time_mk_node;
     util::TimerStatistic& time_check;
   } d_stats;
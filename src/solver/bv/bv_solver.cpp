@@ -10,12 +10,15 @@
 
 #include "solver/bv/bv_solver.h"
 
+#include <thread>
+
 #include "bv/bitvector.h"
 #include "env.h"
 #include "node/node_manager.h"
 #include "node/node_ref_vector.h"
 #include "node/unordered_node_ref_map.h"
 #include "solver/bv/bv_bitblast_solver.h"
+#include "solver/bv/race_terminator.h"
 #include "solving_context.h"
 
 namespace bzla::bv {
@@ -103,11 +106,17 @@ BvSolver::solve()
       d_sat_state = d_prop_solver.solve();
       break;
     case option::BvSolver::PREPROP:
+      if (d_env.options().preprop_parallel())
+      {
+        d_sat_state = solve_parallel();
+        break;
+      }
       d_cur_solver = option::BvSolver::PROP;
       d_sat_state  = d_prop_solver.solve();
       if (d_sat_state == Result::UNKNOWN)
       {
         d_cur_solver = option::BvSolver::BITBLAST;
+        warm_start_bitblast();
         d_sat_state = d_bitblast_solver.solve();
       }
       break;
@@ -120,7 +129,10 @@ Node
 BvSolver::value(const Node& term)
 {
   assert(is_leaf(term));
-  assert(term.type().is_bool() || term.type().is_bv());
+  // Floating-point values are only queried if the prop solver handles
+  // floating-point terms natively.
+  assert(term.type().is_bool() || term.type().is_bv()
+         || d_cur_solver == option::BvSolver::PROP);
   if (d_cur_solver == option::BvSolver::BITBLAST)
   {
     return d_bitblast_solver.value(term);
@@ -145,9 +157,66 @@ BvSolver::unsat_core(std::vector<Node>& core) const
 
 /* --- BvBitblastSolver private --------------------------------------------- */
 
+Result
+BvSolver::solve_parallel()
+{
+  RaceTerminator terminator(d_env.terminator());
+
+  // Seed the phases before local search starts modifying its assignment,
+  // which at this point corresponds to the model of the previous call.
+  warm_start_bitblast();
+
+  // Local search does not create or access any nodes and can thus safely run
+  // on a separate thread. Bit-blasting and CNF encoding require the node
+  // manager and run on the calling thread.
+  Result prop_result = Result::UNKNOWN;
+  bool prop_won      = false;
+  std::thread prop_thread([&]() {
+    prop_result = d_prop_solver.solve(&terminator);
+    prop_won    = terminator.finish(prop_result);
+  });
+  Result bb_result = d_bitblast_solver.solve(&terminator);
+  bool bb_won      = terminator.finish(bb_result);
+  prop_thread.join();
+
+  if (prop_won)
+  {
+    ++d_stats.num_preprop_prop;
+    d_cur_solver = option::BvSolver::PROP;
+    return prop_result;
+  }
+  d_cur_solver = option::BvSolver::BITBLAST;
+  if (bb_won)
+  {
+    ++d_stats.num_preprop_bitblast;
+  }
+  return bb_result;
+}
+
+void
+BvSolver::warm_start_bitblast()
+{
+  if (!d_env.options().preprop_warm_start())
+  {
+    return;
+  }
+  for (const Node& leaf : d_prop_solver.leaves())
+  {
+    const Type& type = leaf.type();
+    if (type.is_bool() || type.is_bv())
+    {
+      d_bitblast_solver.phase(leaf, d_prop_solver.value(leaf));
+    }
+  }
+}
+
 BvSolver::Statistics::Statistics(util::Statistics& stats)
     : num_checks(stats.new_stat<uint64_t>("solver::bv::num_checks")),
       num_assertions(stats.new_stat<uint64_t>("solver::bv::num_assertions")),
+      num_preprop_prop(
+          stats.new_stat<uint64_t>("solver::bv::preprop::num_prop_answers")),
+      num_preprop_bitblast(
+          stats.new_stat<uint64_t>("solver::bv::preprop::num_bitblast_answers")),
       time_check(stats.new_stat<util::TimerStatistic>("solver::bv::time_check"))
 {
 }
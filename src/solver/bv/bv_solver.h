@@ -59,6 +59,19 @@ class BvSolver : public Solver, public BvSolverInterface
   option::BvSolver cur_solver() const { return d_cur_solver; }
 
  private:
+  /**
+   * Race propagation-based local search and bit-blasting of the preprop
+   * solver engine on two threads. The subsolver that determines an answer
+   * first terminates the other one and is used for model values and unsat
+   * cores.
+   */
+  Result solve_parallel();
+  /**
+   * Seed the initial phases of the SAT solver of the bitblast subsolver with
+   * the current assignment of the local search subsolver (if enabled).
+   */
+  void warm_start_bitblast();
+
   /** Result of the last check() call. */
   Result d_sat_state = Result::UNKNOWN;
 
@@ -83,6 +96,8 @@ class BvSolver : public Solver, public BvSolverInterface
     Statistics(util::Statistics& stats);
     uint64_t& num_checks;
     uint64_t& num_assertions;
+    uint64_t& num_preprop_prop;
+    uint64_t& num_preprop_bitblast;
     util::TimerStatistic& time_check;
   } d_stats;
 };
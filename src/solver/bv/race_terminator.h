@@ -0,0 +1,67 @@
+/***
+ * Bitwuzla: Satisfiability Modulo Theories (SMT) solver.
+ *
+ * Copyright (C) 2024 by the authors listed in the AUTHORS file at
+ * https://github.com/bitwuzla/bitwuzla/blob/main/AUTHORS
+ *
+ * This file is part of Bitwuzla under the MIT license. See COPYING for more
+ * information at https://github.com/bitwuzla/bitwuzla/blob/main/COPYING
+ */
+
+#ifndef BZLA_SOLVER_BV_RACE_TERMINATOR_H_INCLUDED
+#define BZLA_SOLVER_BV_RACE_TERMINATOR_H_INCLUDED
+
+#include <atomic>
+#include <mutex>
+
+#include "solver/result.h"
+#include "terminator.h"
+
+namespace bzla::bv {
+
+/**
+ * Terminator for racing solvers on multiple threads.
+ * Terminates if one of the solvers already determined an answer or the
+ * given terminator (e.g., the terminator of the environment) terminates.
+ */
+class RaceTerminator : public Terminator
+{
+ public:
+  RaceTerminator(Terminator* terminator) : d_terminator(terminator) {}
+
+  bool terminate() override
+  {
+    if (d_done)
+    {
+      return true;
+    }
+    // The given terminator is not required to be thread-safe.
+    std::lock_guard<std::mutex> lock(d_mutex);
+    return d_terminator && d_terminator->terminate();
+  }
+
+  /**
+   * Record answer of a solver.
+   * @return True if this is the first definite answer.
+   */
+  bool finish(Result res)
+  {
+    if (res == Result::UNKNOWN)
+    {
+      return false;
+    }
+    return !d_done.exchange(true);
+  }
+
+ private:
+  /** The given terminator. */
+  Terminator* d_terminator;
+  /** True if a solver determined an answer. */
+  std::atomic<bool> d_done{false};
+  /** Mutex for calls to `d_terminator`. */
+  std::mutex d_mutex;
+};
+
+}  // namespace bzla::bv
+
+#endif
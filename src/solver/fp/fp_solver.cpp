@@ -16,6 +16,7 @@
 #include "node/node_ref_vector.h"
 #include "node/node_utils.h"
 #include "node/unordered_node_ref_map.h"
+#include "option/option.h"
 #include "rewrite/rewriter.h"
 #include "solver/array/array_solver.h"
 #include "solver/fp/floating_point.h"
@@ -57,6 +58,10 @@ FpSolver::check()
   Log(1) << "*** check fp";
 
   reset_cached_values();
+  if (is_native())
+  {
+    return true;
+  }
   NodeManager& nm = d_env.nm();
   for (size_t i = d_word_blast_index.get(), size = d_word_blast_queue.size();
        i < size;
@@ -125,4 +130,11 @@ FpSolver::register_term(const Node& term)
   d_word_blast_queue.push_back(term);
 }
 
+bool
+FpSolver::is_native() const
+{
+  const option::Options& options = d_env.options();
+  return options.prop_fp() && options.bv_solver() == option::BvSolver::PROP;
+}
+
 }  // namespace bzla::fp
@@ -37,6 +37,15 @@ class FpSolver : public Solver
 
   void register_term(const Node& term) override;
 
+  /**
+   * Determine if floating-point terms are handled natively by the
+   * propagation-based local search engine of the bit-vector solver (option
+   * prop_fp). In this case, terms are not word-blasted and values of
+   * floating-point constants are determined by the bit-vector solver.
+   * @return True if floating-point terms are handled natively.
+   */
+  bool is_native() const;
+
  private:
   /** The word blaster. */
   WordBlaster d_word_blaster;
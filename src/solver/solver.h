@@ -14,6 +14,7 @@
 #include <unordered_map>
 
 #include "node/node.h"
+#include "node/node_id_map.h"
 #include "solver/result.h"
 #include "solver/solver_state.h"
 
@@ -78,7 +79,7 @@ class Solver
 
  private:
   /** Cache to store computed values. */
-  std::unordered_map<Node, Node> d_value_cache;
+  node::NodeIdMap<Node> d_value_cache;
 };
 
 }  // namespace bzla
@@ -505,7 +505,8 @@ SolverEngine::_value(const Node& term)
           }
           else if (type.is_rm() || type.is_fp())
           {
-            value = d_fp_solver.value(cur);
+            value = d_fp_solver.is_native() ? d_bv_solver.value(cur)
+                                            : d_fp_solver.value(cur);
           }
           else if (type.is_fun() || type.is_uninterpreted())
           {
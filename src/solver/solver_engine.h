@@ -16,6 +16,7 @@
 #include "backtrack/pop_callback.h"
 #include "backtrack/unordered_set.h"
 #include "node/node.h"
+#include "node/node_id_map.h"
 #include "rewrite/rewriter.h"
 #include "solver/array/array_solver.h"
 #include "solver/bv/bv_solver.h"
@@ -144,7 +145,7 @@ class SolverEngine
   uint64_t d_num_printed_stats = 0;
 
   /** Model value cache for _value(). */
-  std::unordered_map<Node, Node> d_value_cache;
+  node::NodeIdMap<Node> d_value_cache;
 
   /** Associated solving context. */
   SolvingContext& d_context;
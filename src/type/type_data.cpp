@@ -162,15 +162,45 @@ TypeData::get_fp_sig_size() const
 void
 TypeData::inc_ref()
 {
-  ++d_refs;
+  if (d_mgr->d_thread_safe)
+  {
+    d_refs.fetch_add(1, std::memory_order_relaxed);
+  }
+  else
+  {
+    d_refs.store(d_refs.load(std::memory_order_relaxed) + 1,
+                 std::memory_order_relaxed);
+  }
 }
 
 void
 TypeData::dec_ref()
 {
-  assert(d_refs > 0);
-  --d_refs;
-  if (d_refs == 0)
+  uint32_t refs = d_refs.load(std::memory_order_relaxed);
+  assert(refs > 0);
+  if (d_mgr->d_thread_safe)
+  {
+    // Fast path: reference count does not drop to zero, no lock required.
+    while (refs > 1)
+    {
+      if (d_refs.compare_exchange_weak(
+              refs, refs - 1, std::memory_order_acq_rel))
+      {
+        return;
+      }
+    }
+    // Note: Dropping the reference count to zero must happen while holding
+    //       the lock to prevent concurrent lookups from resurrecting this
+    //       type data while it is garbage collected.
+    std::lock_guard<std::recursive_mutex> guard(d_mgr->d_mutex);
+    if (d_refs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+    {
+      d_mgr->garbage_collect(this);
+    }
+    return;
+  }
+  d_refs.store(refs - 1, std::memory_order_relaxed);
+  if (refs == 1)
   {
     d_mgr->garbage_collect(this);
   }
@@ -12,6 +12,7 @@
 #define BZLA_TYPE_TYPE_DATA_H_INCLUDED
 
 #include <array>
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
 #include <optional>
@@ -117,7 +118,7 @@ class TypeData
   /** Type kind. */
   Kind d_kind;
   /** Reference count. */
-  uint32_t d_refs = 0;
+  std::atomic<uint32_t> d_refs = 0;
 
   /**
    * Variant that either stores the
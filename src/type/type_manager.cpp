@@ -20,6 +20,8 @@ namespace bzla::type {
 
 /* --- TypeManager public -------------------------------------------------- */
 
+TypeManager::TypeManager(bool thread_safe) : d_thread_safe(thread_safe) {}
+
 TypeManager::~TypeManager()
 {
   // Cleanup remaining types without triggering garbage_collect().
@@ -48,24 +50,28 @@ TypeManager::~TypeManager()
 Type
 TypeManager::mk_bool_type()
 {
+  auto guard = lock();
   return Type(find_or_create_type(TypeData::Kind::BOOL));
 }
 
 Type
 TypeManager::mk_bv_type(uint64_t size)
 {
+  auto guard = lock();
   return Type(find_or_create_bv_type(size));
 }
 
 Type
 TypeManager::mk_fp_type(uint64_t exp_size, uint64_t sig_size)
 {
+  auto guard = lock();
   return Type(find_or_create_fp_type(exp_size, sig_size));
 }
 
 Type
 TypeManager::mk_rm_type()
 {
+  auto guard = lock();
   return Type(find_or_create_type(TypeData::Kind::RM));
 }
 
@@ -74,6 +80,7 @@ TypeManager::mk_array_type(const Type& index, const Type& elem)
 {
   assert(index.tm() == this);
   assert(elem.tm() == this);
+  auto guard = lock();
   return Type(find_or_create_type(TypeData::Kind::ARRAY, {index, elem}));
 }
 
@@ -82,12 +89,14 @@ TypeManager::mk_fun_type(const std::vector<Type>& types)
 {
   assert(std::all_of(
       types.begin(), types.end(), [this](auto& c) { return c.tm() == this; }));
+  auto guard = lock();
   return Type(find_or_create_type(TypeData::Kind::FUN, types));
 }
 
 Type
 TypeManager::mk_uninterpreted_type(const std::optional<std::string>& symbol)
 {
+  auto guard     = lock();
   TypeData* data = new TypeData(this, symbol);
   init_id(data);
   return data;
@@ -175,9 +184,9 @@ TypeManager::garbage_collect(TypeData* data)
         // Manually decrement reference count to not trigger decrement of
         // TypeData reference. This will avoid recursive call to
         // garbage_collect().
-        --d->d_refs;
-        t.d_data = nullptr;
-        if (d->d_refs == 0)
+        uint32_t refs = d->d_refs.fetch_sub(1, std::memory_order_acq_rel) - 1;
+        t.d_data      = nullptr;
+        if (refs == 0)
         {
           visit.push_back(d);
         }
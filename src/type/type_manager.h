@@ -12,6 +12,7 @@
 #define BZLA_TYPE_TYPE_MANAGER_H_INCLUDED
 
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <unordered_set>
 #include <vector>
@@ -29,6 +30,12 @@ class TypeManager
   friend TypeData;
 
  public:
+  /**
+   * Constructor.
+   * @param thread_safe True to allow creating and releasing types from
+   *                    multiple threads concurrently.
+   */
+  explicit TypeManager(bool thread_safe = false);
   ~TypeManager();
 
   /**
@@ -111,6 +118,28 @@ class TypeManager
    */
   void garbage_collect(TypeData* d);
 
+  /**
+   * @return A lock for d_mutex, which is only acquired if the type manager is
+   *         in thread-safe mode.
+   */
+  std::unique_lock<std::recursive_mutex> lock()
+  {
+    return d_thread_safe ? std::unique_lock<std::recursive_mutex>(d_mutex)
+                         : std::unique_lock<std::recursive_mutex>();
+  }
+
+  /** True if this type manager may be used from multiple threads. */
+  const bool d_thread_safe;
+
+  /**
+   * Lock for type creation and garbage collection in thread-safe mode.
+   *
+   * @note Recursive since releasing type data while holding the lock (e.g.,
+   *       duplicate type data in find_or_create()) may trigger garbage
+   *       collection.
+   */
+  std::recursive_mutex d_mutex;
+
   /** Type id counter. */
   uint64_t d_type_id_counter = 1;
 
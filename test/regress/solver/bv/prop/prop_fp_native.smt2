@@ -0,0 +1,11 @@
+(set-logic QF_FP)
+(set-info :status sat)
+(declare-const x Float32)
+(declare-const y Float32)
+(declare-const r RoundingMode)
+(assert (fp.eq (fp.add r x y) ((_ to_fp 8 24) RNE 3.0)))
+(assert (fp.lt x y))
+(assert (fp.isNormal x))
+(assert (fp.gt (fp.mul RNE x y) ((_ to_fp 8 24) RNE 1.0)))
+(assert (not (fp.isNegative (fp.div RTZ y x))))
+(check-sat)
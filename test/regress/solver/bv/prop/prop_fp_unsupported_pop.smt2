@@ -0,0 +1,9 @@
+(set-logic QF_FP)
+(declare-const x Float32)
+(declare-const y Float32)
+(push 1)
+(assert (fp.eq (fp.sqrt RNE x) ((_ to_fp 8 24) RNE 2.0)))
+(check-sat)
+(pop 1)
+(assert (fp.eq (fp.add RNE x y) ((_ to_fp 8 24) RNE 3.0)))
+(check-sat)
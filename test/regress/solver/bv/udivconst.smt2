@@ -0,0 +1,13 @@
+(set-logic QF_BV)
+(set-info :status unsat)
+(declare-const x (_ BitVec 12))
+(define-fun q () (_ BitVec 12) (bvudiv x (_ bv10 12)))
+(define-fun r () (_ BitVec 12) (bvurem x (_ bv10 12)))
+(assert
+  (not
+    (and (= x (bvadd (bvmul q (_ bv10 12)) r))
+         (bvult r (_ bv10 12))
+         (= (bvudiv x (_ bv8 12)) (bvlshr x (_ bv3 12)))
+         (= (bvurem x (_ bv8 12)) (bvand x (_ bv7 12)))
+         (= (bvudiv (bvlshr x (_ bv6 12)) (_ bv100 12)) (_ bv0 12)))))
+(check-sat)
@@ -341,6 +341,65 @@ TEST_F(TestAigBitblaster, bv_mul4) { TEST_BIN_OP(4, "bvmul", bv_mul); }
 
 TEST_F(TestAigBitblaster, bv_mul8) { TEST_BIN_OP(8, "bvmul", bv_mul); }
 
+#define TEST_MUL_ENC(size, enc)                      \
+  {                                                  \
+    bitblast::AigBitblaster bb;                      \
+    bb.set_mul_encoding(bitblast::MulEncoding::enc); \
+    auto a   = bb.bv_constant(size);                 \
+    auto b   = bb.bv_constant(size);                 \
+    auto res = bb.bv_mul(a, b);                      \
+    test_binary("bvmul", res, a, b);                 \
+  }
+
+TEST_F(TestAigBitblaster, bv_mul_wallace1) { TEST_MUL_ENC(1, WALLACE); }
+
+TEST_F(TestAigBitblaster, bv_mul_wallace3) { TEST_MUL_ENC(3, WALLACE); }
+
+TEST_F(TestAigBitblaster, bv_mul_wallace8) { TEST_MUL_ENC(8, WALLACE); }
+
+TEST_F(TestAigBitblaster, bv_mul_wallace16) { TEST_MUL_ENC(16, WALLACE); }
+
+TEST_F(TestAigBitblaster, bv_mul_dadda1) { TEST_MUL_ENC(1, DADDA); }
+
+TEST_F(TestAigBitblaster, bv_mul_dadda3) { TEST_MUL_ENC(3, DADDA); }
+
+TEST_F(TestAigBitblaster, bv_mul_dadda8) { TEST_MUL_ENC(8, DADDA); }
+
+TEST_F(TestAigBitblaster, bv_mul_dadda16) { TEST_MUL_ENC(16, DADDA); }
+
+TEST_F(TestAigBitblaster, bv_mul_booth1) { TEST_MUL_ENC(1, BOOTH); }
+
+TEST_F(TestAigBitblaster, bv_mul_booth3) { TEST_MUL_ENC(3, BOOTH); }
+
+TEST_F(TestAigBitblaster, bv_mul_booth8) { TEST_MUL_ENC(8, BOOTH); }
+
+TEST_F(TestAigBitblaster, bv_mul_booth16) { TEST_MUL_ENC(16, BOOTH); }
+
+TEST_F(TestAigBitblaster, bv_mul_auto16) { TEST_MUL_ENC(16, AUTO); }
+
+TEST_F(TestAigBitblaster, bv_mul_enc_values)
+{
+  for (auto enc : {bitblast::MulEncoding::ARRAY,
+                   bitblast::MulEncoding::WALLACE,
+                   bitblast::MulEncoding::DADDA,
+                   bitblast::MulEncoding::BOOTH,
+                   bitblast::MulEncoding::AUTO})
+  {
+    bitblast::AigBitblaster bb;
+    bb.set_mul_encoding(enc);
+    for (uint64_t size : {1, 5, 16, 33})
+    {
+      for (uint64_t i = 0; i < 10; ++i)
+      {
+        BitVector a = BitVector::from_ui(size, i * 0x9e3779b97f4a7c15u, true);
+        BitVector b = BitVector::from_ui(size, ~i * 0xc2b2ae3d27d4eb4fu, true);
+        ASSERT_EQ(bb.bv_mul(bb.bv_value(a), bb.bv_value(b)),
+                  bb.bv_value(a.bvmul(b)));
+      }
+    }
+  }
+}
+
 TEST_F(TestAigBitblaster, bv_mul_square)
 {
   for (size_t i = 1; i < 17; ++i)
@@ -396,6 +455,66 @@ TEST_F(TestAigBitblaster, bv_urem9) { TEST_BIN_OP(9, "bvurem", bv_urem); }
 
 TEST_F(TestAigBitblaster, bv_urem10) { TEST_BIN_OP(10, "bvurem", bv_urem); }
 
+TEST_F(TestAigBitblaster, bv_shift_value)
+{
+  using Bits = bitblast::AigBitblaster::Bits;
+  bitblast::AigBitblaster bb;
+  auto a      = bb.bv_constant(8);
+  auto zero   = bb.bv_value(BitVector::mk_zero(3));
+  uint64_t n  = bb.num_aig_ands();
+  auto amount = bb.bv_value(BitVector::from_ui(8, 3));
+  auto big    = bb.bv_value(BitVector::from_ui(8, 200));
+
+  // Shifts by values do not create any AND gates.
+  ASSERT_EQ(bb.bv_shl(a, amount),
+            bb.bv_concat(bb.bv_extract(a, 4, 0), zero));
+  ASSERT_EQ(bb.bv_shr(a, amount),
+            bb.bv_concat(zero, bb.bv_extract(a, 7, 3)));
+  ASSERT_EQ(bb.bv_ashr(a, amount),
+            bb.bv_concat(Bits(3, a[0]), bb.bv_extract(a, 7, 3)));
+  ASSERT_EQ(bb.bv_shl(a, big), bb.bv_value(BitVector::mk_zero(8)));
+  ASSERT_EQ(bb.bv_shr(a, big), bb.bv_value(BitVector::mk_zero(8)));
+  ASSERT_EQ(bb.bv_ashr(a, big), Bits(8, a[0]));
+  ASSERT_EQ(bb.num_aig_ands(), n);
+}
+
+TEST_F(TestAigBitblaster, bv_udiv_urem_value)
+{
+  for (bool reciprocal : {false, true})
+  {
+    bitblast::AigBitblaster bb;
+    bb.set_div_reciprocal(reciprocal);
+    for (uint64_t size : {1, 5, 16, 33})
+    {
+      for (uint64_t i = 0; i < 10; ++i)
+      {
+        uint64_t v  = i * i * 0xc2b2ae3d27d4eb4fu;
+        BitVector a = BitVector::from_ui(size, i * 0x9e3779b97f4a7c15u, true);
+        BitVector b = BitVector::from_ui(size, v, true);
+        ASSERT_EQ(bb.bv_udiv(bb.bv_value(a), bb.bv_value(b)),
+                  bb.bv_value(a.bvudiv(b)));
+        ASSERT_EQ(bb.bv_urem(bb.bv_value(a), bb.bv_value(b)),
+                  bb.bv_value(a.bvurem(b)));
+      }
+    }
+
+    // Division by zero and powers of two do not create any AND gates.
+    auto a     = bb.bv_constant(8);
+    auto zero  = bb.bv_value(BitVector::mk_zero(8));
+    auto four  = bb.bv_value(BitVector::from_ui(8, 4));
+    uint64_t n = bb.num_aig_ands();
+    ASSERT_EQ(bb.bv_udiv(a, zero), bb.bv_value(BitVector::mk_ones(8)));
+    ASSERT_EQ(bb.bv_urem(a, zero), a);
+    ASSERT_EQ(bb.bv_udiv(a, four),
+              bb.bv_concat(bb.bv_value(BitVector::mk_zero(2)),
+                           bb.bv_extract(a, 7, 2)));
+    ASSERT_EQ(bb.bv_urem(a, four),
+              bb.bv_concat(bb.bv_value(BitVector::mk_zero(6)),
+                           bb.bv_extract(a, 1, 0)));
+    ASSERT_EQ(bb.num_aig_ands(), n);
+  }
+}
+
 TEST_F(TestAigBitblaster, bv_ite) {
   bitblast::AigBitblaster bb;
   auto a      = bb.bv_constant(32);
@@ -8,6 +8,7 @@
  * information at https://github.com/bitwuzla/bitwuzla/blob/main/COPYING
  */
 
+#include <algorithm>
 #include <iostream>
 
 #include "bitblast/aig/aig_cnf.h"
@@ -129,6 +130,63 @@ class TestAigCnf : public TestCommon
     return "unknown";
   }
 
+  /**
+   * Check the clauses of given encoder for all assignments of given inputs.
+   * The clauses must be satisfied by the values of the AIG nodes, and
+   * flipping the value of an encoded AND gate must falsify a clause if the
+   * flipped value is excluded by the encoded polarities of the gate.
+   */
+  static void check_clauses(const bitblast::AigManager& mgr,
+                            const bitblast::AigCnfEncoder& enc,
+                            const std::vector<bitblast::AigNode>& inputs,
+                            const ClauseList& clauses)
+  {
+    ASSERT_LE(inputs.size(), 12);
+    std::vector<bool> values(mgr.d_nodes.size());
+    auto value = [&values](int64_t lit) {
+      return lit < 0 ? !values[-lit] : values[lit];
+    };
+    auto is_sat = [&clauses, &value]() {
+      return std::all_of(clauses.begin(), clauses.end(), [&](const auto& c) {
+        return std::any_of(c.begin(), c.end(), value);
+      });
+    };
+    for (uint64_t i = 0, n = uint64_t{1} << inputs.size(); i < n; ++i)
+    {
+      values[1] = true;
+      for (size_t j = 0; j < inputs.size(); ++j)
+      {
+        values[inputs[j].get_id()] = (i >> j) & 1;
+      }
+      for (size_t id = 2; id < mgr.d_nodes.size(); ++id)
+      {
+        const auto& d = mgr.d_nodes[id];
+        if (d.d_left != 0)
+        {
+          values[id] = ((d.d_left & 1) != values[d.d_left >> 1])
+                       && ((d.d_right & 1) != values[d.d_right >> 1]);
+        }
+      }
+      ASSERT_TRUE(is_sat());
+
+      for (size_t id = 2; id < mgr.d_nodes.size(); ++id)
+      {
+        if (mgr.d_nodes[id].d_left == 0 || id > enc.d_aig_encoded.size())
+        {
+          continue;
+        }
+        // Positive polarity excludes false gates being true, negative
+        // polarity excludes true gates being false.
+        if (enc.d_aig_encoded[id - 1][values[id] ? 1 : 0] != 0)
+        {
+          values[id] = !values[id];
+          ASSERT_FALSE(is_sat());
+          values[id] = !values[id];
+        }
+      }
+    }
+  }
+
   // a * -1 != ~a + 1
   static std::string perf_test1(size_t bw)
   {
@@ -307,6 +365,212 @@ TEST_F(TestAigCnf, enc_or)
                         {or_id, a.get_id(), b.get_id()}}));
 }
 
+TEST_F(TestAigCnf, enc_scope)
+{
+  bitblast::BitInterface<bitblast::AigNode> aigmgr;
+  DummySatSolver solver;
+  bitblast::AigCnfEncoder enc(solver);
+
+  bitblast::AigNode a       = aigmgr.mk_bit();
+  bitblast::AigNode b       = aigmgr.mk_bit();
+  bitblast::AigNode c       = aigmgr.mk_bit();
+  bitblast::AigNode act     = aigmgr.mk_bit();
+  bitblast::AigNode and_ab  = aigmgr.mk_and(a, b);
+  bitblast::AigNode and_abc = aigmgr.mk_and(and_ab, c);
+  auto ab                   = and_ab.get_id();
+  auto abc                  = and_abc.get_id();
+  auto act_id               = act.get_id();
+
+  enc.push(act);
+  enc.encode(and_abc);
+  ASSERT_EQ(solver.get_clauses(),
+            ClauseList({{-ab, a.get_id(), -act_id},
+                        {-ab, b.get_id(), -act_id},
+                        {ab, -a.get_id(), -b.get_id(), -act_id},
+                        {-abc, c.get_id(), -act_id},
+                        {-abc, ab, -act_id},
+                        {abc, -c.get_id(), -ab, -act_id}}));
+
+  // Top-level encodings are not guarded and must not rely on guarded clauses.
+  solver.get_clauses().clear();
+  enc.encode(aigmgr.mk_not(and_ab), true);
+  ASSERT_EQ(solver.get_clauses(),
+            ClauseList({{-ab, a.get_id()},
+                        {-ab, b.get_id()},
+                        {ab, -a.get_id(), -b.get_id()},
+                        {-ab}}));
+
+  solver.get_clauses().clear();
+  enc.pop();
+  ASSERT_EQ(solver.get_clauses(), ClauseList({{-act_id}}));
+  ASSERT_EQ(enc.statistics().num_released, 2);
+
+  // Nodes of the popped scope are encoded again, top-level nodes are kept.
+  solver.get_clauses().clear();
+  enc.encode(and_abc);
+  ASSERT_EQ(solver.get_clauses(),
+            ClauseList({{-abc, c.get_id()},
+                        {-abc, ab},
+                        {abc, -c.get_id(), -ab}}));
+}
+
+TEST_F(TestAigCnf, enc_xor)
+{
+  bitblast::BitInterface<bitblast::AigNode> aigmgr;
+  DummySatSolver solver;
+  bitblast::AigCnfEncoder enc(solver);
+
+  bitblast::AigNode a = aigmgr.mk_bit();
+  bitblast::AigNode b = aigmgr.mk_bit();
+  bitblast::AigNode xor_aig =
+      aigmgr.mk_and(aigmgr.mk_or(a, b), aigmgr.mk_not(aigmgr.mk_and(a, b)));
+  bitblast::AigNode xnor_aig = aigmgr.mk_iff(a, b);
+
+  // The AND gates of the XOR are not encoded.
+  enc.encode(xor_aig);
+  ASSERT_EQ(solver.get_clauses().size(), 4);
+  ASSERT_EQ(enc.statistics().num_vars, 3);
+  enc.encode(xnor_aig);
+  ASSERT_EQ(solver.get_clauses().size(), 8);
+  ASSERT_EQ(enc.statistics().num_vars, 4);
+  ASSERT_EQ(enc.statistics().num_literals, 24);
+  check_clauses(aigmgr.d_amgr, enc, {a, b}, solver.get_clauses());
+}
+
+TEST_F(TestAigCnf, enc_maj)
+{
+  bitblast::BitInterface<bitblast::AigNode> aigmgr;
+  DummySatSolver solver;
+  bitblast::AigCnfEncoder enc(solver);
+
+  bitblast::AigNode a = aigmgr.mk_bit();
+  bitblast::AigNode b = aigmgr.mk_bit();
+  bitblast::AigNode c = aigmgr.mk_bit();
+  bitblast::AigNode s =
+      aigmgr.mk_and(aigmgr.mk_or(a, b), aigmgr.mk_not(aigmgr.mk_and(a, b)));
+  // Carry of full adder: (a /\ b) \/ ((a xor b) /\ c)
+  bitblast::AigNode carry1 =
+      aigmgr.mk_or(aigmgr.mk_and(a, b), aigmgr.mk_and(s, c));
+  // Carry of full adder: (a /\ b) \/ ((a \/ b) /\ c)
+  bitblast::AigNode carry2 =
+      aigmgr.mk_or(aigmgr.mk_and(aigmgr.mk_or(a, b), c), aigmgr.mk_and(a, b));
+
+  enc.encode(carry1);
+  ASSERT_EQ(solver.get_clauses().size(), 6);
+  ASSERT_EQ(enc.statistics().num_vars, 4);
+  enc.encode(carry2);
+  ASSERT_EQ(solver.get_clauses().size(), 12);
+  ASSERT_EQ(enc.statistics().num_vars, 5);
+  check_clauses(aigmgr.d_amgr, enc, {a, b, c}, solver.get_clauses());
+}
+
+TEST_F(TestAigCnf, enc_gates)
+{
+  for (bool pg : {false, true})
+  {
+    bitblast::AigBitblaster bb;
+    DummySatSolver solver;
+    bitblast::AigCnfEncoder enc(solver, pg);
+
+    auto a   = bb.bv_constant(3);
+    auto b   = bb.bv_constant(3);
+    auto c   = bb.bv_constant(1);
+    auto mul = bb.bv_mul(a, b);
+    auto add = bb.bv_add(a, b);
+    auto div = bb.bv_udiv(a, b);
+    auto ite = bb.bv_ite(c[0], mul, div);
+    auto ult = bb.bv_ult(add, ite);
+    for (const auto& bits : {mul, add, div, ite, ult})
+    {
+      for (size_t i = 0; i < bits.size(); ++i)
+      {
+        // Encode some bits in both polarities.
+        enc.encode(bits[i]);
+        if (i % 2)
+        {
+          enc.encode(bb.d_bit_mgr.mk_not(bits[i]));
+        }
+      }
+    }
+    std::vector<bitblast::AigNode> inputs{c[0]};
+    inputs.insert(inputs.end(), a.begin(), a.end());
+    inputs.insert(inputs.end(), b.begin(), b.end());
+    check_clauses(bb.d_bit_mgr.d_amgr, enc, inputs, solver.get_clauses());
+  }
+}
+
+TEST_F(TestAigCnf, enc_pg)
+{
+  bitblast::BitInterface<bitblast::AigNode> aigmgr;
+  DummySatSolver solver;
+  bitblast::AigCnfEncoder enc(solver, true);
+
+  bitblast::AigNode a      = aigmgr.mk_bit();
+  bitblast::AigNode b      = aigmgr.mk_bit();
+  bitblast::AigNode c      = aigmgr.mk_bit();
+  bitblast::AigNode and_ab = aigmgr.mk_and(a, b);
+  bitblast::AigNode or_abc = aigmgr.mk_or(and_ab, c);
+  auto ab                  = and_ab.get_id();
+  auto abc                 = std::abs(or_abc.get_id());
+
+  // The OR gate is the negation of an AND gate, only its negative polarity
+  // is encoded, which in turn requires the positive polarity of `and_ab`.
+  enc.encode(or_abc);
+  ASSERT_EQ(solver.get_clauses(),
+            ClauseList({{-ab, a.get_id()},
+                        {-ab, b.get_id()},
+                        {abc, c.get_id(), ab}}));
+
+  enc.encode(or_abc);
+  ASSERT_EQ(solver.get_clauses().size(), 3);
+
+  // Missing polarities are added on demand.
+  enc.encode(aigmgr.mk_not(or_abc));
+  ASSERT_EQ(solver.get_clauses(),
+            ClauseList({{-ab, a.get_id()},
+                        {-ab, b.get_id()},
+                        {abc, c.get_id(), ab},
+                        {ab, -a.get_id(), -b.get_id()},
+                        {-abc, -c.get_id()},
+                        {-abc, -ab}}));
+  ASSERT_EQ(enc.statistics().num_vars, 5);
+  check_clauses(aigmgr.d_amgr, enc, {a, b, c}, solver.get_clauses());
+}
+
+TEST_F(TestAigCnf, enc_pg_scope)
+{
+  bitblast::BitInterface<bitblast::AigNode> aigmgr;
+  DummySatSolver solver;
+  bitblast::AigCnfEncoder enc(solver, true);
+
+  bitblast::AigNode a      = aigmgr.mk_bit();
+  bitblast::AigNode b      = aigmgr.mk_bit();
+  bitblast::AigNode act    = aigmgr.mk_bit();
+  bitblast::AigNode and_ab = aigmgr.mk_and(a, b);
+  auto ab                  = and_ab.get_id();
+  auto act_id              = act.get_id();
+
+  enc.encode(and_ab);
+  enc.push(act);
+  enc.encode(aigmgr.mk_not(and_ab));
+  ASSERT_EQ(solver.get_clauses(),
+            ClauseList({{-ab, a.get_id()},
+                        {-ab, b.get_id()},
+                        {ab, -a.get_id(), -b.get_id(), -act_id}}));
+
+  // Only the polarity encoded in the scope is released.
+  solver.get_clauses().clear();
+  enc.pop();
+  ASSERT_EQ(enc.statistics().num_released, 0);
+  ASSERT_TRUE(enc.is_encoded(and_ab));
+  solver.get_clauses().clear();
+  enc.encode(and_ab);
+  ASSERT_TRUE(solver.get_clauses().empty());
+  enc.encode(aigmgr.mk_not(and_ab));
+  ASSERT_EQ(solver.get_clauses(),
+            ClauseList({{ab, -a.get_id(), -b.get_id()}}));
+}
+
 #if 0
 TEST_F(TestAigCnf, enc_or_top)
 {
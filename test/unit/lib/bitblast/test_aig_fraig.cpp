@@ -0,0 +1,349 @@
+/***
+ * Bitwuzla: Satisfiability Modulo Theories (SMT) solver.
+ *
+ * Copyright (C) 2022 by the authors listed in the AUTHORS file at
+ * https://github.com/bitwuzla/bitwuzla/blob/main/AUTHORS
+ *
+ * This file is part of Bitwuzla under the MIT license. See COPYING for more
+ * information at https://github.com/bitwuzla/bitwuzla/blob/main/COPYING
+ */
+
+#include <unordered_map>
+
+#include "bitblast/aig/aig_fraig.h"
+#include "bitblast/aig/aig_manager.h"
+#include "bitblast/aig_bitblaster.h"
+#include "test_lib.h"
+
+namespace bzla::test {
+
+using namespace bitblast;
+
+/** Simple DPLL SAT solver with assumptions and a conflict limit. */
+class DpllSatSolver : public FraigSatInterface
+{
+ public:
+  void add(int64_t lit) override
+  {
+    if (lit == 0)
+    {
+      d_clauses.emplace_back(std::move(d_clause));
+      d_clause.clear();
+      return;
+    }
+    d_clause.push_back(lit);
+    size_t var = static_cast<size_t>(std::abs(lit));
+    if (var >= d_assignment.size())
+    {
+      d_assignment.resize(var + 1, 0);
+    }
+  }
+
+  void add_clause(const std::initializer_list<int64_t>& literals) override
+  {
+    for (int64_t lit : literals)
+    {
+      add(lit);
+    }
+    add(0);
+  }
+
+  bool value(int64_t lit) override
+  {
+    int8_t val = d_assignment[std::abs(lit)];
+    return lit < 0 ? val < 0 : val > 0;
+  }
+
+  void assume(int64_t lit) override { d_assumptions.push_back(lit); }
+
+  int32_t solve(uint64_t conflict_limit) override
+  {
+    std::fill(d_assignment.begin(), d_assignment.end(), 0);
+    d_trail.clear();
+    d_conflicts      = 0;
+    d_conflict_limit = conflict_limit;
+    bool consistent  = true;
+    for (int64_t lit : d_assumptions)
+    {
+      consistent = consistent && assign(lit);
+    }
+    d_assumptions.clear();
+    if (!consistent)
+    {
+      return 20;
+    }
+    return dpll();
+  }
+
+ private:
+  /** Assign given literal, @return False if it is already falsified. */
+  bool assign(int64_t lit)
+  {
+    int8_t& val = d_assignment[std::abs(lit)];
+    if (val != 0)
+    {
+      return (val > 0) == (lit > 0);
+    }
+    val = lit > 0 ? 1 : -1;
+    d_trail.push_back(lit);
+    return true;
+  }
+
+  /** Unit propagation, @return False on conflict. */
+  bool propagate()
+  {
+    bool changed = true;
+    while (changed)
+    {
+      changed = false;
+      for (const auto& clause : d_clauses)
+      {
+        int64_t unit       = 0;
+        uint32_t num_unset = 0;
+        bool sat           = false;
+        for (int64_t lit : clause)
+        {
+          int8_t val = d_assignment[std::abs(lit)];
+          if (val == 0)
+          {
+            unit = lit;
+            ++num_unset;
+          }
+          else if ((val > 0) == (lit > 0))
+          {
+            sat = true;
+            break;
+          }
+        }
+        if (sat)
+        {
+          continue;
+        }
+        if (num_unset == 0)
+        {
+          return false;
+        }
+        if (num_unset == 1)
+        {
+          assign(unit);
+          changed = true;
+        }
+      }
+    }
+    return true;
+  }
+
+  void backtrack(size_t size)
+  {
+    while (d_trail.size() > size)
+    {
+      d_assignment[std::abs(d_trail.back())] = 0;
+      d_trail.pop_back();
+    }
+  }
+
+  int32_t dpll()
+  {
+    if (!propagate())
+    {
+      ++d_conflicts;
+      return 20;
+    }
+    size_t var = 1;
+    while (var < d_assignment.size() && d_assignment[var] != 0)
+    {
+      ++var;
+    }
+    if (var == d_assignment.size())
+    {
+      return 10;
+    }
+    size_t size = d_trail.size();
+    for (int64_t lit : {static_cast<int64_t>(var), -static_cast<int64_t>(var)})
+    {
+      if (d_conflict_limit > 0 && d_conflicts >= d_conflict_limit)
+      {
+        return 0;
+      }
+      assign(lit);
+      int32_t res = dpll();
+      if (res != 20)
+      {
+        return res;
+      }
+      backtrack(size);
+    }
+    return 20;
+  }
+
+  std::vector<std::vector<int64_t>> d_clauses;
+  std::vector<int64_t> d_clause;
+  std::vector<int64_t> d_assumptions;
+  std::vector<int8_t> d_assignment{0};
+  std::vector<int64_t> d_trail;
+  uint64_t d_conflicts      = 0;
+  uint64_t d_conflict_limit = 0;
+};
+
+class TestAigFraig : public TestCommon
+{
+ protected:
+  /** Evaluate given AIG under given assignment of the AIG constants. */
+  static bool eval(const AigNode& aig,
+                   const std::unordered_map<int64_t, bool>& assignment)
+  {
+    bool res;
+    if (aig.is_true() || aig.is_false())
+    {
+      res = true;
+    }
+    else if (aig.is_const())
+    {
+      res = assignment.at(std::abs(aig.get_id()));
+    }
+    else
+    {
+      res = eval(aig[0], assignment) && eval(aig[1], assignment);
+    }
+    return aig.is_negated() ? !res : res;
+  }
+
+  /** Check that given roots are equivalent for all assignments of inputs. */
+  static void check_equiv(const std::vector<AigNode>& inputs,
+                          const std::vector<AigNode>& expected,
+                          const std::vector<AigNode>& roots)
+  {
+    ASSERT_EQ(expected.size(), roots.size());
+    ASSERT_LE(inputs.size(), 16);
+    std::unordered_map<int64_t, bool> assignment;
+    for (uint64_t i = 0, n = uint64_t{1} << inputs.size(); i < n; ++i)
+    {
+      for (size_t j = 0; j < inputs.size(); ++j)
+      {
+        assignment[inputs[j].get_id()] = (i >> j) & 1;
+      }
+      for (size_t j = 0; j < roots.size(); ++j)
+      {
+        ASSERT_EQ(eval(expected[j], assignment), eval(roots[j], assignment));
+      }
+    }
+  }
+
+  static std::vector<AigNode> concat(
+      const std::vector<std::vector<AigNode>>& bits)
+  {
+    std::vector<AigNode> res;
+    for (const auto& b : bits)
+    {
+      res.insert(res.end(), b.begin(), b.end());
+    }
+    return res;
+  }
+
+  AigBitblaster d_bb;
+  DpllSatSolver d_sat_solver;
+};
+
+TEST_F(TestAigFraig, merge_add)
+{
+  AigFraig fraig(d_sat_solver);
+  auto a = d_bb.bv_constant(3);
+  auto b = d_bb.bv_constant(3);
+  auto c = d_bb.bv_constant(3);
+  // Associativity
+  auto l                     = d_bb.bv_add(d_bb.bv_add(a, b), c);
+  auto r                     = d_bb.bv_add(a, d_bb.bv_add(b, c));
+  std::vector<AigNode> roots = concat({l, r});
+  std::vector<AigNode> res   = roots;
+  fraig.fraig(res);
+
+  check_equiv(concat({a, b, c}), roots, res);
+  for (size_t i = 0; i < l.size(); ++i)
+  {
+    ASSERT_EQ(res[i], res[l.size() + i]);
+  }
+  ASSERT_GT(fraig.statistics().num_merged, 0);
+}
+
+TEST_F(TestAigFraig, merge_mul)
+{
+  AigFraig fraig(d_sat_solver);
+  auto a = d_bb.bv_constant(3);
+  auto b = d_bb.bv_constant(3);
+  // Commutativity
+  auto ab                    = d_bb.bv_mul(a, b);
+  auto ba                    = d_bb.bv_mul(b, a);
+  std::vector<AigNode> roots = concat({ab, ba, d_bb.bv_eq(ab, ba)});
+  std::vector<AigNode> res   = roots;
+  fraig.fraig(res);
+
+  check_equiv(concat({a, b}), roots, res);
+  for (size_t i = 0; i < ab.size(); ++i)
+  {
+    ASSERT_EQ(res[i], res[ab.size() + i]);
+  }
+  ASSERT_TRUE(res.back().is_true());
+}
+
+TEST_F(TestAigFraig, not_equivalent)
+{
+  AigFraig fraig(d_sat_solver);
+  auto a = d_bb.bv_constant(4);
+  auto b = d_bb.bv_constant(4);
+  auto c = d_bb.bv_constant(4);
+  std::vector<AigNode> roots =
+      concat({d_bb.bv_add(a, b),
+              d_bb.bv_xor(a, b),
+              d_bb.bv_ult(d_bb.bv_mul(a, b), c),
+              d_bb.bv_ult(d_bb.bv_mul(b, c), a)});
+  std::vector<AigNode> res = roots;
+  fraig.fraig(res);
+  check_equiv(concat({a, b, c}), roots, res);
+}
+
+TEST_F(TestAigFraig, input_predicate)
+{
+  auto a     = d_bb.bv_constant(3);
+  auto b     = d_bb.bv_constant(3);
+  AigNode eq = d_bb.bv_eq(d_bb.bv_mul(a, b), d_bb.bv_mul(b, a))[0];
+  std::vector<AigNode> roots{eq};
+
+  // The structure of the equality is not reduced if it is treated as input.
+  AigFraig fraig(d_sat_solver, [&eq](const AigNode& n) { return n == eq; });
+  std::vector<AigNode> res = roots;
+  fraig.fraig(res);
+  ASSERT_EQ(res[0], eq);
+  ASSERT_EQ(fraig.statistics().num_sat_calls, 0);
+}
+
+TEST_F(TestAigFraig, conflict_limit)
+{
+  AigManager mgr;
+  auto mk_or = [&mgr](const AigNode& a, const AigNode& b) {
+    return mgr.mk_not(mgr.mk_and(mgr.mk_not(a), mgr.mk_not(b)));
+  };
+  AigNode a = mgr.mk_const();
+  AigNode b = mgr.mk_const();
+  AigNode c = mgr.mk_const();
+  // Majority: (a & b) | (a & c) | (b & c) = (a & (b | c)) | (b & c)
+  AigNode bc = mgr.mk_and(b, c);
+  std::vector<AigNode> roots{
+      mk_or(mk_or(mgr.mk_and(a, b), mgr.mk_and(a, c)), bc),
+      mk_or(mgr.mk_and(a, mk_or(b, c)), bc)};
+
+  // Proving the equivalence of the roots requires search.
+  AigFraig fraig(d_sat_solver, nullptr, 1);
+  std::vector<AigNode> res = roots;
+  fraig.fraig(res);
+  check_equiv({a, b, c}, roots, res);
+  ASSERT_GT(fraig.statistics().num_unknown, 0);
+  ASSERT_FALSE(res[0] == res[1]);
+
+  AigFraig fraig_nolimit(d_sat_solver, nullptr, 0);
+  res = roots;
+  fraig_nolimit.fraig(res);
+  check_equiv({a, b, c}, roots, res);
+  ASSERT_EQ(res[0], res[1]);
+}
+
+}  // namespace bzla::test
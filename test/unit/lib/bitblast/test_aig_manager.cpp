@@ -483,4 +483,70 @@ TEST_F(TestAigMgr, idempotence4_3)
   }
 }
 
+TEST_F(TestAigMgr, garbage_collect)
+{
+  bitblast::AigManager mgr;
+  {
+    auto a  = mgr.mk_const();
+    auto b  = mgr.mk_const();
+    auto ab = mgr.mk_and(a, b);
+    ASSERT_EQ(mgr.statistics().num_consts, 2);
+    ASSERT_EQ(mgr.statistics().num_ands, 1);
+    ASSERT_EQ(a.parents(), 1);
+    ASSERT_EQ(b.parents(), 1);
+    ASSERT_EQ(ab[0], a);
+    ASSERT_EQ(ab[1], b);
+    {
+      auto nab  = mgr.mk_not(ab);
+      auto root = mgr.mk_and(nab, a);
+      ASSERT_EQ(root, mgr.mk_and(a, nab));
+      ASSERT_EQ(mgr.statistics().num_ands, 2);
+    }
+    // Only the root is garbage collected, ab is still referenced.
+    ASSERT_EQ(mgr.statistics().num_ands, 1);
+    ASSERT_EQ(a.parents(), 1);
+  }
+  ASSERT_EQ(mgr.statistics().num_ands, 0);
+  ASSERT_EQ(mgr.statistics().num_consts, 0);
+}
+
+TEST_F(TestAigMgr, unique_table)
+{
+  bitblast::AigManager mgr;
+  std::vector<bitblast::AigNode> consts, ands;
+  for (size_t i = 0; i < 100; ++i)
+  {
+    consts.push_back(mgr.mk_const());
+  }
+  for (size_t i = 0; i < consts.size(); ++i)
+  {
+    for (size_t j = i + 1; j < consts.size(); ++j)
+    {
+      ands.push_back(mgr.mk_and(consts[i], mgr.mk_not(consts[j])));
+    }
+  }
+  ASSERT_EQ(mgr.statistics().num_ands, ands.size());
+
+  // Erase every other AND gate and check that the remaining ones are still
+  // found after the table was modified.
+  for (size_t i = 0; i < ands.size(); i += 2)
+  {
+    ands[i] = mgr.mk_true();
+  }
+  ASSERT_EQ(mgr.statistics().num_ands, ands.size() / 2);
+  size_t k = 0;
+  for (size_t i = 0; i < consts.size(); ++i)
+  {
+    for (size_t j = i + 1; j < consts.size(); ++j, ++k)
+    {
+      auto aig = mgr.mk_and(mgr.mk_not(consts[j]), consts[i]);
+      if (k % 2 == 1)
+      {
+        ASSERT_EQ(aig, ands[k]);
+      }
+    }
+  }
+  ASSERT_EQ(mgr.statistics().num_shared, ands.size() / 2);
+}
+
 }  // namespace bzla::test
@@ -0,0 +1,219 @@
+/***
+ * Bitwuzla: Satisfiability Modulo Theories (SMT) solver.
+ *
+ * Copyright (C) 2022 by the authors listed in the AUTHORS file at
+ * https://github.com/bitwuzla/bitwuzla/blob/main/AUTHORS
+ *
+ * This file is part of Bitwuzla under the MIT license. See COPYING for more
+ * information at https://github.com/bitwuzla/bitwuzla/blob/main/COPYING
+ */
+
+#include <unordered_map>
+
+#include "bitblast/aig/aig_manager.h"
+#include "bitblast/aig/aig_optimizer.h"
+#include "bitblast/aig_bitblaster.h"
+#include "test_lib.h"
+
+namespace bzla::test {
+
+using namespace bitblast;
+
+class TestAigOptimizer : public TestCommon
+{
+ protected:
+  AigNode mk_or(const AigNode& a, const AigNode& b)
+  {
+    return d_mgr.mk_not(d_mgr.mk_and(d_mgr.mk_not(a), d_mgr.mk_not(b)));
+  }
+
+  /** Evaluate given AIG under given assignment of the AIG constants. */
+  static bool eval(const AigNode& aig,
+                   const std::unordered_map<int64_t, bool>& assignment)
+  {
+    bool res;
+    if (aig.is_true() || aig.is_false())
+    {
+      res = true;
+    }
+    else if (aig.is_const())
+    {
+      res = assignment.at(std::abs(aig.get_id()));
+    }
+    else
+    {
+      res = eval(aig[0], assignment) && eval(aig[1], assignment);
+    }
+    return aig.is_negated() ? !res : res;
+  }
+
+  /** @return The depth of given AIG. */
+  static uint32_t depth(const AigNode& aig)
+  {
+    if (!aig.is_and())
+    {
+      return 0;
+    }
+    return 1 + std::max(depth(aig[0]), depth(aig[1]));
+  }
+
+  /** Check that given roots are equivalent for all assignments of inputs. */
+  static void check_equiv(const std::vector<AigNode>& inputs,
+                          const std::vector<AigNode>& expected,
+                          const std::vector<AigNode>& roots)
+  {
+    ASSERT_EQ(expected.size(), roots.size());
+    ASSERT_LE(inputs.size(), 16);
+    std::unordered_map<int64_t, bool> assignment;
+    for (uint64_t i = 0, n = uint64_t{1} << inputs.size(); i < n; ++i)
+    {
+      for (size_t j = 0; j < inputs.size(); ++j)
+      {
+        assignment[inputs[j].get_id()] = (i >> j) & 1;
+      }
+      for (size_t j = 0; j < roots.size(); ++j)
+      {
+        ASSERT_EQ(eval(expected[j], assignment), eval(roots[j], assignment));
+      }
+    }
+  }
+
+  std::vector<AigNode> mk_inputs(size_t n)
+  {
+    std::vector<AigNode> res;
+    for (size_t i = 0; i < n; ++i)
+    {
+      res.push_back(d_mgr.mk_const());
+    }
+    return res;
+  }
+
+  AigManager d_mgr;
+};
+
+TEST_F(TestAigOptimizer, balance)
+{
+  AigOptimizer opt;
+  std::vector<AigNode> x = mk_inputs(8);
+  AigNode chain          = x[0];
+  for (size_t i = 1; i < x.size(); ++i)
+  {
+    chain = d_mgr.mk_and(chain, x[i]);
+  }
+  std::vector<AigNode> roots{chain};
+  ASSERT_EQ(depth(chain), 7);
+
+  std::vector<AigNode> res = opt.balance(roots);
+  ASSERT_EQ(depth(res[0]), 3);
+  ASSERT_EQ(opt.count_ands(res), 7);
+  check_equiv(x, roots, res);
+}
+
+TEST_F(TestAigOptimizer, balance_contradiction)
+{
+  AigOptimizer opt;
+  std::vector<AigNode> x = mk_inputs(3);
+  AigNode a              = d_mgr.mk_and(d_mgr.mk_and(x[0], x[1]), x[2]);
+  AigNode b = d_mgr.mk_and(d_mgr.mk_and(d_mgr.mk_not(x[0]), x[1]), x[2]);
+  std::vector<AigNode> roots{d_mgr.mk_and(a, b)};
+  ASSERT_TRUE(roots[0].is_and());
+
+  std::vector<AigNode> res = opt.balance(roots);
+  ASSERT_TRUE(res[0].is_false());
+}
+
+TEST_F(TestAigOptimizer, rewrite)
+{
+  AigOptimizer opt;
+  // Consensus: (a & b) | (~a & c) | (b & c) = (a & b) | (~a & c)
+  std::vector<AigNode> x = mk_inputs(3);
+  AigNode f              = mk_or(mk_or(d_mgr.mk_and(x[0], x[1]),
+                          d_mgr.mk_and(d_mgr.mk_not(x[0]), x[2])),
+                    d_mgr.mk_and(x[1], x[2]));
+  std::vector<AigNode> roots{f};
+  uint64_t before = opt.count_ands(roots);
+
+  std::vector<AigNode> res = opt.rewrite(roots);
+  ASSERT_LT(opt.count_ands(res), before);
+  ASSERT_GT(opt.statistics().num_rewritten, 0);
+  check_equiv(x, roots, res);
+}
+
+TEST_F(TestAigOptimizer, refactor)
+{
+  AigOptimizer opt;
+  // (a & b) | (a & ~b & c) | (a & ~b & ~c & d) | (a & ~b & ~c & ~d & e)
+  //   = a & (b | c | d | e)
+  std::vector<AigNode> x = mk_inputs(5);
+  AigNode prefix         = x[0];
+  AigNode f              = d_mgr.mk_false();
+  for (size_t i = 1; i < x.size(); ++i)
+  {
+    f      = mk_or(f, d_mgr.mk_and(prefix, x[i]));
+    prefix = d_mgr.mk_and(prefix, d_mgr.mk_not(x[i]));
+  }
+  std::vector<AigNode> roots{f};
+  uint64_t before = opt.count_ands(roots);
+
+  std::vector<AigNode> res = opt.refactor(roots);
+  ASSERT_LT(opt.count_ands(res), before);
+  ASSERT_GT(opt.statistics().num_refactored, 0);
+  check_equiv(x, roots, res);
+  // The cut is bounded, the remaining redundancy is removed in a second pass.
+  res = opt.refactor(res);
+  ASSERT_EQ(opt.count_ands(res), 4);
+  check_equiv(x, roots, res);
+}
+
+TEST_F(TestAigOptimizer, input_predicate)
+{
+  std::vector<AigNode> x = mk_inputs(3);
+  AigNode fixed          = d_mgr.mk_and(x[1], x[2]);
+  AigNode f              = mk_or(mk_or(d_mgr.mk_and(x[0], x[1]),
+                          d_mgr.mk_and(d_mgr.mk_not(x[0]), x[2])),
+                    fixed);
+  std::vector<AigNode> roots{f};
+
+  AigOptimizer opt([&fixed](const AigNode& n) { return n == fixed; });
+  std::vector<AigNode> res = opt.rewrite(roots);
+  for (const auto& r : {res, opt.balance(roots), opt.refactor(roots)})
+  {
+    check_equiv(x, roots, r);
+  }
+  // The AND gate treated as input is not counted.
+  ASSERT_EQ(opt.count_ands(roots), AigOptimizer().count_ands(roots) - 1);
+}
+
+TEST_F(TestAigOptimizer, optimize_mul)
+{
+  for (size_t bw : {2, 3, 4})
+  {
+    AigBitblaster bb;
+    auto a = bb.bv_constant(bw);
+    auto b = bb.bv_constant(bw);
+    auto c = bb.bv_constant(bw);
+    std::vector<AigNode> roots{
+        bb.bv_eq(bb.bv_mul(a, b), c)[0],
+        bb.bv_ult(bb.bv_urem(a, b), bb.bv_udiv(c, b))[0]};
+    std::vector<AigNode> inputs;
+    for (const auto& bits : {a, b, c})
+    {
+      inputs.insert(inputs.end(), bits.begin(), bits.end());
+    }
+
+    AigOptimizer opt;
+    std::vector<AigNode> res = roots;
+    opt.optimize(res);
+    ASSERT_LE(opt.count_ands(res), opt.count_ands(roots));
+    ASSERT_EQ(opt.statistics().num_ands_before, opt.count_ands(roots));
+    ASSERT_EQ(opt.statistics().num_ands_after, opt.count_ands(res));
+    check_equiv(inputs, roots, res);
+    for (const auto& r :
+         {opt.balance(roots), opt.rewrite(roots), opt.refactor(roots)})
+    {
+      check_equiv(inputs, roots, r);
+    }
+  }
+}
+
+}  // namespace bzla::test
@@ -175,6 +175,7 @@ class TestBitVector : public TestCommon
                       bool shift_by_int);
   void test_shift(BvFunKind fun_kind, Kind kind, bool shift_by_int);
   void test_udivurem(uint64_t size);
+  void test_multi_limb(uint64_t size);
   std::unique_ptr<RNG> d_rng;
 };
 
@@ -3076,6 +3077,60 @@ TestBitVector::test_shift(BvFunKind fun_kind, Kind kind, bool shift_by_int)
   }
 }
 
+void
+TestBitVector::test_multi_limb(uint64_t size)
+{
+  mpz_class mod = mpz_class(1) << size;
+  auto to_mpz   = [](const BitVector& bv) { return mpz_class(bv.str(), 2); };
+  auto check    = [&size](const BitVector& bv, const mpz_class& expected) {
+    ASSERT_EQ(bv.size(), size);
+    ASSERT_EQ(bv.str(10), expected.get_str(10));
+  };
+  for (uint32_t i = 0; i < N_TESTS / 10; ++i)
+  {
+    BitVector bv1(size, *d_rng);
+    BitVector bv2 = d_rng->flip_coin() ? BitVector(size, *d_rng)
+                                       : BitVector(size, *d_rng, 63, 0);
+    mpz_class a = to_mpz(bv1), b = to_mpz(bv2), r;
+    uint64_t shift = d_rng->pick<uint64_t>(0, size);
+
+    mpz_fdiv_r(r.get_mpz_t(), mpz_class(a + b).get_mpz_t(), mod.get_mpz_t());
+    check(bv1.bvadd(bv2), r);
+    mpz_fdiv_r(r.get_mpz_t(), mpz_class(a - b).get_mpz_t(), mod.get_mpz_t());
+    check(bv1.bvsub(bv2), r);
+    mpz_fdiv_r(r.get_mpz_t(), mpz_class(a * b).get_mpz_t(), mod.get_mpz_t());
+    check(bv1.bvmul(bv2), r);
+    mpz_fdiv_r(r.get_mpz_t(), mpz_class(-a).get_mpz_t(), mod.get_mpz_t());
+    check(bv1.bvneg(), r);
+    check(bv1.bvudiv(bv2), b == 0 ? mpz_class(mod - 1) : mpz_class(a / b));
+    check(bv1.bvurem(bv2), b == 0 ? a : mpz_class(a % b));
+    mpz_fdiv_r(
+        r.get_mpz_t(), mpz_class(a << shift).get_mpz_t(), mod.get_mpz_t());
+    check(bv1.bvshl(shift), r);
+    check(bv1.bvshr(shift), a >> shift);
+    check(bv1.bvand(bv2), a & b);
+    check(bv1.bvor(bv2), a | b);
+    check(bv1.bvxor(bv2), a ^ b);
+    check(bv1.bvnot(), mod - 1 - a);
+    ASSERT_EQ(bv1.compare(bv2), a < b ? -1 : (a == b ? 0 : 1));
+    ASSERT_EQ(bv1.count_trailing_zeros(),
+              a == 0 ? size : mpz_scan1(a.get_mpz_t(), 0));
+    ASSERT_EQ(bv1.count_leading_zeros(),
+              a == 0 ? size : size - mpz_sizeinbase(a.get_mpz_t(), 2));
+    ASSERT_EQ(bv1.is_uadd_overflow(bv2), a + b >= mod);
+    ASSERT_EQ(bv1.is_umul_overflow(bv2), size > 1 && a * b >= mod);
+
+    uint64_t idx_hi = d_rng->pick<uint64_t>(0, size - 1);
+    uint64_t idx_lo = d_rng->pick<uint64_t>(0, idx_hi);
+    mpz_class ext   = a >> idx_lo;
+    mpz_fdiv_r_2exp(ext.get_mpz_t(), ext.get_mpz_t(), idx_hi - idx_lo + 1);
+    ASSERT_EQ(bv1.bvextract(idx_hi, idx_lo).str(10), ext.get_str(10));
+    ASSERT_EQ(bv1.bvconcat(bv2).str(10),
+              mpz_class((a << size) + b).get_str(10));
+    ASSERT_EQ(bv1.bvzext(size).str(10), a.get_str(10));
+  }
+}
+
 void
 TestBitVector::test_udivurem(uint64_t size)
 {
@@ -4698,6 +4753,16 @@ TEST_F(TestBitVector, udivurem)
   test_udivurem(127);
 }
 
+TEST_F(TestBitVector, multi_limb)
+{
+  test_multi_limb(65);
+  test_multi_limb(100);
+  test_multi_limb(128);
+  test_multi_limb(193);
+  test_multi_limb(256);
+  test_multi_limb(257);
+}
+
 /* -------------------------------------------------------------------------- */
 
 }  // namespace bzla::test
@@ -15,18 +15,14 @@ namespace bzla::ls::test {
 class TestBvNodeSelPath : public TestBvNode
 {
  protected:
-  void SetUp() override
-  {
-    TestBvNode::SetUp();
-    /* We want to test deterministically, with selecting essential inputs when
-     * there are any. For this we additionally have to set the probability of
-     * selecting essential inputs to 100% to disables random input selection in
-     * essential path selection mode, which is performed with (the complement of
-     * this) configured probability for completeness.
-     */
-    BitVectorNode::s_path_sel_essential  = true;
-    BitVectorNode::s_prob_pick_ess_input = 1000;
-  }
+  /**
+   * We want to test deterministically, with selecting essential inputs when
+   * there are any. For this we additionally have to set the probability of
+   * selecting essential inputs to 100% to disables random input selection in
+   * essential path selection mode, which is performed with (the complement of
+   * this) configured probability for completeness.
+   */
+  static void set_path_sel(BitVectorNode& op) { op.set_path_sel(true, 1000); }
   template <class T>
   void test_binary(NodeKind kind);
   void test_ite();
@@ -106,6 +102,7 @@ TestBvNodeSelPath::test_binary(NodeKind kind)
         std::unique_ptr<BitVectorNode> leaf1(
             new BitVectorNode(d_rng.get(), s1_val, s1));
         T lop(d_rng.get(), bw_t, leaf0.get(), leaf1.get());
+        set_path_sel(lop);
         is_val0       = lop[0]->is_value();
         is_val1       = lop[1]->is_value();
         is_essential0 = lop.is_essential(t, 0);
@@ -138,6 +135,7 @@ TestBvNodeSelPath::test_binary(NodeKind kind)
         std::unique_ptr<BitVectorNode> op_s1(
             new BitVectorAdd(d_rng.get(), s1, child1.get(), child1.get()));
         T oop(d_rng.get(), bw_t, op_s0.get(), op_s1.get());
+        set_path_sel(oop);
         is_val0       = lop[0]->is_value();
         is_val1       = lop[1]->is_value();
         is_essential0 = oop.is_essential(t, 0);
@@ -229,6 +227,7 @@ TestBvNodeSelPath::test_ite()
               new BitVectorNode(d_rng.get(), s2_val, s2));
           BitVectorIte lop(
               d_rng.get(), bw_t, leaf0.get(), leaf1.get(), leaf2.get());
+          set_path_sel(lop);
           is_val0       = lop[0]->is_value();
           is_val1       = lop[1]->is_value();
           is_val2       = lop[2]->is_value();
@@ -270,6 +269,7 @@ TestBvNodeSelPath::test_ite()
               d_rng.get(), s2, childbwt.get(), childbwt.get()));
           BitVectorIte oop(
               d_rng.get(), bw_t, op_s0.get(), op_s1.get(), op_s2.get());
+          set_path_sel(oop);
           is_val0       = lop[0]->is_value();
           is_val1       = lop[1]->is_value();
           is_val2       = lop[2]->is_value();
@@ -335,6 +335,7 @@ TestBvNodeSelPath::test_not()
       std::unique_ptr<BitVectorNode> leaf0(
           new BitVectorNode(d_rng.get(), s0_val, s0));
       BitVectorNot lop(d_rng.get(), bw_t, leaf0.get());
+      set_path_sel(lop);
       is_val       = lop[0]->is_value();
       is_essential = lop.is_essential(t, 0);
       /* we only perform this death test once (for performance reasons) */
@@ -357,6 +358,7 @@ TestBvNodeSelPath::test_not()
       std::unique_ptr<BitVectorNode> op_s0(
           new BitVectorNot(d_rng.get(), s0, child.get()));
       BitVectorNot oop(d_rng.get(), bw_t, op_s0.get());
+      set_path_sel(oop);
       is_val       = lop[0]->is_value();
       is_essential = oop.is_essential(t, 0);
       /* we only perform this death test once (for performance reasons) */
@@ -415,6 +417,7 @@ TestBvNodeSelPath::test_extract()
           std::unique_ptr<BitVectorNode> leaf0(
               new BitVectorNode(d_rng.get(), s0_val, s0));
           BitVectorExtract lop(d_rng.get(), bw_t, leaf0.get(), hi, lo, false);
+          set_path_sel(lop);
           is_val       = lop[0]->is_value();
           is_essential = lop.is_essential(t, 0);
           /* we only perform this death test once (for performance reasons) */
@@ -437,6 +440,7 @@ TestBvNodeSelPath::test_extract()
           std::unique_ptr<BitVectorNode> op_s0(
               new BitVectorMul(d_rng.get(), s0, child.get(), child.get()));
           BitVectorExtract oop(d_rng.get(), bw_t, op_s0.get(), hi, lo, false);
+          set_path_sel(oop);
           is_val       = lop[0]->is_value();
           is_essential = oop.is_essential(t, 0);
           /* we only perform this death test once (for performance reasons) */
@@ -494,6 +498,7 @@ TestBvNodeSelPath::test_sext()
         std::unique_ptr<BitVectorNode> leaf0(
             new BitVectorNode(d_rng.get(), s0_val, s0));
         BitVectorSignExtend lop(d_rng.get(), bw_t, leaf0.get(), n);
+        set_path_sel(lop);
         is_val       = lop[0]->is_value();
         is_essential = lop.is_essential(t, 0);
         /* we only perform this death test once (for performance reasons) */
@@ -516,6 +521,7 @@ TestBvNodeSelPath::test_sext()
         std::unique_ptr<BitVectorNode> op_s0(
             new BitVectorUdiv(d_rng.get(), s0, child.get(), child.get()));
         BitVectorSignExtend oop(d_rng.get(), bw_t, op_s0.get(), n);
+        set_path_sel(oop);
         is_val       = lop[0]->is_value();
         is_essential = oop.is_essential(t, 0);
         /* we only perform this death test once (for performance reasons) */
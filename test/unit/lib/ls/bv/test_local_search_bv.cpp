@@ -102,17 +102,21 @@ class TestLsBv : public TestBvNodeCommon
     d_root2 = d_ls->mk_node(NodeKind::EQ, 1, {d_v1edv3e_ext, d_v3sc1pv3pv1});
   }
 
+  using ParentsMap =
+      std::unordered_map<uint64_t, std::unordered_set<uint64_t>>;
+
   /**
    * Create a mapping from nodes to their parents to compare against the
    * mapping created internally on node creation.
    */
-  LocalSearchBV::ParentsMap get_expected_parents();
+  ParentsMap get_expected_parents();
   /**
-   * Get a reference of the parents map of the LocalSearchBV object.
+   * Get a mapping from nodes to their parents from the parents graph of the
+   * LocalSearchBV object.
    * Note: LocalSearchBV::d_parents is private and only the main test class has
    *       access to it.
    */
-  const LocalSearchBV::ParentsMap& get_parents() { return d_ls->d_parents; }
+  ParentsMap get_parents();
 
   /**
    * Wrapper for LocalSearchBV::update_cone().
@@ -143,10 +147,10 @@ class TestLsBv : public TestBvNodeCommon
   uint64_t d_root1, d_root2;
 };
 
-LocalSearchBV::ParentsMap
+TestLsBv::ParentsMap
 TestLsBv::get_expected_parents()
 {
-  LocalSearchBV::ParentsMap parents;
+  ParentsMap parents;
   std::vector<uint64_t> to_visit = {d_root1, d_root2};
   while (!to_visit.empty())
   {
@@ -173,6 +177,20 @@ TestLsBv::get_expected_parents()
   return parents;
 }
 
+TestLsBv::ParentsMap
+TestLsBv::get_parents()
+{
+  ParentsMap parents;
+  for (uint64_t id = 0, n = d_ls->d_parents.size(); id < n; ++id)
+  {
+    auto range  = d_ls->d_parents.parents(id);
+    parents[id] = {range.begin(), range.end()};
+    // parents must be unique
+    assert(parents[id].size() == range.size());
+  }
+  return parents;
+}
+
 void
 TestLsBv::update_cone(uint64_t id, const BitVector& assignment)
 {
@@ -588,8 +606,8 @@ TEST_F(TestLsBv, parents)
   d_ls->register_root(d_root1);
   d_ls->register_root(d_root2);
 
-  const LocalSearchBV::ParentsMap& parents   = get_parents();
-  LocalSearchBV::ParentsMap parents_expected = get_expected_parents();
+  ParentsMap parents          = get_parents();
+  ParentsMap parents_expected = get_expected_parents();
 
   {
     const std::unordered_set<uint64_t>& p  = parents.at(d_c1);
@@ -824,6 +842,198 @@ TEST_F(TestLsBv, update_cone)
   }
 }
 
+TEST_F(TestLsBv, move_root_weights)
+{
+  d_ls->d_options.use_root_weights = true;
+  d_ls->register_root(d_root1);
+  d_ls->register_root(d_root2);
+  ASSERT_EQ(d_ls->d_root_weights[d_root1], 1);
+  ASSERT_EQ(d_ls->d_root_weights[d_root2], 1);
+
+  Result res = Result::UNKNOWN;
+  for (uint32_t i = 0; i < NMOVES_FAST && res == Result::UNKNOWN; ++i)
+  {
+    res = d_ls->move();
+  }
+  ASSERT_NE(res, Result::UNSAT);
+  if (res == Result::SAT)
+  {
+    ASSERT_TRUE(d_ls->get_assignment(d_root1).is_true());
+    ASSERT_TRUE(d_ls->get_assignment(d_root2).is_true());
+  }
+  ASSERT_GE(d_ls->d_root_weights[d_root1], 1);
+  ASSERT_GE(d_ls->d_root_weights[d_root2], 1);
+  ASSERT_EQ(d_ls->weighted_unsat() == 0, d_ls->all_roots_sat());
+
+  /* weights are reset when roots are popped */
+  d_ls->push();
+  uint64_t root3 =
+      d_ls->mk_node(NodeKind::BV_ULT, 1, {d_v1pv2av2, d_v1pc1mv2});
+  d_ls->register_root(root3);
+  ASSERT_EQ(d_ls->d_root_weights[root3], 1);
+  d_ls->set_root_weight(root3, 5);
+  d_ls->pop();
+  d_ls->push();
+  d_ls->register_root(root3);
+  ASSERT_EQ(d_ls->d_root_weights[root3], 1);
+  d_ls->pop();
+}
+
+TEST_F(TestLsBv, move_no_root_weights)
+{
+  d_ls->register_root(d_root1);
+  d_ls->register_root(d_root2);
+
+  Result res = Result::UNKNOWN;
+  for (uint32_t i = 0; i < NMOVES_FAST && res == Result::UNKNOWN; ++i)
+  {
+    res = d_ls->move();
+  }
+  ASSERT_NE(res, Result::UNSAT);
+  /* root weights are not maintained if disabled */
+  ASSERT_TRUE(d_ls->d_root_weights.empty());
+  ASSERT_EQ(d_ls->d_weights_unsat.size(), 0);
+}
+
+TEST_F(TestLsBv, weighted_unsat)
+{
+  d_ls->d_options.use_root_weights = true;
+  d_ls->register_root(d_root1);
+  d_ls->register_root(d_root2);
+  d_ls->set_root_weight(d_root1, 3);
+  d_ls->set_root_weight(d_root2, 5);
+
+  auto expected = [this]() {
+    uint64_t res = 0;
+    for (uint64_t id : {d_root1, d_root2})
+    {
+      if (d_ls->get_assignment(id).is_false())
+      {
+        res += d_ls->d_root_weights[id];
+      }
+    }
+    return res;
+  };
+
+  ASSERT_EQ(d_ls->weighted_unsat(), expected());
+  Result res = Result::UNKNOWN;
+  for (uint32_t i = 0; i < NMOVES_FAST && res == Result::UNKNOWN; ++i)
+  {
+    res = d_ls->move();
+    ASSERT_EQ(d_ls->weighted_unsat(), expected());
+  }
+  ASSERT_NE(res, Result::UNSAT);
+
+  /* weights of popped roots do not contribute */
+  d_ls->push();
+  uint64_t root3 =
+      d_ls->mk_node(NodeKind::BV_ULT, 1, {d_v1pv2av2, d_v1pc1mv2});
+  d_ls->register_root(root3);
+  d_ls->set_root_weight(root3, 7);
+  d_ls->pop();
+  ASSERT_EQ(d_ls->weighted_unsat(), expected());
+}
+
+TEST_F(TestLsBv, move_restarts)
+{
+  d_ls->d_options.use_restarts = true;
+  d_ls->d_options.restart_base = 1;
+  d_ls->register_root(d_root1);
+  d_ls->register_root(d_root2);
+  ASSERT_EQ(d_ls->get_num_roots_unsat_best(), d_ls->get_num_roots_unsat());
+
+  Result res = Result::UNKNOWN;
+  for (uint32_t i = 0; i < NMOVES_FAST && res == Result::UNKNOWN; ++i)
+  {
+    uint64_t best = d_ls->get_num_roots_unsat_best();
+    res           = d_ls->move();
+    ASSERT_LE(d_ls->get_num_roots_unsat_best(), best);
+    ASSERT_LE(d_ls->get_num_roots_unsat_best(), d_ls->get_num_roots_unsat());
+  }
+  ASSERT_NE(res, Result::UNSAT);
+  if (res == Result::SAT)
+  {
+    ASSERT_EQ(d_ls->get_num_roots_unsat_best(), 0);
+  }
+
+  /* restoring the best assignment restores its number of unsat roots */
+  uint64_t best = d_ls->get_num_roots_unsat_best();
+  d_ls->restore_best();
+  ASSERT_EQ(d_ls->get_num_roots_unsat(), best);
+  ASSERT_TRUE(d_ls->d_best_diff.empty());
+
+  /* tracking is reset when roots are registered */
+  d_ls->push();
+  uint64_t root3 =
+      d_ls->mk_node(NodeKind::BV_ULT, 1, {d_v1pv2av2, d_v1pc1mv2});
+  d_ls->register_root(root3);
+  ASSERT_EQ(d_ls->get_num_roots_unsat_best(), d_ls->get_num_roots_unsat());
+  d_ls->pop();
+  ASSERT_EQ(d_ls->get_num_roots_unsat_best(), d_ls->get_num_roots_unsat());
+}
+
+TEST_F(TestLsBv, inverse_memo)
+{
+  d_ls->d_options.use_inverse_memo = true;
+
+  uint64_t x = d_ls->mk_node(NodeKind::CONST, TEST_BW);
+  uint64_t s = d_ls->mk_node(NodeKind::CONST, TEST_BW);
+  d_ls->set_assignment(s, BitVector::from_ui(TEST_BW, 3));
+  uint64_t mul  = d_ls->mk_node(NodeKind::BV_MUL, TEST_BW, {x, s});
+  uint64_t urem = d_ls->mk_node(NodeKind::BV_UREM, TEST_BW, {x, s});
+
+  BitVectorNode* mul_node  = d_ls->get_node(mul);
+  BitVectorNode* urem_node = d_ls->get_node(urem);
+  BitVector t              = BitVector::from_ui(TEST_BW, 1);
+  const BitVector& sval    = d_ls->get_assignment(s);
+
+  auto stats = d_ls->statistics();
+  ASSERT_EQ(stats.num_inverse_memo_hits, 0);
+  ASSERT_EQ(stats.num_inverse_memo_misses, 0);
+
+  /* bvmul: multiplicative inverse is memoized */
+  for (uint32_t i = 0; i < 2; ++i)
+  {
+    ASSERT_TRUE(mul_node->is_invertible(t, 0));
+    ASSERT_EQ(mul_node->inverse_value(t, 0).bvmul(sval).compare(t), 0);
+  }
+  ASSERT_EQ(stats.num_inverse_memo_hits, 1);
+  ASSERT_EQ(stats.num_inverse_memo_misses, 1);
+
+  /* bvurem: random search for inverse value is not memoized */
+  for (uint32_t i = 0; i < 2; ++i)
+  {
+    ASSERT_TRUE(urem_node->is_invertible(t, 0));
+    ASSERT_EQ(urem_node->inverse_value(t, 0).bvurem(sval).compare(t), 0);
+  }
+  ASSERT_EQ(stats.num_inverse_memo_hits, 1);
+  ASSERT_EQ(stats.num_inverse_memo_misses, 1);
+
+  /* bvurem: factorization of s - t is memoized, 10 does not match the fixed
+   * bits of x, its factor 5 does */
+  uint64_t x1    = d_ls->mk_node(NodeKind::CONST, BitVectorDomain("01xx"));
+  uint64_t s1    = d_ls->mk_node(BitVector::from_ui(4, 12), BitVectorDomain(4));
+  uint64_t urem1 = d_ls->mk_node(NodeKind::BV_UREM, 4, {s1, x1});
+  BitVectorNode* urem1_node = d_ls->get_node(urem1);
+  BitVector t1              = BitVector::from_ui(4, 2);
+  for (uint32_t i = 0; i < 2; ++i)
+  {
+    ASSERT_TRUE(urem1_node->is_invertible(t1, 1));
+    ASSERT_EQ(BitVector::from_ui(4, 12)
+                  .bvurem(urem1_node->inverse_value(t1, 1))
+                  .compare(t1),
+              0);
+  }
+  ASSERT_EQ(stats.num_inverse_memo_hits, 2);
+  ASSERT_EQ(stats.num_inverse_memo_misses, 2);
+
+  /* nodes of other kinds do not memoize */
+  uint64_t add = d_ls->mk_node(NodeKind::BV_ADD, TEST_BW, {x, s});
+  ASSERT_TRUE(d_ls->get_node(add)->is_invertible(t, 0));
+  ASSERT_EQ(stats.num_inverse_memo_hits, 2);
+  ASSERT_EQ(stats.num_inverse_memo_misses, 2);
+}
+
 TEST_F(TestLsBv, move_add)
 {
   test_move_binary(NodeKind::BV_ADD, 0);
@@ -0,0 +1,320 @@
+/***
+ * Bitwuzla: Satisfiability Modulo Theories (SMT) solver.
+ *
+ * Copyright (C) 2024 by the authors listed in the AUTHORS file at
+ * https://github.com/bitwuzla/bitwuzla/blob/main/AUTHORS
+ *
+ * This file is part of Bitwuzla under the MIT license. See COPYING for more
+ * information at https://github.com/bitwuzla/bitwuzla/blob/main/COPYING
+ */
+
+#include <cfenv>
+#include <cstring>
+
+#include "ls/fp/floating_point_bv.h"
+#include "test_lib.h"
+
+namespace bzla::ls::test {
+
+using RoundingMode = FloatingPointBV::RoundingMode;
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * Tests floating-point arithmetic on bit-vectors against the floating-point
+ * arithmetic of the host for single and double precision. RNA is not
+ * supported by the host and is tested separately.
+ */
+class TestFpBv : public ::bzla::test::TestCommon
+{
+ protected:
+  enum class Op
+  {
+    ADD,
+    MUL,
+    DIV,
+  };
+
+  void SetUp() override
+  {
+    TestCommon::SetUp();
+    d_rng.reset(new RNG(1234));
+  }
+
+  void TearDown() override { std::fesetround(FE_TONEAREST); }
+
+  static BitVector to_bv(float f)
+  {
+    uint32_t u;
+    std::memcpy(&u, &f, sizeof(u));
+    return BitVector::from_ui(32, u);
+  }
+
+  static BitVector to_bv(double d)
+  {
+    uint64_t u;
+    std::memcpy(&u, &d, sizeof(u));
+    return BitVector::from_ui(64, u);
+  }
+
+  template <class T>
+  static T from_bv(const BitVector& bv)
+  {
+    T res;
+    if constexpr (sizeof(T) == 4)
+    {
+      uint32_t u = static_cast<uint32_t>(bv.to_uint64());
+      std::memcpy(&res, &u, sizeof(res));
+    }
+    else
+    {
+      uint64_t u = bv.to_uint64();
+      std::memcpy(&res, &u, sizeof(res));
+    }
+    return res;
+  }
+
+  /** Set the rounding mode of the host. */
+  static void set_host_rm(RoundingMode rm)
+  {
+    switch (rm)
+    {
+      case RoundingMode::RNE: std::fesetround(FE_TONEAREST); break;
+      case RoundingMode::RTN: std::fesetround(FE_DOWNWARD); break;
+      case RoundingMode::RTP: std::fesetround(FE_UPWARD); break;
+      default:
+        assert(rm == RoundingMode::RTZ);
+        std::fesetround(FE_TOWARDZERO);
+    }
+  }
+
+  template <class T>
+  void test_binary(Op op, const FloatingPointBV& fp);
+  template <class T>
+  void test_conversion(const FloatingPointBV& fp);
+
+  static constexpr uint64_t NUM_TESTS = 20000;
+  static constexpr RoundingMode s_host_rms[] = {RoundingMode::RNE,
+                                                RoundingMode::RTN,
+                                                RoundingMode::RTP,
+                                                RoundingMode::RTZ};
+
+  std::unique_ptr<RNG> d_rng;
+  FloatingPointBV d_fp32{8, 24};
+  FloatingPointBV d_fp64{11, 53};
+};
+
+template <class T>
+void
+TestFpBv::test_binary(Op op, const FloatingPointBV& fp)
+{
+  for (RoundingMode rm : s_host_rms)
+  {
+    for (uint64_t i = 0; i < NUM_TESTS; ++i)
+    {
+      BitVector x = fp.mk_random(*d_rng);
+      BitVector y = fp.mk_random(*d_rng);
+      if (i % 4 == 0)
+      {
+        // close exponents for cancellation and tie cases
+        y = fp.add(rm, x, fp.mk_random(*d_rng));
+      }
+      set_host_rm(rm);
+      volatile T a = from_bv<T>(x);
+      volatile T b = from_bv<T>(y);
+      volatile T c;
+      BitVector res;
+      switch (op)
+      {
+        case Op::ADD:
+          c   = a + b;
+          res = fp.add(rm, x, y);
+          break;
+        case Op::MUL:
+          c   = a * b;
+          res = fp.mul(rm, x, y);
+          break;
+        default:
+          assert(op == Op::DIV);
+          c   = a / b;
+          res = fp.div(rm, x, y);
+      }
+      std::fesetround(FE_TONEAREST);
+      BitVector expected = to_bv(static_cast<T>(c));
+      ASSERT_TRUE(fp.smt_eq(res, expected))
+          << "rm: " << static_cast<int>(rm) << ", x: " << x << ", y: " << y
+          << ", expected: " << expected << ", result: " << res;
+    }
+  }
+}
+
+template <class T>
+void
+TestFpBv::test_conversion(const FloatingPointBV& fp)
+{
+  for (RoundingMode rm : s_host_rms)
+  {
+    for (uint64_t i = 0; i < NUM_TESTS; ++i)
+    {
+      BitVector bv(64, *d_rng);
+      uint64_t shift = d_rng->pick<uint64_t>(0, 63);
+      bv.ibvshr(shift);
+      set_host_rm(rm);
+      volatile int64_t s  = static_cast<int64_t>(bv.to_uint64());
+      volatile uint64_t u = bv.to_uint64();
+      volatile T cs       = static_cast<T>(s);
+      volatile T cu       = static_cast<T>(u);
+      std::fesetround(FE_TONEAREST);
+      ASSERT_EQ(fp.from_bv(rm, bv, true), to_bv(static_cast<T>(cs)));
+      ASSERT_EQ(fp.from_bv(rm, bv, false), to_bv(static_cast<T>(cu)));
+    }
+  }
+}
+
+/* -------------------------------------------------------------------------- */
+
+TEST_F(TestFpBv, classify)
+{
+  EXPECT_TRUE(d_fp32.is_nan(to_bv(std::nanf(""))));
+  EXPECT_TRUE(d_fp32.is_nan(d_fp32.mk_nan()));
+  EXPECT_TRUE(d_fp32.is_inf(d_fp32.mk_inf(true)));
+  EXPECT_TRUE(d_fp32.is_neg(d_fp32.mk_inf(true)));
+  EXPECT_TRUE(d_fp32.is_zero(to_bv(-0.0f)));
+  EXPECT_TRUE(d_fp32.is_neg(to_bv(-0.0f)));
+  EXPECT_TRUE(d_fp32.is_subnormal(to_bv(1e-40f)));
+  EXPECT_TRUE(d_fp32.is_normal(to_bv(1e-30f)));
+  EXPECT_FALSE(d_fp32.is_neg(d_fp32.mk_nan()));
+  EXPECT_FALSE(d_fp32.is_pos(d_fp32.mk_nan()));
+  EXPECT_EQ(d_fp32.mk_one(true), to_bv(-1.0f));
+  EXPECT_EQ(d_fp64.mk_max(false), to_bv(1.7976931348623157e308));
+}
+
+TEST_F(TestFpBv, compare)
+{
+  for (uint64_t i = 0; i < NUM_TESTS; ++i)
+  {
+    BitVector x = d_fp64.mk_random(*d_rng);
+    BitVector y = i % 8 == 0 ? x : d_fp64.mk_random(*d_rng);
+    double a    = from_bv<double>(x);
+    double b    = from_bv<double>(y);
+    ASSERT_EQ(d_fp64.eq(x, y), a == b);
+    ASSERT_EQ(d_fp64.lt(x, y), a < b);
+    ASSERT_EQ(d_fp64.leq(x, y), a <= b);
+  }
+  EXPECT_TRUE(d_fp32.eq(to_bv(0.0f), to_bv(-0.0f)));
+  EXPECT_FALSE(d_fp32.smt_eq(to_bv(0.0f), to_bv(-0.0f)));
+  EXPECT_TRUE(d_fp32.smt_eq(to_bv(std::nanf("")), d_fp32.mk_nan()));
+}
+
+TEST_F(TestFpBv, next)
+{
+  EXPECT_EQ(d_fp32.next_up(to_bv(1.0f)), to_bv(std::nextafterf(1.0f, 2.0f)));
+  EXPECT_EQ(d_fp32.next_down(to_bv(1.0f)), to_bv(std::nextafterf(1.0f, 0.0f)));
+  EXPECT_EQ(d_fp32.next_up(to_bv(-0.0f)), to_bv(std::nextafterf(0.0f, 1.0f)));
+  EXPECT_EQ(d_fp32.next_down(to_bv(0.0f)), to_bv(-std::nextafterf(0.0f, 1.0f)));
+  EXPECT_EQ(d_fp32.next_up(d_fp32.mk_max(false)), d_fp32.mk_inf(false));
+  EXPECT_EQ(d_fp32.next_up(d_fp32.mk_inf(true)), d_fp32.mk_max(true));
+}
+
+TEST_F(TestFpBv, add)
+{
+  test_binary<float>(Op::ADD, d_fp32);
+  test_binary<double>(Op::ADD, d_fp64);
+  EXPECT_EQ(d_fp32.add(RoundingMode::RTN, to_bv(1.0f), to_bv(-1.0f)),
+            to_bv(-0.0f));
+  EXPECT_EQ(d_fp32.add(RoundingMode::RNE, to_bv(1.0f), to_bv(-1.0f)),
+            to_bv(0.0f));
+}
+
+TEST_F(TestFpBv, mul)
+{
+  test_binary<float>(Op::MUL, d_fp32);
+  test_binary<double>(Op::MUL, d_fp64);
+}
+
+TEST_F(TestFpBv, div)
+{
+  test_binary<float>(Op::DIV, d_fp32);
+  test_binary<double>(Op::DIV, d_fp64);
+}
+
+TEST_F(TestFpBv, rna)
+{
+  // 1 + 2^-24 is a tie in single precision
+  BitVector x = to_bv(1.0f);
+  BitVector y = to_bv(std::ldexp(1.0f, -24));
+  EXPECT_EQ(d_fp32.add(RoundingMode::RNE, x, y), x);
+  EXPECT_EQ(d_fp32.add(RoundingMode::RNA, x, y), d_fp32.next_up(x));
+  EXPECT_EQ(d_fp32.add(RoundingMode::RNA, d_fp32.neg(x), d_fp32.neg(y)),
+            d_fp32.next_down(d_fp32.neg(x)));
+  // ties in between subnormal values
+  FloatingPointBV fp(3, 3);
+  BitVector min_sub = fp.next_up(fp.mk_zero(false));
+  BitVector two =
+      fp.from_bv(RoundingMode::RNE, BitVector::from_ui(2, 2), false);
+  EXPECT_TRUE(fp.is_zero(fp.div(RoundingMode::RNE, min_sub, two)));
+  EXPECT_EQ(fp.div(RoundingMode::RNA, min_sub, two), min_sub);
+  // overflow
+  EXPECT_EQ(fp.add(RoundingMode::RNA, fp.mk_max(false), fp.mk_max(false)),
+            fp.mk_inf(false));
+  EXPECT_EQ(fp.add(RoundingMode::RTZ, fp.mk_max(false), fp.mk_max(false)),
+            fp.mk_max(false));
+}
+
+TEST_F(TestFpBv, from_fp)
+{
+  for (RoundingMode rm : s_host_rms)
+  {
+    for (uint64_t i = 0; i < NUM_TESTS; ++i)
+    {
+      BitVector x = d_fp64.mk_random(*d_rng);
+      if (i % 2)
+      {
+        // values in the range of single precision
+        x = d_fp64.from_fp(rm, d_fp32.mk_random(*d_rng), d_fp32);
+        x = d_fp64.add(rm, x, d_fp64.mk_random(*d_rng));
+      }
+      set_host_rm(rm);
+      volatile double d = from_bv<double>(x);
+      volatile float f  = static_cast<float>(d);
+      std::fesetround(FE_TONEAREST);
+      BitVector res = d_fp32.from_fp(rm, x, d_fp64);
+      ASSERT_TRUE(d_fp32.smt_eq(res, to_bv(static_cast<float>(f))))
+          << "rm: " << static_cast<int>(rm) << ", x: " << x;
+      // widening is exact
+      BitVector y = d_fp32.mk_random(*d_rng);
+      ASSERT_TRUE(d_fp64.smt_eq(
+          d_fp64.from_fp(rm, y, d_fp32),
+          to_bv(static_cast<double>(from_bv<float>(y)))));
+    }
+  }
+}
+
+TEST_F(TestFpBv, from_bv)
+{
+  test_conversion<float>(d_fp32);
+  test_conversion<double>(d_fp64);
+  EXPECT_EQ(d_fp32.from_bv(
+                RoundingMode::RNE, BitVector::mk_min_signed(8), true),
+            to_bv(-128.0f));
+}
+
+TEST_F(TestFpBv, to_bv)
+{
+  EXPECT_EQ(d_fp32.to_bv(to_bv(-2.75f), 8, true), BitVector::from_si(8, -2));
+  EXPECT_EQ(d_fp32.to_bv(to_bv(127.5f), 8, true), BitVector::from_si(8, 127));
+  EXPECT_EQ(d_fp32.to_bv(to_bv(255.0f), 8, false), BitVector::from_ui(8, 255));
+  EXPECT_EQ(d_fp32.to_bv(to_bv(0.5f), 8, false), BitVector::mk_zero(8));
+  EXPECT_TRUE(d_fp32.to_bv(to_bv(128.0f), 8, true).is_null());
+  EXPECT_TRUE(d_fp32.to_bv(to_bv(256.0f), 8, false).is_null());
+  EXPECT_TRUE(d_fp32.to_bv(to_bv(-1.0f), 8, false).is_null());
+  EXPECT_TRUE(d_fp32.to_bv(d_fp32.mk_nan(), 8, false).is_null());
+  for (uint64_t i = 0; i < NUM_TESTS; ++i)
+  {
+    BitVector bv = BitVector(32, *d_rng).ibvshr(d_rng->pick<uint64_t>(0, 31));
+    BitVector x  = d_fp64.from_bv(RoundingMode::RNE, bv, true);
+    ASSERT_EQ(d_fp64.to_bv(x, 32, true), bv);
+  }
+}
+
+}  // namespace bzla::ls::test
@@ -0,0 +1,461 @@
+/***
+ * Bitwuzla: Satisfiability Modulo Theories (SMT) solver.
+ *
+ * Copyright (C) 2024 by the authors listed in the AUTHORS file at
+ * https://github.com/bitwuzla/bitwuzla/blob/main/AUTHORS
+ *
+ * This file is part of Bitwuzla under the MIT license. See COPYING for more
+ * information at https://github.com/bitwuzla/bitwuzla/blob/main/COPYING
+ */
+
+#include <memory>
+
+#include "bv/domain/bitvector_domain.h"
+#include "ls/fp/floating_point_node.h"
+#include "ls/ls_bv.h"
+#include "rng/rng.h"
+#include "test_lib.h"
+
+namespace bzla::ls::test {
+
+using RoundingMode = FloatingPointBV::RoundingMode;
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * Tests inverse and consistent value computation of floating-point operators
+ * exhaustively for a small format.
+ */
+class TestFpNode : public ::bzla::test::TestCommon
+{
+ protected:
+  /** The exponent size of the tested format. */
+  static constexpr uint64_t EXP_SIZE = 3;
+  /** The significand size of the tested format. */
+  static constexpr uint64_t SIG_SIZE = 3;
+  /** The bit-vector size of the operand of conversions from bit-vectors. */
+  static constexpr uint64_t BV_SIZE = 4;
+  /** The number of random operand assignments per target value. */
+  static constexpr uint32_t NUM_CONS_TESTS = 10;
+
+  void SetUp() override
+  {
+    TestCommon::SetUp();
+    d_rng.reset(new RNG(1234));
+  }
+
+  /** @return All values of size `size`. */
+  static std::vector<BitVector> all_values(uint64_t size)
+  {
+    std::vector<BitVector> res;
+    for (uint64_t i = 0, n = uint64_t{1} << size; i < n; ++i)
+    {
+      res.push_back(BitVector::from_ui(size, i));
+    }
+    return res;
+  }
+
+  std::unique_ptr<BitVectorNode> mk_leaf(const BitVector& value)
+  {
+    return std::make_unique<BitVectorNode>(
+        d_rng.get(), value, BitVectorDomain(value.size()));
+  }
+
+  std::unique_ptr<BitVectorNode> mk_op(NodeKind kind,
+                                       uint64_t size,
+                                       BitVectorNode* child0,
+                                       BitVectorNode* child1 = nullptr,
+                                       BitVectorNode* child2 = nullptr);
+
+  /**
+   * Test is_invertible() and inverse_value() for all operand values and all
+   * target values in the image of the operator wrt. to the operand value
+   * of `s`.
+   * @param kind     The kind of the operator.
+   * @param size     The size of the operator.
+   * @param pos_x    The index of operand `x`.
+   * @param complete True if every target value in the image must be
+   *                 invertible, else at least 90% of them.
+   */
+  void test_inv(NodeKind kind, uint64_t size, uint64_t pos_x, bool complete);
+
+  /**
+   * Test is_consistent() and consistent_value() for all target values and
+   * random operand values.
+   * @param kind  The kind of the operator.
+   * @param size  The size of the operator.
+   * @param pos_x The index of operand `x`.
+   */
+  void test_cons(NodeKind kind, uint64_t size, uint64_t pos_x);
+
+  /** The tested format. */
+  FloatingPointBV d_fp{EXP_SIZE, SIG_SIZE};
+  /** The source format of FP_TO_FP_FROM_FP. */
+  FloatingPointBV d_fp_src{EXP_SIZE + 1, SIG_SIZE + 1};
+  std::unique_ptr<RNG> d_rng;
+
+ private:
+  /** @return The size of the operand at index `pos` of given kind. */
+  uint64_t operand_size(NodeKind kind, uint64_t pos) const;
+  /** @return The arity of given kind. */
+  static uint32_t arity(NodeKind kind);
+};
+
+std::unique_ptr<BitVectorNode>
+TestFpNode::mk_op(NodeKind kind,
+                  uint64_t size,
+                  BitVectorNode* child0,
+                  BitVectorNode* child1,
+                  BitVectorNode* child2)
+{
+  RNG* rng = d_rng.get();
+  BitVectorDomain d(size);
+  uint64_t eb = EXP_SIZE, sb = SIG_SIZE;
+  switch (kind)
+  {
+    case NodeKind::FP_ABS:
+      return std::make_unique<FloatingPointAbs>(rng, d, eb, sb, child0);
+    case NodeKind::FP_NEG:
+      return std::make_unique<FloatingPointNeg>(rng, d, eb, sb, child0);
+    case NodeKind::FP_ADD:
+      return std::make_unique<FloatingPointAdd>(
+          rng, d, eb, sb, child0, child1, child2);
+    case NodeKind::FP_MUL:
+      return std::make_unique<FloatingPointMul>(
+          rng, d, eb, sb, child0, child1, child2);
+    case NodeKind::FP_DIV:
+      return std::make_unique<FloatingPointDiv>(
+          rng, d, eb, sb, child0, child1, child2);
+    case NodeKind::FP_EQ:
+      return std::make_unique<FloatingPointEq>(rng, d, eb, sb, child0, child1);
+    case NodeKind::FP_EQUAL:
+      return std::make_unique<FloatingPointEqual>(
+          rng, d, eb, sb, child0, child1);
+    case NodeKind::FP_LEQ:
+      return std::make_unique<FloatingPointLeq>(
+          rng, d, eb, sb, child0, child1);
+    case NodeKind::FP_LT:
+      return std::make_unique<FloatingPointLt>(rng, d, eb, sb, child0, child1);
+    case NodeKind::FP_TO_FP_FROM_FP:
+      return std::make_unique<FloatingPointToFpFromFp>(rng,
+                                                       d,
+                                                       eb,
+                                                       sb,
+                                                       d_fp_src.exp_size(),
+                                                       d_fp_src.sig_size(),
+                                                       child0,
+                                                       child1);
+    case NodeKind::FP_TO_FP_FROM_SBV:
+    case NodeKind::FP_TO_FP_FROM_UBV:
+      return std::make_unique<FloatingPointToFpFromBv>(
+          rng,
+          d,
+          eb,
+          sb,
+          kind == NodeKind::FP_TO_FP_FROM_SBV,
+          child0,
+          child1);
+    default:
+      return std::make_unique<FloatingPointIsClass>(
+          rng, d, kind, eb, sb, child0);
+  }
+}
+
+uint32_t
+TestFpNode::arity(NodeKind kind)
+{
+  switch (kind)
+  {
+    case NodeKind::FP_ADD:
+    case NodeKind::FP_MUL:
+    case NodeKind::FP_DIV: return 3;
+    case NodeKind::FP_EQ:
+    case NodeKind::FP_EQUAL:
+    case NodeKind::FP_LEQ:
+    case NodeKind::FP_LT:
+    case NodeKind::FP_TO_FP_FROM_FP:
+    case NodeKind::FP_TO_FP_FROM_SBV:
+    case NodeKind::FP_TO_FP_FROM_UBV: return 2;
+    default: return 1;
+  }
+}
+
+uint64_t
+TestFpNode::operand_size(NodeKind kind, uint64_t pos) const
+{
+  switch (kind)
+  {
+    case NodeKind::FP_ADD:
+    case NodeKind::FP_MUL:
+    case NodeKind::FP_DIV:
+      return pos == 0 ? FloatingPointBV::s_rm_size : d_fp.size();
+    case NodeKind::FP_TO_FP_FROM_FP:
+      return pos == 0 ? FloatingPointBV::s_rm_size : d_fp_src.size();
+    case NodeKind::FP_TO_FP_FROM_SBV:
+    case NodeKind::FP_TO_FP_FROM_UBV:
+      return pos == 0 ? FloatingPointBV::s_rm_size : BV_SIZE;
+    default: return d_fp.size();
+  }
+}
+
+void
+TestFpNode::test_inv(NodeKind kind,
+                     uint64_t size,
+                     uint64_t pos_x,
+                     bool complete)
+{
+  uint32_t n = arity(kind);
+  std::vector<BitVector> rms;
+  for (uint64_t i = 0; i < static_cast<uint64_t>(RoundingMode::NUM_RM); ++i)
+  {
+    rms.push_back(FloatingPointBV::mk_rm(static_cast<RoundingMode>(i)));
+  }
+  auto values = [&](uint64_t pos) {
+    // rounding mode operands only range over valid rounding modes
+    bool is_rm = n > 1 && pos == 0 && kind != NodeKind::FP_EQ
+                 && kind != NodeKind::FP_EQUAL && kind != NodeKind::FP_LEQ
+                 && kind != NodeKind::FP_LT;
+    return is_rm ? rms : all_values(operand_size(kind, pos));
+  };
+
+  // all assignments of the operands other than x
+  std::vector<std::vector<BitVector>> other_values;
+  other_values.emplace_back();
+  for (uint32_t i = 0; i < n; ++i)
+  {
+    if (i == pos_x) continue;
+    std::vector<std::vector<BitVector>> tmp;
+    for (const auto& prefix : other_values)
+    {
+      for (const BitVector& v : values(i))
+      {
+        tmp.push_back(prefix);
+        tmp.back().push_back(v);
+      }
+    }
+    other_values = std::move(tmp);
+  }
+
+  std::vector<BitVector> x_values = values(pos_x);
+  uint64_t ninv = 0, nimage = 0;
+  for (const auto& other : other_values)
+  {
+    std::vector<std::unique_ptr<BitVectorNode>> children;
+    for (uint32_t i = 0, j = 0; i < n; ++i)
+    {
+      children.push_back(mk_leaf(i == pos_x ? x_values[0] : other[j++]));
+    }
+    std::unique_ptr<BitVectorNode> op =
+        mk_op(kind,
+              size,
+              children[0].get(),
+              n > 1 ? children[1].get() : nullptr,
+              n > 2 ? children[2].get() : nullptr);
+
+    // the image of the operator wrt. to the current values of s
+    std::vector<BitVector> image;
+    for (const BitVector& x : x_values)
+    {
+      children[pos_x]->set_assignment(x);
+      op->evaluate();
+      BitVector t = op->assignment();
+      bool found  = false;
+      for (const BitVector& v : image)
+      {
+        if (v.compare(t) == 0)
+        {
+          found = true;
+          break;
+        }
+      }
+      if (!found)
+      {
+        image.push_back(t);
+      }
+    }
+
+    children[pos_x]->set_assignment(x_values[0]);
+    op->evaluate();
+    for (const BitVector& t : image)
+    {
+      nimage += 1;
+      if (op->is_invertible(t, pos_x))
+      {
+        ninv += 1;
+        BitVector inv = op->inverse_value(t, pos_x);
+        children[pos_x]->set_assignment(inv);
+        op->evaluate();
+        if (size == d_fp.size())
+        {
+          ASSERT_TRUE(d_fp.smt_eq(op->assignment(), t));
+        }
+        else
+        {
+          ASSERT_EQ(op->assignment().compare(t), 0);
+        }
+        children[pos_x]->set_assignment(x_values[0]);
+        op->evaluate();
+      }
+      else if (complete)
+      {
+        FAIL() << "not invertible: " << kind << " pos_x " << pos_x << " t "
+               << t;
+      }
+    }
+  }
+  ASSERT_GE(ninv * 10, nimage * 9);
+}
+
+void
+TestFpNode::test_cons(NodeKind kind, uint64_t size, uint64_t pos_x)
+{
+  uint32_t n = arity(kind);
+  for (const BitVector& t : all_values(size))
+  {
+    for (uint32_t k = 0; k < NUM_CONS_TESTS; ++k)
+    {
+      std::vector<std::unique_ptr<BitVectorNode>> children;
+      for (uint32_t i = 0; i < n; ++i)
+      {
+        children.push_back(mk_leaf(BitVector(operand_size(kind, i), *d_rng)));
+      }
+      std::unique_ptr<BitVectorNode> op =
+          mk_op(kind,
+                size,
+                children[0].get(),
+                n > 1 ? children[1].get() : nullptr,
+                n > 2 ? children[2].get() : nullptr);
+      if (op->is_consistent(t, pos_x))
+      {
+        const BitVector& cons = op->consistent_value(t, pos_x);
+        ASSERT_EQ(cons.size(), operand_size(kind, pos_x));
+      }
+      else
+      {
+        // only fp.abs has a consistency condition
+        ASSERT_EQ(kind, NodeKind::FP_ABS);
+        ASSERT_TRUE(d_fp.is_neg(t));
+      }
+    }
+  }
+}
+
+/* -------------------------------------------------------------------------- */
+
+TEST_F(TestFpNode, inv_abs)
+{
+  test_inv(NodeKind::FP_ABS, d_fp.size(), 0, true);
+}
+
+TEST_F(TestFpNode, inv_neg)
+{
+  test_inv(NodeKind::FP_NEG, d_fp.size(), 0, true);
+}
+
+TEST_F(TestFpNode, inv_add)
+{
+  test_inv(NodeKind::FP_ADD, d_fp.size(), 0, true);
+  test_inv(NodeKind::FP_ADD, d_fp.size(), 1, false);
+  test_inv(NodeKind::FP_ADD, d_fp.size(), 2, false);
+}
+
+TEST_F(TestFpNode, inv_mul)
+{
+  test_inv(NodeKind::FP_MUL, d_fp.size(), 0, true);
+  test_inv(NodeKind::FP_MUL, d_fp.size(), 1, false);
+  test_inv(NodeKind::FP_MUL, d_fp.size(), 2, false);
+}
+
+TEST_F(TestFpNode, inv_div)
+{
+  test_inv(NodeKind::FP_DIV, d_fp.size(), 0, true);
+  test_inv(NodeKind::FP_DIV, d_fp.size(), 1, false);
+  test_inv(NodeKind::FP_DIV, d_fp.size(), 2, false);
+}
+
+TEST_F(TestFpNode, inv_pred)
+{
+  for (NodeKind kind : {NodeKind::FP_EQ,
+                        NodeKind::FP_EQUAL,
+                        NodeKind::FP_LEQ,
+                        NodeKind::FP_LT})
+  {
+    test_inv(kind, 1, 0, true);
+    test_inv(kind, 1, 1, true);
+  }
+  for (NodeKind kind : {NodeKind::FP_IS_INF,
+                        NodeKind::FP_IS_NAN,
+                        NodeKind::FP_IS_NEG,
+                        NodeKind::FP_IS_NORMAL,
+                        NodeKind::FP_IS_POS,
+                        NodeKind::FP_IS_SUBNORMAL,
+                        NodeKind::FP_IS_ZERO})
+  {
+    test_inv(kind, 1, 0, true);
+  }
+}
+
+TEST_F(TestFpNode, inv_to_fp)
+{
+  for (NodeKind kind : {NodeKind::FP_TO_FP_FROM_FP,
+                        NodeKind::FP_TO_FP_FROM_SBV,
+                        NodeKind::FP_TO_FP_FROM_UBV})
+  {
+    test_inv(kind, d_fp.size(), 0, true);
+    test_inv(kind, d_fp.size(), 1, false);
+  }
+}
+
+TEST_F(TestFpNode, cons)
+{
+  test_cons(NodeKind::FP_ABS, d_fp.size(), 0);
+  test_cons(NodeKind::FP_NEG, d_fp.size(), 0);
+  for (NodeKind kind :
+       {NodeKind::FP_ADD, NodeKind::FP_MUL, NodeKind::FP_DIV})
+  {
+    for (uint64_t pos_x = 0; pos_x < 3; ++pos_x)
+    {
+      test_cons(kind, d_fp.size(), pos_x);
+    }
+  }
+  for (NodeKind kind : {NodeKind::FP_EQ, NodeKind::FP_LEQ, NodeKind::FP_LT})
+  {
+    test_cons(kind, 1, 0);
+    test_cons(kind, 1, 1);
+  }
+  test_cons(NodeKind::FP_IS_NAN, 1, 0);
+  test_cons(NodeKind::FP_TO_FP_FROM_FP, d_fp.size(), 1);
+  test_cons(NodeKind::FP_TO_FP_FROM_SBV, d_fp.size(), 1);
+}
+
+TEST_F(TestFpNode, ls_add)
+{
+  // fp.add(rm, x, y) = t for random t and random initial assignments
+  for (uint32_t i = 0; i < 100; ++i)
+  {
+    BitVector t = d_fp.mk_random(*d_rng);
+    LocalSearchBV ls(1000, 1000, i);
+    BitVectorDomain d(d_fp.size());
+    uint64_t rm = ls.mk_node(FloatingPointBV::mk_rm(RoundingMode::RNE),
+                             BitVectorDomain(FloatingPointBV::s_rm_size));
+    uint64_t x  = ls.mk_node(d_fp.mk_random(*d_rng), d);
+    uint64_t y  = ls.mk_node(d_fp.mk_random(*d_rng), d);
+    uint64_t c  = ls.mk_node(t, BitVectorDomain(t));
+    uint64_t op = ls.mk_node(
+        NodeKind::FP_ADD, d_fp.size(), {rm, x, y}, {EXP_SIZE, SIG_SIZE});
+    uint64_t root = ls.mk_node(
+        NodeKind::FP_EQ, 1, {op, c}, {EXP_SIZE, SIG_SIZE});
+    ls.register_root(root);
+    Result res;
+    do
+    {
+      res = ls.move();
+    } while (res == Result::UNKNOWN && ls.num_moves() < 100);
+    ASSERT_EQ(res, Result::SAT);
+    ASSERT_TRUE(d_fp.smt_eq(ls.get_assignment(op), t));
+  }
+}
+
+/* -------------------------------------------------------------------------- */
+
+}  // namespace bzla::ls::test
@@ -0,0 +1,139 @@
+/***
+ * Bitwuzla: Satisfiability Modulo Theories (SMT) solver.
+ *
+ * Copyright (C) 2024 by the authors listed in the AUTHORS file at
+ * https://github.com/bitwuzla/bitwuzla/blob/main/AUTHORS
+ *
+ * This file is part of Bitwuzla under the MIT license. See COPYING for more
+ * information at https://github.com/bitwuzla/bitwuzla/blob/main/COPYING
+ */
+
+#include <algorithm>
+#include <unordered_set>
+
+#include "ls/sparse_set.h"
+#include "test_lib.h"
+
+namespace bzla::test {
+
+using namespace bzla::ls;
+
+class TestSparseSet : public TestCommon
+{
+ protected:
+  /** Check that `set` contains exactly the ids in `expected`. */
+  static void check(const SparseSet& set,
+                    const std::unordered_set<uint64_t>& expected)
+  {
+    ASSERT_EQ(set.size(), expected.size());
+    ASSERT_EQ(set.empty(), expected.empty());
+    for (size_t i = 0; i < set.size(); ++i)
+    {
+      ASSERT_TRUE(expected.find(set[i]) != expected.end());
+    }
+    for (uint64_t id : expected)
+    {
+      ASSERT_TRUE(set.contains(id));
+    }
+    std::unordered_set<uint64_t> elements(set.begin(), set.end());
+    ASSERT_EQ(elements, expected);
+  }
+};
+
+TEST_F(TestSparseSet, insert_erase)
+{
+  SparseSet set;
+  ASSERT_TRUE(set.empty());
+  ASSERT_FALSE(set.contains(0));
+  ASSERT_FALSE(set.erase(0));
+
+  ASSERT_TRUE(set.insert(3));
+  ASSERT_TRUE(set.insert(7));
+  ASSERT_TRUE(set.insert(0));
+  ASSERT_TRUE(set.insert(5));
+  ASSERT_FALSE(set.insert(7));
+  check(set, {0, 3, 5, 7});
+  ASSERT_FALSE(set.contains(1));
+  ASSERT_FALSE(set.contains(4));
+  ASSERT_FALSE(set.contains(100));
+
+  /* erase first element, last element is moved into its position */
+  ASSERT_TRUE(set.erase(3));
+  ASSERT_FALSE(set.contains(3));
+  ASSERT_EQ(set[0], 5);
+  check(set, {0, 5, 7});
+
+  /* erase moved element */
+  ASSERT_TRUE(set.erase(5));
+  ASSERT_FALSE(set.erase(5));
+  check(set, {0, 7});
+
+  /* erase last element */
+  ASSERT_TRUE(set.erase(0));
+  check(set, {7});
+
+  /* reinsert erased elements */
+  ASSERT_TRUE(set.insert(3));
+  ASSERT_TRUE(set.insert(5));
+  check(set, {3, 5, 7});
+
+  ASSERT_TRUE(set.erase(7));
+  ASSERT_TRUE(set.erase(3));
+  ASSERT_TRUE(set.erase(5));
+  check(set, {});
+}
+
+TEST_F(TestSparseSet, random)
+{
+  RNG rng(1234);
+  SparseSet set;
+  std::unordered_set<uint64_t> expected;
+  for (uint32_t i = 0; i < 10000; ++i)
+  {
+    uint64_t id = rng.pick<uint64_t>(0, 127);
+    if (rng.flip_coin())
+    {
+      ASSERT_EQ(set.insert(id), expected.insert(id).second);
+    }
+    else
+    {
+      ASSERT_EQ(set.erase(id), expected.erase(id) > 0);
+    }
+    ASSERT_EQ(set.contains(id), expected.find(id) != expected.end());
+  }
+  check(set, expected);
+}
+
+TEST_F(TestSparseSet, pick_from_indexed)
+{
+  RNG rng(1234);
+  SparseSet set;
+  for (uint64_t id = 0; id < 64; ++id)
+  {
+    set.insert(id);
+  }
+  for (uint64_t id = 0; id < 64; id += 3)
+  {
+    set.erase(id);
+  }
+
+  std::unordered_set<uint64_t> picked;
+  for (uint32_t i = 0; i < 10000; ++i)
+  {
+    uint64_t id = rng.pick_from_indexed<SparseSet, uint64_t>(set);
+    ASSERT_TRUE(set.contains(id));
+    ASSERT_NE(id % 3, 0);
+    picked.insert(id);
+  }
+  /* all members are picked eventually */
+  ASSERT_EQ(picked.size(), set.size());
+
+  std::vector<uint32_t> vec = {2, 4, 8};
+  for (uint32_t i = 0; i < 100; ++i)
+  {
+    uint32_t val = rng.pick_from_indexed<std::vector<uint32_t>, uint32_t>(vec);
+    ASSERT_TRUE(std::find(vec.begin(), vec.end(), val) != vec.end());
+  }
+}
+
+}  // namespace bzla::test
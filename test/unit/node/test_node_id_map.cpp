@@ -0,0 +1,106 @@
+/***
+ * Bitwuzla: Satisfiability Modulo Theories (SMT) solver.
+ *
+ * Copyright (C) 2024 by the authors listed in the AUTHORS file at
+ * https://github.com/bitwuzla/bitwuzla/blob/main/AUTHORS
+ *
+ * This file is part of Bitwuzla under the MIT license. See COPYING for more
+ * information at https://github.com/bitwuzla/bitwuzla/blob/main/COPYING
+ */
+
+#include "node/node_id_map.h"
+#include "node/node_manager.h"
+#include "test/unit/test.h"
+
+namespace bzla::test {
+
+using namespace bzla::node;
+
+class TestNodeIdMap : public TestCommon
+{
+};
+
+TEST_F(TestNodeIdMap, emplace_find)
+{
+  NodeManager nm;
+  NodeIdMap<uint64_t> map;
+
+  Type bv_type = nm.mk_bv_type(8);
+  Node x       = nm.mk_const(bv_type);
+  Node y       = nm.mk_const(bv_type);
+
+  ASSERT_TRUE(map.empty());
+  ASSERT_EQ(map.find(x), map.end());
+
+  auto [it, inserted] = map.emplace(x, 1);
+  ASSERT_TRUE(inserted);
+  ASSERT_EQ(it->first, x);
+  ASSERT_EQ(it->second, 1);
+  ASSERT_FALSE(map.emplace(x, 2).second);
+  ASSERT_EQ(map.at(x), 1);
+  ASSERT_EQ(map.size(), 1);
+
+  map[y] = 3;
+  ASSERT_EQ(map.size(), 2);
+  ASSERT_EQ(map.find(y)->second, 3);
+  ASSERT_EQ(map.count(y), 1);
+  ASSERT_THROW(map.at(nm.mk_const(bv_type)), std::out_of_range);
+
+  ASSERT_EQ(map.erase(x), 1);
+  ASSERT_EQ(map.erase(x), 0);
+  ASSERT_EQ(map.find(x), map.end());
+  ASSERT_EQ(map.size(), 1);
+
+  map.clear();
+  ASSERT_TRUE(map.empty());
+  ASSERT_EQ(map.begin(), map.end());
+}
+
+TEST_F(TestNodeIdMap, iterate)
+{
+  NodeManager nm;
+  NodeIdMap<Node> map;
+
+  Type bv_type = nm.mk_bv_type(8);
+  std::vector<Node> nodes;
+  for (size_t i = 0; i < 5000; ++i)
+  {
+    nodes.push_back(nm.mk_const(bv_type));
+  }
+  // Insert every third node to leave gaps and unallocated pages.
+  size_t num = 0;
+  for (size_t i = 0; i < nodes.size(); i += 3)
+  {
+    map.emplace(nodes[i], nodes[i]);
+    ++num;
+  }
+  ASSERT_EQ(map.size(), num);
+
+  size_t count = 0;
+  uint64_t prev_id = 0;
+  for (const auto& [key, value] : map)
+  {
+    ASSERT_EQ(key, value);
+    ASSERT_GT(key.id(), prev_id);
+    prev_id = key.id();
+    ++count;
+  }
+  ASSERT_EQ(count, num);
+}
+
+TEST_F(TestNodeIdMap, reference_stability)
+{
+  NodeManager nm;
+  NodeIdMap<Node> map;
+
+  Type bv_type = nm.mk_bv_type(8);
+  Node x       = nm.mk_const(bv_type);
+  const Node& ref = map.emplace(x, x).first->second;
+  for (size_t i = 0; i < 5000; ++i)
+  {
+    map.emplace(nm.mk_const(bv_type));
+  }
+  ASSERT_EQ(ref, x);
+}
+
+}  // namespace bzla::test
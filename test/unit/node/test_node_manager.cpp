@@ -8,6 +8,8 @@
  * information at https://github.com/bitwuzla/bitwuzla/blob/main/COPYING
  */
 
+#include <thread>
+
 #include "bv/bitvector.h"
 #include "node/node.h"
 #include "node/node_manager.h"
@@ -230,6 +232,109 @@ TEST_F(TestNodeManager, mk_apply)
   ASSERT_DEATH_DEBUG(nm.mk_node(Kind::APPLY, {fun, bool_const}), "");
 }
 
+TEST_F(TestNodeManager, node_data_bytes)
+{
+  NodeManager nm;
+
+  Type bv_type = nm.mk_bv_type(128);
+  Node x       = nm.mk_const(bv_type);
+  Node y       = nm.mk_const(bv_type);
+
+  uint64_t bytes = nm.node_data_bytes();
+  ASSERT_GT(bytes, 0);
+  {
+    Node add    = nm.mk_node(Kind::BV_ADD, {x, y});
+    Node mul    =
+        nm.mk_node(Kind::BV_MUL, {add, nm.mk_value(BitVector::mk_one(128))});
+    Node extr   = nm.mk_node(Kind::BV_EXTRACT, {mul}, {63, 0});
+    Node concat = nm.mk_node(Kind::BV_CONCAT, {extr, extr});
+    ASSERT_GT(nm.node_data_bytes(), bytes);
+  }
+  // All nodes above were garbage collected.
+  ASSERT_EQ(nm.node_data_bytes(), bytes);
+
+  // Released memory is reused for node data of the same size.
+  Node add = nm.mk_node(Kind::BV_ADD, {x, y});
+  ASSERT_GT(nm.node_data_bytes(), bytes);
+  ASSERT_EQ(add[0], x);
+  ASSERT_EQ(add[1], y);
+}
+
+TEST_F(TestNodeManager, unique_table_erase)
+{
+  NodeManager nm;
+
+  Type bv_type = nm.mk_bv_type(32);
+  Node x       = nm.mk_const(bv_type);
+
+  std::vector<Node> nodes;
+  for (uint64_t i = 0; i < 1000; ++i)
+  {
+    nodes.push_back(nm.mk_node(Kind::BV_ADD,
+                               {x, nm.mk_value(BitVector::from_ui(32, i))}));
+  }
+  // Release every other node to create holes in probe sequences.
+  for (size_t i = 0; i < nodes.size(); i += 2)
+  {
+    nodes[i] = Node();
+  }
+  // Remaining nodes must still be found via hash consing.
+  for (uint64_t i = 1; i < nodes.size(); i += 2)
+  {
+    ASSERT_EQ(nodes[i],
+              nm.mk_node(Kind::BV_ADD,
+                         {x, nm.mk_value(BitVector::from_ui(32, i))}));
+  }
+  for (uint64_t i = 0; i < nodes.size(); i += 2)
+  {
+    nodes[i] = nm.mk_node(Kind::BV_ADD,
+                          {x, nm.mk_value(BitVector::from_ui(32, i))});
+    ASSERT_EQ(nodes[i][1].value<BitVector>().to_uint64(), i);
+  }
+}
+
+TEST_F(TestNodeManager, thread_safe)
+{
+  NodeManager nm(true);
+  ASSERT_TRUE(nm.is_thread_safe());
+
+  Type bv_type = nm.mk_bv_type(32);
+  Node x       = nm.mk_const(bv_type);
+
+  size_t num_threads = 8;
+  std::vector<std::vector<Node>> results(num_threads);
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < num_threads; ++t)
+  {
+    threads.emplace_back([&nm, &x, &results, t]() {
+      for (size_t r = 0; r < 10; ++r)
+      {
+        std::vector<Node> nodes;
+        for (uint64_t i = 0; i < 100; ++i)
+        {
+          Node add = nm.mk_node(Kind::BV_ADD,
+                                {x, nm.mk_value(BitVector::from_ui(32, i))});
+          nodes.push_back(nm.mk_node(Kind::BV_EXTRACT, {add}, {7, 0}));
+        }
+        results[t] = std::move(nodes);
+      }
+    });
+  }
+  for (auto& thread : threads)
+  {
+    thread.join();
+  }
+
+  // Nodes created by different threads are hash consed.
+  for (size_t t = 1; t < num_threads; ++t)
+  {
+    ASSERT_EQ(results[t], results[0]);
+  }
+  uint64_t bytes = nm.node_data_bytes();
+  results.clear();
+  ASSERT_LT(nm.node_data_bytes(), bytes);
+}
+
 TEST_F(TestNodeManager, check_type)
 {
   NodeManager nm;
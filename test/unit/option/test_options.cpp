@@ -63,6 +63,9 @@ TEST_F(TestOptions, opt_enum)
   ASSERT_EQ(d_opts.sat_solver(), SatSolver::KISSAT);
   ASSERT_EQ(d_opts.get<std::string>(Option::SAT_SOLVER), "kissat");
 #endif
+  d_opts.set<std::string>(Option::SAT_SOLVER, "portfolio");
+  ASSERT_EQ(d_opts.sat_solver(), SatSolver::PORTFOLIO);
+  ASSERT_EQ(d_opts.get<std::string>(Option::SAT_SOLVER), "portfolio");
   ASSERT_DEATH_DEBUG(d_opts.get<bool>(Option::SAT_SOLVER), "is_bool");
   ASSERT_DEATH_DEBUG(d_opts.get<uint64_t>(Option::SAT_SOLVER), "is_numeric");
 }
@@ -77,6 +80,15 @@ TEST_F(TestOptions, opt_defaults)
     ASSERT_EQ(opts.prop_nprops(), 10000);
     ASSERT_EQ(opts.prop_nupdates(), 2000000);
   }
+  {
+    Options opts;
+    opts.set<std::string>(Option::BV_SOLVER, "preprop");
+    opts.set<bool>(Option::PREPROP_PARALLEL, true);
+    opts.finalize();
+    ASSERT_EQ(opts.bv_solver(), BvSolver::PREPROP);
+    ASSERT_EQ(opts.prop_nprops(), 0);
+    ASSERT_EQ(opts.prop_nupdates(), 0);
+  }
   {
     Options opts;
     opts.set<std::string>(Option::BV_SOLVER, "preprop");
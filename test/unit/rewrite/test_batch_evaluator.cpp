@@ -0,0 +1,183 @@
+/***
+ * Bitwuzla: Satisfiability Modulo Theories (SMT) solver.
+ *
+ * Copyright (C) 2024 by the authors listed in the AUTHORS file at
+ * https://github.com/bitwuzla/bitwuzla/blob/main/AUTHORS
+ *
+ * This file is part of Bitwuzla under the MIT license. See COPYING for more
+ * information at https://github.com/bitwuzla/bitwuzla/blob/main/COPYING
+ */
+
+#include "bv/bitvector.h"
+#include "env.h"
+#include "gtest/gtest.h"
+#include "node/node_manager.h"
+#include "rewrite/batch_evaluator.h"
+#include "rewrite/rewriter.h"
+#include "rng/rng.h"
+
+namespace bzla::test {
+
+using namespace bzla::node;
+
+class TestBatchEvaluator : public ::testing::Test
+{
+ protected:
+  TestBatchEvaluator() : d_env(d_nm), d_rewriter(d_env.rewriter()) {}
+
+  /**
+   * Evaluate term over random assignments and check the result in every lane
+   * against the rewriter's constant folding.
+   */
+  void test_term(const Node& term, const std::vector<Node>& inputs)
+  {
+    BatchEvaluator eval({term});
+    ASSERT_TRUE(eval.is_supported());
+    for (const Node& input : inputs)
+    {
+      eval.set_random(input, d_rng);
+    }
+    eval.evaluate();
+
+    for (size_t lane = 0; lane < BatchEvaluator::NUM_LANES; ++lane)
+    {
+      std::unordered_map<Node, Node> subst;
+      for (const Node& input : inputs)
+      {
+        BitVector val = eval.value(input, lane);
+        subst.emplace(input,
+                      input.type().is_bool() ? d_nm.mk_value(val.is_true())
+                                             : d_nm.mk_value(val));
+      }
+      Node expected = d_rewriter.rewrite(d_nm.mk_node(
+          term.kind(),
+          {subst.at(term[0]), subst.at(term[term.num_children() - 1])},
+          term.indices()));
+      ASSERT_TRUE(expected.is_value());
+      BitVector res = eval.value(term, lane);
+      if (term.type().is_bool())
+      {
+        ASSERT_EQ(res.is_true(), expected.value<bool>())
+            << term << " in lane " << lane;
+        ASSERT_EQ((eval.lanes(term) >> lane) & 1, res.is_true());
+      }
+      else
+      {
+        ASSERT_EQ(res, expected.value<BitVector>())
+            << term << " in lane " << lane;
+      }
+    }
+  }
+
+  NodeManager d_nm;
+  Env d_env;
+  Rewriter& d_rewriter;
+  RNG d_rng{1234};
+};
+
+TEST_F(TestBatchEvaluator, binary_bv)
+{
+  std::vector<Kind> kinds = {
+      Kind::BV_ADD,  Kind::BV_AND,  Kind::BV_ASHR, Kind::BV_COMP,
+      Kind::BV_MUL,  Kind::BV_NAND, Kind::BV_NOR,  Kind::BV_OR,
+      Kind::BV_SDIV, Kind::BV_SGE,  Kind::BV_SGT,  Kind::BV_SHL,
+      Kind::BV_SHR,  Kind::BV_SLE,  Kind::BV_SLT,  Kind::BV_SMOD,
+      Kind::BV_SREM, Kind::BV_SUB,  Kind::BV_UADDO, Kind::BV_UDIV,
+      Kind::BV_UGE,  Kind::BV_UGT,  Kind::BV_ULE,  Kind::BV_ULT,
+      Kind::BV_UREM, Kind::BV_USUBO, Kind::BV_XNOR, Kind::BV_XOR,
+      Kind::BV_CONCAT, Kind::EQUAL, Kind::DISTINCT};
+  for (uint64_t size : {1, 3, 4, 8, 13})
+  {
+    Type type = d_nm.mk_bv_type(size);
+    Node x    = d_nm.mk_const(type);
+    Node y    = d_nm.mk_const(type);
+    for (Kind kind : kinds)
+    {
+      test_term(d_nm.mk_node(kind, {x, y}), {x, y});
+    }
+  }
+}
+
+TEST_F(TestBatchEvaluator, unary_bv)
+{
+  Type type = d_nm.mk_bv_type(7);
+  Node x    = d_nm.mk_const(type);
+  for (Kind kind : {Kind::BV_DEC,
+                    Kind::BV_INC,
+                    Kind::BV_NEG,
+                    Kind::BV_NOT,
+                    Kind::BV_REDAND,
+                    Kind::BV_REDOR,
+                    Kind::BV_REDXOR})
+  {
+    test_term(d_nm.mk_node(kind, {x}), {x});
+  }
+  test_term(d_nm.mk_node(Kind::BV_EXTRACT, {x}, {5, 2}), {x});
+  test_term(d_nm.mk_node(Kind::BV_ZERO_EXTEND, {x}, {3}), {x});
+  test_term(d_nm.mk_node(Kind::BV_SIGN_EXTEND, {x}, {3}), {x});
+  test_term(d_nm.mk_node(Kind::BV_REPEAT, {x}, {3}), {x});
+  test_term(d_nm.mk_node(Kind::BV_ROLI, {x}, {3}), {x});
+  test_term(d_nm.mk_node(Kind::BV_RORI, {x}, {9}), {x});
+}
+
+TEST_F(TestBatchEvaluator, boolean)
+{
+  Node a = d_nm.mk_const(d_nm.mk_bool_type());
+  Node b = d_nm.mk_const(d_nm.mk_bool_type());
+  for (Kind kind : {Kind::AND, Kind::IMPLIES, Kind::OR, Kind::XOR, Kind::EQUAL})
+  {
+    test_term(d_nm.mk_node(kind, {a, b}), {a, b});
+  }
+  test_term(d_nm.mk_node(Kind::NOT, {a}), {a});
+}
+
+TEST_F(TestBatchEvaluator, dag)
+{
+  Type type = d_nm.mk_bv_type(8);
+  Node a    = d_nm.mk_const(d_nm.mk_bool_type());
+  Node x    = d_nm.mk_const(type);
+  Node y    = d_nm.mk_const(type);
+  Node sum  = d_nm.mk_node(Kind::BV_ADD, {x, y});
+  Node prod = d_nm.mk_node(Kind::BV_MUL, {sum, x});
+  Node ite  = d_nm.mk_node(Kind::ITE, {a, sum, prod});
+  Node ult  = d_nm.mk_node(Kind::BV_ULT, {ite, y});
+
+  BatchEvaluator eval({ult, a});
+  ASSERT_TRUE(eval.is_supported());
+  ASSERT_EQ(eval.inputs().size(), 3);
+  ASSERT_EQ(eval.num_instructions(), 4);
+
+  for (size_t lane = 0; lane < BatchEvaluator::NUM_LANES; ++lane)
+  {
+    eval.set_value(a, lane, lane % 2 == 0);
+    eval.set_value(x, lane, BitVector::from_ui(8, lane));
+    eval.set_value(y, lane, d_nm.mk_value(BitVector::from_ui(8, 3 * lane)));
+  }
+  eval.evaluate();
+
+  BatchEvaluator::Word sat = 0;
+  for (size_t lane = 0; lane < BatchEvaluator::NUM_LANES; ++lane)
+  {
+    uint64_t s = (lane + 3 * lane) % 256;
+    uint64_t v = lane % 2 == 0 ? s : (s * lane) % 256;
+    bool res   = v < (3 * lane) % 256;
+    ASSERT_EQ(eval.value(ult, lane).is_true(), res);
+    if (res && lane % 2 == 0)
+    {
+      sat |= BatchEvaluator::Word{1} << lane;
+    }
+  }
+  ASSERT_EQ(eval.satisfied(), sat);
+}
+
+TEST_F(TestBatchEvaluator, unsupported)
+{
+  Type type = d_nm.mk_array_type(d_nm.mk_bv_type(4), d_nm.mk_bv_type(4));
+  Node arr  = d_nm.mk_const(type);
+  Node i    = d_nm.mk_const(d_nm.mk_bv_type(4));
+  Node sel  = d_nm.mk_node(Kind::SELECT, {arr, i});
+  BatchEvaluator eval({d_nm.mk_node(Kind::EQUAL, {sel, i})});
+  ASSERT_FALSE(eval.is_supported());
+}
+
+}  // namespace bzla::test